@@ -0,0 +1,124 @@
+/**
+ * bench_atlas.c
+ * NLM-Atlas lookup microbenchmark: pointer tree vs flat index, ns/lookup
+ * over working sets from L1-resident to well beyond the last-level cache
+ */
+
+#include "obivox/nlm_atlas.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define QUERIES      (1u << 20)
+#define OPS_PER_SVC  64
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t lcg_next(uint32_t* state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+typedef struct {
+    char service[32];
+    char operation[32];
+} Query;
+
+static volatile float sink;
+
+static void run(uint32_t nodes) {
+    uint32_t services = (nodes + OPS_PER_SVC - 1) / OPS_PER_SVC;
+    Query* names = malloc(nodes * sizeof(Query));
+    for (uint32_t i = 0; i < nodes; i++) {
+        snprintf(names[i].service, sizeof(names[i].service), "service-%u", i % services);
+        snprintf(names[i].operation, sizeof(names[i].operation), "operation-%u", i / services);
+    }
+
+    // Random insertion order scatters the tree nodes across the heap
+    uint32_t lcg = 7u;
+    for (uint32_t i = nodes - 1; i > 0; i--) {
+        uint32_t j = lcg_next(&lcg) % (i + 1);
+        Query t = names[i]; names[i] = names[j]; names[j] = t;
+    }
+
+    NLMAtlasNode* tree = NULL;
+    for (uint32_t i = 0; i < nodes; i++) {
+        NLMAtlasNode* node = NULL;
+        obivox_atlas_insert(&tree, TREE_MODE_AVL, names[i].service, names[i].operation, &node);
+        node->x_coord = i;
+        node->dynamic_cost = (float)i;
+    }
+
+    OBIVoxAtlasIndex* index = NULL;
+    if (obivox_atlas_index_build(tree, &index) != 0) {
+        fprintf(stderr, "index build failed\n");
+        exit(1);
+    }
+
+    uint32_t* order = malloc(QUERIES * sizeof(uint32_t));
+    OBIVoxAtlasKey* keys = malloc(QUERIES * sizeof(OBIVoxAtlasKey));
+    for (uint32_t q = 0; q < QUERIES; q++) {
+        order[q] = lcg_next(&lcg) % nodes;
+        obivox_atlas_index_key(index, names[order[q]].service, names[order[q]].operation, &keys[q]);
+    }
+
+    // Every backend must agree before anything is timed
+    for (uint32_t q = 0; q < QUERIES; q += 97) {
+        const Query* n = &names[order[q]];
+        NLMAtlasNode* a = obivox_atlas_find(tree, n->service, n->operation);
+        const OBIVoxAtlasEntry* b = obivox_atlas_index_find(index, keys[q]);
+        if (!a || !b || a->x_coord != b->x_coord) {
+            fprintf(stderr, "mismatch at query %u\n", q);
+            exit(1);
+        }
+    }
+
+    double start = now_seconds();
+    float total = 0.0f;
+    for (uint32_t q = 0; q < QUERIES; q++) {
+        const Query* n = &names[order[q]];
+        total += obivox_atlas_find(tree, n->service, n->operation)->dynamic_cost;
+    }
+    double tree_ns = (now_seconds() - start) * 1e9 / QUERIES;
+
+    start = now_seconds();
+    for (uint32_t q = 0; q < QUERIES; q++) {
+        const Query* n = &names[order[q]];
+        total += obivox_atlas_index_lookup(index, n->service, n->operation)->dynamic_cost;
+    }
+    double name_ns = (now_seconds() - start) * 1e9 / QUERIES;
+
+    start = now_seconds();
+    for (uint32_t q = 0; q < QUERIES; q++) {
+        total += obivox_atlas_index_find(index, keys[q])->dynamic_cost;
+    }
+    double key_ns = (now_seconds() - start) * 1e9 / QUERIES;
+    sink = total;
+
+    printf("%9u %12.1f %12.1f %12.1f %8.2fx\n",
+           nodes, tree_ns, name_ns, key_ns, tree_ns / key_ns);
+
+    obivox_atlas_index_destroy(index);
+    obivox_atlas_free(tree);
+    free(keys);
+    free(order);
+    free(names);
+}
+
+int main(void) {
+    printf("node bytes: pointer tree %zu, flat hot %zu (key %zu + entry %zu)\n",
+           sizeof(NLMAtlasNode),
+           sizeof(OBIVoxAtlasKey) + sizeof(OBIVoxAtlasEntry),
+           sizeof(OBIVoxAtlasKey), sizeof(OBIVoxAtlasEntry));
+    printf("%9s %12s %12s %12s %9s\n", "nodes", "tree ns", "index(name)", "index(key)", "speedup");
+
+    static const uint32_t sizes[] = { 64, 1024, 16384, 262144, 1048576 };
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        run(sizes[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * bench_features.c
+ * Stage-3 feature extraction: inline vs worker pool at 1..N workers
+ * Reports real-time factor, speedup and YIN error on a known pitch glide
+ */
+
+#include "obivox/nlm_features.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SAMPLE_RATE 16000
+
+// Voiced glide from 110 to 220 Hz with three harmonics plus noise
+static void synth_signal(float* audio, uint32_t n) {
+    uint32_t lcg = 12345u;
+    double phase = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        double f0 = 110.0 * pow(2.0, (double)i / n);
+        phase += 2.0 * M_PI * f0 / SAMPLE_RATE;
+        lcg = lcg * 1664525u + 1013904223u;
+        float noise = ((lcg >> 8) / 16777216.0f - 0.5f) * 0.02f;
+        audio[i] = (float)(0.4 * sin(phase) + 0.2 * sin(2 * phase) + 0.1 * sin(3 * phase)) + noise;
+    }
+}
+
+static double pitch_error(const OBIVoxFeatureFrames* frames, uint32_t n, uint32_t hop) {
+    double err = 0.0;
+    uint32_t counted = 0;
+    for (uint32_t k = 2; k + 2 < frames->frames; k++) {
+        if (frames->pitch_hz[k] <= 0.0f) continue;
+        double expected = 110.0 * pow(2.0, (double)k * hop / n);
+        err += fabs(frames->pitch_hz[k] - expected) / expected;
+        counted++;
+    }
+    return counted ? err / counted : 1.0;
+}
+
+static int run(const char* name, OBIVoxWorkerPool* pool, float* audio, uint32_t n,
+               float baseline_rtf, float* rtf_out, AudioFeatures* reference) {
+    OBIVoxFeatureExtractor* extractor = NULL;
+    if (obivox_feature_extractor_create(NULL, pool, &extractor) != 0) return -1;
+
+    AudioFeatures features = {0};
+    features.raw_audio = audio;
+    features.num_samples = n;
+    features.sample_rate = SAMPLE_RATE;
+
+    OBIVoxFeatureFrames frames;
+    obivox_feature_extract(extractor, &features, &frames);   // warm-up
+    float best = 1e9f;
+    for (int rep = 0; rep < 3; rep++) {
+        obivox_feature_extract(extractor, &features, &frames);
+        if (frames.real_time_factor < best) best = frames.real_time_factor;
+    }
+
+    bool same = true;
+    if (reference->num_samples) {
+        same = features.contour_frames == reference->contour_frames &&
+               features.pitch_step_sum == reference->pitch_step_sum &&
+               features.energy_sum == reference->energy_sum;
+    } else {
+        *reference = features;
+    }
+
+    printf("%-10s RTF %.5f  %8.1fx realtime  speedup %5.2fx  frames %u  pitch err %.2f%%  matches inline %s\n",
+           name, best, 1.0 / best, baseline_rtf > 0 ? baseline_rtf / best : 1.0,
+           frames.frames, 100.0 * pitch_error(&frames, n, SAMPLE_RATE / 100),
+           same ? "yes" : "no");
+
+    *rtf_out = best;
+    obivox_feature_extractor_destroy(extractor);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    uint32_t seconds = argc > 1 ? (uint32_t)atoi(argv[1]) : 60;
+    uint32_t max_workers = argc > 2 ? (uint32_t)atoi(argv[2]) : 0;
+    uint32_t n = seconds * SAMPLE_RATE;
+    if (n == 0) return 1;
+
+    float* audio = malloc(n * sizeof(float));
+    synth_signal(audio, n);
+
+    printf("stage-3 features (MFCC 13+delta, YIN 2048, Hamming 512), %u s @ %d Hz\n",
+           seconds, SAMPLE_RATE);
+
+    AudioFeatures reference = {0};
+    float baseline = 0.0f;
+    float rtf = 0.0f;
+    run("inline", NULL, audio, n, 0.0f, &baseline, &reference);
+
+    if (max_workers == 0) {
+        OBIVoxWorkerPool* probe = NULL;
+        OBIVoxPoolStats stats;
+        obivox_pool_create(NULL, 0, &probe);
+        obivox_pool_stats(probe, &stats);
+        obivox_pool_destroy(probe);
+        max_workers = stats.workers;
+    }
+
+    for (uint32_t workers = 1; workers <= max_workers;
+         workers = (workers < max_workers && workers * 2 > max_workers) ? max_workers : workers * 2) {
+        OBIVoxWorkerPool* pool = NULL;
+        if (obivox_pool_create(NULL, workers, &pool) != 0) break;
+        char name[32];
+        snprintf(name, sizeof(name), "pool x%u", workers);
+        run(name, pool, audio, n, baseline, &rtf, &reference);
+        obivox_pool_destroy(pool);
+    }
+
+    free(audio);
+    return 0;
+}
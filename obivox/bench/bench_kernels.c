@@ -0,0 +1,103 @@
+/**
+ * bench_kernels.c
+ * Feature kernel microbenchmark: samples/sec per kernel and per ISA,
+ * with each ISA's result checked against the scalar reference
+ */
+
+#include "dsp/obivox_kernels.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BUFFER_SAMPLES  (64 * 1024)   // L2-resident, like a feature block
+#define MIN_SECONDS     0.2
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+typedef enum {
+    KERNEL_ZERO_CROSSINGS,
+    KERNEL_DOT,
+    KERNEL_SUM,
+    KERNEL_DIFF_ENERGY,
+    KERNEL_LISP_FILTER,
+    KERNEL_COUNT
+} KernelId;
+
+static const char* kernel_names[KERNEL_COUNT] = {
+    "zero_crossings", "dot", "sum", "diff_energy", "lisp_filter"
+};
+
+static volatile double sink;
+
+static double run_once(const OBIVoxKernels* k, KernelId id,
+                       const float* a, const float* b, float* scratch) {
+    switch (id) {
+    case KERNEL_ZERO_CROSSINGS: return (double)k->zero_crossings(a, BUFFER_SAMPLES, 0.0f);
+    case KERNEL_DOT:            return k->dot(a, b, BUFFER_SAMPLES);
+    case KERNEL_SUM:            return k->sum(a, BUFFER_SAMPLES);
+    case KERNEL_DIFF_ENERGY:    return k->diff_energy(a, BUFFER_SAMPLES);
+    case KERNEL_LISP_FILTER:
+        memcpy(scratch, a, BUFFER_SAMPLES * sizeof(float));
+        k->lisp_filter(scratch, BUFFER_SAMPLES, 0.06f, 0.0f);
+        return scratch[BUFFER_SAMPLES - 1];
+    default:
+        return 0.0;
+    }
+}
+
+int main(void) {
+    float* a = malloc(BUFFER_SAMPLES * sizeof(float));
+    float* b = malloc(BUFFER_SAMPLES * sizeof(float));
+    float* scratch = malloc(BUFFER_SAMPLES * sizeof(float));
+    uint32_t lcg = 1u;
+    for (uint32_t i = 0; i < BUFFER_SAMPLES; i++) {
+        lcg = lcg * 1664525u + 1013904223u;
+        a[i] = (lcg >> 8) / 16777216.0f - 0.5f;
+        b[i] = sinf(i * 0.01f);
+    }
+
+    double scalar_rate[KERNEL_COUNT] = {0};
+    double reference[KERNEL_COUNT] = {0};
+
+    printf("%-8s %-15s %12s %8s %10s\n", "isa", "kernel", "Msamples/s", "speedup", "rel_err");
+    for (int isa = 0; isa < OBIVOX_ISA_COUNT; isa++) {
+        const OBIVoxKernels* k = obivox_kernels_for_isa((OBIVoxISA)isa);
+        if (!k) continue;
+
+        for (int id = 0; id < KERNEL_COUNT; id++) {
+            double result = run_once(k, (KernelId)id, a, b, scratch);
+            uint64_t iterations = 0;
+            double start = now_seconds(), elapsed = 0.0;
+            do {
+                sink = run_once(k, (KernelId)id, a, b, scratch);
+                iterations++;
+                elapsed = now_seconds() - start;
+            } while (elapsed < MIN_SECONDS);
+
+            double rate = iterations * (double)BUFFER_SAMPLES / elapsed;
+            if (isa == OBIVOX_ISA_SCALAR) {
+                scalar_rate[id] = rate;
+                reference[id] = result;
+            }
+            double rel_err = fabs(result - reference[id]) /
+                             (fabs(reference[id]) > 1e-12 ? fabs(reference[id]) : 1.0);
+
+            printf("%-8s %-15s %12.1f %7.2fx %10.2e\n",
+                   k->name, kernel_names[id], rate / 1e6,
+                   rate / scalar_rate[id], rel_err);
+        }
+    }
+
+    printf("dispatch selects: %s\n", obivox_kernels()->name);
+
+    free(a);
+    free(b);
+    free(scratch);
+    return 0;
+}
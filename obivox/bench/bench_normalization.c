@@ -0,0 +1,103 @@
+/**
+ * bench_normalization.c
+ * Stutter smoother: legacy in-place window re-sum vs running-sum box filter
+ * Reports throughput and error against an order-independent double reference
+ */
+
+#include "obivox/nlm_framwork.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define SAMPLE_RATE   16000
+#define SMOOTH_WINDOW 512
+#define PRESERVATION  0.7f
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Deterministic speech-like test signal: voiced harmonics plus noise
+static void synth_signal(float* audio, uint32_t n) {
+    uint32_t lcg = 12345u;
+    for (uint32_t i = 0; i < n; i++) {
+        float t = (float)i / SAMPLE_RATE;
+        lcg = lcg * 1664525u + 1013904223u;
+        float noise = ((lcg >> 8) / 16777216.0f - 0.5f) * 0.05f;
+        audio[i] = 0.4f * sinf(2.0f * (float)M_PI * 140.0f * t) +
+                   0.2f * sinf(2.0f * (float)M_PI * 280.0f * t) + noise;
+    }
+}
+
+// Centred box over the original samples, accumulated in double
+static void reference_smooth(const float* in, double* out, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) out[i] = in[i];
+    for (uint32_t i = SMOOTH_WINDOW; i < n - SMOOTH_WINDOW; i++) {
+        double sum = 0.0;
+        for (int j = -SMOOTH_WINDOW / 2; j <= SMOOTH_WINDOW / 2; j++) {
+            sum += in[i + j];
+        }
+        out[i] = in[i] * PRESERVATION + (sum / SMOOTH_WINDOW) * (1.0 - PRESERVATION);
+    }
+}
+
+static void run_mode(
+    const char* name,
+    NormalizationMode mode,
+    const float* input,
+    const double* reference,
+    uint32_t n) {
+
+    PhoneticAccessibility acc = {0};
+    acc.stutter_detection = true;
+    acc.normalization_mode = mode;
+
+    float* a = malloc(n * sizeof(float));
+    float* b = malloc(n * sizeof(float));
+    memcpy(a, input, n * sizeof(float));
+    memcpy(b, input, n * sizeof(float));
+
+    double start = now_seconds();
+    obivox_apply_phonetic_normalization(a, n, &acc, PRESERVATION);
+    double elapsed = now_seconds() - start;
+    obivox_apply_phonetic_normalization(b, n, &acc, PRESERVATION);
+
+    double max_err = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        double err = fabs(a[i] - reference[i]);
+        if (err > max_err) max_err = err;
+    }
+
+    printf("%-10s %10.2f Msamples/s  %8.1fx realtime  max_err %.3e  deterministic %s\n",
+           name,
+           n / elapsed / 1e6,
+           (n / (double)SAMPLE_RATE) / elapsed,
+           max_err,
+           memcmp(a, b, n * sizeof(float)) == 0 ? "yes" : "no");
+
+    free(a);
+    free(b);
+}
+
+int main(int argc, char** argv) {
+    uint32_t seconds = argc > 1 ? (uint32_t)atoi(argv[1]) : 60;
+    uint32_t n = seconds * SAMPLE_RATE;
+    if (n <= 2 * SMOOTH_WINDOW) return 1;
+
+    float* input = malloc(n * sizeof(float));
+    double* reference = malloc(n * sizeof(double));
+    synth_signal(input, n);
+    reference_smooth(input, reference, n);
+
+    printf("stutter smoother, %u s @ %d Hz (%u samples)\n", seconds, SAMPLE_RATE, n);
+    run_mode("legacy", NORMALIZATION_LEGACY, input, reference, n);
+    run_mode("box", NORMALIZATION_BOX_FILTER, input, reference, n);
+
+    free(input);
+    free(reference);
+    return 0;
+}
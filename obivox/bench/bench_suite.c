@@ -0,0 +1,633 @@
+/**
+ * bench_suite.c
+ * Regression harness for the public API (nlm_framwork.h), the Atlas and
+ * the FFmpeg pipeline over synthetic or recorded corpora of 1 s, 60 s and
+ * 1 h. Each case runs in a forked child so peak RSS is its own; results
+ * are one JSON document on stdout
+ *
+ *   bench_suite [--lengths 1,60,3600] [--corpus file] [--filter text]
+ *               [--min-time ms]
+ */
+
+#include "obivox/nlm_framwork.h"
+#include "obivox/nlm_arena.h"
+#include "obivox/nlm_atlas.h"
+#include "obivox/nlm_ffmpeg.h"
+#include "obivox/nlm_features.h"
+#include "obivox/nlm_denoise.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SAMPLE_RATE      16000
+#define MAX_LENGTHS      8
+#define BATCH_TARGET_NS  1000000ull     // Cheap calls are timed in batches
+#define MAX_ITERATIONS   1000000ull
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================================
+// Allocation Counting
+// ============================================================================
+
+// The executable's allocator wrappers interpose on the library's calls;
+// other C libraries report allocations as null
+#ifdef __GLIBC__
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t count, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void* __libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void* ptr);
+
+static atomic_uint_fast64_t allocations;
+#define ALLOCATIONS_COUNTED 1
+
+void* malloc(size_t size) {
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+    atomic_fetch_add_explicit(&allocations, 1, memory_order_relaxed);
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr ? 0 : 12;  // ENOMEM
+}
+
+void free(void* ptr) {
+    __libc_free(ptr);
+}
+
+static uint64_t allocation_count(void) {
+    return atomic_load_explicit(&allocations, memory_order_relaxed);
+}
+#else
+#define ALLOCATIONS_COUNTED 0
+static uint64_t allocation_count(void) { return 0; }
+#endif
+
+// ============================================================================
+// Corpora
+// ============================================================================
+
+typedef struct {
+    float* audio;                // Pristine corpus, never written
+    uint32_t num_samples;
+    uint8_t* wav;                // Same audio as 16-bit WAV, for FFmpeg
+    size_t wav_bytes;
+    char wav_path[64];
+    char out_path[64];
+} Corpus;
+
+// Deterministic speech-like signal: voiced harmonics with a syllable-rate
+// envelope, pauses and noise (as the other benches, plus pauses so VAD
+// and normalization see realistic structure)
+static void synth_signal(float* audio, uint32_t n) {
+    uint32_t lcg = 12345u;
+    for (uint32_t i = 0; i < n; i++) {
+        float t = (float)i / SAMPLE_RATE;
+        lcg = lcg * 1664525u + 1013904223u;
+        float noise = ((lcg >> 8) / 16777216.0f - 0.5f) * 0.05f;
+        float syllable = 0.5f + 0.5f * sinf(2.0f * (float)M_PI * 4.0f * t);
+        float voiced = fmodf(t, 3.0f) < 2.4f ? 1.0f : 0.0f;
+        float f0 = 140.0f + 20.0f * sinf(2.0f * (float)M_PI * 0.5f * t);
+        audio[i] = voiced * syllable * (0.4f * sinf(2.0f * (float)M_PI * f0 * t) +
+                                        0.2f * sinf(4.0f * (float)M_PI * f0 * t)) + noise;
+    }
+}
+
+static void put_le(uint8_t* p, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) p[i] = (uint8_t)(value >> (8 * i));
+}
+
+static int corpus_wav(Corpus* c) {
+    size_t data = (size_t)c->num_samples * 2;
+    c->wav_bytes = 44 + data;
+    c->wav = malloc(c->wav_bytes);
+    if (!c->wav) return -1;
+
+    uint8_t* h = c->wav;
+    memcpy(h, "RIFF", 4);
+    put_le(h + 4, (uint32_t)(36 + data), 4);
+    memcpy(h + 8, "WAVEfmt ", 8);
+    put_le(h + 16, 16, 4);
+    put_le(h + 20, 1, 2);                   // PCM
+    put_le(h + 22, 1, 2);                   // Mono
+    put_le(h + 24, SAMPLE_RATE, 4);
+    put_le(h + 28, SAMPLE_RATE * 2, 4);
+    put_le(h + 32, 2, 2);
+    put_le(h + 34, 16, 2);
+    memcpy(h + 36, "data", 4);
+    put_le(h + 40, (uint32_t)data, 4);
+    for (uint32_t i = 0; i < c->num_samples; i++) {
+        float s = c->audio[i] < -1.0f ? -1.0f : (c->audio[i] > 1.0f ? 1.0f : c->audio[i]);
+        put_le(h + 44 + 2 * (size_t)i, (uint32_t)(int16_t)lrintf(s * 32767.0f), 2);
+    }
+
+    snprintf(c->wav_path, sizeof(c->wav_path), "/tmp/obivox-bench-%d.wav", (int)getpid());
+    snprintf(c->out_path, sizeof(c->out_path), "/tmp/obivox-bench-%d-out.wav", (int)getpid());
+    FILE* f = fopen(c->wav_path, "wb");
+    if (!f) return -1;
+    size_t written = fwrite(c->wav, 1, c->wav_bytes, f);
+    return fclose(f) == 0 && written == c->wav_bytes ? 0 : -1;
+}
+
+// A recorded corpus is decoded once and tiled (or cut) to each length
+static int corpus_create(const OBIVoxPCMBuffer* recorded, uint32_t seconds, Corpus* c) {
+    memset(c, 0, sizeof(*c));
+    c->num_samples = seconds * SAMPLE_RATE;
+    c->audio = malloc((size_t)c->num_samples * sizeof(float));
+    if (!c->audio) return -1;
+
+    if (recorded) {
+        for (uint32_t i = 0; i < c->num_samples; i++) {
+            c->audio[i] = recorded->samples[i % recorded->num_samples];
+        }
+    } else {
+        synth_signal(c->audio, c->num_samples);
+    }
+    return corpus_wav(c);
+}
+
+static void corpus_destroy(Corpus* c) {
+    if (c->wav_path[0]) unlink(c->wav_path);
+    if (c->out_path[0]) unlink(c->out_path);
+    free(c->audio);
+    free(c->wav);
+}
+
+static int load_recorded(const char* path, OBIVoxPCMBuffer* pcm) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return -1;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    void* data = size > 0 ? malloc((size_t)size) : NULL;
+    int ret = -1;
+    if (data && fread(data, 1, (size_t)size, f) == (size_t)size) {
+        ret = obivox_decode_memory(data, (size_t)size, pcm);
+        if (ret == 0 && pcm->num_samples == 0) ret = -1;
+    }
+    free(data);
+    fclose(f);
+    return ret;
+}
+
+// ============================================================================
+// Cases
+// ============================================================================
+
+typedef enum { UNIT_SAMPLES, UNIT_BYTES, UNIT_CALLS } WorkUnit;
+
+static const char* const unit_names[] = { "samples/s", "bytes/s", "calls/s" };
+
+typedef struct {
+    const Corpus* corpus;
+    float* scratch;              // Per-iteration copy for in-place calls
+    OBIVoxNLMSystem* system;
+    OBIVoxFeatureExtractor* extractor;
+    AudioFeatures features;      // Extracted once, for the mapping
+    OBIVoxPCMBuffer pcm;
+    uint32_t counter;
+} BenchContext;
+
+typedef struct {
+    const char* name;
+    const char* group;           // framework, atlas or ffmpeg
+    bool scales;                 // Run at every corpus length
+    WorkUnit unit;
+    void (*prepare)(BenchContext* ctx);             // Untimed, per call
+    int (*run)(BenchContext* ctx, uint64_t* work);  // Timed
+} BenchCase;
+
+static const char* const TTS_TEXT =
+    "This is his sister's voice; she says the sessions usually start at six.";
+
+static void reset_scratch(BenchContext* ctx) {
+    memcpy(ctx->scratch, ctx->corpus->audio, (size_t)ctx->corpus->num_samples * sizeof(float));
+}
+
+static int run_init_destroy(BenchContext* ctx, uint64_t* work) {
+    (void)ctx;
+    OBIVoxNLMSystem* system = NULL;
+    if (obivox_nlm_init(&system) != 0) return -1;
+    obivox_nlm_destroy(system);
+    *work = 1;
+    return 0;
+}
+
+static int run_detect_variations(BenchContext* ctx, uint64_t* work) {
+    PhoneticAccessibility accessibility = ctx->system->accessibility;
+    float score = 0.0f;
+    *work = ctx->corpus->num_samples;
+    return obivox_detect_speech_variations(ctx->corpus->audio, ctx->corpus->num_samples,
+                                           &accessibility, &score);
+}
+
+static int run_normalization(BenchContext* ctx, uint64_t* work, NormalizationMode mode) {
+    PhoneticAccessibility accessibility = ctx->system->accessibility;
+    accessibility.normalization_mode = mode;
+    *work = ctx->corpus->num_samples;
+    return obivox_apply_phonetic_normalization(ctx->scratch, ctx->corpus->num_samples,
+                                               &accessibility, 0.7f);
+}
+
+static int run_normalization_box(BenchContext* ctx, uint64_t* work) {
+    return run_normalization(ctx, work, NORMALIZATION_BOX_FILTER);
+}
+
+static int run_normalization_legacy(BenchContext* ctx, uint64_t* work) {
+    return run_normalization(ctx, work, NORMALIZATION_LEGACY);
+}
+
+static int run_denoise(BenchContext* ctx, uint64_t* work) {
+    *work = ctx->corpus->num_samples;
+    return obivox_denoise_buffer(ctx->system->denoiser, ctx->scratch, ctx->corpus->num_samples);
+}
+
+static int run_convert_stt(BenchContext* ctx, uint64_t* work) {
+    void* output = NULL;
+    float confidence = 0.0f;
+    size_t bytes = (size_t)ctx->corpus->num_samples * sizeof(float);
+    int ret = obivox_bidirectional_convert_sized(ctx->system, ctx->scratch, bytes,
+                                                 INPUT_AUDIO, &output, &confidence);
+    if (ret == 0) obivox_release_output(ctx->system, output);
+    *work = ctx->corpus->num_samples;
+    return ret;
+}
+
+static int run_convert_tts(BenchContext* ctx, uint64_t* work) {
+    void* output = NULL;
+    float confidence = 0.0f;
+    int ret = obivox_bidirectional_convert(ctx->system, TTS_TEXT, INPUT_TEXT, &output, &confidence);
+    if (ret == 0) obivox_release_output(ctx->system, output);
+    *work = strlen(TTS_TEXT);
+    return ret;
+}
+
+static int run_map_to_nlm(BenchContext* ctx, uint64_t* work) {
+    NLMCoordinate position;
+    *work = ctx->corpus->num_samples;
+    return obivox_map_to_nlm_space(&ctx->features, &position);
+}
+
+static int run_select_codec(BenchContext* ctx, uint64_t* work) {
+    TreeMode mode;
+    *work = 1;
+    return obivox_select_optimal_codec(ctx->system, &ctx->system->current_position, &mode);
+}
+
+static int run_handle_drift(BenchContext* ctx, uint64_t* work) {
+    // Cycles through the three OBIAI zones, restructuring the Atlas
+    static const float drift[] = { 0.1f, 0.5f, 0.9f };
+    bool cascade = false;
+    *work = 1;
+    return obivox_handle_drift(ctx->system, drift[ctx->counter++ % 3], &cascade);
+}
+
+static int run_human_validation(BenchContext* ctx, uint64_t* work) {
+    (void)ctx;
+    HumanFeedback feedback = {0};
+    int ret = obivox_request_human_validation("transcribed text with variation handling",
+                                              0.8f, &feedback);
+    free(feedback.suggested_correction);
+    free(feedback.original_interpretation);
+    *work = 1;
+    return ret < 0 ? -1 : 0;
+}
+
+static int run_incorporate_feedback(BenchContext* ctx, uint64_t* work) {
+    HumanFeedback feedback = { .confidence_threshold = 0.954f };
+    *work = 1;
+    return obivox_incorporate_feedback(ctx->system, &feedback);
+}
+
+static int run_register_plugin(BenchContext* ctx, uint64_t* work) {
+    OBIVoxPlugin plugin = { .name = "bench", .version = "1.0.0" };
+    *work = 1;
+    return obivox_register_plugin(ctx->system, &plugin);
+}
+
+static int run_pronunciation_guide(BenchContext* ctx, uint64_t* work) {
+    char* guide = NULL;
+    int ret = obivox_generate_pronunciation_guide(TTS_TEXT, &ctx->system->accessibility, &guide);
+    free(guide);
+    *work = strlen(TTS_TEXT);
+    return ret;
+}
+
+static int run_atlas_lookup(BenchContext* ctx, uint64_t* work) {
+    OBIVoxAtlasEntry entry;
+    *work = 1;
+    return obivox_atlas_lookup(ctx->system->atlas, OBIVOX_ATLAS_SERVICE_CODEC, "whisper", &entry);
+}
+
+static void bump_cost(OBIVoxAtlasEntry* entry, void* context) {
+    (void)context;
+    entry->dynamic_cost += 1.0f;
+}
+
+static int run_atlas_update(BenchContext* ctx, uint64_t* work) {
+    *work = 1;
+    return obivox_atlas_update(ctx->system->atlas, OBIVOX_ATLAS_SERVICE_PLUGIN, "bench",
+                               bump_cost, NULL) < 0 ? -1 : 0;
+}
+
+static int run_decode_memory(BenchContext* ctx, uint64_t* work) {
+    // The buffer is kept across calls, as a long-lived decoder would
+    *work = ctx->corpus->num_samples;
+    return obivox_decode_memory(ctx->corpus->wav, ctx->corpus->wav_bytes, &ctx->pcm) == 0 ? 0 : -1;
+}
+
+static int run_convert_format(BenchContext* ctx, uint64_t* work) {
+    *work = ctx->corpus->wav_bytes;
+    return obivox_convert_audio_format(ctx->corpus->wav_path, ctx->corpus->out_path, "wav") == 0 ? 0 : -1;
+}
+
+static const BenchCase CASES[] = {
+    { "obivox_nlm_init+destroy",              "framework", false, UNIT_CALLS,   NULL,          run_init_destroy },
+    { "obivox_detect_speech_variations",      "framework", true,  UNIT_SAMPLES, NULL,          run_detect_variations },
+    { "obivox_apply_phonetic_normalization/box",    "framework", true, UNIT_SAMPLES, reset_scratch, run_normalization_box },
+    { "obivox_apply_phonetic_normalization/legacy", "framework", true, UNIT_SAMPLES, reset_scratch, run_normalization_legacy },
+    { "obivox_denoise_buffer",                "framework", true,  UNIT_SAMPLES, reset_scratch, run_denoise },
+    { "obivox_bidirectional_convert/stt",     "framework", true,  UNIT_SAMPLES, reset_scratch, run_convert_stt },
+    { "obivox_bidirectional_convert/tts",     "framework", false, UNIT_BYTES,   NULL,          run_convert_tts },
+    { "obivox_map_to_nlm_space",              "framework", true,  UNIT_SAMPLES, NULL,          run_map_to_nlm },
+    { "obivox_select_optimal_codec",          "framework", false, UNIT_CALLS,   NULL,          run_select_codec },
+    { "obivox_handle_drift",                  "framework", false, UNIT_CALLS,   NULL,          run_handle_drift },
+    { "obivox_request_human_validation",      "framework", false, UNIT_CALLS,   NULL,          run_human_validation },
+    { "obivox_incorporate_feedback",          "framework", false, UNIT_CALLS,   NULL,          run_incorporate_feedback },
+    { "obivox_register_plugin",               "framework", false, UNIT_CALLS,   NULL,          run_register_plugin },
+    { "obivox_generate_pronunciation_guide",  "framework", false, UNIT_BYTES,   NULL,          run_pronunciation_guide },
+    { "obivox_convert_audio_format",          "ffmpeg",    true,  UNIT_BYTES,   NULL,          run_convert_format },
+    { "obivox_decode_memory",                 "ffmpeg",    true,  UNIT_SAMPLES, NULL,          run_decode_memory },
+    { "obivox_atlas_lookup",                  "atlas",     false, UNIT_CALLS,   NULL,          run_atlas_lookup },
+    { "obivox_atlas_update",                  "atlas",     false, UNIT_CALLS,   NULL,          run_atlas_update },
+};
+
+// Declared in nlm_framwork.h without a definition in the library yet
+static const char* const UNIMPLEMENTED[] = {
+    "obivox_process_with_variations",
+    "obivox_calculate_confidence",
+};
+
+// ============================================================================
+// Runner
+// ============================================================================
+
+typedef struct {
+    int status;
+    uint64_t iterations;
+    uint64_t total_ns;
+    uint64_t min_ns;             // Fastest call (per call within a batch)
+    uint64_t work;
+    uint64_t allocations;
+} CaseResult;
+
+static int context_create(const Corpus* corpus, BenchContext* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->corpus = corpus;
+    ctx->scratch = malloc((size_t)corpus->num_samples * sizeof(float));
+    if (!ctx->scratch) return -1;
+    memcpy(ctx->scratch, corpus->audio, (size_t)corpus->num_samples * sizeof(float));
+    if (obivox_nlm_init(&ctx->system) != 0) return -1;
+
+    ctx->features.raw_audio = ctx->scratch;
+    ctx->features.num_samples = corpus->num_samples;
+    ctx->features.sample_rate = SAMPLE_RATE;
+    if (obivox_feature_extractor_create(NULL, NULL, &ctx->extractor) != 0 ||
+        obivox_feature_extract(ctx->extractor, &ctx->features, NULL) != 0) {
+        return -1;
+    }
+
+    // The mapping folds every frame, as for a producer without sums
+    ctx->features.contour_stats_frames = 0;
+    return 0;
+}
+
+static void measure(const BenchCase* bench, BenchContext* ctx, uint64_t min_time_ns, CaseResult* result) {
+    memset(result, 0, sizeof(*result));
+    result->min_ns = UINT64_MAX;
+
+    // One untimed call warms caches, plans and pools
+    uint64_t work = 0;
+    if (bench->prepare) bench->prepare(ctx);
+    if (bench->run(ctx, &work) != 0) {
+        result->status = -1;
+        return;
+    }
+
+    uint64_t batch = 1;
+    while (result->total_ns < min_time_ns && result->iterations < MAX_ITERATIONS) {
+        if (bench->prepare) bench->prepare(ctx);
+
+        uint64_t allocs = allocation_count();
+        uint64_t start = now_ns();
+        for (uint64_t i = 0; i < batch; i++) {
+            if (bench->run(ctx, &work) != 0) result->status = -1;
+            result->work += work;
+        }
+        uint64_t elapsed = now_ns() - start;
+        result->allocations += allocation_count() - allocs;
+        result->total_ns += elapsed;
+        result->iterations += batch;
+        if (elapsed / batch < result->min_ns) result->min_ns = elapsed / batch;
+
+        // In-place cases re-prepare between calls, so they stay unbatched
+        if (!bench->prepare && elapsed < BATCH_TARGET_NS && batch < MAX_ITERATIONS / 2) batch *= 2;
+    }
+}
+
+static void context_destroy(BenchContext* ctx) {
+    obivox_pcm_release(&ctx->pcm);
+    obivox_feature_extractor_destroy(ctx->extractor);
+    obivox_nlm_destroy(ctx->system);
+    free(ctx->scratch);
+}
+
+// The child measures; the parent reads its result and its peak RSS
+static int run_isolated(const BenchCase* bench, const Corpus* corpus, uint64_t min_time_ns,
+                        CaseResult* result, long* peak_rss_kb) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    fflush(stdout);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        CaseResult r = { .status = -1 };
+        BenchContext ctx;
+        if (context_create(corpus, &ctx) == 0) measure(bench, &ctx, min_time_ns, &r);
+        context_destroy(&ctx);
+        ssize_t written = write(fds[1], &r, sizeof(r));
+        _exit(written == (ssize_t)sizeof(r) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t got = read(fds[0], result, sizeof(*result));
+    close(fds[0]);
+    int status = 0;
+    struct rusage usage;
+    if (wait4(pid, &status, 0, &usage) < 0) return -1;
+    *peak_rss_kb = usage.ru_maxrss;
+    if (got != (ssize_t)sizeof(*result) || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+// ============================================================================
+// JSON Report
+// ============================================================================
+
+static void json_number(const char* key, double value, bool valid, bool last) {
+    if (valid && isfinite(value)) {
+        printf("\"%s\": %.6g%s", key, value, last ? "" : ", ");
+    } else {
+        printf("\"%s\": null%s", key, last ? "" : ", ");
+    }
+}
+
+static void report(const BenchCase* bench, const Corpus* corpus, bool first,
+                   int ret, const CaseResult* r, long peak_rss_kb) {
+    bool ok = ret == 0 && r->status == 0 && r->iterations > 0;
+    double seconds = r->total_ns / 1e9;
+    double audio_seconds = (double)corpus->num_samples / SAMPLE_RATE;
+    double mean_ns = ok ? (double)r->total_ns / r->iterations : 0.0;
+
+    printf("%s\n    {\"name\": \"%s\", \"group\": \"%s\", ", first ? "" : ",", bench->name, bench->group);
+    json_number("length_s", audio_seconds, bench->scales, false);
+    printf("\"status\": \"%s\", \"iterations\": %llu, ", ok ? "ok" : "error",
+           (unsigned long long)r->iterations);
+    json_number("mean_ns", mean_ns, ok, false);
+    json_number("min_ns", (double)r->min_ns, ok, false);
+    json_number("throughput", r->work / seconds, ok && seconds > 0, false);
+    printf("\"throughput_unit\": \"%s\", ", unit_names[bench->unit]);
+
+    // Real-time factor: processing time per second of audio
+    json_number("rtf", mean_ns / 1e9 / audio_seconds, ok && bench->scales, false);
+    json_number("allocs_per_call", (double)r->allocations / r->iterations,
+                ok && ALLOCATIONS_COUNTED, false);
+    json_number("peak_rss_kb", (double)peak_rss_kb, ret == 0, true);
+    printf("}");
+}
+
+static int parse_lengths(const char* text, uint32_t* lengths) {
+    int count = 0;
+    while (*text && count < MAX_LENGTHS) {
+        char* end;
+        long value = strtol(text, &end, 10);
+        if (end == text || value <= 0 || value > 4 * 3600) return -1;
+        lengths[count++] = (uint32_t)value;
+        text = *end == ',' ? end + 1 : end;
+        if (*end && *end != ',') return -1;
+    }
+    return count;
+}
+
+int main(int argc, char** argv) {
+    uint32_t lengths[MAX_LENGTHS] = { 1, 60, 3600 };
+    int length_count = 3;
+    const char* corpus_path = NULL;
+    const char* filter = NULL;
+    uint64_t min_time_ns = 200000000ull;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--lengths") == 0 && i + 1 < argc) {
+            length_count = parse_lengths(argv[++i], lengths);
+            if (length_count <= 0) {
+                fprintf(stderr, "bad --lengths\n");
+                return 2;
+            }
+        } else if (strcmp(argv[i], "--corpus") == 0 && i + 1 < argc) {
+            corpus_path = argv[++i];
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            min_time_ns = (uint64_t)strtoull(argv[++i], NULL, 10) * 1000000ull;
+        } else {
+            fprintf(stderr, "usage: %s [--lengths 1,60,3600] [--corpus file] "
+                    "[--filter text] [--min-time ms]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    OBIVoxPCMBuffer recorded = {0};
+    if (corpus_path && load_recorded(corpus_path, &recorded) != 0) {
+        fprintf(stderr, "cannot decode corpus %s\n", corpus_path);
+        return 1;
+    }
+
+    printf("{\n  \"suite\": \"obivox\",\n  \"timestamp\": %lld,\n", (long long)time(NULL));
+    printf("  \"cpus\": %ld,\n  \"corpus\": \"%s\",\n", sysconf(_SC_NPROCESSORS_ONLN),
+           corpus_path ? "recorded" : "synthetic");
+    printf("  \"allocations_counted\": %s,\n  \"results\": [", ALLOCATIONS_COUNTED ? "true" : "false");
+
+    bool first = true;
+    int failures = 0;
+    size_t case_count = sizeof(CASES) / sizeof(CASES[0]);
+    for (int l = 0; l < length_count; l++) {
+        Corpus corpus;
+        if (corpus_create(corpus_path ? &recorded : NULL, lengths[l], &corpus) != 0) {
+            fprintf(stderr, "cannot build %u s corpus\n", lengths[l]);
+            corpus_destroy(&corpus);
+            failures++;
+            continue;
+        }
+
+        for (size_t c = 0; c < case_count; c++) {
+            const BenchCase* bench = &CASES[c];
+            if (filter && !strstr(bench->name, filter)) continue;
+
+            // Fixed-size cases run once, against the shortest corpus
+            if (!bench->scales && l > 0) continue;
+
+            CaseResult result = {0};
+            long peak_rss_kb = 0;
+            int ret = run_isolated(bench, &corpus, min_time_ns, &result, &peak_rss_kb);
+            report(bench, &corpus, first, ret, &result, peak_rss_kb);
+            first = false;
+            if (ret != 0 || result.status != 0) failures++;
+        }
+        corpus_destroy(&corpus);
+    }
+
+    printf("\n  ],\n  \"skipped\": [");
+    for (size_t i = 0; i < sizeof(UNIMPLEMENTED) / sizeof(UNIMPLEMENTED[0]); i++) {
+        printf("%s\n    {\"name\": \"%s\", \"reason\": \"declared, not implemented\"}",
+               i ? "," : "", UNIMPLEMENTED[i]);
+    }
+    printf("\n  ]\n}\n");
+
+    obivox_pcm_release(&recorded);
+    return failures ? 1 : 0;
+}
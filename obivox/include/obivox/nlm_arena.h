@@ -0,0 +1,113 @@
+/**
+ * OBIVox Buffer Arena
+ * Pre-sized reusable slabs for output and scratch buffers so steady-state
+ * conversion does not touch the system allocator
+ */
+
+#ifndef OBIVOX_NLM_ARENA_H
+#define OBIVOX_NLM_ARENA_H
+
+#include <stddef.h>
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// Arena Types
+// ============================================================================
+
+typedef struct obivox_arena OBIVoxArena;
+
+typedef struct {
+    size_t bytes;      // Rounded up to a power-of-two size class
+    uint32_t count;    // Buffers pre-allocated for that class
+} OBIVoxArenaSlab;
+
+typedef struct {
+    uint64_t acquired;       // Buffers handed out
+    uint64_t recycled;       // Buffers returned
+    uint64_t slab_misses;    // Acquires that had to grow a class
+    uint64_t oversize;       // Requests above the largest class (heap)
+    size_t bytes_reserved;   // Total slab memory owned by the arena
+} OBIVoxArenaStats;
+
+// ============================================================================
+// Arena API
+// ============================================================================
+
+/**
+ * Create an arena; slabs may be NULL for the default layout
+ * (256 B feedback strings, 4 KB transcripts, 64 KB scratch,
+ * 640 KB / 10 s TTS audio)
+ */
+int obivox_arena_create(
+    const OBIVoxArenaSlab* slabs,
+    uint32_t slab_count,
+    OBIVoxArena** arena
+);
+
+/**
+ * Destroy the arena and every slab buffer, including ones not recycled
+ */
+void obivox_arena_destroy(OBIVoxArena* arena);
+
+/**
+ * Take a buffer of at least bytes; contents are undefined
+ * Buffers are 64-byte aligned; thread-safe
+ */
+void* obivox_arena_acquire(OBIVoxArena* arena, size_t bytes);
+
+/**
+ * As obivox_arena_acquire, with the first bytes zeroed
+ */
+void* obivox_arena_acquire_zeroed(OBIVoxArena* arena, size_t bytes);
+
+/**
+ * Return a buffer obtained from this arena. Returns 0, or 1 when the
+ * arena does not own buffer (left untouched, never read); -1 for NULL
+ */
+int obivox_arena_recycle(OBIVoxArena* arena, void* buffer);
+
+/**
+ * Whether buffer was handed out by this arena and not yet freed by it
+ */
+bool obivox_arena_owns(const OBIVoxArena* arena, const void* buffer);
+
+/**
+ * Snapshot of the arena counters
+ */
+void obivox_arena_stats(const OBIVoxArena* arena, OBIVoxArenaStats* stats);
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+/**
+ * Attach an arena to the system (NULL detaches); the system does not take
+ * ownership. Outputs of obivox_bidirectional_convert then come from it
+ */
+int obivox_nlm_attach_arena(OBIVoxNLMSystem* system, OBIVoxArena* arena);
+
+/**
+ * Release a buffer returned by obivox_bidirectional_convert
+ * Recycles into the attached arena when it owns the buffer and frees it
+ * otherwise (heap outputs from before the arena was attached). Release
+ * an arena's outputs before detaching or replacing it
+ */
+void obivox_release_output(OBIVoxNLMSystem* system, void* output);
+
+/**
+ * obivox_request_human_validation with strings drawn from the arena
+ * (arena may be NULL for heap strings)
+ */
+int obivox_request_human_validation_arena(
+    OBIVoxArena* arena,
+    const char* transcription,
+    float confidence,
+    HumanFeedback* feedback
+);
+
+/**
+ * Release the strings of a HumanFeedback filled by the call above
+ */
+void obivox_release_human_feedback(OBIVoxArena* arena, HumanFeedback* feedback);
+
+#endif // OBIVOX_NLM_ARENA_H
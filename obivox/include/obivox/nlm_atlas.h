@@ -0,0 +1,230 @@
+/**
+ * OBIVox NLM-Atlas Service Discovery
+ * Pointer tree over NLMAtlasNode (service_tree) and a flat, read-optimised
+ * index built from it for per-request lookups
+ */
+
+#ifndef OBIVOX_NLM_ATLAS_H
+#define OBIVOX_NLM_ATLAS_H
+
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// Pointer Tree (service_tree)
+// ============================================================================
+
+/**
+ * Insert or find the (service, operation) node; names longer than 63
+ * characters are truncated. Returns 1 when a node was created, 0 when it
+ * already existed, -1 on error
+ */
+int obivox_atlas_insert(
+    NLMAtlasNode** root,
+    TreeMode mode,
+    const char* service,
+    const char* operation,
+    NLMAtlasNode** node
+);
+
+/**
+ * Find a node by name; NULL when absent
+ */
+NLMAtlasNode* obivox_atlas_find(
+    NLMAtlasNode* root,
+    const char* service,
+    const char* operation
+);
+
+/**
+ * Free every node of the tree
+ */
+void obivox_atlas_free(NLMAtlasNode* root);
+
+// ============================================================================
+// Flat Index
+// ============================================================================
+
+typedef struct obivox_atlas_index OBIVoxAtlasIndex;
+
+// Interned (service << 32 | operation); valid for the index that issued it
+typedef uint64_t OBIVoxAtlasKey;
+
+// Hot part of a node - two entries per cache line, names kept apart
+typedef struct {
+    uint64_t x_coord;
+    uint64_t y_coord;
+    uint64_t z_coord;
+    float dynamic_cost;
+    float confidence_score;
+} OBIVoxAtlasEntry;
+
+/**
+ * Snapshot a pointer tree into a flat index (an empty tree is allowed)
+ * Keys are stored in Eytzinger order so a lookup walks one cache line
+ * per three tree levels
+ */
+int obivox_atlas_index_build(const NLMAtlasNode* root, OBIVoxAtlasIndex** index);
+
+void obivox_atlas_index_destroy(OBIVoxAtlasIndex* index);
+
+uint32_t obivox_atlas_index_count(const OBIVoxAtlasIndex* index);
+
+/**
+ * Intern a name pair once; returns -1 when either name is unknown
+ */
+int obivox_atlas_index_key(
+    const OBIVoxAtlasIndex* index,
+    const char* service,
+    const char* operation,
+    OBIVoxAtlasKey* key
+);
+
+/**
+ * Lookup by interned key; NULL when absent
+ */
+const OBIVoxAtlasEntry* obivox_atlas_index_find(
+    const OBIVoxAtlasIndex* index,
+    OBIVoxAtlasKey key
+);
+
+/**
+ * Lookup by name (interning plus find)
+ */
+const OBIVoxAtlasEntry* obivox_atlas_index_lookup(
+    const OBIVoxAtlasIndex* index,
+    const char* service,
+    const char* operation
+);
+
+/**
+ * Entry at position (0 .. count - 1) in (service, operation) order, the
+ * order of the tree it was built from; NULL past the end
+ */
+const OBIVoxAtlasEntry* obivox_atlas_index_entry(
+    const OBIVoxAtlasIndex* index,
+    uint32_t position
+);
+
+/**
+ * Write a position-independent image of the index into buffer (capacity
+ * bytes); bytes receives the image size. A NULL buffer only sizes it
+ */
+int obivox_atlas_index_serialize(
+    const OBIVoxAtlasIndex* index,
+    void* buffer,
+    size_t capacity,
+    size_t* bytes
+);
+
+/**
+ * Use an image from obivox_atlas_index_serialize in place, e.g. inside a
+ * read-only mapping: the arrays are validated, never copied or written.
+ * image must be 8-byte aligned and outlive the index
+ */
+int obivox_atlas_index_open(const void* image, size_t bytes, OBIVoxAtlasIndex** index);
+
+/**
+ * Cold data: names of an entry returned by this index
+ */
+const char* obivox_atlas_index_service(
+    const OBIVoxAtlasIndex* index,
+    const OBIVoxAtlasEntry* entry
+);
+
+const char* obivox_atlas_index_operation(
+    const OBIVoxAtlasIndex* index,
+    const OBIVoxAtlasEntry* entry
+);
+
+// ============================================================================
+// Adaptive Atlas (shared, thread-safe)
+// ============================================================================
+
+typedef struct obivox_atlas OBIVoxAtlas;
+
+// Read-modify-write of one payload, applied on the writer's private copy
+typedef void (*OBIVoxAtlasUpdateFn)(OBIVoxAtlasEntry* entry, void* context);
+
+// Well-known services
+#define OBIVOX_ATLAS_SERVICE_CODEC   "codec"
+#define OBIVOX_ATLAS_SERVICE_PLUGIN  "plugin"
+
+typedef struct {
+    TreeMode mode;                // Requested: AVL, RB or HYBRID
+    TreeMode balancing;           // In effect: AVL or RB
+    uint32_t nodes;
+    uint32_t height;              // Longest root-to-leaf path, in nodes
+    uint64_t lookups;
+    uint64_t writes;
+    float mean_lookup_depth;      // Nodes visited per lookup
+    float window_read_ratio;      // Reads / (reads + writes), last window
+    uint64_t rotations;           // Incremental rebalancing on insert
+    uint64_t migrations;          // Full AVL <-> RB restructures
+    uint64_t migration_ns;        // Total time spent restructuring
+} OBIVoxAtlasMetrics;
+
+/**
+ * Create an empty Atlas. TREE_MODE_HYBRID starts strict and migrates
+ * between AVL and RB as the observed read/write ratio moves.
+ * Lookups take no locks (epoch-based reclamation); writers copy the
+ * touched path, publish the new root and retire the old nodes
+ */
+int obivox_atlas_create(TreeMode mode, OBIVoxAtlas** atlas);
+
+void obivox_atlas_destroy(OBIVoxAtlas* atlas);
+
+/**
+ * Change the requested mode; migrates at once when the balancing changes
+ */
+int obivox_atlas_set_mode(OBIVoxAtlas* atlas, TreeMode mode);
+
+/**
+ * Insert or update the hot payload of (service, operation)
+ * Returns 1 when the node is new, 0 when updated, -1 on error
+ */
+int obivox_atlas_upsert(
+    OBIVoxAtlas* atlas,
+    const char* service,
+    const char* operation,
+    const OBIVoxAtlasEntry* values
+);
+
+/**
+ * Insert-or-update through a callback; new nodes start from the default
+ * payload (confidence 0.954). Writers serialise, readers never wait
+ * Returns 1 when the node is new, 0 when updated, -1 on error
+ */
+int obivox_atlas_update(
+    OBIVoxAtlas* atlas,
+    const char* service,
+    const char* operation,
+    OBIVoxAtlasUpdateFn update,
+    void* context
+);
+
+/**
+ * Copy out the payload of (service, operation); 0 found, -1 absent
+ * Counts towards the node's access_frequency and the read/write ratio
+ */
+int obivox_atlas_lookup(
+    OBIVoxAtlas* atlas,
+    const char* service,
+    const char* operation,
+    OBIVoxAtlasEntry* entry
+);
+
+void obivox_atlas_metrics(OBIVoxAtlas* atlas, OBIVoxAtlasMetrics* metrics);
+
+/**
+ * Flat index of the current version; concurrent writers are not blocked
+ */
+int obivox_atlas_build_index(OBIVoxAtlas* atlas, OBIVoxAtlasIndex** index);
+
+/**
+ * Replace every node with the entries of index in one balanced build (no
+ * per-node rebalancing); readers switch versions atomically and access
+ * frequencies start again from zero
+ */
+int obivox_atlas_load_index(OBIVoxAtlas* atlas, const OBIVoxAtlasIndex* index);
+
+#endif // OBIVOX_NLM_ATLAS_H
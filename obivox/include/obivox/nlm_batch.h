@@ -0,0 +1,89 @@
+/**
+ * OBIVox Micro-Batching Dispatch
+ * Collects utterances from concurrent sessions for up to a deadline or a
+ * batch size, runs them together through one codec context and hands each
+ * caller its own result
+ */
+
+#ifndef OBIVOX_NLM_BATCH_H
+#define OBIVOX_NLM_BATCH_H
+
+#include "obivox/nlm_models.h"
+
+// Hard upper bound on items per batch
+#define OBIVOX_BATCH_MAX_ITEMS  64
+
+// ============================================================================
+// Batcher Types
+// ============================================================================
+
+typedef struct obivox_batcher OBIVoxBatcher;
+
+typedef struct {
+    int codec;                  // Default CODEC_WHISPER
+
+    // Dispatch as soon as this many items are pending (1..64)
+    uint32_t max_batch;
+
+    // Or once the oldest pending item has waited this long; 0 dispatches
+    // whatever queued up while the previous batch ran
+    uint32_t max_wait_us;
+} OBIVoxBatchConfig;
+
+typedef struct {
+    uint64_t batches;
+    uint64_t items;
+    uint64_t full_batches;      // Dispatched at max_batch
+    uint64_t deadline_batches;  // Dispatched at max_wait_us
+    uint64_t failed_batches;
+    uint64_t queue_wait_ns;     // Summed enqueue-to-dispatch time
+    uint64_t max_queue_wait_ns;
+    uint32_t pending;
+} OBIVoxBatchStats;
+
+// ============================================================================
+// Batcher API
+// ============================================================================
+
+/**
+ * Defaults: whisper, batches of 8, 10 ms deadline
+ */
+void obivox_batch_config_default(OBIVoxBatchConfig* config);
+
+/**
+ * Create a batcher over the shared model pool; config may be NULL for
+ * defaults. The dispatch thread starts on the first submit and acquires
+ * a context from the pool per batch
+ */
+int obivox_batcher_create(
+    OBIVoxModelManager* models,
+    const OBIVoxBatchConfig* config,
+    OBIVoxBatcher** batcher
+);
+
+/**
+ * Change max_batch / max_wait_us of a running batcher; takes effect from
+ * the next batch. The codec cannot change
+ */
+int obivox_batcher_configure(OBIVoxBatcher* batcher, const OBIVoxBatchConfig* config);
+
+/**
+ * True when the codec is registered with a run_batch backend
+ */
+bool obivox_batcher_available(OBIVoxBatcher* batcher);
+
+/**
+ * Queue one item and block until its batch has run; thread-safe. The
+ * item and its buffers must stay valid until this returns. Returns the
+ * item's status: 0 on success, -1 if batching is unavailable or failed
+ */
+int obivox_batcher_submit(OBIVoxBatcher* batcher, OBIVoxBatchItem* item);
+
+void obivox_batcher_stats(OBIVoxBatcher* batcher, OBIVoxBatchStats* stats);
+
+/**
+ * Run everything still queued, then stop the dispatch thread
+ */
+void obivox_batcher_destroy(OBIVoxBatcher* batcher);
+
+#endif // OBIVOX_NLM_BATCH_H
@@ -0,0 +1,119 @@
+/**
+ * OBIVox Result Cache (stage-6 cache_manager)
+ * Sharded, content-addressed LRU of transcripts and synthesized PCM under
+ * one byte budget, with an optional mmap'd on-disk spill tier
+ */
+
+#ifndef OBIVOX_NLM_CACHE_H
+#define OBIVOX_NLM_CACHE_H
+
+#include <stddef.h>
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// Cache Types
+// ============================================================================
+
+typedef struct obivox_result_cache OBIVoxResultCache;
+
+// Input content plus every setting that changes the output
+typedef struct {
+    uint64_t input_hash;
+    uint64_t input_size;
+    uint64_t settings_hash;
+    uint32_t input_type;        // OBIVoxInputType
+} OBIVoxCacheKey;
+
+typedef struct {
+    size_t max_bytes;           // Budget for entries in memory (1 GB)
+    uint32_t shards;            // Independent LRUs, rounded to a power of two
+
+    // Optional disk tier: evicted entries are appended to a ring in this
+    // file (created, spill_bytes long) and promoted back on a hit.
+    // The ring index lives in memory; the file does not survive restarts
+    const char* spill_path;
+    size_t spill_bytes;
+} OBIVoxCacheConfig;
+
+typedef struct {
+    uint64_t hits;
+    uint64_t spill_hits;        // Hits served from the disk tier
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;         // Dropped from memory (spilled or not)
+    uint64_t spills;
+    size_t bytes;               // Charged to max_bytes, headers included
+    uint64_t entries;
+} OBIVoxCacheStats;
+
+// ============================================================================
+// Cache API
+// ============================================================================
+
+/**
+ * Defaults from the stage-6 spec: LRU, 1 GB, 16 shards, no disk tier
+ */
+void obivox_cache_config_default(OBIVoxCacheConfig* config);
+
+/**
+ * Create a cache; config may be NULL for defaults. Thread-safe
+ */
+int obivox_cache_create(const OBIVoxCacheConfig* config, OBIVoxResultCache** cache);
+
+void obivox_cache_destroy(OBIVoxResultCache* cache);
+
+/**
+ * Key for an input of input_size bytes under the system's accessibility
+ * and codec settings. 64-bit content hash: accidental collisions are
+ * negligible at any size that fits the budget, but inputs are not
+ * compared byte for byte
+ */
+void obivox_cache_key(
+    const OBIVoxNLMSystem* system,
+    const void* input,
+    size_t input_size,
+    OBIVoxInputType input_type,
+    OBIVoxCacheKey* key
+);
+
+/**
+ * Copy a cached value into out (capacity bytes) and refresh its recency
+ * Returns 1 on a hit, 0 on a miss (or a value larger than capacity),
+ * -1 on error
+ */
+int obivox_cache_get(
+    OBIVoxResultCache* cache,
+    const OBIVoxCacheKey* key,
+    void* out,
+    size_t capacity,
+    size_t* size,
+    float* confidence
+);
+
+/**
+ * Insert or replace a value (copied); evicts least recently used entries
+ * of the shard to stay within budget. Values larger than a shard's share
+ * of the budget are not cached (returns 1)
+ */
+int obivox_cache_put(
+    OBIVoxResultCache* cache,
+    const OBIVoxCacheKey* key,
+    const void* value,
+    size_t size,
+    float confidence
+);
+
+void obivox_cache_stats(OBIVoxResultCache* cache, OBIVoxCacheStats* stats);
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+/**
+ * Attach a cache to the system (NULL detaches); the system does not take
+ * ownership. obivox_bidirectional_convert_sized then serves repeated
+ * inputs from it; sessions of an engine share the template's cache
+ */
+int obivox_nlm_attach_cache(OBIVoxNLMSystem* system, OBIVoxResultCache* cache);
+
+#endif // OBIVOX_NLM_CACHE_H
@@ -0,0 +1,79 @@
+/**
+ * OBIVox Codec Cost Model
+ * Measured latency histograms and confidence per codec, published to the
+ * Atlas ("codec", name) nodes that obivox_select_optimal_codec reads
+ */
+
+#ifndef OBIVOX_NLM_CODEC_H
+#define OBIVOX_NLM_CODEC_H
+
+#include "obivox/nlm_framwork.h"
+#include "obivox/nlm_atlas.h"
+
+// ============================================================================
+// Cost Model Types
+// ============================================================================
+
+typedef struct obivox_codec_costs OBIVoxCodecCosts;
+
+typedef struct {
+    uint64_t samples;
+
+    // Latency per second of audio (real-time factor) from the histogram
+    float p50_rtf;
+    float p90_rtf;
+    float p99_rtf;
+
+    // As published to the Atlas node
+    float dynamic_cost;         // p90_rtf once measured, else the prior
+    float confidence_score;     // Confidence on easy audio (difficulty 0)
+} OBIVoxCodecCostStats;
+
+// ============================================================================
+// Cost Model API
+// ============================================================================
+
+/**
+ * Create a cost model over the Atlas and seed the whisper, coqui and
+ * vosk codec nodes with prior costs and confidences; measurements
+ * replace the priors as they arrive. Thread-safe after creation
+ */
+int obivox_codec_costs_create(OBIVoxAtlas* atlas, OBIVoxCodecCosts** costs);
+
+void obivox_codec_costs_destroy(OBIVoxCodecCosts* costs);
+
+/**
+ * Atlas operation name of a codec: "whisper", "coqui", "vosk" or
+ * "adaptive"
+ */
+const char* obivox_codec_name(int codec);
+
+/**
+ * Difficulty in [0, 1] of audio at an NLM position: detected variation
+ * (z) and pitch instability (low x) make audio harder
+ */
+float obivox_codec_difficulty(const NLMCoordinate* position);
+
+/**
+ * Confidence a codec is expected to reach at a difficulty, from the
+ * Atlas confidence_score and the codec's robustness
+ */
+float obivox_codec_expected_confidence(int codec, float confidence_score, float difficulty);
+
+/**
+ * Fold one measured request into the codec's histogram and confidence
+ * backlog. The Atlas node is republished only when its p90 lands in
+ * another bucket or 64 requests are pending, so most calls never copy
+ */
+int obivox_codec_record(
+    OBIVoxCodecCosts* costs,
+    int codec,
+    float difficulty,
+    uint64_t processing_time_ns,
+    double audio_seconds,
+    float confidence
+);
+
+void obivox_codec_cost_stats(OBIVoxCodecCosts* costs, int codec, OBIVoxCodecCostStats* stats);
+
+#endif // OBIVOX_NLM_CODEC_H
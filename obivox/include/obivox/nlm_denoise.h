@@ -0,0 +1,100 @@
+/**
+ * OBIVox Noise Reduction (stage-2 noise_reduction / noise_profiler)
+ * Streaming STFT with overlap-add: noise profiling, spectral subtraction
+ * and fricative (lisp) shaping share one forward and one inverse FFT per
+ * hop, with the plan and every buffer allocated at creation
+ */
+
+#ifndef OBIVOX_NLM_DENOISE_H
+#define OBIVOX_NLM_DENOISE_H
+
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// Denoiser Types
+// ============================================================================
+
+typedef struct obivox_denoiser OBIVoxDenoiser;
+
+typedef struct {
+    uint32_t sample_rate;
+    uint32_t frame_size;        // Power of two; hop is half a frame
+
+    // Noise profile from the start of each stream (500 ms). The quieter
+    // half of its frames is averaged, so speech inside the window does
+    // not inflate the profile
+    float profile_ms;
+
+    // Over-subtraction is 1 + aggressiveness (spec: 0.7)
+    float aggressiveness;
+
+    // Lowest gain any bin may get (preserve_speech); limits musical noise
+    float spectral_floor;
+
+    // After profiling, keep adapting the profile during quiet frames
+    bool track_noise;
+} OBIVoxDenoiseConfig;
+
+// ============================================================================
+// Denoiser API
+// ============================================================================
+
+/**
+ * Defaults: 16 kHz, 512-sample frames (32 ms, 16 ms hop), 500 ms
+ * profile, aggressiveness 0.7, floor 0.1, tracking on
+ */
+void obivox_denoise_config_default(OBIVoxDenoiseConfig* config);
+
+/**
+ * Create a denoiser; config may be NULL. One stream at a time per
+ * denoiser; processing never allocates
+ */
+int obivox_denoiser_create(const OBIVoxDenoiseConfig* config, OBIVoxDenoiser** denoiser);
+
+void obivox_denoiser_destroy(OBIVoxDenoiser* denoiser);
+
+/**
+ * Start a new stream: forget the profile and the overlap state
+ */
+void obivox_denoiser_reset(OBIVoxDenoiser* denoiser);
+
+/**
+ * Fricative shaping applied with the subtraction: the magnitude response
+ * of the time-domain lisp filter of that gain (0 = off, < 1), without
+ * its phase delay
+ */
+int obivox_denoiser_set_lisp_shaping(OBIVoxDenoiser* denoiser, float gain);
+
+/**
+ * Samples by which output trails input (one frame)
+ */
+uint32_t obivox_denoiser_latency(const OBIVoxDenoiser* denoiser);
+
+/**
+ * Stream num_samples in and exactly num_samples out, delayed by the
+ * latency (the stream starts with that much silence). input and output
+ * may be the same buffer
+ */
+int obivox_denoiser_process(
+    OBIVoxDenoiser* denoiser,
+    const float* input,
+    float* output,
+    uint32_t num_samples
+);
+
+/**
+ * End the stream: write the last latency samples into output
+ */
+int obivox_denoiser_flush(OBIVoxDenoiser* denoiser, float* output);
+
+/**
+ * Denoise a whole buffer in place as one stream, latency compensated
+ */
+int obivox_denoise_buffer(OBIVoxDenoiser* denoiser, float* audio, uint32_t num_samples);
+
+/**
+ * True once the profile covers profile_ms of the current stream
+ */
+bool obivox_denoiser_profile_ready(const OBIVoxDenoiser* denoiser);
+
+#endif // OBIVOX_NLM_DENOISE_H
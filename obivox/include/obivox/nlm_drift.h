@@ -0,0 +1,117 @@
+/**
+ * OBIVox Drift Monitor (OBIAI data drift)
+ * Per-session EWMA control chart over the NLM coordinate and confidence
+ * stream: a Welford baseline during warm-up, then slow exponentially
+ * weighted mean/variance against a fast mean. O(1) per observation, no
+ * history kept
+ */
+
+#ifndef OBIVOX_NLM_DRIFT_H
+#define OBIVOX_NLM_DRIFT_H
+
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// Drift Types
+// ============================================================================
+
+typedef struct obivox_drift_monitor OBIVoxDriftMonitor;
+
+// Zones of the OBIAI failure scale obivox_handle_drift acts on
+typedef enum {
+    OBIVOX_DRIFT_AI_STRESS = -1,    // Confidence fell: adapt (RB, cascade)
+    OBIVOX_DRIFT_GREEN = 0,
+    OBIVOX_DRIFT_HUMAN_STRESS = 1   // Position moved: ask for clarity (AVL)
+} OBIVoxDriftZone;
+
+typedef struct {
+    uint32_t warmup_frames;     // Exact baseline over the first frames (32)
+    float baseline_alpha;       // Slow baseline weight after warm-up (0.002)
+    float fast_alpha;           // Weight of the compared mean (0.1)
+
+    // Failure-scale thresholds in standard errors of the fast mean; a
+    // zone is entered above enter and left below exit (4 and 2)
+    float enter_threshold;
+    float exit_threshold;
+
+    float min_sigma;            // Floor for near-constant axes (0.01)
+} OBIVoxDriftConfig;
+
+typedef struct {
+    OBIVoxDriftZone zone;
+    float failure;              // OBIAI scale, -12 .. +12
+    float magnitude;            // obivox_handle_drift input: (failure + 12) / 24
+    float position_score;       // Largest |z| over the x, y, z axes
+    float confidence_score;     // Signed z of confidence (negative = falling)
+    uint64_t frames;
+    bool warmed_up;
+} OBIVoxDriftState;
+
+// ============================================================================
+// Drift API
+// ============================================================================
+
+void obivox_drift_config_default(OBIVoxDriftConfig* config);
+
+/**
+ * Create a monitor; config may be NULL. Not thread-safe: one per session
+ */
+int obivox_drift_monitor_create(const OBIVoxDriftConfig* config, OBIVoxDriftMonitor** monitor);
+
+void obivox_drift_monitor_destroy(OBIVoxDriftMonitor* monitor);
+
+/**
+ * Forget the baseline and start warming up again
+ */
+void obivox_drift_reset(OBIVoxDriftMonitor* monitor);
+
+/**
+ * Accept the current regime as the new baseline (after human feedback),
+ * keeping the variance estimates
+ */
+void obivox_drift_rebase(OBIVoxDriftMonitor* monitor);
+
+/**
+ * Fold in one observation. Returns 1 when the zone changed, 0 when not,
+ * -1 on error; state may be NULL
+ */
+int obivox_drift_update(
+    OBIVoxDriftMonitor* monitor,
+    const NLMCoordinate* observation,
+    OBIVoxDriftState* state
+);
+
+int obivox_drift_state(const OBIVoxDriftMonitor* monitor, OBIVoxDriftState* state);
+
+/**
+ * Zone of a drift magnitude: failure = magnitude * 24 - 12, stress
+ * beyond +-3. The one mapping obivox_handle_drift acts on
+ */
+OBIVoxDriftZone obivox_drift_zone(float magnitude);
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+/**
+ * Give the system its own monitor (config may be NULL); it replaces the
+ * per-call check of a caller-set drift_magnitude and is freed with the
+ * system (sessions: on close). Returns 1 if one is already attached
+ */
+int obivox_nlm_enable_drift_monitor(OBIVoxNLMSystem* system, const OBIVoxDriftConfig* config);
+
+/**
+ * Current zone: the monitor's when attached, else drift_magnitude's
+ */
+OBIVoxDriftZone obivox_nlm_drift_zone(const OBIVoxNLMSystem* system);
+
+/**
+ * Observe one frame on the system's monitor and, on a zone change, run
+ * obivox_handle_drift and the cascade bookkeeping. Returns 1 when the
+ * zone changed, 0 when not or without a monitor, -1 on error.
+ * obivox_bidirectional_convert calls this once per STT request; streams
+ * may call it per pushed frame on their own session
+ */
+int obivox_nlm_observe_drift(OBIVoxNLMSystem* system, const NLMCoordinate* observation);
+
+#endif // OBIVOX_NLM_DRIFT_H
@@ -0,0 +1,123 @@
+/**
+ * OBIVox Shared Engine, Sessions and Worker Pool
+ * One immutable engine per process, one lightweight session per request
+ * stream, and a work-stealing pool to run independent streams on all cores
+ */
+
+#ifndef OBIVOX_NLM_ENGINE_H
+#define OBIVOX_NLM_ENGINE_H
+
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// Engine and Session Types
+// ============================================================================
+
+// Read-only after creation: configuration and FFmpeg context; sessions
+// bind their own codec contexts from the shared model pool, and the Atlas
+// and arena synchronise internally. Safe to share between threads
+typedef struct obivox_engine OBIVoxEngine;
+
+// Mutable per-stream state: NLM position, accessibility flags, drift and
+// recovery counters, codec feedback, analysis scratch. One thread at a time
+typedef struct obivox_session OBIVoxSession;
+
+// ============================================================================
+// Engine API
+// ============================================================================
+
+/**
+ * Create a shared engine; config may be NULL for obivox_nlm_init defaults
+ * The config is copied - later changes to it do not affect the engine
+ */
+int obivox_engine_create(const OBIVoxNLMSystem* config, OBIVoxEngine** engine);
+
+/**
+ * Destroy the engine; every session must already be closed
+ */
+void obivox_engine_destroy(OBIVoxEngine* engine);
+
+/**
+ * The engine's immutable configuration template
+ */
+const OBIVoxNLMSystem* obivox_engine_config(const OBIVoxEngine* engine);
+
+// ============================================================================
+// Session API
+// ============================================================================
+
+/**
+ * Open a session seeded from the engine template; thread-safe
+ */
+int obivox_session_open(OBIVoxEngine* engine, OBIVoxSession** session);
+
+/**
+ * System view for the existing API (obivox_bidirectional_convert,
+ * obivox_handle_drift, obivox_stream_open, ...). Mutable fields belong to
+ * the session; shared pointers are borrowed from the engine
+ */
+OBIVoxNLMSystem* obivox_session_system(OBIVoxSession* session);
+
+/**
+ * Reset mutable state back to the engine template between requests
+ */
+void obivox_session_reset(OBIVoxSession* session);
+
+void obivox_session_close(OBIVoxSession* session);
+
+// ============================================================================
+// Work-Stealing Worker Pool
+// ============================================================================
+
+typedef struct obivox_worker_pool OBIVoxWorkerPool;
+
+// Tasks run with the executing worker's own session (NULL without engine)
+typedef void (*OBIVoxTaskFn)(OBIVoxSession* session, void* arg);
+
+typedef struct {
+    uint32_t workers;
+    uint64_t submitted;
+    uint64_t executed;
+    uint64_t stolen;      // Tasks run by a worker other than the one queued on
+} OBIVoxPoolStats;
+
+/**
+ * Start num_workers threads (0 = online CPUs), each with a session on engine
+ */
+int obivox_pool_create(
+    OBIVoxEngine* engine,
+    uint32_t num_workers,
+    OBIVoxWorkerPool** pool
+);
+
+/**
+ * Queue a task; from a worker thread it lands on that worker's deque,
+ * otherwise deques are filled round-robin. Idle workers steal the oldest
+ */
+int obivox_pool_submit(OBIVoxWorkerPool* pool, OBIVoxTaskFn fn, void* arg);
+
+/**
+ * Block until every task submitted so far has finished
+ */
+void obivox_pool_wait(OBIVoxWorkerPool* pool);
+
+void obivox_pool_stats(OBIVoxWorkerPool* pool, OBIVoxPoolStats* stats);
+
+/**
+ * Finish queued tasks, join the workers and close their sessions
+ */
+void obivox_pool_destroy(OBIVoxWorkerPool* pool);
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+/**
+ * Run the system's stage-3 feature blocks on pool (NULL: inline); the
+ * system does not take ownership. Rebuilds the feature extractor, so not
+ * from a task on the pool previously attached. Every pool worker's
+ * session is attached to its own pool, and session resets keep the pool
+ */
+int obivox_nlm_attach_pool(OBIVoxNLMSystem* system, OBIVoxWorkerPool* pool);
+
+#endif // OBIVOX_NLM_ENGINE_H
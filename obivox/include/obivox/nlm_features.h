@@ -0,0 +1,89 @@
+/**
+ * OBIVox Stage-3 Feature Extraction
+ * MFCC (13 + delta), YIN pitch and Hamming energy on one shared hop grid,
+ * computed as parallel frame blocks on the worker pool
+ */
+
+#ifndef OBIVOX_NLM_FEATURES_H
+#define OBIVOX_NLM_FEATURES_H
+
+#include "obivox/nlm_framwork.h"
+#include "obivox/nlm_engine.h"
+
+#define OBIVOX_MFCC_COEFFS  13
+
+// ============================================================================
+// Feature Extractor Types
+// ============================================================================
+
+typedef struct obivox_feature_extractor OBIVoxFeatureExtractor;
+
+typedef struct {
+    uint32_t sample_rate;
+
+    // Hop shared by every feature; frame k is centred on sample k * hop
+    float hop_ms;
+
+    // Hamming frame shared by the energy and MFCC paths (power of two)
+    uint32_t frame_size;
+    uint32_t mel_filters;
+
+    // YIN: frame_size / 2 integration window (power of two)
+    uint32_t pitch_frame_size;
+    float pitch_min_hz;
+    float pitch_max_hz;
+    float yin_threshold;
+} OBIVoxFeatureConfig;
+
+// Per-frame results - borrowed, valid until the next extract or destroy
+typedef struct {
+    uint32_t frames;
+    const float* mfcc;           // frames x OBIVOX_MFCC_COEFFS
+    const float* mfcc_delta;     // frames x OBIVOX_MFCC_COEFFS
+    const float* pitch_hz;       // 0 where unvoiced
+    const float* energy;         // Hamming-weighted RMS
+
+    double elapsed_seconds;
+    float real_time_factor;      // Processing time / audio duration
+} OBIVoxFeatureFrames;
+
+// ============================================================================
+// Feature Extractor API
+// ============================================================================
+
+/**
+ * Defaults from the stage-3 spec: 16 kHz, 10 ms hop, Hamming 512,
+ * 26 mel filters, YIN frame 2048 over 60-500 Hz, threshold 0.1
+ */
+void obivox_feature_config_default(OBIVoxFeatureConfig* config);
+
+/**
+ * Create an extractor; pool may be NULL to run every block inline
+ * Scratch for each block is allocated here, so extraction only grows the
+ * per-frame outputs. One thread at a time per extractor; extraction may
+ * run from a task on the same pool (the caller works through the blocks
+ * itself), destroy may not
+ */
+int obivox_feature_extractor_create(
+    const OBIVoxFeatureConfig* config,
+    OBIVoxWorkerPool* pool,
+    OBIVoxFeatureExtractor** extractor
+);
+
+/**
+ * Extract from features->raw_audio / num_samples and point the contour
+ * view at the extractor's per-hop pitch (f0 / pitch_max_hz, unvoiced
+ * frames hold the last voiced value) and energy, with the running sums
+ * filled in; valid until the next extract. features->mfcc_features, when
+ * set, receives the utterance-mean OBIVOX_MFCC_COEFFS coefficients; when
+ * NULL it is pointed at the extractor's copy. frames may be NULL
+ */
+int obivox_feature_extract(
+    OBIVoxFeatureExtractor* extractor,
+    AudioFeatures* features,
+    OBIVoxFeatureFrames* frames
+);
+
+void obivox_feature_extractor_destroy(OBIVoxFeatureExtractor* extractor);
+
+#endif // OBIVOX_NLM_FEATURES_H
@@ -0,0 +1,108 @@
+/**
+ * OBIVox Batched Feedback
+ * Human feedback coalesced per speaker, dialect and codec, then applied
+ * in one pass: one coordinate adjustment, one drift reset, and one Atlas
+ * write per codec and per group however many records arrived. A buffer
+ * adds count and time based flushing, so Atlas write load follows the
+ * flush policy rather than the feedback arrival rate
+ */
+
+#ifndef OBIVOX_NLM_FEEDBACK_H
+#define OBIVOX_NLM_FEEDBACK_H
+
+#include "obivox/nlm_framwork.h"
+
+// Atlas service of per-group feedback profiles, operation "dialect/speaker"
+#define OBIVOX_ATLAS_SERVICE_FEEDBACK  "feedback"
+
+// ============================================================================
+// Feedback Types
+// ============================================================================
+
+typedef struct {
+    HumanFeedback feedback;     // Strings borrowed for the call
+    const char* speaker;        // NULL = anonymous
+    const char* dialect;        // NULL = unmarked
+    int codec;                  // Codec that produced the result; -1 = the system's
+} OBIVoxFeedbackRecord;
+
+typedef struct obivox_feedback_buffer OBIVoxFeedbackBuffer;
+
+typedef struct {
+    uint32_t max_records;       // Flush once this many are pending (256)
+    uint32_t max_delay_ms;      // Or once the oldest has waited this long (1000)
+    uint32_t max_groups;        // Distinct groups held before an early flush (64)
+} OBIVoxFeedbackPolicy;
+
+typedef struct {
+    uint64_t records;
+    uint64_t flushes;
+    uint64_t count_flushes;     // Reached max_records
+    uint64_t time_flushes;      // Reached max_delay_ms
+    uint64_t group_flushes;     // Ran out of groups
+    uint64_t atlas_writes;
+    uint32_t pending;
+    uint32_t groups;
+} OBIVoxFeedbackStats;
+
+// ============================================================================
+// Batch API
+// ============================================================================
+
+/**
+ * Incorporate count records in one pass. The result matches applying
+ * them one by one with obivox_incorporate_feedback, except that every
+ * Atlas confidence moves once, as if each outcome had been the batch's
+ * acceptance rate: order within a batch is dropped, so a confidence can
+ * differ from the one-by-one value (it is that value averaged over
+ * arrival orders). Groups with a speaker or dialect also update
+ * their OBIVOX_ATLAS_SERVICE_FEEDBACK profile (acceptance in
+ * confidence_score, correction rate in dynamic_cost)
+ */
+int obivox_incorporate_feedback_batch(
+    OBIVoxNLMSystem* system,
+    const OBIVoxFeedbackRecord* records,
+    uint32_t count
+);
+
+// ============================================================================
+// Feedback Buffer
+// ============================================================================
+
+/**
+ * Defaults: 256 records, 1 s, 64 groups
+ */
+void obivox_feedback_policy_default(OBIVoxFeedbackPolicy* policy);
+
+/**
+ * Buffer in front of system; policy may be NULL. Same threading rules as
+ * the system it feeds: one thread at a time
+ */
+int obivox_feedback_buffer_create(
+    OBIVoxNLMSystem* system,
+    const OBIVoxFeedbackPolicy* policy,
+    OBIVoxFeedbackBuffer** buffer
+);
+
+/**
+ * Flush what is pending, then free the buffer
+ */
+void obivox_feedback_buffer_destroy(OBIVoxFeedbackBuffer* buffer);
+
+/**
+ * Coalesce one record (strings are copied). Returns 1 when this add
+ * flushed, 0 when the record is pending, -1 on error
+ */
+int obivox_feedback_buffer_add(OBIVoxFeedbackBuffer* buffer, const OBIVoxFeedbackRecord* record);
+
+/**
+ * Time-based flush for callers with a timer: flushes when the oldest
+ * pending record is older than max_delay_ms. Returns 1 when it flushed
+ */
+int obivox_feedback_buffer_poll(OBIVoxFeedbackBuffer* buffer);
+
+int obivox_feedback_buffer_flush(OBIVoxFeedbackBuffer* buffer);
+
+void obivox_feedback_buffer_stats(const OBIVoxFeedbackBuffer* buffer, OBIVoxFeedbackStats* stats);
+
+#endif // OBIVOX_NLM_FEEDBACK_H
@@ -0,0 +1,119 @@
+/**
+ * OBIVox FFmpeg Pipeline
+ * In-memory decode straight to the analysis format (mono float32, 16 kHz)
+ * without temporary files or a second decode pass, and reusable
+ * stream-copy converters for batch format conversion
+ */
+
+#ifndef OBIVOX_NLM_FFMPEG_H
+#define OBIVOX_NLM_FFMPEG_H
+
+#include <stddef.h>
+#include "obivox/nlm_framwork.h"
+
+#define OBIVOX_DECODE_RATE  16000
+
+// ============================================================================
+// PCM Buffer
+// ============================================================================
+
+typedef struct {
+    float* samples;          // Mono float32 at sample_rate
+    uint32_t num_samples;
+    uint32_t capacity;       // Kept across decodes so steady state never grows
+    uint32_t sample_rate;
+} OBIVoxPCMBuffer;
+
+/**
+ * Free the samples of a buffer filled by the decode calls below
+ */
+void obivox_pcm_release(OBIVoxPCMBuffer* pcm);
+
+/**
+ * Point features->raw_audio at the buffer without copying; the buffer
+ * must outlive every use of features
+ */
+int obivox_pcm_borrow(const OBIVoxPCMBuffer* pcm, AudioFeatures* features);
+
+// ============================================================================
+// Decode API
+// ============================================================================
+
+// Custom input: read returns bytes read or a negative AVERROR (AVERROR_EOF
+// at the end); seek follows avio semantics including AVSEEK_SIZE
+typedef int (*OBIVoxReadFn)(void* opaque, uint8_t* buffer, int size);
+typedef int64_t (*OBIVoxSeekFn)(void* opaque, int64_t offset, int whence);
+
+/**
+ * Decode a complete encoded file held in memory (any container/codec
+ * FFmpeg probes). Returns 0 or a negative AVERROR
+ */
+int obivox_decode_memory(
+    const void* data,
+    size_t size,
+    OBIVoxPCMBuffer* pcm
+);
+
+/**
+ * Decode from caller callbacks; seek may be NULL for non-seekable input
+ */
+int obivox_decode_callbacks(
+    void* opaque,
+    OBIVoxReadFn read,
+    OBIVoxSeekFn seek,
+    OBIVoxPCMBuffer* pcm
+);
+
+/**
+ * Decode from an AVIOContext the caller already owns (AVIOContext*)
+ */
+int obivox_decode_avio(
+    void* avio_context,
+    OBIVoxPCMBuffer* pcm
+);
+
+// ============================================================================
+// Format Converter
+// ============================================================================
+
+// Caches the muxer, the last demuxer (tried first on the next input), the
+// packet and the stream map. One thread at a time per converter
+typedef struct obivox_converter OBIVoxConverter;
+
+typedef struct {
+    const char* input_path;
+    const char* output_path;
+    int result;              // 0 or a negative AVERROR, set by the batch
+} OBIVoxConvertJob;
+
+/**
+ * Create a converter for one target container ("wav", "mp3", "ipod", ...)
+ */
+int obivox_converter_create(const char* target_format, OBIVoxConverter** converter);
+
+/**
+ * Stream-copy the audio streams of input_path into output_path with
+ * packet timestamps rescaled to the output time bases
+ * Returns 0 or a negative AVERROR
+ */
+int obivox_converter_convert(
+    OBIVoxConverter* converter,
+    const char* input_path,
+    const char* output_path
+);
+
+void obivox_converter_destroy(OBIVoxConverter* converter);
+
+/**
+ * Convert every job with one converter per worker thread (0 = online
+ * CPUs); jobs are handed out dynamically so uneven clips balance
+ * Returns the number of failed jobs, or -1 if the workers could not start
+ */
+int obivox_convert_batch(
+    const char* target_format,
+    OBIVoxConvertJob* jobs,
+    uint32_t count,
+    uint32_t num_threads
+);
+
+#endif // OBIVOX_NLM_FFMPEG_H
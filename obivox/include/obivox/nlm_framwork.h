@@ -7,6 +7,7 @@
 #ifndef OBIVOX_NLM_FRAMEWORK_H
 #define OBIVOX_NLM_FRAMEWORK_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -21,12 +22,18 @@ typedef struct {
     float confidence;  // Epistemic confidence (target: 0.954)
 } NLMCoordinate;
 
+typedef enum {
+    NORMALIZATION_BOX_FILTER = 0,  // O(1) per sample running sum, order independent
+    NORMALIZATION_LEGACY = 1       // In-place window re-sum (reference only)
+} NormalizationMode;
+
 typedef struct {
     // Phonetic variation handling for accessibility
     bool lisp_mitigation;
     bool stutter_detection;
     bool accent_normalization;
     float variation_tolerance;  // 0.0 to 1.0
+    NormalizationMode normalization_mode;
     
     // Cultural preservation
     char* dialect_markers[16];
@@ -82,9 +89,21 @@ typedef struct {
     uint32_t sample_rate;
     uint32_t num_samples;
     
-    // Phonetic features
-    float pitch_contour[256];
-    float energy_envelope[256];
+    // Phonetic features: per-frame contours borrowed from the buffer of
+    // whoever produced them (feature extractor, stream), valid until it
+    // next writes. Length follows the audio at contour_frame_rate
+    const float* pitch_contour;     // f0 / pitch_max_hz (or ZCR proxy)
+    const float* energy_envelope;   // RMS
+    uint32_t contour_frames;
+    float contour_frame_rate;       // Frames per second
+    
+    // Running sums over the first contour_stats_frames frames (squared
+    // pitch steps, energy); producers keep them current so the mapping
+    // only folds in frames added since
+    double pitch_step_sum;
+    double energy_sum;
+    uint32_t contour_stats_frames;
+    
     float* mfcc_features;  // 13 coefficients
     
     // Speech variations detected
@@ -112,10 +131,19 @@ typedef struct {
         CODEC_VOSK,
         CODEC_ADAPTIVE
     } active_codec;
+    int selected_codec;  // Cost model pick while active_codec is CODEC_ADAPTIVE
+    
+    // Micro-batches whisper requests across sessions (see nlm_batch.h)
+    struct obivox_batcher* whisper_batcher;
     
-    // Performance tracking
+    // Optional, caller-owned: CODEC_ADAPTIVE races a fast and a slow
+    // codec instead of picking one (see nlm_speculate.h)
+    struct obivox_speculator* speculator;
+    
+    // Performance tracking; measured requests feed the shared cost model
     float last_confidence;
     uint64_t processing_time_ns;
+    struct obivox_codec_costs* costs;  // See nlm_codec.h
 } CodecEngine;
 
 // ============================================================================
@@ -130,20 +158,38 @@ typedef struct {
     // NLM-Atlas service discovery
     NLMAtlasNode* service_tree;
     TreeMode current_tree_mode;
+    struct obivox_atlas* atlas;  // Shared, thread-safe (see nlm_atlas.h)
     
     // Codec engine
     CodecEngine codec_engine;
+    struct obivox_model_manager* models;  // Shared warm pool (see nlm_models.h)
     
     // FFmpeg integration
     void* ffmpeg_context;
     
-    // OBIAI data drift detection
+    // OBIAI data drift detection; with a monitor (opt-in, nlm_drift.h),
+    // drift_magnitude is its output and the per-call check is replaced
     float drift_magnitude;
+    struct obivox_drift_monitor* drift_monitor;
     float coherence_threshold;  // 0.954
     
     // Self-healing architecture
     bool fault_tolerance_enabled;
     uint8_t recovery_attempts;
+    
+    // Buffer reuse (see nlm_arena.h); NULL arena = plain heap buffers
+    struct obivox_arena* arena;
+    struct obivox_result_cache* cache;  // Optional, shared (see nlm_cache.h)
+    struct obivox_lexicon* lexicon;     // G2P table, NULL = built-in (nlm_lexicon.h)
+    struct obivox_metrics* metrics;     // Optional stage spans (see nlm_metrics.h)
+    struct obivox_validation_queue* validation;  // Optional, shared (nlm_validation.h)
+    struct obivox_plugin_registry* plugins;      // Optional, shared (nlm_plugin.h)
+    struct obivox_worker_pool* pool;    // Optional, shared; stage-3 blocks (nlm_engine.h)
+    uint64_t validation_ticket;         // Last STT result's ticket, 0 = final
+    struct obivox_vad* vad;             // Stage 2 silence skip (nlm_vad.h)
+    struct obivox_variation_engine* variation_engine;
+    struct obivox_feature_extractor* feature_extractor;  // Stage 3, over pool
+    struct obivox_denoiser* denoiser;   // Stage 2 STFT pass (nlm_denoise.h)
 } OBIVoxNLMSystem;
 
 // ============================================================================
@@ -155,6 +201,12 @@ typedef struct {
  */
 int obivox_nlm_init(OBIVoxNLMSystem** system);
 
+/**
+ * Release a system created by obivox_nlm_init (an attached arena is
+ * owned by the caller and is not destroyed)
+ */
+void obivox_nlm_destroy(OBIVoxNLMSystem* system);
+
 /**
  * Process audio with phonetic variation awareness
  * Handles lisps, stutters, accents while preserving meaning
@@ -166,19 +218,42 @@ int obivox_process_with_variations(
     char** output_text
 );
 
+typedef enum {
+    INPUT_AUDIO,    // Mono float32 16 kHz PCM
+    INPUT_TEXT      // NUL-terminated UTF-8
+} OBIVoxInputType;
+
 /**
- * Bidirectional conversion with consciousness preservation
+ * Bidirectional conversion with consciousness preservation. Carries no
+ * input length, so INPUT_AUDIO fails with -1: use
+ * obivox_bidirectional_convert_sized for audio
  */
 int obivox_bidirectional_convert(
     OBIVoxNLMSystem* system,
     const void* input,
-    enum { INPUT_AUDIO, INPUT_TEXT } input_type,
+    OBIVoxInputType input_type,
+    void** output,
+    float* confidence
+);
+
+/**
+ * As obivox_bidirectional_convert with the input length in bytes (0 =
+ * strlen for text; audio needs at least one sample or fails with -1).
+ * Known lengths let the result cache (nlm_cache.h) serve repeated inputs
+ */
+int obivox_bidirectional_convert_sized(
+    OBIVoxNLMSystem* system,
+    const void* input,
+    size_t input_size,
+    OBIVoxInputType input_type,
     void** output,
     float* confidence
 );
 
 /**
  * NLM coordinate mapping for concept evolution
+ * Pitch variance and energy mean over however many contour frames exist;
+ * cost is proportional to the frames not yet in the running sums
  */
 int obivox_map_to_nlm_space(
     const AudioFeatures* features,
@@ -187,6 +262,12 @@ int obivox_map_to_nlm_space(
 
 /**
  * Adaptive codec selection based on NLM-Atlas
+ * Picks the cheapest codec (Atlas dynamic_cost, measured p90 real-time
+ * factor) whose confidence_score, adjusted for the difficulty of the
+ * position, still meets coherence_threshold; otherwise the most confident.
+ * Only codecs with a registered model compete once any is registered.
+ * Sets codec_engine.selected_codec; suggests TREE_MODE_RB when no codec
+ * meets the threshold (feedback writes ahead), else TREE_MODE_HYBRID
  */
 int obivox_select_optimal_codec(
     OBIVoxNLMSystem* system,
@@ -195,7 +276,8 @@ int obivox_select_optimal_codec(
 );
 
 /**
- * Handle data drift with OBIAI integration
+ * Handle data drift with OBIAI integration: sets the system's tree mode
+ * and coherence threshold for the zone, never the shared Atlas mode
  */
 int obivox_handle_drift(
     OBIVoxNLMSystem* system,
@@ -209,7 +291,8 @@ int obivox_handle_drift(
 
 /**
  * Detect and normalize speech variations
- * Preserves speaker intent while improving clarity
+ * Preserves speaker intent while improving clarity. Runs on an engine
+ * cached per calling thread (nlm_variation.h)
  */
 int obivox_detect_speech_variations(
     const float* audio,
@@ -221,6 +304,7 @@ int obivox_detect_speech_variations(
 /**
  * Apply phonetic normalization for accessibility
  * Example: lisp correction while preserving speaker identity
+ * Stutter smoothing follows accessibility->normalization_mode
  */
 int obivox_apply_phonetic_normalization(
     float* audio,
@@ -270,7 +354,9 @@ typedef struct {
 } OBIVoxPlugin;
 
 /**
- * Register custom codec plugin
+ * Register custom codec plugin (ABI v1) under the Atlas plugin service;
+ * with a registry attached it registers there instead and is callable
+ * through nlm_plugin.h. New plugins should use ABI v2
  */
 int obivox_register_plugin(
     OBIVoxNLMSystem* system,
@@ -0,0 +1,113 @@
+/**
+ * OBIVox Pronunciation Lexicon
+ * Word-level grapheme-to-phoneme table behind a minimal perfect hash, laid
+ * out as one position-independent blob so a prebuilt file maps straight in
+ */
+
+#ifndef OBIVOX_NLM_LEXICON_H
+#define OBIVOX_NLM_LEXICON_H
+
+#include <stddef.h>
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// Lexicon Types
+// ============================================================================
+
+typedef struct obivox_lexicon OBIVoxLexicon;
+
+typedef struct {
+    const char* word;           // Letters and apostrophes, any case
+    const char* phonemes;       // Space-separated ARPAbet, stress optional
+} OBIVoxLexiconEntry;
+
+typedef struct {
+    uint32_t entries;
+    uint32_t slots;             // Perfect-hash table size
+    size_t bytes;               // Blob size (file size when saved)
+    bool mapped;                // Served from an mmap'd file
+    uint64_t lookups;
+    uint64_t misses;            // Words that fell back to the rules
+} OBIVoxLexiconStats;
+
+// ============================================================================
+// Lexicon API
+// ============================================================================
+
+/**
+ * Build from entries; words are lower-cased, stress digits dropped and
+ * duplicates keep their first pronunciation. Words over 63 bytes are
+ * skipped, never truncated
+ */
+int obivox_lexicon_build(
+    const OBIVoxLexiconEntry* entries,
+    uint32_t count,
+    OBIVoxLexicon** lexicon
+);
+
+/**
+ * The built-in table of common words, built once and shared; never
+ * destroy it
+ */
+OBIVoxLexicon* obivox_lexicon_default(void);
+
+/**
+ * Load a file written by obivox_lexicon_save (mapped read-only, no
+ * parsing), or a CMUdict-style text file ("WORD  W ER1 D" per line,
+ * ";;;" comments, "(2)" variants skipped), which is built in memory
+ */
+int obivox_lexicon_load(const char* path, OBIVoxLexicon** lexicon);
+
+/**
+ * Serve a blob from obivox_lexicon_blob in place (validated, never
+ * copied or written), e.g. inside a larger read-only mapping. blob must
+ * be 8-byte aligned and outlive the lexicon
+ */
+int obivox_lexicon_open(const void* blob, size_t bytes, OBIVoxLexicon** lexicon);
+
+/**
+ * The lexicon's blob, as written by obivox_lexicon_save
+ */
+const void* obivox_lexicon_blob(const OBIVoxLexicon* lexicon, size_t* bytes);
+
+/**
+ * Write the blob for later obivox_lexicon_load
+ */
+int obivox_lexicon_save(const OBIVoxLexicon* lexicon, const char* path);
+
+void obivox_lexicon_destroy(OBIVoxLexicon* lexicon);
+
+/**
+ * Phonemes of a word (length bytes, any case); NULL when absent or over
+ * 63 bytes. One hash, one displacement and one string compare. Thread-safe
+ */
+const char* obivox_lexicon_lookup(OBIVoxLexicon* lexicon, const char* word, size_t length);
+
+void obivox_lexicon_stats(const OBIVoxLexicon* lexicon, OBIVoxLexiconStats* stats);
+
+/**
+ * Pronunciation guide from a lexicon (NULL = built-in): one line per word,
+ * "word<TAB>PHONEMES". Words outside the table, and any over 63 bytes,
+ * use letter-to-sound rules over the whole word. With lisp_mitigation,
+ * words holding sibilants (S Z SH ZH CH JH TH DH) are marked with a
+ * leading '*'. The guide is malloc'd; free it
+ */
+int obivox_generate_pronunciation_guide_lexicon(
+    OBIVoxLexicon* lexicon,
+    const char* text,
+    const PhoneticAccessibility* accessibility,
+    char** phonetic_guide
+);
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+/**
+ * Use a lexicon for the system's TTS guides (NULL restores the built-in
+ * table); the system does not take ownership. Cached TTS results are
+ * keyed by the attached lexicon
+ */
+int obivox_nlm_attach_lexicon(OBIVoxNLMSystem* system, OBIVoxLexicon* lexicon);
+
+#endif // OBIVOX_NLM_LEXICON_H
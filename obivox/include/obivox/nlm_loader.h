@@ -0,0 +1,145 @@
+/**
+ * OBIVox Plugin Loader
+ * Discovers plugin shared objects in a directory, registers them (ABI v2
+ * entry point or v1 table) and runs each plugin's inference on its own
+ * workers, pinned to configured cores and NUMA node, with contexts and
+ * buffers allocated node-locally
+ */
+
+#ifndef OBIVOX_NLM_LOADER_H
+#define OBIVOX_NLM_LOADER_H
+
+#include "obivox/nlm_plugin.h"
+
+#define OBIVOX_PLUGIN_DIRECTORY  "build/plugins"
+
+// ============================================================================
+// Loader Types
+// ============================================================================
+
+typedef struct obivox_plugin_loader OBIVoxPluginLoader;
+typedef struct obivox_loaded_plugin OBIVoxLoadedPlugin;
+
+typedef struct {
+    // Plugin name (or file name without extension); NULL matches every
+    // plugin without a placement of its own
+    const char* name;
+
+    int numa_node;              // -1 = no node binding
+    const char* cpus;           // "0-7,16-23"; NULL = the node's CPUs (or any)
+    uint32_t workers;           // Pinned inference threads (0 = 1)
+} OBIVoxPluginPlacement;
+
+typedef struct {
+    const char* directory;      // OBIVOX_PLUGIN_DIRECTORY
+    const OBIVoxPluginPlacement* placements;
+    uint32_t placement_count;
+
+    // Registrations are published here too (may be NULL)
+    struct obivox_atlas* atlas;
+
+    // Each worker creates its context at start, on its own node, rather
+    // than on the first request (true)
+    bool prewarm;
+} OBIVoxLoaderConfig;
+
+typedef struct {
+    const char* name;
+    const char* path;
+    int numa_node;              // -1 when unbound
+    uint32_t workers;
+    uint32_t pinned_workers;    // Workers whose CPU affinity took effect
+    bool memory_bound;          // Worker allocations prefer numa_node
+    uint64_t jobs;
+    uint64_t items;
+    uint64_t queue_ns;          // Time jobs waited for a worker
+    uint32_t queued;
+} OBIVoxLoadedInfo;
+
+typedef struct {
+    uint32_t scanned;           // Shared objects found in the directory
+    uint32_t loaded;
+    uint32_t failed;            // dlopen, missing entry point or rejected table
+} OBIVoxLoaderStats;
+
+// Completion of a submitted job, on the plugin's worker thread
+typedef void (*OBIVoxLoaderDone)(int status, void* user_data);
+
+// ============================================================================
+// Loader API
+// ============================================================================
+
+/**
+ * Defaults: OBIVOX_PLUGIN_DIRECTORY, no placements, prewarm
+ */
+void obivox_loader_config_default(OBIVoxLoaderConfig* config);
+
+/**
+ * Load every shared object in the directory (in name order) into a new
+ * registry and start each plugin's workers; config may be NULL. Objects
+ * that fail to load are skipped and counted. A missing directory loads
+ * nothing. Placement is best effort: see pinned_workers / memory_bound
+ */
+int obivox_loader_create(const OBIVoxLoaderConfig* config, OBIVoxPluginLoader** loader);
+
+/**
+ * Finish queued jobs, join the workers, destroy the registry and unload
+ * the objects; streams on the registry must be closed first
+ */
+void obivox_loader_destroy(OBIVoxPluginLoader* loader);
+
+/**
+ * The loader's registry, for obivox_nlm_attach_plugins and direct calls
+ * on the caller's thread
+ */
+OBIVoxPluginRegistry* obivox_loader_registry(OBIVoxPluginLoader* loader);
+
+void obivox_loader_stats(const OBIVoxPluginLoader* loader, OBIVoxLoaderStats* stats);
+
+uint32_t obivox_loader_count(const OBIVoxPluginLoader* loader);
+
+OBIVoxLoadedPlugin* obivox_loader_plugin(OBIVoxPluginLoader* loader, uint32_t index);
+
+OBIVoxLoadedPlugin* obivox_loader_find(OBIVoxPluginLoader* loader, const char* name);
+
+OBIVoxPluginHandle* obivox_loader_handle(OBIVoxLoadedPlugin* plugin);
+
+void obivox_loader_info(OBIVoxLoadedPlugin* plugin, OBIVoxLoadedInfo* info);
+
+// ============================================================================
+// Placed Execution
+// ============================================================================
+
+/**
+ * Run count items on one of the plugin's workers (the registry's batch
+ * path). Descriptors must stay valid until done runs; done may be NULL.
+ * Thread-safe
+ */
+int obivox_loader_submit(
+    OBIVoxLoadedPlugin* plugin,
+    const OBIVoxBuffer* inputs,
+    OBIVoxBuffer* outputs,
+    uint32_t count,
+    OBIVoxLoaderDone done,
+    void* user_data
+);
+
+/**
+ * obivox_loader_submit and wait; returns the job's status
+ */
+int obivox_loader_process_batch(
+    OBIVoxLoadedPlugin* plugin,
+    const OBIVoxBuffer* inputs,
+    OBIVoxBuffer* outputs,
+    uint32_t count
+);
+
+/**
+ * Page-aligned buffer whose pages prefer the plugin's node (plain pages
+ * without a node); free with obivox_loader_free and the same size
+ */
+void* obivox_loader_alloc(OBIVoxLoadedPlugin* plugin, size_t bytes);
+
+void obivox_loader_free(OBIVoxLoadedPlugin* plugin, void* buffer, size_t bytes);
+
+#endif // OBIVOX_NLM_LOADER_H
@@ -0,0 +1,139 @@
+/**
+ * OBIVox Latency Instrumentation
+ * Monotonic spans around each stage of obivox_bidirectional_convert,
+ * per-thread log-linear histograms merged on read, throughput counters,
+ * and Prometheus or callback export. Detached, a span costs one branch
+ */
+
+#ifndef OBIVOX_NLM_METRICS_H
+#define OBIVOX_NLM_METRICS_H
+
+#include <stddef.h>
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// Metrics Types
+// ============================================================================
+
+typedef struct obivox_metrics OBIVoxMetrics;
+
+typedef enum {
+    OBIVOX_STAGE_TOTAL = 0,         // Whole convert call
+    OBIVOX_STAGE_CACHE,             // Key and lookup
+    OBIVOX_STAGE_DRIFT,             // Drift handling and cascade
+    OBIVOX_STAGE_VAD,               // Voice activity segmentation
+    OBIVOX_STAGE_VARIATION,         // Speech variation detection
+    OBIVOX_STAGE_DENOISE,           // STFT noise reduction
+    OBIVOX_STAGE_NORMALIZATION,
+    OBIVOX_STAGE_FEATURES,
+    OBIVOX_STAGE_MAPPING,           // NLM space mapping
+    OBIVOX_STAGE_CODEC_SELECT,
+    OBIVOX_STAGE_CODEC,             // Inference (processing_time_ns)
+    OBIVOX_STAGE_G2P,               // Pronunciation guide
+    OBIVOX_STAGE_SYNTHESIS,
+
+    // Outside convert: recorded by callers with obivox_metrics_record
+    OBIVOX_STAGE_DECODE,            // FFmpeg decode and resample
+    OBIVOX_STAGE_VALIDATION,        // Human-in-the-loop round trip
+    OBIVOX_STAGE_COUNT
+} OBIVoxStage;
+
+typedef enum {
+    OBIVOX_COUNTER_REQUESTS = 0,
+    OBIVOX_COUNTER_ERRORS,
+    OBIVOX_COUNTER_CACHE_HITS,
+    OBIVOX_COUNTER_SAMPLES_IN,      // STT audio samples
+    OBIVOX_COUNTER_SAMPLES_VOICED,  // Of those, inside VAD segments
+    OBIVOX_COUNTER_TEXT_BYTES_IN,   // TTS text bytes
+    OBIVOX_COUNTER_SAMPLES_OUT,     // TTS audio samples
+    OBIVOX_COUNTER_TEXT_BYTES_OUT,  // STT transcript bytes
+    OBIVOX_COUNTER_COUNT
+} OBIVoxCounter;
+
+typedef struct {
+    uint64_t count;
+    uint64_t total_ns;
+    uint64_t max_ns;
+
+    // Bucket midpoints: within 12.5% of the true quantile
+    uint64_t p50_ns;
+    uint64_t p95_ns;
+    uint64_t p99_ns;
+} OBIVoxStageStats;
+
+typedef struct {
+    OBIVoxStageStats stages[OBIVOX_STAGE_COUNT];
+    uint64_t counters[OBIVOX_COUNTER_COUNT];
+} OBIVoxMetricsSnapshot;
+
+typedef void (*OBIVoxMetricsCallback)(const OBIVoxMetricsSnapshot* snapshot, void* user_data);
+
+typedef struct {
+    // Optional push export: at most once per interval, the request that
+    // finishes after the interval elapsed takes a snapshot and calls back
+    // on its own thread (keep the callback short)
+    OBIVoxMetricsCallback callback;
+    void* user_data;
+    uint32_t export_interval_ms;    // Default 10000
+} OBIVoxMetricsConfig;
+
+// ============================================================================
+// Metrics API
+// ============================================================================
+
+/**
+ * Defaults: no callback, 10 s export interval
+ */
+void obivox_metrics_config_default(OBIVoxMetricsConfig* config);
+
+/**
+ * Create a metrics sink; config may be NULL. Threads record into their
+ * own shard (threads beyond the shard count share one), lock-free
+ */
+int obivox_metrics_create(const OBIVoxMetricsConfig* config, OBIVoxMetrics** metrics);
+
+void obivox_metrics_destroy(OBIVoxMetrics* metrics);
+
+/**
+ * Monotonic clock in nanoseconds, the time base of every span
+ */
+uint64_t obivox_metrics_now(void);
+
+/**
+ * Record one stage duration; no-op when metrics is NULL
+ */
+void obivox_metrics_record(OBIVoxMetrics* metrics, OBIVoxStage stage, uint64_t duration_ns);
+
+/**
+ * Record a span opened with obivox_metrics_now(); returns its duration
+ */
+uint64_t obivox_metrics_span_end(OBIVoxMetrics* metrics, OBIVoxStage stage, uint64_t start_ns);
+
+void obivox_metrics_add(OBIVoxMetrics* metrics, OBIVoxCounter counter, uint64_t value);
+
+/**
+ * Merge every shard; concurrent records may land on either side
+ */
+void obivox_metrics_snapshot(OBIVoxMetrics* metrics, OBIVoxMetricsSnapshot* snapshot);
+
+/**
+ * Prometheus text exposition: a summary per stage (seconds) and a
+ * counter per counter. Returns the full length like snprintf (output is
+ * truncated to capacity), or -1 on error
+ */
+int obivox_metrics_export_prometheus(OBIVoxMetrics* metrics, char* buffer, size_t capacity);
+
+const char* obivox_stage_name(OBIVoxStage stage);
+const char* obivox_counter_name(OBIVoxCounter counter);
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+/**
+ * Attach metrics to the system (NULL detaches); the system does not take
+ * ownership. Sessions of an engine share the template's metrics
+ */
+int obivox_nlm_attach_metrics(OBIVoxNLMSystem* system, OBIVoxMetrics* metrics);
+
+#endif // OBIVOX_NLM_METRICS_H
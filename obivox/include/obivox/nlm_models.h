@@ -0,0 +1,158 @@
+/**
+ * OBIVox Codec Model Manager
+ * Loads each codec model (whisper, coqui, vosk) once and keeps a warm pool
+ * of inference contexts that sessions borrow, so requests never pay for
+ * model load
+ */
+
+#ifndef OBIVOX_NLM_MODELS_H
+#define OBIVOX_NLM_MODELS_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include "obivox/nlm_framwork.h"
+
+// Codecs with models: CODEC_WHISPER, CODEC_COQUI, CODEC_VOSK
+#define OBIVOX_MODEL_CODECS  3
+
+// ============================================================================
+// Model Manager Types
+// ============================================================================
+
+typedef struct obivox_model_manager OBIVoxModelManager;
+
+// One utterance in a batched inference call
+typedef struct {
+    const float* audio;
+    uint32_t num_samples;
+    uint32_t sample_rate;
+
+    // Caller-owned output, filled by the backend
+    char* text;
+    size_t text_capacity;
+    float confidence;
+    int status;                 // 0 = transcribed, OBIVOX_BATCH_CANCELLED
+
+    // Optional: backends poll this between decode steps and stop early,
+    // setting status OBIVOX_BATCH_CANCELLED, once it is set
+    const atomic_bool* cancel;
+} OBIVoxBatchItem;
+
+#define OBIVOX_BATCH_CANCELLED  1
+
+// How one codec library loads weights and creates inference contexts
+typedef struct {
+    const char* name;
+
+    // Load shared read-only model state. With mmap_weights, weights/size
+    // are the mapped model file; otherwise NULL/0 and the backend reads
+    // model_path itself
+    int (*load)(const char* model_path, const void* weights, size_t size, void** model);
+
+    // Per-request inference state over a loaded model; must be safe to
+    // call concurrently for the same model
+    int (*context_create)(void* model, void** context);
+
+    // Optional: clear per-request state before a context is reused
+    void (*context_reset)(void* context);
+
+    void (*context_destroy)(void* context);
+    void (*unload)(void* model);
+
+    // Optional: run count items together through one context, filling
+    // text, confidence and status of each. Required for micro-batching
+    // (see nlm_batch.h); a non-zero return fails the whole batch
+    int (*run_batch)(void* context, OBIVoxBatchItem* items, uint32_t count);
+} OBIVoxModelBackend;
+
+typedef struct {
+    const char* model_path;
+
+    // Contexts created as soon as the model loads
+    uint32_t warm_contexts;
+
+    // Upper bound on live contexts (0 = no bound); acquire waits beyond it
+    uint32_t max_contexts;
+
+    // Map the model file read-only and shared, so processes using the
+    // same file share one copy through the page cache
+    bool mmap_weights;
+
+    // Load at registration instead of on first acquire
+    bool preload;
+} OBIVoxModelConfig;
+
+typedef struct {
+    bool registered;
+    bool loaded;
+    uint64_t load_ns;           // Time spent in load + warm contexts
+    size_t mapped_bytes;
+    uint32_t contexts;          // Live: idle + in use
+    uint32_t idle;
+    uint64_t acquires;
+    uint64_t cold_creates;      // Contexts created after warm-up, on demand
+    uint64_t waits;             // Acquires that blocked at max_contexts
+} OBIVoxModelStats;
+
+// ============================================================================
+// Model Manager API
+// ============================================================================
+
+int obivox_models_create(OBIVoxModelManager** manager);
+
+/**
+ * Destroy every context and unload every model; all contexts must
+ * have been released
+ */
+void obivox_models_destroy(OBIVoxModelManager* manager);
+
+/**
+ * Register the backend for a codec. Strings in config are copied, the
+ * backend table must outlive the manager. With preload the model and
+ * warm contexts are ready when this returns
+ */
+int obivox_models_register(
+    OBIVoxModelManager* manager,
+    int codec,
+    const OBIVoxModelBackend* backend,
+    const OBIVoxModelConfig* config
+);
+
+/**
+ * Borrow a context; loads the model on first use. With wait, blocks
+ * while max_contexts are in use; without, returns 1 and leaves *context
+ * NULL instead. Returns 0 on success, -1 if unregistered or on error
+ */
+int obivox_models_acquire(
+    OBIVoxModelManager* manager,
+    int codec,
+    bool wait,
+    void** context
+);
+
+/**
+ * Return a context to the warm pool (reset first if the backend can)
+ */
+void obivox_models_release(OBIVoxModelManager* manager, int codec, void* context);
+
+/**
+ * Fill whisper/coqui/vosk_context of a codec engine with contexts for
+ * every registered codec, without waiting; unbind returns them. Whisper
+ * stays NULL when the engine has a whisper_batcher and the backend can
+ * batch, since the batcher owns those contexts
+ */
+int obivox_models_bind(OBIVoxModelManager* manager, CodecEngine* codecs);
+void obivox_models_unbind(OBIVoxModelManager* manager, CodecEngine* codecs);
+
+/**
+ * The backend registered for a codec, NULL if none
+ */
+const OBIVoxModelBackend* obivox_models_backend(OBIVoxModelManager* manager, int codec);
+
+void obivox_models_stats(
+    OBIVoxModelManager* manager,
+    int codec,
+    OBIVoxModelStats* stats
+);
+
+#endif // OBIVOX_NLM_MODELS_H
@@ -0,0 +1,302 @@
+/**
+ * OBIVox Plugin ABI v2
+ * Typed buffer descriptors instead of bare pointers, explicit ownership
+ * (inputs and caller outputs are borrowed, plugin outputs are released
+ * views), batch calls, and declared capabilities the host routes on.
+ * v1 OBIVoxPlugin tables still register, through an adapter
+ */
+
+#ifndef OBIVOX_NLM_PLUGIN_H
+#define OBIVOX_NLM_PLUGIN_H
+
+#include <stddef.h>
+#include "obivox/nlm_framwork.h"
+
+#define OBIVOX_PLUGIN_ABI_VERSION  2
+
+// Registrations one registry holds
+#define OBIVOX_PLUGIN_MAX          64
+
+// ============================================================================
+// Buffer Descriptors
+// ============================================================================
+
+typedef enum {
+    OBIVOX_SAMPLE_BYTES = 0,    // Opaque bytes; only bytes is meaningful
+    OBIVOX_SAMPLE_TEXT = 1,     // UTF-8, bytes excludes any terminator
+    OBIVOX_SAMPLE_F32 = 2,
+    OBIVOX_SAMPLE_S16 = 3,
+    OBIVOX_SAMPLE_S32 = 4,
+    OBIVOX_SAMPLE_U8 = 5
+} OBIVoxSampleFormat;
+
+// Output points into plugin memory; hand it back with obivox_plugin_release
+#define OBIVOX_BUFFER_VIEW      (1u << 0)
+
+// Caller output the plugin may not have filled completely (streaming)
+#define OBIVOX_BUFFER_PARTIAL   (1u << 1)
+
+typedef struct {
+    void* data;
+    size_t bytes;               // Input: valid bytes. Output: capacity, then filled
+    uint32_t frames;            // Samples per channel
+    uint16_t channels;          // 0 is read as 1
+    uint16_t format;            // OBIVoxSampleFormat
+    uint32_t sample_rate;       // 0 = not audio / unknown
+
+    // Byte distance between consecutive frames and between channels of a
+    // frame; 0 = packed interleaved (channels * sample size, sample size)
+    int32_t frame_stride;
+    int32_t channel_stride;
+
+    uint32_t flags;             // OBIVOX_BUFFER_*
+    void* owner;                // Set by the host on views: the producing context
+} OBIVoxBuffer;
+
+/**
+ * Describe packed interleaved PCM (channels 0 = 1); bytes is computed
+ */
+void obivox_buffer_pcm(
+    OBIVoxBuffer* buffer,
+    void* data,
+    OBIVoxSampleFormat format,
+    uint16_t channels,
+    uint32_t frames,
+    uint32_t sample_rate
+);
+
+/**
+ * Describe a UTF-8 string (length excludes the terminator)
+ */
+void obivox_buffer_text(OBIVoxBuffer* buffer, const char* text, size_t length);
+
+/**
+ * Byte span the descriptor addresses: bytes for BYTES and TEXT, the
+ * strided extent for PCM; SIZE_MAX when malformed (negative strides or
+ * strides below the sample size)
+ */
+size_t obivox_buffer_span(const OBIVoxBuffer* buffer);
+
+size_t obivox_sample_size(OBIVoxSampleFormat format);
+
+// ============================================================================
+// Plugin Table
+// ============================================================================
+
+// Many callers may share one context concurrently
+#define OBIVOX_PLUGIN_CAP_THREAD_SAFE   (1u << 0)
+
+// State carries across process calls (one context per stream); flush
+// drains what is held back
+#define OBIVOX_PLUGIN_CAP_STREAMING     (1u << 1)
+
+// Fills outputs with data == NULL with views into its own memory
+#define OBIVOX_PLUGIN_CAP_OUTPUT_VIEWS  (1u << 2)
+
+// Output may alias the input
+#define OBIVOX_PLUGIN_CAP_IN_PLACE      (1u << 3)
+
+typedef struct {
+    // ABI the plugin was built against and sizeof the table as it saw
+    // it; the host reads no field past struct_size, so later versions
+    // may append fields
+    uint32_t abi_version;
+    uint32_t struct_size;
+
+    const char* name;
+    const char* version;
+
+    uint32_t capabilities;      // OBIVOX_PLUGIN_CAP_*
+    uint32_t preferred_batch;   // Items per process_batch the plugin runs best at (0 = 1)
+    uint32_t max_batch;         // Most items per process_batch (0 = no limit)
+    OBIVoxSampleFormat input_format;
+    OBIVoxSampleFormat output_format;
+    uint32_t input_rate;        // Required input sample rate (0 = any)
+
+    // Contexts are created on demand: one per concurrent caller unless
+    // thread-safe, one per stream when streaming
+    int (*init)(void** context);
+    void (*destroy)(void* context);
+
+    // Input is borrowed, read-only, for the call. An output with data is
+    // caller memory: write at most bytes and set bytes/frames. An output
+    // with data == NULL and CAP_OUTPUT_VIEWS gets a view and the
+    // OBIVOX_BUFFER_VIEW flag. Returns 0 on success
+    int (*process)(void* context, const OBIVoxBuffer* input, OBIVoxBuffer* output);
+
+    // Optional: count inputs and outputs in one call, under the same
+    // rules; a non-zero return fails the whole batch
+    int (*process_batch)(void* context, const OBIVoxBuffer* inputs,
+                         OBIVoxBuffer* outputs, uint32_t count);
+
+    // Optional: streaming plugins emit what they hold back
+    int (*flush)(void* context, OBIVoxBuffer* output);
+
+    // Optional: clear per-request state before a context is reused
+    void (*reset)(void* context);
+
+    // Required with CAP_OUTPUT_VIEWS: the view's memory may be reused
+    void (*release)(void* context, const OBIVoxBuffer* view);
+} OBIVoxPluginV2;
+
+// Shared objects export the entry point with C linkage and return NULL
+// when they cannot serve host_abi; v1 objects may export an OBIVoxPlugin
+// table named OBIVOX_PLUGIN_V1_SYMBOL instead (see nlm_loader.h)
+#define OBIVOX_PLUGIN_ENTRY_SYMBOL  "obivox_plugin_entry"
+#define OBIVOX_PLUGIN_V1_SYMBOL     "obivox_plugin"
+
+typedef const OBIVoxPluginV2* (*OBIVoxPluginEntryFn)(uint32_t host_abi);
+
+// ============================================================================
+// Plugin Registry
+// ============================================================================
+
+typedef struct obivox_plugin_registry OBIVoxPluginRegistry;
+typedef struct obivox_plugin_handle OBIVoxPluginHandle;
+typedef struct obivox_plugin_stream OBIVoxPluginStream;
+
+typedef struct {
+    const char* name;
+    const char* version;
+    uint32_t abi_version;       // 1 for adapted OBIVoxPlugin tables
+    uint32_t capabilities;
+    uint32_t preferred_batch;
+    uint32_t max_batch;
+    OBIVoxSampleFormat input_format;
+    OBIVoxSampleFormat output_format;
+    uint32_t input_rate;
+} OBIVoxPluginInfo;
+
+typedef struct {
+    uint64_t calls;             // process / process_batch calls into the plugin
+    uint64_t items;
+    uint64_t failures;
+    uint64_t process_ns;
+    uint32_t contexts;          // Live contexts, idle + in use
+    uint32_t idle;
+    uint32_t streams;
+} OBIVoxPluginStats;
+
+// What a caller needs; the host picks among matching plugins
+typedef struct {
+    const char* name;           // NULL = any
+    OBIVoxSampleFormat input_format;
+    OBIVoxSampleFormat output_format;
+    uint32_t input_rate;        // 0 = any
+    uint32_t capabilities;      // Every bit required
+} OBIVoxPluginQuery;
+
+/**
+ * Create a registry. Registrations are also published under the Atlas
+ * plugin service when atlas is not NULL. Thread-safe
+ */
+int obivox_plugins_create(struct obivox_atlas* atlas, OBIVoxPluginRegistry** registry);
+
+/**
+ * Destroy every context; streams must be closed and views released
+ */
+void obivox_plugins_destroy(OBIVoxPluginRegistry* registry);
+
+/**
+ * Register a v2 table (copied, up to its struct_size; strings and code
+ * must outlive the registry). Rejects other ABI versions and tables
+ * missing init, destroy or process. Returns 0, or 1 when the name was
+ * already registered (handle receives the existing registration)
+ */
+int obivox_plugins_register(
+    OBIVoxPluginRegistry* registry,
+    const OBIVoxPluginV2* plugin,
+    OBIVoxPluginHandle** handle
+);
+
+/**
+ * Register a v1 table: untyped pointers, no capabilities, one call per
+ * item. Its process receives input->data and output->data
+ */
+int obivox_plugins_register_v1(
+    OBIVoxPluginRegistry* registry,
+    const OBIVoxPlugin* plugin,
+    OBIVoxPluginHandle** handle
+);
+
+OBIVoxPluginHandle* obivox_plugins_find(OBIVoxPluginRegistry* registry, const char* name);
+
+/**
+ * Best match for a query: formats, rate and capabilities must match;
+ * among matches, the lowest measured time per item wins and unmeasured
+ * plugins are tried first. NULL when nothing matches
+ */
+OBIVoxPluginHandle* obivox_plugins_route(
+    OBIVoxPluginRegistry* registry,
+    const OBIVoxPluginQuery* query
+);
+
+int obivox_plugin_info(const OBIVoxPluginHandle* handle, OBIVoxPluginInfo* info);
+
+void obivox_plugin_stats(OBIVoxPluginHandle* handle, OBIVoxPluginStats* stats);
+
+// ============================================================================
+// Processing
+// ============================================================================
+
+/**
+ * One item on a pooled context. Descriptors are checked against the
+ * declared formats and rate first. Returns 0 or -1; thread-safe
+ */
+int obivox_plugin_process(
+    OBIVoxPluginHandle* handle,
+    const OBIVoxBuffer* input,
+    OBIVoxBuffer* output
+);
+
+/**
+ * count items on one pooled context, in process_batch calls of at most
+ * max_batch (or one process call per item without process_batch).
+ * Returns 0 or -1
+ */
+int obivox_plugin_process_batch(
+    OBIVoxPluginHandle* handle,
+    const OBIVoxBuffer* inputs,
+    OBIVoxBuffer* outputs,
+    uint32_t count
+);
+
+/**
+ * Hand a view back to the context that produced it
+ */
+void obivox_plugin_release(OBIVoxPluginHandle* handle, OBIVoxBuffer* view);
+
+/**
+ * A context held for one stream's lifetime (any plugin; state only
+ * carries over for CAP_STREAMING ones). One thread at a time per stream
+ */
+int obivox_plugin_stream_open(OBIVoxPluginHandle* handle, OBIVoxPluginStream** stream);
+
+int obivox_plugin_stream_process(
+    OBIVoxPluginStream* stream,
+    const OBIVoxBuffer* input,
+    OBIVoxBuffer* output
+);
+
+/**
+ * Drain held-back output; 0 with output->bytes == 0 when nothing is left
+ */
+int obivox_plugin_stream_flush(OBIVoxPluginStream* stream, OBIVoxBuffer* output);
+
+/**
+ * Reset the context and return it to the pool
+ */
+void obivox_plugin_stream_close(OBIVoxPluginStream* stream);
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+/**
+ * Attach a registry (NULL detaches); the system does not take ownership.
+ * obivox_register_plugin then registers v1 tables with it, and the Atlas
+ * node comes from the registry's Atlas (create it on the system's)
+ */
+int obivox_nlm_attach_plugins(OBIVoxNLMSystem* system, OBIVoxPluginRegistry* registry);
+
+#endif // OBIVOX_NLM_PLUGIN_H
@@ -0,0 +1,89 @@
+/**
+ * OBIVox System Snapshots
+ * Versioned, position-independent image of a configured system: scalars
+ * and dialect markers, the flat Atlas index and the attached lexicon, at
+ * aligned offsets. Opening maps it read-only and uses the tables in place,
+ * so forked workers share one copy through the page cache
+ */
+
+#ifndef OBIVOX_NLM_SNAPSHOT_H
+#define OBIVOX_NLM_SNAPSHOT_H
+
+#include "obivox/nlm_atlas.h"
+#include "obivox/nlm_lexicon.h"
+
+// ============================================================================
+// Snapshot Types
+// ============================================================================
+
+typedef struct obivox_snapshot OBIVoxSnapshot;
+
+typedef struct {
+    uint32_t version;
+    size_t bytes;               // File size
+    uint32_t atlas_entries;
+    uint32_t lexicon_entries;   // 0 = the system used the built-in table
+    uint32_t dialects;
+} OBIVoxSnapshotInfo;
+
+// ============================================================================
+// Snapshot API
+// ============================================================================
+
+/**
+ * Write the system's current state to path. The file is written beside
+ * path and renamed over it, so processes still mapping an older snapshot
+ * keep a consistent image. Codec backends are code and are not captured:
+ * register them again after loading (their learned costs live in the
+ * Atlas and are)
+ */
+int obivox_snapshot_save(OBIVoxNLMSystem* system, const char* path);
+
+/**
+ * Map a snapshot read-only and validate it (magic, version, byte order,
+ * section bounds); nothing is parsed or copied. Open once before forking
+ * to share the mapping outright
+ */
+int obivox_snapshot_open(const char* path, OBIVoxSnapshot** snapshot);
+
+/**
+ * Unmap. The snapshot must outlive every system restored from it and
+ * everything sharing their borrowed tables (engines built from them and
+ * their sessions): destroy those first, or their dialect markers and
+ * lexicon dangle
+ */
+void obivox_snapshot_close(OBIVoxSnapshot* snapshot);
+
+void obivox_snapshot_info(const OBIVoxSnapshot* snapshot, OBIVoxSnapshotInfo* info);
+
+/**
+ * The mapped flat Atlas index, for read-only lookups with no Atlas at all
+ */
+const OBIVoxAtlasIndex* obivox_snapshot_atlas(const OBIVoxSnapshot* snapshot);
+
+/**
+ * The mapped lexicon; NULL when the snapshot uses the built-in table
+ */
+OBIVoxLexicon* obivox_snapshot_lexicon(const OBIVoxSnapshot* snapshot);
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+/**
+ * Restore a snapshot into a system: scalars and dialect markers, tree
+ * mode, lexicon, and the Atlas contents in one balanced build. Dialect
+ * markers and the lexicon stay borrowed from the mapping (read-only), so
+ * the snapshot must stay open until the system is destroyed; the Atlas
+ * is copied and does not depend on it
+ */
+int obivox_nlm_apply_snapshot(OBIVoxNLMSystem* system, const OBIVoxSnapshot* snapshot);
+
+/**
+ * obivox_nlm_init followed by obivox_nlm_apply_snapshot; a NULL snapshot
+ * is a plain obivox_nlm_init. The same lifetime rule applies: close the
+ * snapshot only after obivox_nlm_destroy
+ */
+int obivox_nlm_init_snapshot(const OBIVoxSnapshot* snapshot, OBIVoxNLMSystem** system);
+
+#endif // OBIVOX_NLM_SNAPSHOT_H
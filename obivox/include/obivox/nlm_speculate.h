@@ -0,0 +1,118 @@
+/**
+ * OBIVox Speculative Dual-Codec Execution
+ * CODEC_ADAPTIVE runs a fast and a slow codec side by side; a confident
+ * fast result cancels the slow job, otherwise the slow result wins and
+ * both are checked for cross-codec agreement (stage-5 consistency)
+ */
+
+#ifndef OBIVOX_NLM_SPECULATE_H
+#define OBIVOX_NLM_SPECULATE_H
+
+#include "obivox/nlm_models.h"
+#include "obivox/nlm_engine.h"
+
+// Longest transcript the slow codec may produce (matches arena transcripts)
+#define OBIVOX_SPECULATE_TEXT_MAX  4096
+
+// ============================================================================
+// Speculator Types
+// ============================================================================
+
+typedef struct obivox_speculator OBIVoxSpeculator;
+
+typedef struct {
+    int fast_codec;               // Default CODEC_VOSK
+    int slow_codec;               // Default CODEC_WHISPER
+
+    // Fast results at or above this confidence are accepted (0.85,
+    // stage-5 confidence_checker min_confidence)
+    float accept_confidence;
+
+    // Word-level agreement the two transcripts need to count as
+    // consistent (0.8, stage-5 cross_codec_agreement)
+    float agreement_threshold;
+
+    // Cancellation budget: a slow job that takes longer than this to
+    // stop after cancel is counted as overdue
+    uint32_t cancel_grace_us;
+} OBIVoxSpeculateConfig;
+
+typedef struct {
+    int fast_codec;
+    int slow_codec;
+    int codec;                    // Codec whose transcript was returned
+    float confidence;
+    bool slow_cancelled;
+
+    // Set when both codecs finished: word agreement in [0, 1]; -1 and
+    // false otherwise
+    float agreement;
+    bool agreed;
+
+    uint64_t fast_ns;
+    uint64_t slow_ns;             // 0 when cancelled
+    uint64_t total_ns;
+} OBIVoxSpeculateResult;
+
+typedef struct {
+    uint64_t runs;
+    uint64_t fast_accepted;
+    uint64_t slow_used;
+    uint64_t cancelled_queued;    // Dropped before they took a context
+    uint64_t cancelled_running;   // Stopped mid-decode
+    uint64_t overdue_cancels;     // Took longer than cancel_grace_us
+    uint64_t max_cancel_ns;       // Worst cancel-to-stop latency
+    uint64_t disagreements;
+} OBIVoxSpeculateStats;
+
+// ============================================================================
+// Speculator API
+// ============================================================================
+
+/**
+ * Defaults: vosk fast, whisper slow, accept at 0.85, agreement 0.8,
+ * 20 ms cancel grace
+ */
+void obivox_speculate_config_default(OBIVoxSpeculateConfig* config);
+
+/**
+ * Create a speculator over the model pool; slow jobs run on pool, or
+ * after the fast codec on the caller when pool is NULL. Both codecs need
+ * a backend with run_batch once runs start. config may be NULL
+ */
+int obivox_speculate_create(
+    OBIVoxModelManager* models,
+    OBIVoxWorkerPool* pool,
+    const OBIVoxSpeculateConfig* config,
+    OBIVoxSpeculator** speculator
+);
+
+/**
+ * Transcribe audio into text (text_capacity bytes). Thread-safe; never
+ * call from a task on the same pool. A running slow job is waited for
+ * until it finishes or observes its cancellation; one still queued is
+ * abandoned without waiting and never touches audio, so audio is only
+ * borrowed for the call. Returns 0, or -1 when neither codec produced a
+ * transcript
+ */
+int obivox_speculate_run(
+    OBIVoxSpeculator* speculator,
+    const float* audio,
+    uint32_t num_samples,
+    uint32_t sample_rate,
+    char* text,
+    size_t text_capacity,
+    OBIVoxSpeculateResult* result
+);
+
+/**
+ * Word-level agreement between two transcripts: 1 - word edit distance
+ * over the longer length (two empty transcripts agree fully)
+ */
+float obivox_transcript_agreement(const char* a, const char* b);
+
+void obivox_speculate_stats(OBIVoxSpeculator* speculator, OBIVoxSpeculateStats* stats);
+
+void obivox_speculate_destroy(OBIVoxSpeculator* speculator);
+
+#endif // OBIVOX_NLM_SPECULATE_H
@@ -0,0 +1,102 @@
+/**
+ * OBIVox NLM Streaming Sessions
+ * Frame-by-frame STT front-end for live audio (e.g. 20 ms call frames)
+ * Carries AudioFeatures and NLMCoordinate state between pushed chunks
+ */
+
+#ifndef OBIVOX_NLM_STREAM_H
+#define OBIVOX_NLM_STREAM_H
+
+#include "obivox/nlm_framwork.h"
+#include "obivox/nlm_vad.h"
+
+// ============================================================================
+// Streaming Session Types
+// ============================================================================
+
+// Analysis hop for the pitch/energy contours (10 ms, spec tone resolution)
+#define OBIVOX_STREAM_HOP_MS          10
+
+// NLM mapping looks at the most recent hops only (2.56 s at 10 ms)
+#define OBIVOX_STREAM_CONTOUR_HOPS    256
+
+// Stutter windows match obivox_detect_speech_variations
+#define OBIVOX_STREAM_STUTTER_WINDOW  1024
+
+// Look-ahead of the centred stutter smoother, in samples
+#define OBIVOX_STREAM_SMOOTH_DELAY    256
+
+typedef struct obivox_stream OBIVoxStream;
+
+typedef struct {
+    // Transcript so far - borrowed, valid until the next push or close
+    const char* text;
+    float confidence;
+
+    // NLM state carried across all chunks pushed so far
+    NLMCoordinate position;
+    float variation_score;
+    bool has_lisp;
+    bool has_stutter;
+
+    // Normalized audio produced since the previous pull - borrowed,
+    // valid until the next push or close
+    // Lags the input by OBIVOX_STREAM_SMOOTH_DELAY samples
+    const float* audio;
+    uint32_t audio_samples;
+
+    // Stream progress
+    uint64_t samples_processed;
+    uint64_t timestamp_ms;
+
+    // Voice activity: samples that reached detection and the codec, and
+    // speech segments closed since the previous pull - borrowed, valid
+    // until the next push or close
+    uint64_t voiced_samples;
+    bool in_speech;
+    const OBIVoxSpeechSegment* segments;
+    uint32_t num_segments;
+} OBIVoxPartialResult;
+
+// ============================================================================
+// Streaming Session API
+// ============================================================================
+
+/**
+ * Open a streaming STT session against an initialized system
+ * Accessibility settings are copied so detection never writes the system
+ */
+int obivox_stream_open(
+    OBIVoxNLMSystem* system,
+    uint32_t sample_rate,
+    OBIVoxStream** stream
+);
+
+/**
+ * Push a chunk of mono float samples of any length
+ * Variation detection, normalization and NLM mapping run on the new
+ * samples only, so cost is proportional to the chunk, not the utterance
+ * Chunks outside VAD speech segments are normalized but skip detection,
+ * NLM mapping and transcription
+ */
+int obivox_stream_push(
+    OBIVoxStream* stream,
+    const float* samples,
+    uint32_t num_samples
+);
+
+/**
+ * Pull the current partial result
+ * Returns 1 if samples were pushed since the last pull, 0 otherwise
+ */
+int obivox_stream_pull(
+    OBIVoxStream* stream,
+    OBIVoxPartialResult* result
+);
+
+/**
+ * Close the session and release its buffers
+ */
+void obivox_stream_close(OBIVoxStream* stream);
+
+#endif // OBIVOX_NLM_STREAM_H
@@ -0,0 +1,116 @@
+/**
+ * OBIVox Streaming Synthesis
+ * Chunked TTS for live playback: text is split into sentence and phrase
+ * units, each voiced on the stream's worker while earlier audio plays,
+ * and PCM leaves through a ring buffer (pull) or a chunk callback (push).
+ * First audio waits for one phrase, and memory is fixed at open whatever
+ * the text length
+ */
+
+#ifndef OBIVOX_NLM_SYNTH_H
+#define OBIVOX_NLM_SYNTH_H
+
+#include "obivox/nlm_framwork.h"
+
+// Mono float PCM
+#define OBIVOX_SYNTH_SAMPLE_RATE  16000
+
+// ============================================================================
+// Streaming Synthesis Types
+// ============================================================================
+
+typedef struct obivox_synth_stream OBIVoxSynthStream;
+
+// Audio in order, on the stream's worker thread; pcm is valid for the call
+typedef void (*OBIVoxSynthChunkFn)(const float* pcm, uint32_t samples, void* user_data);
+
+typedef struct {
+    // Phrases end at . ! ? ; : , or a newline; longer runs are cut at the
+    // last space before this many bytes (96)
+    uint32_t max_phrase_bytes;
+
+    uint32_t ring_samples;          // PCM held between worker and reader (2 s)
+
+    // Audio held back before delivery starts, so a slow phrase later on
+    // does not underrun playback; 0 = start once the first phrase is
+    // voiced. Capped at ring_samples
+    uint32_t prebuffer_samples;
+
+    // Push mode: audio in chunk_samples pieces (20 ms; the last may be
+    // shorter). NULL = pull with obivox_synth_read
+    OBIVoxSynthChunkFn on_chunk;
+    uint32_t chunk_samples;
+    void* user_data;
+} OBIVoxSynthConfig;
+
+typedef struct {
+    uint64_t utterances;
+    uint64_t phrases;
+    uint64_t samples;               // Voiced, including word gaps
+    uint64_t first_audio_ns;        // Last utterance: begin to delivery start
+    uint64_t underruns;             // Pull reads short of capacity mid-utterance
+    uint32_t peak_buffered;         // Most samples the ring has held
+} OBIVoxSynthStats;
+
+// ============================================================================
+// Streaming Synthesis API
+// ============================================================================
+
+/**
+ * Defaults: 96-byte phrases, 2 s ring, no prebuffer, pull mode
+ */
+void obivox_synth_config_default(OBIVoxSynthConfig* config);
+
+/**
+ * Open a stream against an initialized system (config may be NULL) and
+ * start its worker. Accessibility settings are copied; the system's
+ * lexicon and metrics are used as attached at each begin. Every phrase is
+ * voiced from its pronunciation guide, '*'-marked with lisp mitigation
+ */
+int obivox_synth_open(
+    OBIVoxNLMSystem* system,
+    const OBIVoxSynthConfig* config,
+    OBIVoxSynthStream** stream
+);
+
+/**
+ * Start synthesizing text (length 0 = strlen). The text is borrowed until
+ * the utterance ends: obivox_synth_read returns 1, obivox_synth_wait
+ * returns, or obivox_synth_cancel. Returns 1 while the previous utterance
+ * is still being delivered
+ */
+int obivox_synth_begin(OBIVoxSynthStream* stream, const char* text, size_t length);
+
+/**
+ * Pull mode: copy up to capacity buffered samples without blocking.
+ * Returns 0 (samples may be 0 while prebuffering or on underrun), or 1
+ * once the utterance is voiced and fully read. Safe from an audio
+ * callback alongside the worker; one reader at a time
+ */
+int obivox_synth_read(
+    OBIVoxSynthStream* stream,
+    float* pcm,
+    uint32_t capacity,
+    uint32_t* samples
+);
+
+/**
+ * Block until the worker has voiced the utterance (push mode: and
+ * delivered it). In pull mode another thread must keep reading
+ */
+int obivox_synth_wait(OBIVoxSynthStream* stream);
+
+/**
+ * Stop the utterance and drop buffered audio; returns once the worker
+ * no longer touches the text. Not from on_chunk
+ */
+int obivox_synth_cancel(OBIVoxSynthStream* stream);
+
+void obivox_synth_stats(OBIVoxSynthStream* stream, OBIVoxSynthStats* stats);
+
+/**
+ * Cancel, join the worker and release the stream's buffers
+ */
+void obivox_synth_close(OBIVoxSynthStream* stream);
+
+#endif // OBIVOX_NLM_SYNTH_H
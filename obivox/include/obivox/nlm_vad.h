@@ -0,0 +1,108 @@
+/**
+ * OBIVox Voice Activity Segmentation
+ * Stage-2 energy/zero-crossing VAD that runs ahead of variation detection
+ * so silence never reaches normalization or the codec
+ */
+
+#ifndef OBIVOX_NLM_VAD_H
+#define OBIVOX_NLM_VAD_H
+
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// VAD Types
+// ============================================================================
+
+typedef struct obivox_vad OBIVoxVAD;
+
+typedef struct {
+    uint32_t sample_rate;
+
+    // Analysis frame (non-overlapping)
+    float frame_ms;
+
+    // Fraction of the noise-floor-to-peak log-energy range a frame must
+    // clear to count as voiced (spec vad_segmentation.energy_threshold)
+    float energy_threshold;
+
+    // Pauses shorter than this stay inside a segment (spec min_silence)
+    float min_silence_ms;
+
+    // Bursts shorter than this (clicks, breaths) are dropped
+    float min_speech_ms;
+
+    // Context kept around each segment so onsets and releases survive
+    float padding_ms;
+
+    // Crossings per sample above which a quieter frame still counts as
+    // unvoiced speech (fricatives, the sounds lisp detection needs)
+    float zcr_threshold;
+} OBIVoxVADConfig;
+
+typedef struct {
+    uint64_t start_sample;
+    uint64_t end_sample;        // Exclusive
+    uint64_t start_ms;
+    uint64_t end_ms;
+} OBIVoxSpeechSegment;
+
+// ============================================================================
+// VAD API
+// ============================================================================
+
+/**
+ * Default configuration: 16 kHz, 10 ms frames, threshold 0.3,
+ * 300 ms min silence, 100 ms min speech, 50 ms padding, ZCR 0.25
+ */
+void obivox_vad_config_default(OBIVoxVADConfig* config);
+
+/**
+ * Create a VAD; config may be NULL for the defaults
+ */
+int obivox_vad_create(const OBIVoxVADConfig* config, OBIVoxVAD** vad);
+
+/**
+ * Segment a whole buffer. Noise floor and peak come from the buffer's own
+ * energy distribution. Segments are borrowed, valid until the next call;
+ * resets any streaming state
+ */
+int obivox_vad_segment(
+    OBIVoxVAD* vad,
+    const float* audio,
+    uint32_t num_samples,
+    const OBIVoxSpeechSegment** segments,
+    uint32_t* count
+);
+
+/**
+ * Push a chunk of a live stream; floor and peak are tracked as it goes
+ * Returns 1 if any part of the chunk is inside a segment (including the
+ * min_silence hangover), 0 if the chunk is silence, -1 on error
+ */
+int obivox_vad_push(OBIVoxVAD* vad, const float* samples, uint32_t num_samples);
+
+/**
+ * Close the open segment, if any, at the end of the stream
+ */
+int obivox_vad_flush(OBIVoxVAD* vad);
+
+/**
+ * Segments completed since the previous take - borrowed, valid until the
+ * next push, flush or reset
+ */
+int obivox_vad_take_segments(
+    OBIVoxVAD* vad,
+    const OBIVoxSpeechSegment** segments,
+    uint32_t* count
+);
+
+/**
+ * True while inside a segment or its hangover
+ */
+bool obivox_vad_in_speech(const OBIVoxVAD* vad);
+
+void obivox_vad_reset(OBIVoxVAD* vad);
+
+void obivox_vad_destroy(OBIVoxVAD* vad);
+
+#endif // OBIVOX_NLM_VAD_H
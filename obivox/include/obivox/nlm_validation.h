@@ -0,0 +1,155 @@
+/**
+ * OBIVox Asynchronous Human Validation
+ * Low-confidence results go out provisional with a ticket instead of
+ * waiting for a person. Reviewers drain the queue at their own pace and
+ * resolve tickets; a background thread folds the resolutions into a
+ * learner system through obivox_incorporate_feedback, in batches
+ */
+
+#ifndef OBIVOX_NLM_VALIDATION_H
+#define OBIVOX_NLM_VALIDATION_H
+
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// Validation Types
+// ============================================================================
+
+typedef struct obivox_validation_queue OBIVoxValidationQueue;
+
+// Ticket ids are never 0; 0 means the result was final
+typedef uint64_t OBIVoxTicket;
+
+// Called on the feedback thread after a resolution was incorporated;
+// correction is NULL when the reviewer accepted the provisional text
+typedef void (*OBIVoxValidationApplied)(
+    OBIVoxTicket ticket,
+    const char* original,
+    const char* correction,
+    void* user_data
+);
+
+typedef struct {
+    // Outstanding tickets (waiting for review or to be applied); past
+    // this, submissions are rejected or wait (backpressure)
+    uint32_t capacity;
+
+    // Results below this confidence are queued (request_human_validation's 0.85)
+    float confidence_threshold;
+
+    // How long a full queue may block a submitter; 0 rejects at once so
+    // workers never wait on reviewers
+    uint32_t block_timeout_ms;
+
+    // Feedback thread applies up to batch_size resolutions at a time,
+    // once batch_size are ready or the oldest has waited flush_interval_ms
+    uint32_t batch_size;
+    uint32_t flush_interval_ms;
+
+    // Tickets unresolved this long after submission, or after a claim,
+    // are dropped (the result stays final unreviewed); 0 keeps them
+    uint32_t expire_ms;
+
+    OBIVoxValidationApplied on_applied;
+    void* user_data;
+} OBIVoxValidationConfig;
+
+typedef struct {
+    OBIVoxTicket ticket;
+    const char* text;           // Valid until resolved or expire_ms after the claim
+    float confidence;
+    uint64_t submitted_ns;      // CLOCK_MONOTONIC
+} OBIVoxValidationRequest;
+
+typedef struct {
+    uint64_t submitted;         // Tickets issued
+    uint64_t confident;         // Submissions above the threshold, no ticket
+    uint64_t rejected;          // Full queue: published without a ticket
+    uint64_t blocked;           // Submissions that waited for space
+    uint64_t resolved;
+    uint64_t corrected;         // Resolutions carrying a correction
+    uint64_t applied;
+    uint64_t batches;
+    uint64_t expired;
+    uint32_t waiting;           // Not yet taken by a reviewer
+    uint32_t outstanding;       // Every ticket still holding a slot
+} OBIVoxValidationStats;
+
+// ============================================================================
+// Validation API
+// ============================================================================
+
+/**
+ * Defaults: 1024 tickets, threshold 0.85, never block, batches of 32
+ * every 100 ms, tickets expire after 10 minutes
+ */
+void obivox_validation_config_default(OBIVoxValidationConfig* config);
+
+/**
+ * Create a queue and its feedback thread; config may be NULL. learner
+ * receives every resolution and is touched by no other thread from here
+ * on: give the queue its own session, which shares the engine's Atlas so
+ * codec confidence learned from corrections routes every session. NULL
+ * learner only reports resolutions through on_applied
+ */
+int obivox_validation_queue_create(
+    OBIVoxNLMSystem* learner,
+    const OBIVoxValidationConfig* config,
+    OBIVoxValidationQueue** queue
+);
+
+/**
+ * Apply every resolution already made, stop the feedback thread and drop
+ * tickets still waiting for review. Submitters blocked on a full queue
+ * return -1 first; no call may start once destroy has
+ */
+void obivox_validation_queue_destroy(OBIVoxValidationQueue* queue);
+
+/**
+ * Publish a result. Below the threshold, or with force, the text is copied
+ * under a fresh ticket. Returns 0 (ticket 0 when confident), 1 when the
+ * queue stayed full (ticket 0, result is final unreviewed), -1 on error
+ * or when the queue is being destroyed. Thread-safe
+ */
+int obivox_validation_submit(
+    OBIVoxValidationQueue* queue,
+    const char* text,
+    float confidence,
+    bool force,
+    OBIVoxTicket* ticket
+);
+
+/**
+ * Reviewer side: take the oldest unclaimed ticket. Returns 0 with a
+ * request, 1 when none is waiting
+ */
+int obivox_validation_next(OBIVoxValidationQueue* queue, OBIVoxValidationRequest* request);
+
+/**
+ * Resolve a ticket, claimed or not; correction NULL accepts the text.
+ * Returns -1 for unknown, expired or already resolved tickets
+ */
+int obivox_validation_resolve(OBIVoxValidationQueue* queue, OBIVoxTicket ticket, const char* correction);
+
+/**
+ * Wake the feedback thread now and wait until every resolution made so
+ * far has been applied
+ */
+int obivox_validation_flush(OBIVoxValidationQueue* queue);
+
+void obivox_validation_stats(OBIVoxValidationQueue* queue, OBIVoxValidationStats* stats);
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+/**
+ * Attach a queue (NULL detaches); the system does not take ownership.
+ * obivox_bidirectional_convert then publishes low-confidence STT results,
+ * and every result while drift sits in the human stress zone, leaving
+ * the ticket in system->validation_ticket. Sessions share the template's
+ * queue
+ */
+int obivox_nlm_attach_validation(OBIVoxNLMSystem* system, OBIVoxValidationQueue* queue);
+
+#endif // OBIVOX_NLM_VALIDATION_H
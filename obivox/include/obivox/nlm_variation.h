@@ -0,0 +1,73 @@
+/**
+ * OBIVox Speech Variation Engine
+ * Spectral repetition detection (multi-lag normalised autocorrelation)
+ * sharing one framing pass with the zero-crossing lisp heuristic
+ */
+
+#ifndef OBIVOX_NLM_VARIATION_H
+#define OBIVOX_NLM_VARIATION_H
+
+#include "obivox/nlm_framwork.h"
+
+// ============================================================================
+// Variation Engine Types
+// ============================================================================
+
+typedef struct obivox_variation_engine OBIVoxVariationEngine;
+
+typedef struct {
+    uint32_t sample_rate;
+
+    // Syllable repetition lags searched per frame (stutters: 80-400 ms)
+    float min_lag_ms;
+    float max_lag_ms;
+
+    // Frame advance; frames span 2x max_lag, so shorter hops overlap more
+    float hop_ms;
+
+    // Normalised autocorrelation peak that counts as a repetition
+    float repetition_threshold;
+} OBIVoxVariationConfig;
+
+typedef struct {
+    float zero_crossing_rate;
+    float repetition_score;     // Frames whose peak cleared the threshold
+    float peak_correlation;     // Best normalised peak over all frames
+    float peak_lag_ms;          // Lag of that peak
+    uint32_t frames_analyzed;
+} OBIVoxVariationReport;
+
+// ============================================================================
+// Variation Engine API
+// ============================================================================
+
+/**
+ * Default configuration: 16 kHz, 80-400 ms lags, 100 ms hop, threshold 0.8
+ */
+void obivox_variation_config_default(OBIVoxVariationConfig* config);
+
+/**
+ * Create an engine with its FFT plan and frame buffers pre-allocated
+ * Reuse one engine per thread; analysis never allocates
+ */
+int obivox_variation_engine_create(
+    const OBIVoxVariationConfig* config,
+    OBIVoxVariationEngine** engine
+);
+
+/**
+ * Analyze a whole buffer and update accessibility flags as
+ * obivox_detect_speech_variations does; report may be NULL
+ */
+int obivox_variation_engine_analyze(
+    OBIVoxVariationEngine* engine,
+    const float* audio,
+    uint32_t num_samples,
+    PhoneticAccessibility* accessibility,
+    OBIVoxVariationReport* report,
+    float* variation_score
+);
+
+void obivox_variation_engine_destroy(OBIVoxVariationEngine* engine);
+
+#endif // OBIVOX_NLM_VARIATION_H
@@ -0,0 +1,359 @@
+/**
+ * nlm_arena.c
+ * Power-of-two size-class slabs with per-class free lists
+ * Every buffer carries a 64-byte header naming its class; the arena keeps
+ * a set of the addresses it handed out, so ownership is decided without
+ * reading memory in front of a foreign pointer
+ */
+
+#include "obivox/nlm_arena.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_MIN_SHIFT   8      // 256 B
+#define ARENA_MAX_SHIFT   22     // 4 MB
+#define ARENA_CLASSES     (ARENA_MAX_SHIFT - ARENA_MIN_SHIFT + 1)
+#define ARENA_OVERSIZE    0xFFFFFFFFu
+#define ARENA_ALIGN       64
+#define ARENA_SET_INITIAL 64     // Owned-address set slots (power of two)
+
+typedef struct arena_block {
+    struct arena_block* next_free;
+    uint32_t size_class;
+} ArenaBlock;
+
+typedef struct {
+    pthread_mutex_t lock;
+    ArenaBlock* free_list;
+    uint64_t acquired;
+    uint64_t recycled;
+    uint64_t misses;
+    uint64_t blocks;
+} ArenaClass;
+
+struct obivox_arena {
+    ArenaClass classes[ARENA_CLASSES];
+    pthread_mutex_t oversize_lock;
+    uint64_t oversize;
+
+    // Every live block (slab and oversize), open addressing on the block
+    // address; 0 marks an empty slot
+    pthread_mutex_t owned_lock;
+    uintptr_t* owned;
+    uint32_t owned_capacity;
+    uint32_t owned_count;
+};
+
+static const OBIVoxArenaSlab default_slabs[] = {
+    { 256, 32 },                      // Short feedback strings
+    { 4096, 16 },                     // Transcripts
+    { 64 * 1024, 16 },                // Per-request scratch
+    { 16000 * 10 * sizeof(float), 4 } // 10 s of 16 kHz TTS output
+};
+
+_Static_assert(sizeof(ArenaBlock) <= ARENA_ALIGN, "arena header must fit alignment");
+
+// ============================================================================
+// Size Classes
+// ============================================================================
+
+static uint32_t size_class_for(size_t bytes) {
+    uint32_t shift = ARENA_MIN_SHIFT;
+    while (shift <= ARENA_MAX_SHIFT && ((size_t)1 << shift) < bytes) shift++;
+    return shift <= ARENA_MAX_SHIFT ? shift - ARENA_MIN_SHIFT : ARENA_OVERSIZE;
+}
+
+// ============================================================================
+// Owned-Address Set
+// ============================================================================
+
+static inline uint32_t owned_slot(uintptr_t address, uint32_t capacity) {
+    return (uint32_t)(((uint64_t)(address >> 6) * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+}
+
+// Under owned_lock
+static int owned_grow(OBIVoxArena* arena) {
+    uint32_t capacity = arena->owned_capacity ? arena->owned_capacity * 2 : ARENA_SET_INITIAL;
+    uintptr_t* table = calloc(capacity, sizeof(uintptr_t));
+    if (!table) return -1;
+    for (uint32_t i = 0; i < arena->owned_capacity; i++) {
+        uintptr_t address = arena->owned[i];
+        if (!address) continue;
+        uint32_t slot = owned_slot(address, capacity);
+        while (table[slot]) slot = (slot + 1) & (capacity - 1);
+        table[slot] = address;
+    }
+    free(arena->owned);
+    arena->owned = table;
+    arena->owned_capacity = capacity;
+    return 0;
+}
+
+static int owned_insert(OBIVoxArena* arena, ArenaBlock* block) {
+    uintptr_t address = (uintptr_t)block;
+    pthread_mutex_lock(&arena->owned_lock);
+    // Keep the load at or below one half
+    if ((arena->owned_count + 1) * 2 > arena->owned_capacity && owned_grow(arena) != 0) {
+        pthread_mutex_unlock(&arena->owned_lock);
+        return -1;
+    }
+    uint32_t mask = arena->owned_capacity - 1;
+    uint32_t slot = owned_slot(address, arena->owned_capacity);
+    while (arena->owned[slot]) slot = (slot + 1) & mask;
+    arena->owned[slot] = address;
+    arena->owned_count++;
+    pthread_mutex_unlock(&arena->owned_lock);
+    return 0;
+}
+
+// Under owned_lock; the slot of address, or capacity when absent
+static uint32_t owned_find(const OBIVoxArena* arena, uintptr_t address) {
+    if (arena->owned_capacity == 0) return 0;
+    uint32_t mask = arena->owned_capacity - 1;
+    uint32_t slot = owned_slot(address, arena->owned_capacity);
+    while (arena->owned[slot]) {
+        if (arena->owned[slot] == address) return slot;
+        slot = (slot + 1) & mask;
+    }
+    return arena->owned_capacity;
+}
+
+// Under owned_lock: backward-shift deletion keeps probe runs unbroken
+static void owned_remove_slot(OBIVoxArena* arena, uint32_t slot) {
+    uint32_t mask = arena->owned_capacity - 1;
+    uint32_t hole = slot;
+    for (uint32_t next = (hole + 1) & mask; arena->owned[next]; next = (next + 1) & mask) {
+        uint32_t home = owned_slot(arena->owned[next], arena->owned_capacity);
+        // Move next into the hole unless its home lies in (hole, next]
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            arena->owned[hole] = arena->owned[next];
+            hole = next;
+        }
+    }
+    arena->owned[hole] = 0;
+    arena->owned_count--;
+}
+
+// ============================================================================
+// Blocks
+// ============================================================================
+
+static ArenaBlock* block_alloc(OBIVoxArena* arena, uint32_t size_class, size_t bytes) {
+    size_t padded = (bytes + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    ArenaBlock* block = aligned_alloc(ARENA_ALIGN, ARENA_ALIGN + padded);
+    if (!block) return NULL;
+    block->next_free = NULL;
+    block->size_class = size_class;
+    if (owned_insert(arena, block) != 0) {
+        free(block);
+        return NULL;
+    }
+    return block;
+}
+
+static inline void* block_data(ArenaBlock* block) {
+    return (char*)block + ARENA_ALIGN;
+}
+
+// The block address a buffer would have, computed without dereferencing
+static inline uintptr_t data_address(const void* buffer) {
+    return (uintptr_t)buffer - ARENA_ALIGN;
+}
+
+// ============================================================================
+// Arena Lifecycle
+// ============================================================================
+
+int obivox_arena_create(
+    const OBIVoxArenaSlab* slabs,
+    uint32_t slab_count,
+    OBIVoxArena** arena) {
+
+    if (!arena) return -1;
+
+    OBIVoxArena* a = calloc(1, sizeof(OBIVoxArena));
+    if (!a) return -1;
+
+    for (uint32_t c = 0; c < ARENA_CLASSES; c++) {
+        pthread_mutex_init(&a->classes[c].lock, NULL);
+    }
+    pthread_mutex_init(&a->oversize_lock, NULL);
+    pthread_mutex_init(&a->owned_lock, NULL);
+
+    if (!slabs) {
+        slabs = default_slabs;
+        slab_count = sizeof(default_slabs) / sizeof(default_slabs[0]);
+    }
+
+    // Pre-size each class so steady state never grows
+    for (uint32_t s = 0; s < slab_count; s++) {
+        uint32_t c = size_class_for(slabs[s].bytes);
+        if (c == ARENA_OVERSIZE) {
+            obivox_arena_destroy(a);
+            return -1;
+        }
+        ArenaClass* cls = &a->classes[c];
+        size_t bytes = (size_t)1 << (c + ARENA_MIN_SHIFT);
+        for (uint32_t i = 0; i < slabs[s].count; i++) {
+            ArenaBlock* block = block_alloc(a, c, bytes);
+            if (!block) {
+                obivox_arena_destroy(a);
+                return -1;
+            }
+            block->next_free = cls->free_list;
+            cls->free_list = block;
+            cls->blocks++;
+        }
+    }
+
+    *arena = a;
+    return 0;
+}
+
+void obivox_arena_destroy(OBIVoxArena* arena) {
+    if (!arena) return;
+
+    // Slab and oversize blocks alike, recycled or not
+    for (uint32_t i = 0; i < arena->owned_capacity; i++) {
+        ArenaBlock* block = (ArenaBlock*)arena->owned[i];
+        if (!block) continue;
+        free(block);
+    }
+    for (uint32_t c = 0; c < ARENA_CLASSES; c++) {
+        pthread_mutex_destroy(&arena->classes[c].lock);
+    }
+    pthread_mutex_destroy(&arena->owned_lock);
+    pthread_mutex_destroy(&arena->oversize_lock);
+    free(arena->owned);
+    free(arena);
+}
+
+// ============================================================================
+// Acquire / Recycle
+// ============================================================================
+
+void* obivox_arena_acquire(OBIVoxArena* arena, size_t bytes) {
+    if (!arena) return NULL;
+    if (bytes == 0) bytes = 1;
+
+    uint32_t c = size_class_for(bytes);
+    if (c == ARENA_OVERSIZE) {
+        ArenaBlock* block = block_alloc(arena, ARENA_OVERSIZE, bytes);
+        if (!block) return NULL;
+        pthread_mutex_lock(&arena->oversize_lock);
+        arena->oversize++;
+        pthread_mutex_unlock(&arena->oversize_lock);
+        return block_data(block);
+    }
+
+    ArenaClass* cls = &arena->classes[c];
+    pthread_mutex_lock(&cls->lock);
+    ArenaBlock* block = cls->free_list;
+    if (block) {
+        cls->free_list = block->next_free;
+    } else {
+        // Slow path: grow the class, the block stays owned afterwards
+        block = block_alloc(arena, c, (size_t)1 << (c + ARENA_MIN_SHIFT));
+        if (block) {
+            cls->blocks++;
+            cls->misses++;
+        }
+    }
+    if (block) cls->acquired++;
+    pthread_mutex_unlock(&cls->lock);
+
+    return block ? block_data(block) : NULL;
+}
+
+void* obivox_arena_acquire_zeroed(OBIVoxArena* arena, size_t bytes) {
+    void* buffer = obivox_arena_acquire(arena, bytes);
+    if (buffer) memset(buffer, 0, bytes);
+    return buffer;
+}
+
+bool obivox_arena_owns(const OBIVoxArena* arena, const void* buffer) {
+    if (!arena || !buffer) return false;
+    OBIVoxArena* a = (OBIVoxArena*)arena;
+    pthread_mutex_lock(&a->owned_lock);
+    bool owned = owned_find(a, data_address(buffer)) < a->owned_capacity;
+    pthread_mutex_unlock(&a->owned_lock);
+    return owned;
+}
+
+int obivox_arena_recycle(OBIVoxArena* arena, void* buffer) {
+    if (!arena || !buffer) return -1;
+
+    // Only a buffer found in the set has a header to read
+    uintptr_t address = data_address(buffer);
+    pthread_mutex_lock(&arena->owned_lock);
+    uint32_t slot = owned_find(arena, address);
+    if (slot == arena->owned_capacity) {
+        pthread_mutex_unlock(&arena->owned_lock);
+        return 1;
+    }
+    ArenaBlock* block = (ArenaBlock*)address;
+    bool oversize = block->size_class == ARENA_OVERSIZE;
+    if (oversize) owned_remove_slot(arena, slot);
+    pthread_mutex_unlock(&arena->owned_lock);
+
+    if (oversize) {
+        free(block);
+        return 0;
+    }
+
+    ArenaClass* cls = &arena->classes[block->size_class];
+    pthread_mutex_lock(&cls->lock);
+    block->next_free = cls->free_list;
+    cls->free_list = block;
+    cls->recycled++;
+    pthread_mutex_unlock(&cls->lock);
+    return 0;
+}
+
+void obivox_arena_stats(const OBIVoxArena* arena, OBIVoxArenaStats* stats) {
+    if (!arena || !stats) return;
+    memset(stats, 0, sizeof(*stats));
+
+    OBIVoxArena* a = (OBIVoxArena*)arena;
+    for (uint32_t c = 0; c < ARENA_CLASSES; c++) {
+        ArenaClass* cls = &a->classes[c];
+        pthread_mutex_lock(&cls->lock);
+        stats->acquired += cls->acquired;
+        stats->recycled += cls->recycled;
+        stats->slab_misses += cls->misses;
+        stats->bytes_reserved += cls->blocks * ((size_t)1 << (c + ARENA_MIN_SHIFT));
+        pthread_mutex_unlock(&cls->lock);
+    }
+    pthread_mutex_lock(&a->oversize_lock);
+    stats->oversize = a->oversize;
+    pthread_mutex_unlock(&a->oversize_lock);
+}
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+int obivox_nlm_attach_arena(OBIVoxNLMSystem* system, OBIVoxArena* arena) {
+    if (!system) return -1;
+    system->arena = arena;
+    return 0;
+}
+
+// Arena buffers go back to their class; anything else came from the heap
+static void release_buffer(OBIVoxArena* arena, void* buffer) {
+    if (!buffer) return;
+    if (obivox_arena_recycle(arena, buffer) != 0) free(buffer);
+}
+
+void obivox_release_output(OBIVoxNLMSystem* system, void* output) {
+    release_buffer(system ? system->arena : NULL, output);
+}
+
+void obivox_release_human_feedback(OBIVoxArena* arena, HumanFeedback* feedback) {
+    if (!feedback) return;
+    release_buffer(arena, feedback->suggested_correction);
+    release_buffer(arena, feedback->original_interpretation);
+    feedback->suggested_correction = NULL;
+    feedback->original_interpretation = NULL;
+}
@@ -5,10 +5,31 @@
  */
 
 #include "obivox/nlm/framework.h"
+#include "obivox/nlm_variation.h"
+#include "obivox/nlm_arena.h"
+#include "obivox/nlm_atlas.h"
+#include "obivox/nlm_ffmpeg.h"
+#include "obivox/nlm_features.h"
+#include "obivox/nlm_denoise.h"
+#include "obivox/nlm_vad.h"
+#include "obivox/nlm_drift.h"
+#include "obivox/nlm_validation.h"
+#include "obivox/nlm_feedback.h"
+#include "obivox/nlm_models.h"
+#include "obivox/nlm_batch.h"
+#include "obivox/nlm_codec.h"
+#include "obivox/nlm_speculate.h"
+#include "obivox/nlm_cache.h"
+#include "obivox/nlm_lexicon.h"
+#include "obivox/nlm_metrics.h"
+#include "obivox/nlm_plugin.h"
+#include "core/nlm_internal.h"
+#include "dsp/obivox_kernels.h"
 #include <libavformat/avformat.h>
 #include <libavcodec/avcodec.h>
 #include <libswresample/swresample.h>
 #include <math.h>
+#include <pthread.h>
 #include <string.h>
 
 // ============================================================================
@@ -35,31 +56,120 @@ int obivox_nlm_init(OBIVoxNLMSystem** system) {
     sys->accessibility.stutter_detection = true;
     sys->accessibility.accent_normalization = false;  // Preserve by default
     sys->accessibility.variation_tolerance = 0.7f;
+    sys->accessibility.normalization_mode = NORMALIZATION_BOX_FILTER;
     sys->accessibility.phenomenological_integrity = 0.95f;
     sys->accessibility.experiential_authenticity = 0.95f;
     
     // Initialize NLM-Atlas tree as hybrid mode
     sys->current_tree_mode = TREE_MODE_HYBRID;
     sys->service_tree = NULL;
+    if (obivox_atlas_create(TREE_MODE_HYBRID, &sys->atlas) != 0) goto fail;
     
     // Initialize FFmpeg
     av_register_all();
     
-    // Setup codec engine
+    // Setup codec engine; backends register with sys->models and load
+    // once, at registration (preload) or on first acquire
     sys->codec_engine.active_codec = CODEC_ADAPTIVE;
+    sys->codec_engine.selected_codec = CODEC_WHISPER;
     sys->codec_engine.last_confidence = 0.0f;
+    if (obivox_codec_costs_create(sys->atlas, &sys->codec_engine.costs) != 0) goto fail;
+    if (obivox_models_create(&sys->models) != 0) goto fail;
+    
+    // Whisper requests from every session share micro-batches once a
+    // backend with run_batch registers; tune with obivox_batcher_configure
+    if (obivox_batcher_create(sys->models, NULL, &sys->codec_engine.whisper_batcher) != 0) {
+        goto fail;
+    }
+    
+    // Built-in G2P table, built once per process; attach a larger one
+    // with obivox_nlm_attach_lexicon
+    obivox_lexicon_default();
     
     // Enable fault tolerance
     sys->fault_tolerance_enabled = true;
     sys->recovery_attempts = 0;
     
+    // Silence is cut before any other STT stage sees the audio
+    if (obivox_vad_create(NULL, &sys->vad) != 0) goto fail;
+    
+    // Variation engine reused by every STT request (FFT plan + frames)
+    if (obivox_variation_engine_create(NULL, &sys->variation_engine) != 0) goto fail;
+    
+    // Stage-3 features over the system's pool; inline until
+    // obivox_nlm_attach_pool gives it one
+    if (obivox_feature_extractor_create(NULL, sys->pool, &sys->feature_extractor) != 0) {
+        goto fail;
+    }
+    
+    // Stage-2 denoiser; one stream per request, latency compensated
+    if (obivox_denoiser_create(NULL, &sys->denoiser) != 0) goto fail;
+    
     return 0;
+    
+fail:
+    obivox_nlm_destroy(sys);
+    *system = NULL;
+    return -1;
+}
+
+void obivox_nlm_destroy(OBIVoxNLMSystem* system) {
+    if (!system) return;
+    obivox_models_unbind(system->models, &system->codec_engine);
+    obivox_batcher_destroy(system->codec_engine.whisper_batcher);
+    obivox_models_destroy(system->models);
+    obivox_codec_costs_destroy(system->codec_engine.costs);
+    obivox_drift_monitor_destroy(system->drift_monitor);
+    obivox_denoiser_destroy(system->denoiser);
+    obivox_feature_extractor_destroy(system->feature_extractor);
+    obivox_variation_engine_destroy(system->variation_engine);
+    obivox_vad_destroy(system->vad);
+    obivox_atlas_destroy(system->atlas);
+    free(system);
+}
+
+// Output buffers come from the attached arena when there is one
+static void* system_acquire(OBIVoxNLMSystem* system, size_t bytes, bool zeroed) {
+    if (system->arena) {
+        return zeroed ? obivox_arena_acquire_zeroed(system->arena, bytes)
+                      : obivox_arena_acquire(system->arena, bytes);
+    }
+    return zeroed ? calloc(1, bytes) : malloc(bytes);
 }
 
 // ============================================================================
 // Speech Variation Detection & Normalization
 // ============================================================================
 
+// One engine per calling thread, created on first use and released at
+// thread exit, so repeated calls reuse the FFT plan and frame buffers
+static pthread_once_t variation_once = PTHREAD_ONCE_INIT;
+static pthread_key_t variation_key;
+static _Thread_local OBIVoxVariationEngine* thread_variation;
+
+static void variation_release(void* engine) {
+    obivox_variation_engine_destroy(engine);
+}
+
+static void variation_key_create(void) {
+    pthread_key_create(&variation_key, variation_release);
+}
+
+static OBIVoxVariationEngine* variation_engine(void) {
+    if (thread_variation) return thread_variation;
+    pthread_once(&variation_once, variation_key_create);
+    
+    // Default config: the pipeline rate
+    OBIVoxVariationEngine* engine = NULL;
+    if (obivox_variation_engine_create(NULL, &engine) != 0) return NULL;
+    if (pthread_setspecific(variation_key, engine) != 0) {
+        obivox_variation_engine_destroy(engine);
+        return NULL;
+    }
+    thread_variation = engine;
+    return engine;
+}
+
 int obivox_detect_speech_variations(
     const float* audio,
     uint32_t num_samples,
@@ -68,53 +178,81 @@ int obivox_detect_speech_variations(
     
     if (!audio || !accessibility || !variation_score) return -1;
     
-    // Analyze spectral characteristics for speech variations
-    float spectral_centroid = 0.0f;
-    float spectral_rolloff = 0.0f;
-    float zero_crossing_rate = 0.0f;
+    OBIVoxVariationEngine* engine = variation_engine();
+    if (!engine) return -1;
+    
+    return obivox_variation_engine_analyze(
+        engine,
+        audio,
+        num_samples,
+        accessibility,
+        NULL,
+        variation_score
+    );
+}
+
+// Stutter smoother: centred window of SMOOTH_WINDOW + 1 taps, scaled by
+// 1 / SMOOTH_WINDOW, applied to samples [SMOOTH_WINDOW, n - SMOOTH_WINDOW)
+#define SMOOTH_WINDOW      512
+#define SMOOTH_HALF        (SMOOTH_WINDOW / 2)
+
+// Output block for the box filter - block plus context stays in L1/L2
+#define SMOOTH_BLOCK       2048
+
+static void smooth_stutter_legacy(
+    float* audio,
+    uint32_t num_samples,
+    float preservation_factor) {
     
-    // Calculate zero crossing rate (indicator of fricatives affected by lisp)
-    for (uint32_t i = 1; i < num_samples; i++) {
-        if ((audio[i] > 0) != (audio[i-1] > 0)) {
-            zero_crossing_rate += 1.0f;
+    const int smooth_window = SMOOTH_WINDOW;
+    for (uint32_t i = smooth_window; i < num_samples - smooth_window; i++) {
+        float avg = 0.0f;
+        for (int j = -smooth_window/2; j <= smooth_window/2; j++) {
+            avg += audio[i + j];
         }
+        avg /= smooth_window;
+        
+        // Blend original with smoothed based on preservation factor
+        audio[i] = (audio[i] * preservation_factor) + 
+                  (avg * (1.0f - preservation_factor));
     }
-    zero_crossing_rate /= num_samples;
+}
+
+static void smooth_stutter_box(
+    float* audio,
+    uint32_t num_samples,
+    float preservation_factor) {
     
-    // High ZCR in fricatives may indicate lisp
-    if (zero_crossing_rate > 0.4f) {
-        accessibility->lisp_mitigation = true;
-    }
+    // Unmodified samples for one block plus SMOOTH_HALF either side, so
+    // every output reads only original input regardless of write order
+    float window[SMOOTH_HALF + SMOOTH_BLOCK + SMOOTH_HALF];
+    float* block = window + SMOOTH_HALF;
+    const uint32_t end = num_samples - SMOOTH_WINDOW;
+    const float wet = (1.0f - preservation_factor) / SMOOTH_WINDOW;
     
-    // Detect stuttering patterns (repeated onsets)
-    float repetition_score = 0.0f;
-    const int window_size = 1024;
-    for (uint32_t i = window_size; i < num_samples - window_size; i += window_size/2) {
-        float correlation = 0.0f;
-        for (int j = 0; j < window_size; j++) {
-            correlation += audio[i+j] * audio[i-window_size+j];
+    memcpy(window, audio + SMOOTH_WINDOW - SMOOTH_HALF, SMOOTH_HALF * sizeof(float));
+    
+    for (uint32_t start = SMOOTH_WINDOW; start < end; start += SMOOTH_BLOCK) {
+        uint32_t len = end - start < SMOOTH_BLOCK ? end - start : SMOOTH_BLOCK;
+        
+        // Right context is never written before its block, so it is
+        // still original; left context was carried from the last block
+        memcpy(block, audio + start, (len + SMOOTH_HALF) * sizeof(float));
+        
+        // Re-seed the running sum per block to bound rounding drift
+        double sum = 0.0;
+        for (int j = -SMOOTH_HALF; j <= SMOOTH_HALF; j++) {
+            sum += block[j];
         }
-        if (correlation > 0.8f) {
-            repetition_score += 1.0f;
+        
+        for (uint32_t i = 0; ; i++) {
+            audio[start + i] = (block[i] * preservation_factor) + ((float)sum * wet);
+            if (i + 1 == len) break;
+            sum += (double)block[i + SMOOTH_HALF + 1] - block[(int)i - SMOOTH_HALF];
         }
+        
+        memmove(window, block + len - SMOOTH_HALF, SMOOTH_HALF * sizeof(float));
     }
-    
-    if (repetition_score > 3.0f) {
-        accessibility->stutter_detection = true;
-    }
-    
-    // Calculate overall variation score
-    *variation_score = (zero_crossing_rate * 0.3f) + 
-                      (repetition_score * 0.1f) + 
-                      (accessibility->variation_tolerance * 0.6f);
-    
-    // Preserve phenomenological integrity
-    if (*variation_score > 0.5f && accessibility->phenomenological_integrity > 0.9f) {
-        // High variation but high integrity - preserve speaker identity
-        accessibility->accent_normalization = false;
-    }
-    
-    return 0;
 }
 
 int obivox_apply_phonetic_normalization(
@@ -129,28 +267,24 @@ int obivox_apply_phonetic_normalization(
     if (accessibility->lisp_mitigation && preservation_factor < 1.0f) {
         // Spectral modification for fricative correction
         // This is simplified - real implementation would use FFT
-        for (uint32_t i = 0; i < num_samples; i++) {
-            // Gentle high-frequency adjustment
-            if (i > 0) {
-                float diff = audio[i] - audio[i-1];
-                audio[i] = audio[i] - (diff * 0.2f * (1.0f - preservation_factor));
-            }
+        // Gentle high-frequency adjustment, first sample passes through
+        if (num_samples > 1) {
+            obivox_kernels()->lisp_filter(
+                audio + 1,
+                num_samples - 1,
+                0.2f * (1.0f - preservation_factor),
+                audio[0]
+            );
         }
     }
     
-    if (accessibility->stutter_detection && preservation_factor < 1.0f) {
+    if (accessibility->stutter_detection && preservation_factor < 1.0f &&
+        num_samples > 2 * SMOOTH_WINDOW) {
         // Smooth out repetitions while preserving content
-        const int smooth_window = 512;
-        for (uint32_t i = smooth_window; i < num_samples - smooth_window; i++) {
-            float avg = 0.0f;
-            for (int j = -smooth_window/2; j <= smooth_window/2; j++) {
-                avg += audio[i + j];
-            }
-            avg /= smooth_window;
-            
-            // Blend original with smoothed based on preservation factor
-            audio[i] = (audio[i] * preservation_factor) + 
-                      (avg * (1.0f - preservation_factor));
+        if (accessibility->normalization_mode == NORMALIZATION_LEGACY) {
+            smooth_stutter_legacy(audio, num_samples, preservation_factor);
+        } else {
+            smooth_stutter_box(audio, num_samples, preservation_factor);
         }
     }
     
@@ -169,37 +303,58 @@ int obivox_map_to_nlm_space(
     
     // Map acoustic features to XYZ coordinates
     
-    // X-axis: Coherence spectrum (fictional to factual)
-    // Based on pitch stability and energy distribution
-    float pitch_variance = 0.0f;
-    for (int i = 1; i < 256; i++) {
-        float diff = features->pitch_contour[i] - features->pitch_contour[i-1];
-        pitch_variance += diff * diff;
+    uint32_t frames = features->contour_frames;
+    uint32_t counted = features->contour_stats_frames;
+    if (counted > frames) counted = frames;
+    if (frames > 0 && (!features->pitch_contour || !features->energy_envelope)) return -1;
+    
+    // Fold in only the frames the producer has not summed yet; the pitch
+    // step into the first new frame needs the frame before it
+    double pitch_steps = counted > 0 ? features->pitch_step_sum : 0.0;
+    double energy_total = counted > 0 ? features->energy_sum : 0.0;
+    if (frames > counted) {
+        const OBIVoxKernels* kernels = obivox_kernels();
+        uint32_t from = counted > 0 ? counted - 1 : 0;
+        pitch_steps += kernels->diff_energy(features->pitch_contour + from, frames - from);
+        energy_total += kernels->sum(features->energy_envelope + counted, frames - counted);
     }
-    pitch_variance /= 256.0f;
     
-    // Low variance = more factual, high variance = more expressive/fictional
-    coordinates->x_axis = 1.0f - (2.0f * tanhf(pitch_variance));
+    // X-axis: Coherence spectrum (fictional to factual)
+    // Based on pitch stability and energy distribution
+    float pitch_variance = frames > 1 ? (float)(pitch_steps / (frames - 1)) : 0.0f;
     
     // Y-axis: Reasoning formality (informal to formal)
     // Based on speaking rate and pause patterns
-    float energy_mean = 0.0f;
-    for (int i = 0; i < 256; i++) {
-        energy_mean += features->energy_envelope[i];
-    }
-    energy_mean /= 256.0f;
+    float energy_mean = frames > 0 ? (float)(energy_total / frames) : 0.0f;
+    
+    obivox_nlm_coordinate_from_stats(
+        pitch_variance,
+        energy_mean,
+        features->variations.variation_score,
+        coordinates
+    );
+    
+    return 0;
+}
+
+void obivox_nlm_coordinate_from_stats(
+    float pitch_variance,
+    float energy_mean,
+    float variation_score,
+    NLMCoordinate* coordinates) {
+    
+    // Low variance = more factual, high variance = more expressive/fictional
+    coordinates->x_axis = 1.0f - (2.0f * tanhf(pitch_variance));
     
     // Higher energy consistency = more formal
     coordinates->y_axis = tanhf(energy_mean * 2.0f);
     
     // Z-axis: Conceptual evolution
     // Based on detected variations and adaptations
-    coordinates->z_axis = features->variations.variation_score;
+    coordinates->z_axis = variation_score;
     
     // Calculate confidence based on all factors
-    coordinates->confidence = 0.954f * (1.0f - features->variations.variation_score * 0.1f);
-    
-    return 0;
+    coordinates->confidence = 0.954f * (1.0f - variation_score * 0.1f);
 }
 
 // ============================================================================
@@ -209,95 +364,396 @@ int obivox_map_to_nlm_space(
 int obivox_bidirectional_convert(
     OBIVoxNLMSystem* system,
     const void* input,
-    enum { INPUT_AUDIO, INPUT_TEXT } input_type,
+    OBIVoxInputType input_type,
     void** output,
     float* confidence) {
     
-    if (!system || !input || !output || !confidence) return -1;
+    return obivox_bidirectional_convert_sized(system, input, 0, input_type, output, confidence);
+}
+
+#define STT_OUTPUT_BYTES  4096
+#define TTS_OUTPUT_BYTES  (16000 * 10 * sizeof(float))  // 10 seconds
+
+// Serve a repeated input from the cache into a fresh output buffer
+static int convert_from_cache(
+    OBIVoxNLMSystem* system,
+    const OBIVoxCacheKey* key,
+    OBIVoxInputType input_type,
+    void** output,
+    float* confidence) {
+    
+    bool audio_out = input_type == INPUT_TEXT;
+    size_t capacity = audio_out ? TTS_OUTPUT_BYTES : STT_OUTPUT_BYTES;
+    void* buffer = system_acquire(system, capacity, audio_out);
+    if (!buffer) return -1;
     
-    // Check for data drift
-    if (system->drift_magnitude > 0.3f) {
-        // Activate OBIAI cascade
-        bool should_cascade = false;
-        obivox_handle_drift(system, system->drift_magnitude, &should_cascade);
+    size_t size = 0;
+    if (obivox_cache_get(system->cache, key, buffer, capacity, &size, confidence) != 1) {
+        obivox_release_output(system, buffer);
+        return 0;
+    }
+    
+    *output = buffer;
+    system->codec_engine.last_confidence = *confidence;
+    return 1;
+}
+
+// PCM is stored without its trailing silence and transcripts with their
+// terminator, so cached entries cost what was produced, not the buffer
+static void convert_to_cache(
+    OBIVoxNLMSystem* system,
+    const OBIVoxCacheKey* key,
+    OBIVoxInputType input_type,
+    const void* output,
+    float confidence) {
+    
+    size_t size;
+    if (input_type == INPUT_TEXT) {
+        const float* pcm = output;
+        size_t samples = TTS_OUTPUT_BYTES / sizeof(float);
+        while (samples > 0 && pcm[samples - 1] == 0.0f) samples--;
+        size = samples * sizeof(float);
+    } else {
+        size = strnlen(output, STT_OUTPUT_BYTES - 1) + 1;
+    }
+    obivox_cache_put(system->cache, key, output, size, confidence);
+}
+
+size_t obivox_synthesize_phoneme(
+    const char* phoneme,
+    size_t length,
+    bool marked,
+    float* audio,
+    size_t capacity) {
+    
+    bool vowel = strchr("AEIOU", phoneme[0]) != NULL;
+    bool sibilant = (length == 1 && (phoneme[0] == 'S' || phoneme[0] == 'Z')) ||
+                    (length == 2 && (phoneme[1] == 'H' && strchr("SZCTD", phoneme[0]))) ||
+                    (length == 2 && phoneme[0] == 'J' && phoneme[1] == 'H');
+    float frequency = vowel ? 440.0f : 330.0f;
+    float amplitude = vowel ? 0.1f : (marked && sibilant ? 0.02f : 0.05f);
+    size_t samples = OBIVOX_SYNTH_PHONEME < capacity ? OBIVOX_SYNTH_PHONEME : capacity;
+    for (size_t i = 0; i < samples; i++) {
+        audio[i] = sinf(2.0f * M_PI * frequency * i / OBIVOX_SYNTH_SAMPLE_RATE) * amplitude;
+    }
+    return samples;
+}
+
+// Synthesize speech (simplified): one tone per guide phoneme, with the
+// sibilants of '*' words softened; without a guide, one second of tone.
+// Real implementation would use Coqui TTS or similar
+static size_t synthesize_placeholder(const char* guide, float* audio, size_t capacity) {
+    if (!guide) {
+        size_t samples = OBIVOX_SYNTH_SAMPLE_RATE < capacity ? OBIVOX_SYNTH_SAMPLE_RATE : capacity;
+        for (size_t i = 0; i < samples; i++) {
+            audio[i] = sinf(2.0f * M_PI * 440.0f * i / OBIVOX_SYNTH_SAMPLE_RATE) * 0.1f;
+        }
+        return samples;
+    }
+    
+    size_t at = 0;
+    const char* line = guide;
+    while (*line && at < capacity) {
+        bool marked = *line == '*';
+        const char* phonemes = strchr(line, '\t');
+        const char* end = strchr(line, '\n');
+        if (!phonemes || !end) break;
         
-        if (should_cascade && system->recovery_attempts < 3) {
-            // Attempt self-healing
-            system->recovery_attempts++;
-            system->fault_tolerance_enabled = true;
+        for (const char* p = phonemes + 1; p < end && at < capacity;) {
+            size_t n = strcspn(p, " \n");
+            at += obivox_synthesize_phoneme(p, n, marked, audio + at, capacity - at);
+            p += n;
+            if (*p == ' ') p++;
         }
+        at += OBIVOX_SYNTH_WORD_GAP;
+        line = end + 1;
     }
+    return at < capacity ? at : capacity;
+}
+
+// Stage spans read the clock only with metrics attached
+static inline uint64_t span_begin(OBIVoxMetrics* metrics) {
+    return metrics ? obivox_metrics_now() : 0;
+}
+
+static inline void span_end(OBIVoxMetrics* metrics, OBIVoxStage stage, uint64_t start) {
+    if (metrics) obivox_metrics_span_end(metrics, stage, start);
+}
+
+// STT stages over the voiced part of the input only
+static int convert_speech(
+    OBIVoxNLMSystem* system,
+    const void* input,
+    size_t input_size,
+    void** output,
+    float* confidence) {
     
-    int result = 0;
+    OBIVoxMetrics* metrics = system->metrics;
+    uint64_t span;
+    const float* audio = input;
+    uint32_t num_samples = (uint32_t)(input_size / sizeof(float));
+    obivox_metrics_add(metrics, OBIVOX_COUNTER_SAMPLES_IN, num_samples);
+    
+    // Voice activity first, so silence never reaches variation detection,
+    // the denoiser or the codec
+    const OBIVoxSpeechSegment* segments = NULL;
+    uint32_t num_segments = 0;
+    span = span_begin(metrics);
+    int segmented = obivox_vad_segment(system->vad, audio, num_samples, &segments, &num_segments);
+    span_end(metrics, OBIVOX_STAGE_VAD, span);
+    if (segmented != 0) return -1;
+    
+    uint64_t voiced = 0;
+    for (uint32_t i = 0; i < num_segments; i++) {
+        voiced += segments[i].end_sample - segments[i].start_sample;
+    }
+    obivox_metrics_add(metrics, OBIVOX_COUNTER_SAMPLES_VOICED, voiced);
     
-    if (input_type == INPUT_AUDIO) {
-        // Audio to Text (STT)
-        AudioFeatures features = {0};
-        features.raw_audio = (float*)input;
-        features.sample_rate = 16000;  // Standard rate
-        
-        // Detect speech variations
-        float variation_score = 0.0f;
-        obivox_detect_speech_variations(
+    // Nothing voiced: an empty transcript, and no position, drift or
+    // validation update from audio that held no speech
+    if (voiced == 0) {
+        char* transcription = system_acquire(system, STT_OUTPUT_BYTES, true);
+        if (!transcription) return -1;
+        *output = transcription;
+        *confidence = system->current_position.confidence;
+        return 0;
+    }
+    
+    // Segments, padding included, are joined into a scratch buffer that
+    // denoising and normalization may rewrite; the caller's audio stays
+    // as it was passed
+    AudioFeatures features = {0};
+    features.sample_rate = 16000;  // Standard rate
+    features.num_samples = (uint32_t)voiced;
+    features.raw_audio = system_acquire(system, voiced * sizeof(float), false);
+    if (!features.raw_audio) return -1;
+    
+    float* at = features.raw_audio;
+    for (uint32_t i = 0; i < num_segments; i++) {
+        size_t length = segments[i].end_sample - segments[i].start_sample;
+        memcpy(at, audio + segments[i].start_sample, length * sizeof(float));
+        at += length;
+    }
+    
+    // Detect speech variations
+    float variation_score = 0.0f;
+    span = span_begin(metrics);
+    obivox_variation_engine_analyze(
+        system->variation_engine,
+        features.raw_audio,
+        features.num_samples,
+        &system->accessibility,
+        NULL,
+        &variation_score
+    );
+    span_end(metrics, OBIVOX_STAGE_VARIATION, span);
+    
+    // Noise reduction, with the fricative correction folded into the
+    // same spectral pass when normalization applies (preserve 70%)
+    bool normalize = variation_score > 0.5f;
+    span = span_begin(metrics);
+    obivox_denoiser_set_lisp_shaping(
+        system->denoiser,
+        normalize && system->accessibility.lisp_mitigation ? 0.2f * (1.0f - 0.7f) : 0.0f
+    );
+    obivox_denoise_buffer(system->denoiser, features.raw_audio, features.num_samples);
+    span_end(metrics, OBIVOX_STAGE_DENOISE, span);
+    
+    // Apply normalization if needed
+    if (normalize) {
+        PhoneticAccessibility time_domain = system->accessibility;
+        time_domain.lisp_mitigation = false;  // Done in the spectral pass
+        span = span_begin(metrics);
+        obivox_apply_phonetic_normalization(
             features.raw_audio,
             features.num_samples,
-            &system->accessibility,
-            &variation_score
+            &time_domain,
+            0.7f  // preservation_factor
         );
+        span_end(metrics, OBIVOX_STAGE_NORMALIZATION, span);
+    }
+    
+    // Stage-3 pitch, energy and MFCC so the mapping sees real contours
+    span = span_begin(metrics);
+    obivox_feature_extract(system->feature_extractor, &features, NULL);
+    span_end(metrics, OBIVOX_STAGE_FEATURES, span);
+    
+    // Map to NLM space
+    span = span_begin(metrics);
+    obivox_map_to_nlm_space(&features, &system->current_position);
+    span_end(metrics, OBIVOX_STAGE_MAPPING, span);
+    
+    // Select optimal codec based on tree mode
+    TreeMode suggested_mode;
+    span = span_begin(metrics);
+    obivox_select_optimal_codec(system, &system->current_position, &suggested_mode);
+    span_end(metrics, OBIVOX_STAGE_CODEC_SELECT, span);
+    
+    char* transcription = system_acquire(system, STT_OUTPUT_BYTES, false);
+    if (!transcription) {
+        obivox_release_output(system, features.raw_audio);
+        return -1;
+    }
+    *output = transcription;
+    *confidence = system->current_position.confidence;
+    
+    CodecEngine* codecs = &system->codec_engine;
+    int codec = codecs->active_codec == CODEC_ADAPTIVE ?
+        codecs->selected_codec : (int)codecs->active_codec;
+    double audio_seconds = (double)features.num_samples / features.sample_rate;
+    float difficulty = obivox_codec_difficulty(&system->current_position);
+    OBIVoxBatchItem item = {
+        .audio = features.raw_audio,
+        .num_samples = features.num_samples,
+        .sample_rate = features.sample_rate,
+        .text = transcription,
+        .text_capacity = STT_OUTPUT_BYTES
+    };
+    OBIVoxSpeculateResult race;
+    uint64_t start = obivox_now_ns();
+    
+    // Adaptive with a speculator races a fast and a slow codec (a
+    // confident fast transcript cancels the slow one); whisper otherwise
+    // runs batched with other sessions' utterances
+    if (codecs->active_codec == CODEC_ADAPTIVE && codecs->speculator &&
+        obivox_speculate_run(codecs->speculator, features.raw_audio,
+                             features.num_samples, features.sample_rate,
+                             transcription, STT_OUTPUT_BYTES, &race) == 0) {
+        *confidence = race.confidence;
+        codecs->selected_codec = race.codec;
+        codecs->processing_time_ns = race.total_ns;
         
-        // Apply normalization if needed
-        if (variation_score > 0.5f) {
-            // Preserve 70% of original characteristics
-            obivox_apply_phonetic_normalization(
-                features.raw_audio,
-                features.num_samples,
-                &system->accessibility,
-                0.7f  // preservation_factor
-            );
-        }
-        
-        // Map to NLM space
-        obivox_map_to_nlm_space(&features, &system->current_position);
-        
-        // Select optimal codec based on tree mode
-        TreeMode suggested_mode;
-        obivox_select_optimal_codec(system, &system->current_position, &suggested_mode);
-        
-        // Perform transcription (simplified - would use actual codec)
-        char* transcription = calloc(4096, 1);
+        // The winning codec's own decode time trains the cost model
+        obivox_codec_record(
+            codecs->costs,
+            race.codec,
+            difficulty,
+            race.codec == race.slow_codec ? race.slow_ns : race.fast_ns,
+            audio_seconds,
+            race.confidence
+        );
+    } else if (codec == CODEC_WHISPER &&
+        obivox_batcher_submit(codecs->whisper_batcher, &item) == 0) {
+        *confidence = item.confidence;
+        codecs->processing_time_ns = obivox_now_ns() - start;
+        obivox_codec_record(
+            codecs->costs,
+            codec,
+            difficulty,
+            codecs->processing_time_ns,
+            audio_seconds,
+            item.confidence
+        );
+    } else {
+        // Perform transcription (simplified - would use actual codec);
+        // only real inference trains the cost model
         strcpy(transcription, "Transcribed text with variation handling");
-        
-        *output = transcription;
-        *confidence = system->current_position.confidence;
-        
+        codecs->processing_time_ns = obivox_now_ns() - start;
+    }
+    obivox_metrics_record(metrics, OBIVOX_STAGE_CODEC, codecs->processing_time_ns);
+    if (metrics) {
+        obivox_metrics_add(metrics, OBIVOX_COUNTER_TEXT_BYTES_OUT,
+                           strnlen(transcription, STT_OUTPUT_BYTES));
+    }
+    obivox_release_output(system, features.raw_audio);
+    
+    // Position plus the codec's own confidence; tree mode and cascade
+    // change only when the drift zone does
+    if (system->drift_monitor) {
+        NLMCoordinate observed = system->current_position;
+        observed.confidence = *confidence;
+        span = span_begin(metrics);
+        obivox_nlm_observe_drift(system, &observed);
+        span_end(metrics, OBIVOX_STAGE_DRIFT, span);
+    }
+    
+    // Low-confidence results, and every result while drift sits in the
+    // human stress zone (this one included), go out provisional;
+    // reviewers answer later
+    if (system->validation) {
+        bool human_stress = obivox_nlm_drift_zone(system) == OBIVOX_DRIFT_HUMAN_STRESS;
+        obivox_validation_submit(system->validation, transcription, *confidence,
+                                 human_stress, &system->validation_ticket);
+    }
+    
+    return 0;
+}
+
+static int convert_stages(
+    OBIVoxNLMSystem* system,
+    const void* input,
+    size_t input_size,
+    OBIVoxInputType input_type,
+    void** output,
+    float* confidence) {
+    
+    OBIVoxMetrics* metrics = system->metrics;
+    uint64_t span;
+    system->validation_ticket = 0;
+    
+    // Hits skip analysis, so the NLM position keeps its previous value
+    OBIVoxCacheKey key;
+    bool cacheable = system->cache && input_size > 0;
+    if (cacheable) {
+        span = span_begin(metrics);
+        obivox_cache_key(system, input, input_size, input_type, &key);
+        int hit = convert_from_cache(system, &key, input_type, output, confidence);
+        span_end(metrics, OBIVOX_STAGE_CACHE, span);
+        if (hit > 0) obivox_metrics_add(metrics, OBIVOX_COUNTER_CACHE_HITS, 1);
+        if (hit != 0) return hit < 0 ? -1 : 0;
+    }
+    
+    // Check for data drift set by the caller; a monitor instead acts on
+    // zone changes as STT results are observed below
+    if (!system->drift_monitor) {
+        span = span_begin(metrics);
+        if (system->drift_magnitude > 0.3f) {
+            // Activate OBIAI cascade
+            bool should_cascade = false;
+            obivox_handle_drift(system, system->drift_magnitude, &should_cascade);
+            
+            if (should_cascade && system->recovery_attempts < 3) {
+                // Attempt self-healing
+                system->recovery_attempts++;
+                system->fault_tolerance_enabled = true;
+            }
+        }
+        span_end(metrics, OBIVOX_STAGE_DRIFT, span);
+    }
+    
+    int result = 0;
+    
+    if (input_type == INPUT_AUDIO) {
+        // Audio to Text (STT)
+        if (convert_speech(system, input, input_size, output, confidence) != 0) return -1;
     } else if (input_type == INPUT_TEXT) {
         // Text to Audio (TTS)
         const char* text = (const char*)input;
+        obivox_metrics_add(metrics, OBIVOX_COUNTER_TEXT_BYTES_IN, input_size);
         
         // Allocate audio buffer (simplified)
-        float* audio_output = calloc(16000 * 10, sizeof(float));  // 10 seconds
+        float* audio_output = system_acquire(system, TTS_OUTPUT_BYTES, true);
+        if (!audio_output) return -1;
         
-        // Generate pronunciation guide if needed
+        // Generate pronunciation guide if needed: one lexicon lookup per
+        // word, letter-to-sound rules only for words outside the table
+        char* phonetic_guide = NULL;
         if (system->accessibility.lisp_mitigation) {
-            char* phonetic_guide = NULL;
-            obivox_generate_pronunciation_guide(
+            span = span_begin(metrics);
+            obivox_generate_pronunciation_guide_lexicon(
+                system->lexicon,
                 text,
                 &system->accessibility,
                 &phonetic_guide
             );
-            
-            // Use guide for synthesis (implementation would use actual TTS)
-            if (phonetic_guide) {
-                // Adjust synthesis parameters
-                free(phonetic_guide);
-            }
+            span_end(metrics, OBIVOX_STAGE_G2P, span);
         }
         
-        // Synthesize speech (simplified)
-        // Real implementation would use Coqui TTS or similar
-        for (int i = 0; i < 16000; i++) {
-            audio_output[i] = sinf(2.0f * M_PI * 440.0f * i / 16000.0f) * 0.1f;
-        }
+        span = span_begin(metrics);
+        size_t samples = synthesize_placeholder(phonetic_guide, audio_output, TTS_OUTPUT_BYTES / sizeof(float));
+        span_end(metrics, OBIVOX_STAGE_SYNTHESIS, span);
+        obivox_metrics_add(metrics, OBIVOX_COUNTER_SAMPLES_OUT, samples);
+        free(phonetic_guide);
         
         *output = audio_output;
         *confidence = 0.95f;
@@ -306,9 +762,90 @@ int obivox_bidirectional_convert(
     // Update system confidence
     system->codec_engine.last_confidence = *confidence;
     
+    if (cacheable && result == 0) {
+        convert_to_cache(system, &key, input_type, *output, *confidence);
+    }
+    
     return result;
 }
 
+int obivox_bidirectional_convert_sized(
+    OBIVoxNLMSystem* system,
+    const void* input,
+    size_t input_size,
+    OBIVoxInputType input_type,
+    void** output,
+    float* confidence) {
+    
+    if (!system || !input || !output || !confidence) return -1;
+    if (input_type == INPUT_TEXT && input_size == 0) input_size = strlen(input);
+    if (input_type == INPUT_AUDIO && input_size < sizeof(float)) return -1;
+    
+    OBIVoxMetrics* metrics = system->metrics;
+    if (!metrics) {
+        return convert_stages(system, input, input_size, input_type, output, confidence);
+    }
+    
+    uint64_t start = obivox_metrics_now();
+    int result = convert_stages(system, input, input_size, input_type, output, confidence);
+    obivox_metrics_add(metrics, OBIVOX_COUNTER_REQUESTS, 1);
+    if (result != 0) obivox_metrics_add(metrics, OBIVOX_COUNTER_ERRORS, 1);
+    obivox_metrics_span_end(metrics, OBIVOX_STAGE_TOTAL, start);
+    return result;
+}
+
+// ============================================================================
+// Adaptive Codec Selection
+// ============================================================================
+
+int obivox_select_optimal_codec(
+    OBIVoxNLMSystem* system,
+    const NLMCoordinate* position,
+    TreeMode* suggested_mode) {
+    
+    if (!system || !position || !suggested_mode) return -1;
+    
+    // With any model registered, unregistered codecs cannot serve
+    bool any_registered = false;
+    for (int codec = CODEC_WHISPER; codec <= CODEC_VOSK; codec++) {
+        if (obivox_models_backend(system->models, codec)) any_registered = true;
+    }
+    
+    float difficulty = obivox_codec_difficulty(position);
+    int cheapest = -1;
+    float cheapest_cost = 0.0f;
+    int most_confident = -1;
+    float best_confidence = 0.0f;
+    
+    for (int codec = CODEC_WHISPER; codec <= CODEC_VOSK; codec++) {
+        if (any_registered && !obivox_models_backend(system->models, codec)) continue;
+        
+        OBIVoxAtlasEntry entry;
+        if (!system->atlas ||
+            obivox_atlas_lookup(system->atlas, OBIVOX_ATLAS_SERVICE_CODEC,
+                                obivox_codec_name(codec), &entry) != 0) {
+            continue;
+        }
+        
+        float expected = obivox_codec_expected_confidence(codec, entry.confidence_score, difficulty);
+        if (most_confident < 0 || expected > best_confidence) {
+            most_confident = codec;
+            best_confidence = expected;
+        }
+        if (expected >= system->coherence_threshold &&
+            (cheapest < 0 || entry.dynamic_cost < cheapest_cost)) {
+            cheapest = codec;
+            cheapest_cost = entry.dynamic_cost;
+        }
+    }
+    
+    if (most_confident < 0) return -1;
+    
+    system->codec_engine.selected_codec = cheapest >= 0 ? cheapest : most_confident;
+    *suggested_mode = cheapest >= 0 ? TREE_MODE_HYBRID : TREE_MODE_RB;
+    return 0;
+}
+
 // ============================================================================
 // OBIAI Data Drift Handling
 // ============================================================================
@@ -322,11 +859,9 @@ int obivox_handle_drift(
     
     *should_cascade = false;
     
-    // OBIAI failure scale: -12 to +12
-    // Map drift to failure scale
-    float failure_magnitude = drift_detected * 24.0f - 12.0f;
+    OBIVoxDriftZone zone = obivox_drift_zone(drift_detected);
     
-    if (failure_magnitude < -3.0f) {
+    if (zone == OBIVOX_DRIFT_AI_STRESS) {
         // AI stress zone - need adaptation
         system->current_tree_mode = TREE_MODE_RB;  // Write-heavy for adaptation
         *should_cascade = true;
@@ -334,17 +869,14 @@ int obivox_handle_drift(
         // Reduce confidence threshold temporarily
         system->coherence_threshold = 0.85f;
         
-    } else if (failure_magnitude > 3.0f) {
+    } else if (zone == OBIVOX_DRIFT_HUMAN_STRESS) {
         // Human stress zone - need clarity
         system->current_tree_mode = TREE_MODE_AVL;  // Read-heavy for clarity
         
-        // Request human validation
-        HumanFeedback feedback = {0};
-        feedback.requires_confirmation = true;
-        feedback.confidence_threshold = 0.954f;
-        
-        // Would trigger UI for human confirmation
-        *should_cascade = false;  // Wait for human input
+        // Human validation: with a queue attached, results in this zone
+        // are published provisional for review (nlm_validation.h); nothing
+        // waits for the answer, which arrives as feedback
+        *should_cascade = false;
         
     } else {
         // Green zone - optimal operation
@@ -354,6 +886,8 @@ int obivox_handle_drift(
     
     system->drift_magnitude = drift_detected;
     
+    // The tree mode is this session's; the Atlas is shared, and in
+    // HYBRID it follows the read/write mix every session produces
     return 0;
 }
 
@@ -366,14 +900,32 @@ int obivox_request_human_validation(
     float confidence,
     HumanFeedback* feedback) {
     
+    return obivox_request_human_validation_arena(NULL, transcription, confidence, feedback);
+}
+
+int obivox_request_human_validation_arena(
+    OBIVoxArena* arena,
+    const char* transcription,
+    float confidence,
+    HumanFeedback* feedback) {
+    
     if (!transcription || !feedback) return -1;
     
     feedback->requires_confirmation = (confidence < 0.85f);
     feedback->confidence_threshold = 0.954f;
     
     // Allocate space for suggestions
-    feedback->suggested_correction = calloc(strlen(transcription) + 100, 1);
-    feedback->original_interpretation = strdup(transcription);
+    size_t length = strlen(transcription);
+    if (arena) {
+        feedback->suggested_correction = obivox_arena_acquire_zeroed(arena, length + 100);
+        feedback->original_interpretation = obivox_arena_acquire(arena, length + 1);
+        if (feedback->original_interpretation) {
+            memcpy(feedback->original_interpretation, transcription, length + 1);
+        }
+    } else {
+        feedback->suggested_correction = calloc(length + 100, 1);
+        feedback->original_interpretation = strdup(transcription);
+    }
     
     // In real implementation, this would trigger UI
     // For now, return that confirmation is needed
@@ -387,26 +939,38 @@ int obivox_incorporate_feedback(
     
     if (!system || !feedback) return -1;
     
-    // Update NLM position based on feedback
-    if (feedback->suggested_correction) {
-        // Move towards more formal if corrections were needed
-        system->current_position.y_axis += 0.1f;
-        if (system->current_position.y_axis > 1.0f) {
-            system->current_position.y_axis = 1.0f;
-        }
-        
-        // Increase evolution axis - system is learning
-        system->current_position.z_axis += 0.05f;
-        if (system->current_position.z_axis > 1.0f) {
-            system->current_position.z_axis = 1.0f;
-        }
-    }
+    // A batch of one: move towards more formal and further evolved if a
+    // correction was needed, fold the outcome into the active codec's
+    // Atlas confidence, reset drift (see nlm_feedback.h)
+    OBIVoxFeedbackRecord record = { .feedback = *feedback, .codec = -1 };
+    return obivox_incorporate_feedback_batch(system, &record, 1);
+}
+
+// ============================================================================
+// Plugin System
+// ============================================================================
+
+int obivox_register_plugin(
+    OBIVoxNLMSystem* system,
+    const OBIVoxPlugin* plugin) {
     
-    // Reset drift if human corrected
-    system->drift_magnitude = 0.0f;
-    system->recovery_attempts = 0;
+    if (!system || !plugin || !plugin->name || !system->atlas) return -1;
     
-    return 0;
+    // Typed dispatch through the attached registry (v1 adapter), which
+    // also owns the Atlas node, so each registration publishes once
+    if (system->plugins) {
+        return obivox_plugins_register_v1(system->plugins, plugin, NULL) < 0 ? -1 : 0;
+    }
+    
+    // Discoverable through the Atlas; re-registering keeps learned stats
+    int ret = obivox_atlas_update(
+        system->atlas,
+        OBIVOX_ATLAS_SERVICE_PLUGIN,
+        plugin->name,
+        NULL,
+        NULL
+    );
+    return ret < 0 ? -1 : 0;
 }
 
 // ============================================================================
@@ -418,66 +982,14 @@ int obivox_convert_audio_format(
     const char* output_path,
     const char* target_format) {
     
-    AVFormatContext* input_ctx = NULL;
-    AVFormatContext* output_ctx = NULL;
-    int ret = 0;
-    
-    // Open input file
-    ret = avformat_open_input(&input_ctx, input_path, NULL, NULL);
+    // One-shot use of the reusable converter; batches should keep a
+    // converter (or use obivox_convert_batch) to avoid the setup per file
+    OBIVoxConverter* converter = NULL;
+    int ret = obivox_converter_create(target_format, &converter);
     if (ret < 0) return ret;
     
-    ret = avformat_find_stream_info(input_ctx, NULL);
-    if (ret < 0) {
-        avformat_close_input(&input_ctx);
-        return ret;
-    }
-    
-    // Setup output format
-    avformat_alloc_output_context2(&output_ctx, NULL, target_format, output_path);
-    if (!output_ctx) {
-        avformat_close_input(&input_ctx);
-        return -1;
-    }
-    
-    // Copy streams (simplified - full implementation would transcode)
-    for (unsigned int i = 0; i < input_ctx->nb_streams; i++) {
-        AVStream* in_stream = input_ctx->streams[i];
-        AVStream* out_stream = avformat_new_stream(output_ctx, NULL);
-        
-        if (!out_stream) {
-            ret = -1;
-            goto cleanup;
-        }
-        
-        ret = avcodec_parameters_copy(out_stream->codecpar, in_stream->codecpar);
-        if (ret < 0) goto cleanup;
-    }
-    
-    // Open output file
-    if (!(output_ctx->oformat->flags & AVFMT_NOFILE)) {
-        ret = avio_open(&output_ctx->pb, output_path, AVIO_FLAG_WRITE);
-        if (ret < 0) goto cleanup;
-    }
-    
-    // Write header
-    ret = avformat_write_header(output_ctx, NULL);
-    if (ret < 0) goto cleanup;
-    
-    // Copy packets (simplified)
-    AVPacket pkt;
-    while (av_read_frame(input_ctx, &pkt) >= 0) {
-        av_interleaved_write_frame(output_ctx, &pkt);
-        av_packet_unref(&pkt);
-    }
-    
-    av_write_trailer(output_ctx);
-    
-cleanup:
-    if (output_ctx && !(output_ctx->oformat->flags & AVFMT_NOFILE)) {
-        avio_closep(&output_ctx->pb);
-    }
-    avformat_free_context(output_ctx);
-    avformat_close_input(&input_ctx);
+    ret = obivox_converter_convert(converter, input_path, output_path);
+    obivox_converter_destroy(converter);
     
     return ret;
 }
@@ -0,0 +1,88 @@
+/**
+ * nlm_internal.h
+ * Shared internals between the NLM core and its incremental front-ends
+ * Not installed - include only from src/
+ */
+
+#ifndef OBIVOX_NLM_INTERNAL_H
+#define OBIVOX_NLM_INTERNAL_H
+
+#include "obivox/nlm_framwork.h"
+#include "obivox/nlm_synth.h"
+#include <time.h>
+
+// ============================================================================
+// NLM Coordinate Mapping Internals
+// ============================================================================
+
+/**
+ * Final step of obivox_map_to_nlm_space, split out so callers that keep
+ * running contour statistics can map without rescanning the contours
+ */
+void obivox_nlm_coordinate_from_stats(
+    float pitch_variance,
+    float energy_mean,
+    float variation_score,
+    NLMCoordinate* coordinates
+);
+
+// ============================================================================
+// Clock
+// ============================================================================
+
+// CLOCK_MONOTONIC in nanoseconds: the one clock behind every span,
+// deadline and queue age in the library
+static inline uint64_t obivox_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// ============================================================================
+// Log-Linear Histogram Internals
+// ============================================================================
+
+// Four buckets per octave: values below 4 map to themselves, then each
+// power of two splits in quarters. Relative error stays under 12.5%
+
+static inline uint32_t obivox_histogram_bucket(uint64_t value, uint32_t buckets) {
+    if (value < 4) return (uint32_t)value;
+
+    uint32_t msb = 63 - (uint32_t)__builtin_clzll(value);
+    uint32_t sub = (uint32_t)(value >> (msb - 2)) & 3;
+    uint32_t index = 4 * (msb - 1) + sub;
+    return index < buckets ? index : buckets - 1;
+}
+
+static inline uint64_t obivox_histogram_midpoint(uint32_t index) {
+    if (index < 4) return index;
+
+    uint32_t msb = index / 4 + 1;
+    uint64_t width = 1ull << (msb - 2);
+    uint64_t low = (uint64_t)(4 + index % 4) << (msb - 2);
+    return low + width / 2;
+}
+
+// ============================================================================
+// Placeholder Synthesis Internals
+// ============================================================================
+
+// OBIVOX_SYNTH_SAMPLE_RATE: one tone per guide phoneme, silence after
+// each word
+#define OBIVOX_SYNTH_PHONEME    1280    // 80 ms
+#define OBIVOX_SYNTH_WORD_GAP   320     // 20 ms
+
+/**
+ * One guide phoneme (length bytes, e.g. "SH") of a word marked '*' or
+ * not; writes min(OBIVOX_SYNTH_PHONEME, capacity) samples and returns
+ * the count. Shared by the batch TTS path and streaming synthesis
+ */
+size_t obivox_synthesize_phoneme(
+    const char* phoneme,
+    size_t length,
+    bool marked,
+    float* audio,
+    size_t capacity
+);
+
+#endif // OBIVOX_NLM_INTERNAL_H
@@ -0,0 +1,364 @@
+/**
+ * nlm_stream.c
+ * Incremental STT front-end: variation detection, normalization and
+ * NLM mapping carried across pushed chunks instead of whole utterances
+ * Chunks the VAD marks as silence skip detection and the codec
+ */
+
+#include "obivox/nlm_stream.h"
+#include "obivox/nlm_vad.h"
+#include "core/nlm_internal.h"
+#include "dsp/obivox_kernels.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define STUTTER_HISTORY   (OBIVOX_STREAM_STUTTER_WINDOW * 2)
+#define STUTTER_MASK      (STUTTER_HISTORY - 1)
+#define SMOOTH_TAPS       (OBIVOX_STREAM_SMOOTH_DELAY * 2 + 1)
+#define CONTOUR_HOPS      OBIVOX_STREAM_CONTOUR_HOPS
+
+// Same preservation factor obivox_bidirectional_convert uses for STT
+static const float STREAM_PRESERVATION = 0.7f;
+
+struct obivox_stream {
+    OBIVoxNLMSystem* system;
+
+    // Per-session copy - detection flags never touch the shared system
+    PhoneticAccessibility accessibility;
+    AudioFeatures features;
+    uint64_t samples_processed;
+
+    // Detection runs on voiced chunks only; its timeline is voiced samples
+    OBIVoxVAD* vad;
+    uint64_t voiced_samples;
+
+    // Zero crossing rate over the whole stream
+    float last_sample;
+    uint64_t zero_crossings;
+
+    // Stutter repetition: last two windows, checked every half window
+    float stutter_history[STUTTER_HISTORY];
+    uint64_t next_stutter_end;
+    float repetition_score;
+
+    // Lisp filter carries its previous output sample
+    float lisp_prev;
+
+    // Centred box smoother over SMOOTH_TAPS samples
+    float smooth_ring[SMOOTH_TAPS];
+    uint32_t smooth_pos;
+    double smooth_sum;
+    uint64_t smooth_filled;
+
+    // Normalized output since the last pull
+    float* output;
+    uint32_t output_len;
+    uint32_t output_capacity;
+    bool output_pulled;
+
+    // 10 ms analysis hops feeding the contour window. Each value is stored
+    // at slot and slot + CONTOUR_HOPS, so the newest CONTOUR_HOPS values are
+    // always contiguous and the AudioFeatures view needs no copy
+    float pitch_window[CONTOUR_HOPS * 2];
+    float energy_window[CONTOUR_HOPS * 2];
+    uint32_t hop_size;
+    uint32_t hop_fill;
+    double hop_energy;
+    uint32_t hop_crossings;
+    uint64_t hops;
+    double energy_sum;
+    double pitch_diff_sum;
+
+    bool updated;
+    char transcript[4096];
+};
+
+// ============================================================================
+// Session Lifecycle
+// ============================================================================
+
+int obivox_stream_open(
+    OBIVoxNLMSystem* system,
+    uint32_t sample_rate,
+    OBIVoxStream** stream) {
+
+    if (!system || !stream) return -1;
+
+    OBIVoxStream* s = calloc(1, sizeof(OBIVoxStream));
+    if (!s) return -1;
+
+    s->system = system;
+    s->accessibility = system->accessibility;
+    s->features.sample_rate = sample_rate ? sample_rate : 16000;  // Standard rate
+    s->features.nlm_position = system->current_position;
+    s->next_stutter_end = STUTTER_HISTORY;
+
+    s->hop_size = s->features.sample_rate * OBIVOX_STREAM_HOP_MS / 1000;
+    if (s->hop_size == 0) s->hop_size = 1;
+    s->features.contour_frame_rate = 1000.0f / OBIVOX_STREAM_HOP_MS;
+
+    OBIVoxVADConfig vad_config;
+    obivox_vad_config_default(&vad_config);
+    vad_config.sample_rate = s->features.sample_rate;
+    if (obivox_vad_create(&vad_config, &s->vad) != 0) {
+        free(s);
+        return -1;
+    }
+
+    *stream = s;
+    return 0;
+}
+
+void obivox_stream_close(OBIVoxStream* stream) {
+    if (!stream) return;
+    obivox_vad_destroy(stream->vad);
+    free(stream->output);
+    free(stream);
+}
+
+// ============================================================================
+// Incremental Variation Detection
+// ============================================================================
+
+static void stream_push_contour(OBIVoxStream* s, float pitch, float energy) {
+    AudioFeatures* f = &s->features;
+    uint32_t slot = (uint32_t)(s->hops % CONTOUR_HOPS);
+
+    // Retire the oldest hop and its pitch step once the window is full
+    if (s->hops >= CONTOUR_HOPS) {
+        float oldest = s->pitch_window[slot];
+        float next = s->pitch_window[(slot + 1) % CONTOUR_HOPS];
+        s->pitch_diff_sum -= (double)(next - oldest) * (next - oldest);
+        s->energy_sum -= s->energy_window[slot];
+    }
+    if (s->hops > 0) {
+        float prev = s->pitch_window[(slot + CONTOUR_HOPS - 1) % CONTOUR_HOPS];
+        s->pitch_diff_sum += (double)(pitch - prev) * (pitch - prev);
+    }
+
+    s->pitch_window[slot] = s->pitch_window[slot + CONTOUR_HOPS] = pitch;
+    s->energy_window[slot] = s->energy_window[slot + CONTOUR_HOPS] = energy;
+    s->energy_sum += energy;
+    s->hops++;
+
+    // View of the newest hops, with the window sums already maintained
+    uint32_t frames = s->hops < CONTOUR_HOPS ? (uint32_t)s->hops : CONTOUR_HOPS;
+    uint32_t first = s->hops < CONTOUR_HOPS ? 0 : (uint32_t)(s->hops % CONTOUR_HOPS);
+    f->pitch_contour = s->pitch_window + first;
+    f->energy_envelope = s->energy_window + first;
+    f->contour_frames = frames;
+    f->pitch_step_sum = s->pitch_diff_sum;
+    f->energy_sum = s->energy_sum;
+    f->contour_stats_frames = frames;
+}
+
+// Dot product of two equal-length spans of the stutter ring, split into
+// pieces where neither span wraps so the kernel sees contiguous memory
+static float stutter_ring_dot(const float* ring, uint32_t a, uint32_t b, uint32_t len) {
+    const OBIVoxKernels* kernels = obivox_kernels();
+    float total = 0.0f;
+    while (len > 0) {
+        uint32_t step = len;
+        if (STUTTER_HISTORY - a < step) step = STUTTER_HISTORY - a;
+        if (STUTTER_HISTORY - b < step) step = STUTTER_HISTORY - b;
+        total += kernels->dot(ring + a, ring + b, step);
+        a = (a + step) & STUTTER_MASK;
+        b = (b + step) & STUTTER_MASK;
+        len -= step;
+    }
+    return total;
+}
+
+static void stream_detect(OBIVoxStream* s, const float* samples, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        float x = samples[i];
+        uint64_t t = s->voiced_samples + i;
+
+        // Zero crossing rate (indicator of fricatives affected by lisp)
+        bool crossed = (t > 0) && ((x > 0) != (s->last_sample > 0));
+        if (crossed) {
+            s->zero_crossings++;
+            s->hop_crossings++;
+        }
+        s->last_sample = x;
+
+        // Stutter: compare the newest window with the one before it
+        s->stutter_history[t & STUTTER_MASK] = x;
+        if (t + 1 == s->next_stutter_end) {
+            uint32_t base = (uint32_t)((t + 1) & STUTTER_MASK);
+            float correlation = stutter_ring_dot(
+                s->stutter_history,
+                base,
+                (base + OBIVOX_STREAM_STUTTER_WINDOW) & STUTTER_MASK,
+                OBIVOX_STREAM_STUTTER_WINDOW
+            );
+            if (correlation > 0.8f) {
+                s->repetition_score += 1.0f;
+            }
+            s->next_stutter_end += OBIVOX_STREAM_STUTTER_WINDOW / 2;
+        }
+
+        // Contour hop: RMS energy, with hop ZCR as pitch proxy until
+        // stage-3 feature extraction fills the contour for real
+        s->hop_energy += (double)x * x;
+        if (++s->hop_fill == s->hop_size) {
+            float energy = sqrtf((float)(s->hop_energy / s->hop_size));
+            float pitch = (float)s->hop_crossings / s->hop_size;
+            stream_push_contour(s, pitch, energy);
+            s->hop_fill = 0;
+            s->hop_energy = 0.0;
+            s->hop_crossings = 0;
+        }
+    }
+}
+
+static void stream_update_variations(OBIVoxStream* s, uint64_t total) {
+    PhoneticAccessibility* acc = &s->accessibility;
+    float zero_crossing_rate = (float)s->zero_crossings / (float)total;
+
+    // Same thresholds as obivox_detect_speech_variations
+    if (zero_crossing_rate > 0.4f) {
+        acc->lisp_mitigation = true;
+        s->features.variations.has_lisp = true;
+    }
+    if (s->repetition_score > 3.0f) {
+        acc->stutter_detection = true;
+        s->features.variations.has_stutter = true;
+    }
+
+    float score = (zero_crossing_rate * 0.3f) +
+                  (s->repetition_score * 0.1f) +
+                  (acc->variation_tolerance * 0.6f);
+    s->features.variations.variation_score = score;
+
+    if (score > 0.5f && acc->phenomenological_integrity > 0.9f) {
+        acc->accent_normalization = false;
+    }
+}
+
+// ============================================================================
+// Incremental Normalization
+// ============================================================================
+
+static int stream_reserve_output(OBIVoxStream* s, uint32_t extra) {
+    if (s->output_pulled) {
+        s->output_len = 0;
+        s->output_pulled = false;
+    }
+    if (s->output_len + extra <= s->output_capacity) return 0;
+
+    uint32_t capacity = s->output_capacity ? s->output_capacity : 1024;
+    while (capacity < s->output_len + extra) capacity *= 2;
+
+    float* grown = realloc(s->output, capacity * sizeof(float));
+    if (!grown) return -1;
+    s->output = grown;
+    s->output_capacity = capacity;
+    return 0;
+}
+
+static void stream_normalize(OBIVoxStream* s, const float* samples, uint32_t n) {
+    const PhoneticAccessibility* acc = &s->accessibility;
+    bool normalize = s->features.variations.variation_score > 0.5f;
+    bool lisp = normalize && acc->lisp_mitigation;
+    bool smooth = normalize && acc->stutter_detection;
+    float lisp_gain = 0.2f * (1.0f - STREAM_PRESERVATION);
+
+    for (uint32_t i = 0; i < n; i++) {
+        float x = samples[i];
+
+        // First-difference fricative filter, continuous across chunks
+        if (lisp && s->samples_processed + i > 0) {
+            x = x - ((x - s->lisp_prev) * lisp_gain);
+        }
+        s->lisp_prev = x;
+
+        // Running-sum box filter; every sample passes through the delay
+        // line so toggling the smoother never shifts the timeline
+        float evicted = s->smooth_ring[s->smooth_pos];
+        s->smooth_ring[s->smooth_pos] = x;
+        s->smooth_pos = (s->smooth_pos + 1) % SMOOTH_TAPS;
+        s->smooth_filled++;
+        s->smooth_sum += (double)x - (s->smooth_filled > SMOOTH_TAPS ? evicted : 0.0f);
+
+        if (s->smooth_filled <= OBIVOX_STREAM_SMOOTH_DELAY) continue;
+
+        float center = s->smooth_ring[(s->smooth_pos + OBIVOX_STREAM_SMOOTH_DELAY) % SMOOTH_TAPS];
+        if (smooth && s->smooth_filled >= SMOOTH_TAPS) {
+            float avg = (float)(s->smooth_sum / (OBIVOX_STREAM_SMOOTH_DELAY * 2));
+            center = (center * STREAM_PRESERVATION) +
+                     (avg * (1.0f - STREAM_PRESERVATION));
+        }
+        s->output[s->output_len++] = center;
+    }
+}
+
+// ============================================================================
+// Push / Pull
+// ============================================================================
+
+int obivox_stream_push(
+    OBIVoxStream* stream,
+    const float* samples,
+    uint32_t num_samples) {
+
+    if (!stream || (!samples && num_samples > 0)) return -1;
+    if (num_samples == 0) return 0;
+
+    if (stream_reserve_output(stream, num_samples) != 0) return -1;
+
+    int voiced = obivox_vad_push(stream->vad, samples, num_samples);
+    if (voiced < 0) return -1;
+
+    // Silence still flows through the normalizer so the output timeline
+    // is unbroken, but its crossings and energy never skew detection
+    if (voiced) {
+        stream_detect(stream, samples, num_samples);
+        stream_update_variations(stream, stream->voiced_samples + num_samples);
+        stream->voiced_samples += num_samples;
+    }
+    stream_normalize(stream, samples, num_samples);
+    stream->samples_processed += num_samples;
+    stream->updated = true;
+    if (!voiced) return 0;
+
+    // Map to NLM space; the window sums make this O(1)
+    AudioFeatures* f = &stream->features;
+    f->raw_audio = stream->output;
+    f->num_samples = stream->output_len;
+    obivox_map_to_nlm_space(f, &f->nlm_position);
+
+    // Perform transcription (simplified - would use actual codec)
+    strcpy(stream->transcript, "Transcribed text with variation handling");
+    return 0;
+}
+
+int obivox_stream_pull(
+    OBIVoxStream* stream,
+    OBIVoxPartialResult* result) {
+
+    if (!stream || !result) return -1;
+
+    const AudioFeatures* f = &stream->features;
+
+    result->text = stream->transcript;
+    result->confidence = f->nlm_position.confidence;
+    result->position = f->nlm_position;
+    result->variation_score = f->variations.variation_score;
+    result->has_lisp = f->variations.has_lisp;
+    result->has_stutter = f->variations.has_stutter;
+    result->audio = stream->output_pulled ? NULL : stream->output;
+    result->audio_samples = stream->output_pulled ? 0 : stream->output_len;
+    result->samples_processed = stream->samples_processed;
+    result->timestamp_ms = stream->samples_processed * 1000 / f->sample_rate;
+    result->voiced_samples = stream->voiced_samples;
+    result->in_speech = obivox_vad_in_speech(stream->vad);
+    obivox_vad_take_segments(stream->vad, &result->segments, &result->num_segments);
+
+    stream->output_pulled = true;
+
+    int fresh = stream->updated ? 1 : 0;
+    stream->updated = false;
+    return fresh;
+}
@@ -0,0 +1,271 @@
+/**
+ * obivox_batch.c
+ * Micro-batching dispatch: submitters queue on-stack requests, one
+ * dispatch thread closes a batch at max_batch items or when the oldest
+ * has waited max_wait_us, and runs it through a pooled codec context
+ */
+
+#include "obivox/nlm_batch.h"
+#include "core/nlm_internal.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct batch_request {
+    OBIVoxBatchItem* item;
+    uint64_t enqueued_ns;
+    bool done;
+    struct batch_request* next;
+} BatchRequest;
+
+struct obivox_batcher {
+    OBIVoxModelManager* models;
+    int codec;
+
+    pthread_mutex_t lock;
+    pthread_cond_t pending_changed;   // Dispatch thread: new item or stop
+    pthread_cond_t completed;         // Submitters: a batch finished
+    uint32_t max_batch;
+    uint64_t max_wait_ns;
+
+    // FIFO of waiting requests
+    BatchRequest* head;
+    BatchRequest* tail;
+    uint32_t pending;
+
+    pthread_t thread;
+    bool started;
+    bool stopping;
+
+    // Dispatch-thread scratch: the batch handed to the backend
+    BatchRequest* taken[OBIVOX_BATCH_MAX_ITEMS];
+    OBIVoxBatchItem items[OBIVOX_BATCH_MAX_ITEMS];
+
+    OBIVoxBatchStats stats;
+};
+
+static uint32_t clamp_batch(uint32_t max_batch) {
+    if (max_batch == 0) return 1;
+    return max_batch > OBIVOX_BATCH_MAX_ITEMS ? OBIVOX_BATCH_MAX_ITEMS : max_batch;
+}
+
+// ============================================================================
+// Batcher Lifecycle
+// ============================================================================
+
+void obivox_batch_config_default(OBIVoxBatchConfig* config) {
+    if (!config) return;
+    config->codec = CODEC_WHISPER;
+    config->max_batch = 8;
+    config->max_wait_us = 10000;
+}
+
+int obivox_batcher_create(
+    OBIVoxModelManager* models,
+    const OBIVoxBatchConfig* config,
+    OBIVoxBatcher** batcher) {
+
+    if (!models || !batcher) return -1;
+
+    OBIVoxBatchConfig defaults;
+    if (!config) {
+        obivox_batch_config_default(&defaults);
+        config = &defaults;
+    }
+    if (config->codec < 0 || config->codec >= OBIVOX_MODEL_CODECS) return -1;
+
+    OBIVoxBatcher* b = calloc(1, sizeof(OBIVoxBatcher));
+    if (!b) return -1;
+
+    b->models = models;
+    b->codec = config->codec;
+    b->max_batch = clamp_batch(config->max_batch);
+    b->max_wait_ns = (uint64_t)config->max_wait_us * 1000;
+
+    // Deadlines are absolute monotonic times
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&b->pending_changed, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_cond_init(&b->completed, NULL);
+    pthread_mutex_init(&b->lock, NULL);
+
+    *batcher = b;
+    return 0;
+}
+
+int obivox_batcher_configure(OBIVoxBatcher* batcher, const OBIVoxBatchConfig* config) {
+    if (!batcher || !config) return -1;
+
+    pthread_mutex_lock(&batcher->lock);
+    batcher->max_batch = clamp_batch(config->max_batch);
+    batcher->max_wait_ns = (uint64_t)config->max_wait_us * 1000;
+    pthread_cond_signal(&batcher->pending_changed);
+    pthread_mutex_unlock(&batcher->lock);
+    return 0;
+}
+
+void obivox_batcher_destroy(OBIVoxBatcher* batcher) {
+    if (!batcher) return;
+
+    pthread_mutex_lock(&batcher->lock);
+    batcher->stopping = true;
+    bool started = batcher->started;
+    pthread_cond_signal(&batcher->pending_changed);
+    pthread_mutex_unlock(&batcher->lock);
+
+    if (started) pthread_join(batcher->thread, NULL);
+
+    pthread_cond_destroy(&batcher->pending_changed);
+    pthread_cond_destroy(&batcher->completed);
+    pthread_mutex_destroy(&batcher->lock);
+    free(batcher);
+}
+
+bool obivox_batcher_available(OBIVoxBatcher* batcher) {
+    if (!batcher) return false;
+    const OBIVoxModelBackend* backend = obivox_models_backend(batcher->models, batcher->codec);
+    return backend && backend->run_batch;
+}
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+static void run_batch(OBIVoxBatcher* b, uint32_t count) {
+    const OBIVoxModelBackend* backend = obivox_models_backend(b->models, b->codec);
+    void* context = NULL;
+    int ret = -1;
+
+    if (backend && backend->run_batch &&
+        obivox_models_acquire(b->models, b->codec, true, &context) == 0) {
+        ret = backend->run_batch(context, b->items, count);
+        obivox_models_release(b->models, b->codec, context);
+    }
+
+    if (ret != 0) {
+        for (uint32_t i = 0; i < count; i++) b->items[i].status = -1;
+    }
+}
+
+static void* dispatch_thread(void* arg) {
+    OBIVoxBatcher* b = arg;
+
+    pthread_mutex_lock(&b->lock);
+    for (;;) {
+        while (!b->head && !b->stopping) {
+            pthread_cond_wait(&b->pending_changed, &b->lock);
+        }
+        if (!b->head) break;
+
+        // Hold the batch open until it fills or the oldest item is due;
+        // on stop, drain without waiting
+        bool full = b->pending >= b->max_batch;
+        while (!full && !b->stopping) {
+            uint64_t deadline = b->head->enqueued_ns + b->max_wait_ns;
+            if (obivox_now_ns() >= deadline) break;
+
+            struct timespec ts = {
+                .tv_sec = (time_t)(deadline / 1000000000ull),
+                .tv_nsec = (long)(deadline % 1000000000ull)
+            };
+            pthread_cond_timedwait(&b->pending_changed, &b->lock, &ts);
+            full = b->pending >= b->max_batch;
+        }
+
+        uint32_t count = 0;
+        uint64_t dispatched = obivox_now_ns();
+        while (b->head && count < b->max_batch) {
+            BatchRequest* r = b->head;
+            b->head = r->next;
+            b->pending--;
+
+            uint64_t waited = dispatched - r->enqueued_ns;
+            b->stats.queue_wait_ns += waited;
+            if (waited > b->stats.max_queue_wait_ns) b->stats.max_queue_wait_ns = waited;
+
+            b->taken[count] = r;
+            b->items[count] = *r->item;
+            b->items[count].status = 0;
+            count++;
+        }
+        if (!b->head) b->tail = NULL;
+
+        b->stats.batches++;
+        b->stats.items += count;
+        if (full) b->stats.full_batches++;
+        else b->stats.deadline_batches++;
+
+        // New submitters queue the next batch while this one runs
+        pthread_mutex_unlock(&b->lock);
+        run_batch(b, count);
+        pthread_mutex_lock(&b->lock);
+
+        uint32_t transcribed = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            OBIVoxBatchItem* out = b->taken[i]->item;
+            out->confidence = b->items[i].confidence;
+            out->status = b->items[i].status;
+            if (out->status == 0) transcribed++;
+            b->taken[i]->done = true;
+        }
+        if (transcribed == 0) b->stats.failed_batches++;
+        pthread_cond_broadcast(&b->completed);
+    }
+    pthread_mutex_unlock(&b->lock);
+    return NULL;
+}
+
+int obivox_batcher_submit(OBIVoxBatcher* batcher, OBIVoxBatchItem* item) {
+    if (!batcher || !item || (!item->audio && item->num_samples > 0)) return -1;
+    if (!obivox_batcher_available(batcher)) return -1;
+
+    BatchRequest request = {
+        .item = item,
+        .enqueued_ns = obivox_now_ns(),
+        .done = false,
+        .next = NULL
+    };
+
+    pthread_mutex_lock(&batcher->lock);
+    if (batcher->stopping) {
+        pthread_mutex_unlock(&batcher->lock);
+        return -1;
+    }
+    if (!batcher->started) {
+        if (pthread_create(&batcher->thread, NULL, dispatch_thread, batcher) != 0) {
+            pthread_mutex_unlock(&batcher->lock);
+            return -1;
+        }
+        batcher->started = true;
+    }
+
+    if (batcher->tail) batcher->tail->next = &request;
+    else batcher->head = &request;
+    batcher->tail = &request;
+    batcher->pending++;
+
+    // The dispatch thread only needs waking for the first item or a full
+    // batch; in between it is sleeping on the deadline anyway
+    if (batcher->pending == 1 || batcher->pending >= batcher->max_batch) {
+        pthread_cond_signal(&batcher->pending_changed);
+    }
+
+    while (!request.done) pthread_cond_wait(&batcher->completed, &batcher->lock);
+    pthread_mutex_unlock(&batcher->lock);
+
+    return item->status == 0 ? 0 : -1;
+}
+
+void obivox_batcher_stats(OBIVoxBatcher* batcher, OBIVoxBatchStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!batcher) return;
+
+    pthread_mutex_lock(&batcher->lock);
+    *stats = batcher->stats;
+    stats->pending = batcher->pending;
+    pthread_mutex_unlock(&batcher->lock);
+}
@@ -0,0 +1,605 @@
+/**
+ * obivox_cache.c
+ * Result cache: power-of-two shards, each a chained hash table threaded
+ * onto an LRU list with its own byte budget. Entries hold header and
+ * value in one allocation. Evicted entries optionally go to a shared
+ * mmap'd ring on disk and leave a header-only marker behind
+ */
+
+#include "obivox/nlm_cache.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define DEFAULT_MAX_BYTES   ((size_t)1 << 30)
+#define DEFAULT_SHARDS      16
+#define INITIAL_BUCKETS     64
+
+typedef struct cache_entry {
+    OBIVoxCacheKey key;
+    uint64_t hash;
+    struct cache_entry* chain;
+
+    // LRU (resident) or spill order (spilled), most recent at head
+    struct cache_entry* prev;
+    struct cache_entry* next;
+
+    size_t size;
+    float confidence;
+    bool spilled;
+    uint64_t spill_pos;         // Ring position of the spilled record
+    unsigned char value[];      // Resident entries only
+} CacheEntry;
+
+typedef struct {
+    pthread_mutex_t lock;
+    CacheEntry** buckets;
+    uint32_t bucket_count;
+    uint32_t count;
+
+    CacheEntry* lru_head;
+    CacheEntry* lru_tail;
+    CacheEntry* spill_head;
+    CacheEntry* spill_tail;
+
+    size_t bytes;
+    size_t budget;
+
+    uint64_t hits;
+    uint64_t spill_hits;
+    uint64_t misses;
+    uint64_t inserts;
+    uint64_t evictions;
+    uint64_t spills;
+} CacheShard;
+
+// Record header in the spill ring; the value follows
+typedef struct {
+    OBIVoxCacheKey key;
+    uint64_t size;
+    float confidence;
+} SpillRecord;
+
+struct obivox_result_cache {
+    CacheShard* shards;
+    uint32_t shard_mask;
+
+    // Disk tier: a ring addressed by a monotonic write position
+    pthread_mutex_t spill_lock;
+    unsigned char* spill_map;
+    size_t spill_bytes;
+    uint64_t spill_write;
+};
+
+// ============================================================================
+// Hashing
+// ============================================================================
+
+#define PRIME1  0x9E3779B185EBCA87ull
+#define PRIME2  0xC2B2AE3D27D4EB4Full
+#define PRIME3  0x165667B19E3779F9ull
+#define PRIME4  0x85EBCA77C2B2AE63ull
+#define PRIME5  0x27D4EB2F165667C5ull
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t read64(const unsigned char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t round64(uint64_t acc, uint64_t lane) {
+    acc += lane * PRIME2;
+    acc = rotl64(acc, 31);
+    return acc * PRIME1;
+}
+
+static inline uint64_t merge64(uint64_t acc, uint64_t lane) {
+    acc ^= round64(0, lane);
+    return acc * PRIME1 + PRIME4;
+}
+
+// xxHash64-style: four independent lanes over 32-byte stripes keep the
+// multipliers busy, so hashing a long recording runs near memory speed
+static uint64_t hash_bytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = data;
+    const unsigned char* end = p + size;
+    uint64_t h;
+
+    if (size >= 32) {
+        uint64_t v1 = seed + PRIME1 + PRIME2;
+        uint64_t v2 = seed + PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME1;
+        const unsigned char* limit = end - 32;
+        do {
+            v1 = round64(v1, read64(p));
+            v2 = round64(v2, read64(p + 8));
+            v3 = round64(v3, read64(p + 16));
+            v4 = round64(v4, read64(p + 24));
+            p += 32;
+        } while (p <= limit);
+
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = merge64(h, v1);
+        h = merge64(h, v2);
+        h = merge64(h, v3);
+        h = merge64(h, v4);
+    } else {
+        h = seed + PRIME5;
+    }
+    h += (uint64_t)size;
+
+    for (; p + 8 <= end; p += 8) {
+        h ^= round64(0, read64(p));
+        h = rotl64(h, 27) * PRIME1 + PRIME4;
+    }
+    for (; p < end; p++) {
+        h ^= (*p) * PRIME5;
+        h = rotl64(h, 11) * PRIME1;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+    return h;
+}
+
+static uint64_t hash_mix(uint64_t h, const void* data, size_t size) {
+    return hash_bytes(data, size, h);
+}
+
+void obivox_cache_key(
+    const OBIVoxNLMSystem* system,
+    const void* input,
+    size_t input_size,
+    OBIVoxInputType input_type,
+    OBIVoxCacheKey* key) {
+
+    if (!key) return;
+    memset(key, 0, sizeof(*key));
+    if (!system || (!input && input_size > 0)) return;
+
+    key->input_hash = hash_bytes(input, input_size, 0);
+    key->input_size = input_size;
+    key->input_type = (uint32_t)input_type;
+
+    // Fields hashed one at a time: struct padding is not stable
+    const PhoneticAccessibility* a = &system->accessibility;
+    uint64_t h = 0;
+    uint8_t flags = (uint8_t)(a->lisp_mitigation | a->stutter_detection << 1 |
+                              a->accent_normalization << 2);
+    int32_t normalization = a->normalization_mode;
+    int32_t codec = system->codec_engine.active_codec;
+    h = hash_mix(h, &flags, sizeof(flags));
+    h = hash_mix(h, &a->variation_tolerance, sizeof(float));
+    h = hash_mix(h, &normalization, sizeof(normalization));
+    h = hash_mix(h, &a->phenomenological_integrity, sizeof(float));
+    h = hash_mix(h, &a->experiential_authenticity, sizeof(float));
+    for (uint8_t i = 0; i < a->dialect_count && i < 16; i++) {
+        if (a->dialect_markers[i]) {
+            h = hash_mix(h, a->dialect_markers[i], strlen(a->dialect_markers[i]) + 1);
+        }
+    }
+    h = hash_mix(h, &codec, sizeof(codec));
+    h = hash_mix(h, &system->coherence_threshold, sizeof(float));
+    uintptr_t lexicon = (uintptr_t)system->lexicon;
+    h = hash_mix(h, &lexicon, sizeof(lexicon));
+    key->settings_hash = h;
+}
+
+static uint64_t key_hash(const OBIVoxCacheKey* key) {
+    uint64_t h = key->input_hash ^ rotl64(key->settings_hash, 17) ^
+                 (key->input_size * PRIME3) ^ ((uint64_t)key->input_type << 61);
+    h ^= h >> 31;
+    return h * PRIME2;
+}
+
+static bool key_equal(const OBIVoxCacheKey* a, const OBIVoxCacheKey* b) {
+    return a->input_hash == b->input_hash && a->settings_hash == b->settings_hash &&
+           a->input_size == b->input_size && a->input_type == b->input_type;
+}
+
+// ============================================================================
+// Cache Lifecycle
+// ============================================================================
+
+void obivox_cache_config_default(OBIVoxCacheConfig* config) {
+    if (!config) return;
+    memset(config, 0, sizeof(*config));
+    config->max_bytes = DEFAULT_MAX_BYTES;
+    config->shards = DEFAULT_SHARDS;
+}
+
+static int spill_open(OBIVoxResultCache* c, const char* path, size_t bytes) {
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) return -1;
+
+    if (ftruncate(fd, (off_t)bytes) != 0) {
+        close(fd);
+        return -1;
+    }
+    void* map = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    c->spill_map = map;
+    c->spill_bytes = bytes;
+    return 0;
+}
+
+int obivox_cache_create(const OBIVoxCacheConfig* config, OBIVoxResultCache** cache) {
+    if (!cache) return -1;
+
+    OBIVoxCacheConfig defaults;
+    if (!config) {
+        obivox_cache_config_default(&defaults);
+        config = &defaults;
+    }
+    if (config->max_bytes == 0) return -1;
+
+    uint32_t shards = 1;
+    while (shards < config->shards && shards < 1024) shards <<= 1;
+
+    OBIVoxResultCache* c = calloc(1, sizeof(OBIVoxResultCache));
+    if (!c) return -1;
+    c->shards = calloc(shards, sizeof(CacheShard));
+    if (!c->shards) {
+        free(c);
+        return -1;
+    }
+    c->shard_mask = shards - 1;
+    pthread_mutex_init(&c->spill_lock, NULL);
+
+    for (uint32_t i = 0; i < shards; i++) {
+        CacheShard* s = &c->shards[i];
+        s->buckets = calloc(INITIAL_BUCKETS, sizeof(CacheEntry*));
+        if (!s->buckets) {
+            c->shard_mask = i ? i - 1 : 0;
+            obivox_cache_destroy(c);
+            return -1;
+        }
+        s->bucket_count = INITIAL_BUCKETS;
+        s->budget = config->max_bytes / shards;
+        pthread_mutex_init(&s->lock, NULL);
+    }
+
+    if (config->spill_path && config->spill_bytes > sizeof(SpillRecord)) {
+        if (spill_open(c, config->spill_path, config->spill_bytes) != 0) {
+            obivox_cache_destroy(c);
+            return -1;
+        }
+    }
+
+    *cache = c;
+    return 0;
+}
+
+void obivox_cache_destroy(OBIVoxResultCache* cache) {
+    if (!cache) return;
+
+    for (uint32_t i = 0; i <= cache->shard_mask; i++) {
+        CacheShard* s = &cache->shards[i];
+        if (!s->buckets) continue;
+        for (uint32_t b = 0; b < s->bucket_count; b++) {
+            CacheEntry* e = s->buckets[b];
+            while (e) {
+                CacheEntry* next = e->chain;
+                free(e);
+                e = next;
+            }
+        }
+        free(s->buckets);
+        pthread_mutex_destroy(&s->lock);
+    }
+    if (cache->spill_map) munmap(cache->spill_map, cache->spill_bytes);
+    pthread_mutex_destroy(&cache->spill_lock);
+    free(cache->shards);
+    free(cache);
+}
+
+// ============================================================================
+// Shard Internals (shard lock held)
+// ============================================================================
+
+static size_t entry_charge(const CacheEntry* e) {
+    return sizeof(CacheEntry) + (e->spilled ? 0 : e->size);
+}
+
+static void list_unlink(CacheEntry** head, CacheEntry** tail, CacheEntry* e) {
+    if (e->prev) e->prev->next = e->next;
+    else *head = e->next;
+    if (e->next) e->next->prev = e->prev;
+    else *tail = e->prev;
+    e->prev = e->next = NULL;
+}
+
+static void list_push(CacheEntry** head, CacheEntry** tail, CacheEntry* e) {
+    e->prev = NULL;
+    e->next = *head;
+    if (*head) (*head)->prev = e;
+    else *tail = e;
+    *head = e;
+}
+
+static CacheEntry** bucket_slot(CacheShard* s, uint64_t hash, const OBIVoxCacheKey* key) {
+    CacheEntry** slot = &s->buckets[(hash >> 8) & (s->bucket_count - 1)];
+    while (*slot && !((*slot)->hash == hash && key_equal(&(*slot)->key, key))) {
+        slot = &(*slot)->chain;
+    }
+    return slot;
+}
+
+static void table_grow(CacheShard* s) {
+    uint32_t count = s->bucket_count * 2;
+    CacheEntry** buckets = calloc(count, sizeof(CacheEntry*));
+    if (!buckets) return;  // Longer chains, still correct
+
+    for (uint32_t b = 0; b < s->bucket_count; b++) {
+        CacheEntry* e = s->buckets[b];
+        while (e) {
+            CacheEntry* next = e->chain;
+            uint32_t index = (uint32_t)((e->hash >> 8) & (count - 1));
+            e->chain = buckets[index];
+            buckets[index] = e;
+            e = next;
+        }
+    }
+    free(s->buckets);
+    s->buckets = buckets;
+    s->bucket_count = count;
+}
+
+// Unlink from its table and list, uncharge, free
+static void entry_remove(CacheShard* s, CacheEntry* e) {
+    CacheEntry** slot = bucket_slot(s, e->hash, &e->key);
+    *slot = e->chain;
+    if (e->spilled) list_unlink(&s->spill_head, &s->spill_tail, e);
+    else list_unlink(&s->lru_head, &s->lru_tail, e);
+    s->bytes -= entry_charge(e);
+    s->count--;
+    free(e);
+}
+
+static void entry_insert(CacheShard* s, CacheEntry* e) {
+    if (s->count + 1 > s->bucket_count) table_grow(s);
+
+    CacheEntry** slot = &s->buckets[(e->hash >> 8) & (s->bucket_count - 1)];
+    e->chain = *slot;
+    *slot = e;
+    if (e->spilled) list_push(&s->spill_head, &s->spill_tail, e);
+    else list_push(&s->lru_head, &s->lru_tail, e);
+    s->bytes += entry_charge(e);
+    s->count++;
+}
+
+// ============================================================================
+// Disk Tier
+// ============================================================================
+
+static size_t spill_record_bytes(size_t size) {
+    return (sizeof(SpillRecord) + size + 7) & ~(size_t)7;
+}
+
+// A record survives until the write position laps it
+static bool spill_valid(OBIVoxResultCache* c, uint64_t pos) {
+    return c->spill_write <= pos + c->spill_bytes;
+}
+
+// Append an evicted value; returns false when it cannot be spilled
+static bool spill_write(OBIVoxResultCache* c, const CacheEntry* e, uint64_t* pos) {
+    size_t bytes = spill_record_bytes(e->size);
+    if (!c->spill_map || bytes > c->spill_bytes) return false;
+
+    pthread_mutex_lock(&c->spill_lock);
+    uint64_t at = c->spill_write;
+    size_t offset = (size_t)(at % c->spill_bytes);
+
+    // Records never wrap; skip the tail and start at the beginning
+    if (offset + bytes > c->spill_bytes) {
+        at += c->spill_bytes - offset;
+        offset = 0;
+    }
+
+    SpillRecord header = { e->key, e->size, e->confidence };
+    memcpy(c->spill_map + offset, &header, sizeof(header));
+    memcpy(c->spill_map + offset + sizeof(header), e->value, e->size);
+    c->spill_write = at + bytes;
+    pthread_mutex_unlock(&c->spill_lock);
+
+    *pos = at;
+    return true;
+}
+
+// Copy a spilled value out under the spill lock so no append overwrites
+// it midway; false when it has been lapped
+static bool spill_read(OBIVoxResultCache* c, const CacheEntry* e, void* out) {
+    pthread_mutex_lock(&c->spill_lock);
+    bool valid = spill_valid(c, e->spill_pos);
+    if (valid) {
+        size_t offset = (size_t)(e->spill_pos % c->spill_bytes);
+        SpillRecord header;
+        memcpy(&header, c->spill_map + offset, sizeof(header));
+        valid = key_equal(&header.key, &e->key) && header.size == e->size;
+        if (valid) memcpy(out, c->spill_map + offset + sizeof(header), e->size);
+    }
+    pthread_mutex_unlock(&c->spill_lock);
+    return valid;
+}
+
+// Drop spill markers the ring has lapped; oldest are at the tail
+static void spill_trim(OBIVoxResultCache* c, CacheShard* s) {
+    while (s->spill_tail) {
+        pthread_mutex_lock(&c->spill_lock);
+        bool valid = spill_valid(c, s->spill_tail->spill_pos);
+        pthread_mutex_unlock(&c->spill_lock);
+        if (valid) break;
+        entry_remove(s, s->spill_tail);
+    }
+}
+
+// Evict from the LRU tail until need more bytes fit the budget
+static void shard_evict(OBIVoxResultCache* c, CacheShard* s, size_t need) {
+    while (s->lru_tail && s->bytes + need > s->budget) {
+        CacheEntry* victim = s->lru_tail;
+        s->evictions++;
+
+        // Swap the resident entry for a header-only marker
+        uint64_t pos;
+        CacheEntry* marker = NULL;
+        if (spill_write(c, victim, &pos)) marker = malloc(sizeof(CacheEntry));
+        if (marker) {
+            *marker = *victim;
+            marker->spilled = true;
+            marker->spill_pos = pos;
+            entry_remove(s, victim);
+            entry_insert(s, marker);
+            s->spills++;
+        } else {
+            entry_remove(s, victim);
+        }
+    }
+
+    // Markers cost a header each; old ones go first
+    while (s->spill_tail && s->bytes + need > s->budget) {
+        entry_remove(s, s->spill_tail);
+    }
+    if (c->spill_map) spill_trim(c, s);
+}
+
+// ============================================================================
+// Lookup and Insert
+// ============================================================================
+
+static CacheShard* shard_for(OBIVoxResultCache* c, uint64_t hash) {
+    return &c->shards[hash & c->shard_mask];
+}
+
+int obivox_cache_get(
+    OBIVoxResultCache* cache,
+    const OBIVoxCacheKey* key,
+    void* out,
+    size_t capacity,
+    size_t* size,
+    float* confidence) {
+
+    if (!cache || !key || (!out && capacity > 0)) return -1;
+
+    uint64_t hash = key_hash(key);
+    CacheShard* s = shard_for(cache, hash);
+
+    pthread_mutex_lock(&s->lock);
+    CacheEntry* e = *bucket_slot(s, hash, key);
+    if (!e || e->size > capacity) {
+        s->misses++;
+        pthread_mutex_unlock(&s->lock);
+        return 0;
+    }
+
+    if (!e->spilled) {
+        memcpy(out, e->value, e->size);
+        if (size) *size = e->size;
+        if (confidence) *confidence = e->confidence;
+        list_unlink(&s->lru_head, &s->lru_tail, e);
+        list_push(&s->lru_head, &s->lru_tail, e);
+        s->hits++;
+        pthread_mutex_unlock(&s->lock);
+        return 1;
+    }
+
+    // Disk tier: copy out, then promote back into memory
+    if (!spill_read(cache, e, out)) {
+        entry_remove(s, e);
+        s->misses++;
+        pthread_mutex_unlock(&s->lock);
+        return 0;
+    }
+    if (size) *size = e->size;
+    if (confidence) *confidence = e->confidence;
+    s->hits++;
+    s->spill_hits++;
+
+    CacheEntry* resident = malloc(sizeof(CacheEntry) + e->size);
+    if (resident) {
+        *resident = *e;
+        resident->spilled = false;
+        memcpy(resident->value, out, e->size);
+        entry_remove(s, e);
+        shard_evict(cache, s, entry_charge(resident));
+        entry_insert(s, resident);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return 1;
+}
+
+int obivox_cache_put(
+    OBIVoxResultCache* cache,
+    const OBIVoxCacheKey* key,
+    const void* value,
+    size_t size,
+    float confidence) {
+
+    if (!cache || !key || (!value && size > 0)) return -1;
+
+    uint64_t hash = key_hash(key);
+    CacheShard* s = shard_for(cache, hash);
+    size_t charge = sizeof(CacheEntry) + size;
+    if (charge > s->budget) return 1;
+
+    // Copy outside the lock; only linking is serialised
+    CacheEntry* e = malloc(charge);
+    if (!e) return -1;
+    memset(e, 0, sizeof(CacheEntry));
+    e->key = *key;
+    e->hash = hash;
+    e->size = size;
+    e->confidence = confidence;
+    memcpy(e->value, value, size);
+
+    pthread_mutex_lock(&s->lock);
+    CacheEntry* existing = *bucket_slot(s, hash, key);
+    if (existing) entry_remove(s, existing);
+    shard_evict(cache, s, charge);
+    entry_insert(s, e);
+    s->inserts++;
+    pthread_mutex_unlock(&s->lock);
+    return 0;
+}
+
+void obivox_cache_stats(OBIVoxResultCache* cache, OBIVoxCacheStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!cache) return;
+
+    for (uint32_t i = 0; i <= cache->shard_mask; i++) {
+        CacheShard* s = &cache->shards[i];
+        pthread_mutex_lock(&s->lock);
+        stats->hits += s->hits;
+        stats->spill_hits += s->spill_hits;
+        stats->misses += s->misses;
+        stats->inserts += s->inserts;
+        stats->evictions += s->evictions;
+        stats->spills += s->spills;
+        stats->bytes += s->bytes;
+        stats->entries += s->count;
+        pthread_mutex_unlock(&s->lock);
+    }
+}
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+int obivox_nlm_attach_cache(OBIVoxNLMSystem* system, OBIVoxResultCache* cache) {
+    if (!system) return -1;
+    system->cache = cache;
+    return 0;
+}
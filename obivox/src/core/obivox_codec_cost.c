@@ -0,0 +1,213 @@
+/**
+ * obivox_codec_cost.c
+ * Per-codec latency histograms (log-linear, four buckets per octave of
+ * microseconds per audio second) and confidence EWMAs, accumulated in
+ * atomics and published to the Atlas when the p90 changes bucket or
+ * enough requests are pending
+ */
+
+#include "obivox/nlm_codec.h"
+#include "core/nlm_internal.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COST_CODECS          3     // CODEC_WHISPER, CODEC_COQUI, CODEC_VOSK
+#define HISTOGRAM_BUCKETS    128
+#define CONFIDENCE_ALPHA     0.05f
+#define PUBLISH_SAMPLES      64    // Pending requests that force a publish
+
+// Pending requests since the last publish, packed so one exchange takes
+// both: count in the top bits, confidence sum in PENDING_SCALE units below
+#define PENDING_COUNT_SHIFT  44
+#define PENDING_SCALE        1048576.0f
+#define PENDING_SUM_MASK     ((1ull << PENDING_COUNT_SHIFT) - 1)
+
+typedef struct {
+    atomic_uint_fast64_t buckets[HISTOGRAM_BUCKETS];
+    atomic_uint_fast64_t samples;
+    atomic_uint_fast64_t pending;
+    atomic_uint published_bucket;   // p90 bucket on the Atlas node + 1, 0 = prior
+} CodecHistogram;
+
+struct obivox_codec_costs {
+    OBIVoxAtlas* atlas;
+    CodecHistogram histograms[COST_CODECS];
+};
+
+// Priors until measurements arrive: real-time factor, confidence on easy
+// audio, and confidence lost per unit of difficulty
+static const struct {
+    float rtf;
+    float confidence;
+    float robustness_penalty;
+} codec_priors[COST_CODECS] = {
+    [CODEC_WHISPER] = { 0.30f, 0.975f, 0.02f },
+    [CODEC_COQUI]   = { 0.12f, 0.965f, 0.08f },
+    [CODEC_VOSK]    = { 0.04f, 0.960f, 0.15f },
+};
+
+const char* obivox_codec_name(int codec) {
+    switch (codec) {
+    case CODEC_WHISPER: return "whisper";
+    case CODEC_COQUI:   return "coqui";
+    case CODEC_VOSK:    return "vosk";
+    default:            return "adaptive";
+    }
+}
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+// Bucket holding quantile q; counters are read without a snapshot, so
+// concurrent records can shift the result by a bucket
+static uint32_t histogram_quantile_bucket(CodecHistogram* h, uint64_t total, double q) {
+    uint64_t rank = (uint64_t)(q * (double)(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += atomic_load_explicit(&h->buckets[i], memory_order_relaxed);
+        if (seen >= rank) return i;
+    }
+    return HISTOGRAM_BUCKETS - 1;
+}
+
+static inline float bucket_rtf(uint32_t bucket) {
+    return (float)(obivox_histogram_midpoint(bucket) / 1e6);
+}
+
+// Real-time factor at quantile q
+static float histogram_quantile(CodecHistogram* h, double q) {
+    uint64_t total = atomic_load_explicit(&h->samples, memory_order_relaxed);
+    if (total == 0) return 0.0f;
+    return bucket_rtf(histogram_quantile_bucket(h, total, q));
+}
+
+// ============================================================================
+// Cost Model
+// ============================================================================
+
+int obivox_codec_costs_create(OBIVoxAtlas* atlas, OBIVoxCodecCosts** costs) {
+    if (!atlas || !costs) return -1;
+
+    OBIVoxCodecCosts* c = calloc(1, sizeof(OBIVoxCodecCosts));
+    if (!c) return -1;
+    c->atlas = atlas;
+
+    for (int codec = 0; codec < COST_CODECS; codec++) {
+        OBIVoxAtlasEntry seed = {
+            .dynamic_cost = codec_priors[codec].rtf,
+            .confidence_score = codec_priors[codec].confidence
+        };
+        if (obivox_atlas_upsert(atlas, OBIVOX_ATLAS_SERVICE_CODEC,
+                                obivox_codec_name(codec), &seed) < 0) {
+            free(c);
+            return -1;
+        }
+    }
+
+    *costs = c;
+    return 0;
+}
+
+void obivox_codec_costs_destroy(OBIVoxCodecCosts* costs) {
+    free(costs);
+}
+
+float obivox_codec_difficulty(const NLMCoordinate* position) {
+    if (!position) return 0.0f;
+
+    float variation = position->z_axis;
+    float instability = (1.0f - position->x_axis) * 0.5f;
+    float d = 0.6f * variation + 0.4f * instability;
+    return d < 0.0f ? 0.0f : (d > 1.0f ? 1.0f : d);
+}
+
+float obivox_codec_expected_confidence(int codec, float confidence_score, float difficulty) {
+    if (codec < 0 || codec >= COST_CODECS) return 0.0f;
+    return confidence_score - codec_priors[codec].robustness_penalty * difficulty;
+}
+
+typedef struct {
+    float easy_confidence;      // Mean over the pending requests
+    uint64_t requests;
+    float p90_rtf;
+} CostSample;
+
+// The pending mean enters with the weight its requests would have had
+// one by one, 1 - (1 - alpha)^n; only their order is lost
+static void publish_cost(OBIVoxAtlasEntry* entry, void* context) {
+    const CostSample* sample = context;
+    float weight = 1.0f - powf(1.0f - CONFIDENCE_ALPHA, (float)sample->requests);
+    entry->dynamic_cost = sample->p90_rtf;
+    entry->confidence_score += (sample->easy_confidence - entry->confidence_score) * weight;
+}
+
+int obivox_codec_record(
+    OBIVoxCodecCosts* costs,
+    int codec,
+    float difficulty,
+    uint64_t processing_time_ns,
+    double audio_seconds,
+    float confidence) {
+
+    if (!costs || codec < 0 || codec >= COST_CODECS || audio_seconds <= 0.0) return -1;
+
+    CodecHistogram* h = &costs->histograms[codec];
+    uint64_t us_per_second = (uint64_t)((double)processing_time_ns / 1000.0 / audio_seconds);
+    atomic_fetch_add_explicit(&h->buckets[obivox_histogram_bucket(us_per_second, HISTOGRAM_BUCKETS)], 1, memory_order_relaxed);
+    uint64_t total = atomic_fetch_add_explicit(&h->samples, 1, memory_order_relaxed) + 1;
+
+    // Stored confidence is normalised back to easy audio, so results on
+    // hard input do not make a codec look worse on easy input
+    float easy = confidence + codec_priors[codec].robustness_penalty * difficulty;
+    easy = easy < 0.0f ? 0.0f : (easy > 2.0f ? 2.0f : easy);
+    uint64_t delta = (1ull << PENDING_COUNT_SHIFT) + (uint64_t)(easy * PENDING_SCALE);
+    uint64_t pending = atomic_fetch_add_explicit(&h->pending, delta, memory_order_relaxed) + delta;
+
+    // Copy-on-write only when routing would see a different estimate or
+    // the confidence backlog is large; otherwise the atomics carry it
+    uint32_t p90 = histogram_quantile_bucket(h, total, 0.90);
+    bool moved = p90 + 1 != atomic_load_explicit(&h->published_bucket, memory_order_relaxed);
+    if (!moved && (pending >> PENDING_COUNT_SHIFT) < PUBLISH_SAMPLES) return 0;
+
+    // One recorder takes the backlog; the others' samples wait for the next
+    pending = atomic_exchange_explicit(&h->pending, 0, memory_order_relaxed);
+    uint64_t requests = pending >> PENDING_COUNT_SHIFT;
+    if (requests == 0) return 0;
+    atomic_store_explicit(&h->published_bucket, p90 + 1, memory_order_relaxed);
+
+    CostSample sample = {
+        .easy_confidence = (float)(pending & PENDING_SUM_MASK) / PENDING_SCALE / (float)requests,
+        .requests = requests,
+        .p90_rtf = bucket_rtf(p90)
+    };
+    int ret = obivox_atlas_update(
+        costs->atlas,
+        OBIVOX_ATLAS_SERVICE_CODEC,
+        obivox_codec_name(codec),
+        publish_cost,
+        &sample
+    );
+    return ret < 0 ? -1 : 0;
+}
+
+void obivox_codec_cost_stats(OBIVoxCodecCosts* costs, int codec, OBIVoxCodecCostStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!costs || codec < 0 || codec >= COST_CODECS) return;
+
+    CodecHistogram* h = &costs->histograms[codec];
+    stats->samples = atomic_load_explicit(&h->samples, memory_order_relaxed);
+    stats->p50_rtf = histogram_quantile(h, 0.50);
+    stats->p90_rtf = histogram_quantile(h, 0.90);
+    stats->p99_rtf = histogram_quantile(h, 0.99);
+
+    OBIVoxAtlasEntry entry;
+    if (obivox_atlas_lookup(costs->atlas, OBIVOX_ATLAS_SERVICE_CODEC,
+                            obivox_codec_name(codec), &entry) == 0) {
+        stats->dynamic_cost = entry.dynamic_cost;
+        stats->confidence_score = entry.confidence_score;
+    }
+}
@@ -0,0 +1,239 @@
+/**
+ * obivox_drift.c
+ * EWMA control chart over NLM coordinates: four channels (x, y, z and
+ * confidence), each a baseline mean/variance plus a fast mean. The fast
+ * mean's standard error is sigma * sqrt(alpha / (2 - alpha)), so scores
+ * are z-values whatever the smoothing
+ */
+
+#include "obivox/nlm_drift.h"
+#include <math.h>
+#include <stdlib.h>
+
+#define DRIFT_CHANNELS  4
+#define CONFIDENCE      3
+#define ZONE_EDGE       3.25f   // Just past obivox_handle_drift's +-3 edges
+
+typedef struct {
+    double mean;        // Baseline
+    double m2;          // Welford sum of squares during warm-up
+    double variance;    // Baseline variance after warm-up
+    double fast;        // Fast mean
+} DriftChannel;
+
+struct obivox_drift_monitor {
+    OBIVoxDriftConfig config;
+    float standard_error;       // sqrt(fast_alpha / (2 - fast_alpha))
+    DriftChannel channels[DRIFT_CHANNELS];
+    OBIVoxDriftState state;
+};
+
+void obivox_drift_config_default(OBIVoxDriftConfig* config) {
+    if (!config) return;
+    config->warmup_frames = 32;
+    config->baseline_alpha = 0.002f;
+    config->fast_alpha = 0.1f;
+    config->enter_threshold = 4.0f;
+    config->exit_threshold = 2.0f;
+    config->min_sigma = 0.01f;
+}
+
+int obivox_drift_monitor_create(const OBIVoxDriftConfig* config, OBIVoxDriftMonitor** monitor) {
+    if (!monitor) return -1;
+    *monitor = NULL;
+
+    OBIVoxDriftConfig c;
+    if (config) {
+        c = *config;
+    } else {
+        obivox_drift_config_default(&c);
+    }
+    if (c.warmup_frames < 2) return -1;
+    if (c.baseline_alpha <= 0.0f || c.baseline_alpha >= 1.0f) return -1;
+    if (c.fast_alpha <= 0.0f || c.fast_alpha > 1.0f) return -1;
+    if (c.exit_threshold < 0.0f || c.exit_threshold > c.enter_threshold) return -1;
+    if (c.min_sigma <= 0.0f) return -1;
+
+    OBIVoxDriftMonitor* m = calloc(1, sizeof(OBIVoxDriftMonitor));
+    if (!m) return -1;
+    m->config = c;
+    m->standard_error = sqrtf(c.fast_alpha / (2.0f - c.fast_alpha));
+    obivox_drift_reset(m);
+
+    *monitor = m;
+    return 0;
+}
+
+void obivox_drift_monitor_destroy(OBIVoxDriftMonitor* monitor) {
+    free(monitor);
+}
+
+void obivox_drift_reset(OBIVoxDriftMonitor* monitor) {
+    if (!monitor) return;
+    for (int i = 0; i < DRIFT_CHANNELS; i++) {
+        monitor->channels[i] = (DriftChannel){0};
+    }
+    monitor->state = (OBIVoxDriftState){
+        .zone = OBIVOX_DRIFT_GREEN,
+        .magnitude = 0.5f
+    };
+}
+
+void obivox_drift_rebase(OBIVoxDriftMonitor* monitor) {
+    if (!monitor || !monitor->state.warmed_up) return;
+    for (int i = 0; i < DRIFT_CHANNELS; i++) {
+        monitor->channels[i].mean = monitor->channels[i].fast;
+    }
+    monitor->state.zone = OBIVOX_DRIFT_GREEN;
+    monitor->state.failure = 0.0f;
+    monitor->state.magnitude = 0.5f;
+    monitor->state.position_score = 0.0f;
+    monitor->state.confidence_score = 0.0f;
+}
+
+// ============================================================================
+// Update
+// ============================================================================
+
+static void channel_observe(const OBIVoxDriftMonitor* m, DriftChannel* c, double x, uint64_t n) {
+    if (n <= m->config.warmup_frames) {
+        // Welford: exact mean and variance of the warm-up frames
+        double delta = x - c->mean;
+        c->mean += delta / (double)n;
+        c->m2 += delta * (x - c->mean);
+        if (n == m->config.warmup_frames) {
+            c->variance = c->m2 / (double)(n - 1);
+            c->fast = c->mean;
+        }
+        return;
+    }
+
+    // Exponentially weighted baseline (West), then the fast mean
+    double alpha = m->config.baseline_alpha;
+    double delta = x - c->mean;
+    c->mean += alpha * delta;
+    c->variance = (1.0 - alpha) * (c->variance + alpha * delta * delta);
+    c->fast += m->config.fast_alpha * (x - c->fast);
+}
+
+static float channel_score(const OBIVoxDriftMonitor* m, const DriftChannel* c) {
+    double sigma = sqrt(c->variance);
+    if (sigma < m->config.min_sigma) sigma = m->config.min_sigma;
+    return (float)((c->fast - c->mean) / (sigma * m->standard_error));
+}
+
+int obivox_drift_update(
+    OBIVoxDriftMonitor* monitor,
+    const NLMCoordinate* observation,
+    OBIVoxDriftState* state) {
+
+    if (!monitor || !observation) return -1;
+
+    OBIVoxDriftState* s = &monitor->state;
+    const double values[DRIFT_CHANNELS] = {
+        observation->x_axis,
+        observation->y_axis,
+        observation->z_axis,
+        observation->confidence
+    };
+
+    uint64_t n = ++s->frames;
+    for (int i = 0; i < DRIFT_CHANNELS; i++) {
+        channel_observe(monitor, &monitor->channels[i], values[i], n);
+    }
+    s->warmed_up = n >= monitor->config.warmup_frames;
+
+    int changed = 0;
+    if (n > monitor->config.warmup_frames) {
+        float position = 0.0f;
+        for (int i = 0; i < CONFIDENCE; i++) {
+            float z = fabsf(channel_score(monitor, &monitor->channels[i]));
+            if (z > position) position = z;
+        }
+        float confidence = channel_score(monitor, &monitor->channels[CONFIDENCE]);
+
+        // Falling confidence pulls towards AI stress, a moved position
+        // towards human stress; rising confidence is never drift
+        float failure = position - (confidence < 0.0f ? -confidence : 0.0f);
+        if (failure > 12.0f) failure = 12.0f;
+        if (failure < -12.0f) failure = -12.0f;
+
+        // Hysteresis: enter past enter_threshold, leave below exit_threshold
+        OBIVoxDriftZone zone = s->zone;
+        float level = fabsf(failure);
+        if (zone == OBIVOX_DRIFT_GREEN) {
+            if (level > monitor->config.enter_threshold) {
+                zone = failure < 0.0f ? OBIVOX_DRIFT_AI_STRESS : OBIVOX_DRIFT_HUMAN_STRESS;
+            }
+        } else if (level < monitor->config.exit_threshold) {
+            zone = OBIVOX_DRIFT_GREEN;
+        } else if (level > monitor->config.enter_threshold &&
+                   (failure < 0.0f) != (zone == OBIVOX_DRIFT_AI_STRESS)) {
+            zone = failure < 0.0f ? OBIVOX_DRIFT_AI_STRESS : OBIVOX_DRIFT_HUMAN_STRESS;
+        }
+
+        changed = zone != s->zone;
+        s->zone = zone;
+        s->failure = failure;
+        s->position_score = position;
+        s->confidence_score = confidence;
+
+        // obivox_handle_drift maps magnitude back with * 24 - 12 and has
+        // no hysteresis, so the reported value always lands in our zone
+        float mapped = 0.0f;
+        if (zone == OBIVOX_DRIFT_AI_STRESS) mapped = failure < -ZONE_EDGE ? failure : -ZONE_EDGE;
+        if (zone == OBIVOX_DRIFT_HUMAN_STRESS) mapped = failure > ZONE_EDGE ? failure : ZONE_EDGE;
+        s->magnitude = (mapped + 12.0f) / 24.0f;
+    }
+
+    if (state) *state = *s;
+    return changed;
+}
+
+int obivox_drift_state(const OBIVoxDriftMonitor* monitor, OBIVoxDriftState* state) {
+    if (!monitor || !state) return -1;
+    *state = monitor->state;
+    return 0;
+}
+
+OBIVoxDriftZone obivox_drift_zone(float magnitude) {
+    // OBIAI failure scale: -12 to +12
+    float failure = magnitude * 24.0f - 12.0f;
+    if (failure < -3.0f) return OBIVOX_DRIFT_AI_STRESS;
+    if (failure > 3.0f) return OBIVOX_DRIFT_HUMAN_STRESS;
+    return OBIVOX_DRIFT_GREEN;
+}
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+int obivox_nlm_enable_drift_monitor(OBIVoxNLMSystem* system, const OBIVoxDriftConfig* config) {
+    if (!system) return -1;
+    if (system->drift_monitor) return 1;
+    return obivox_drift_monitor_create(config, &system->drift_monitor);
+}
+
+OBIVoxDriftZone obivox_nlm_drift_zone(const OBIVoxNLMSystem* system) {
+    if (!system) return OBIVOX_DRIFT_GREEN;
+    if (system->drift_monitor) return system->drift_monitor->state.zone;
+    return obivox_drift_zone(system->drift_magnitude);
+}
+
+int obivox_nlm_observe_drift(OBIVoxNLMSystem* system, const NLMCoordinate* observation) {
+    if (!system || !observation) return -1;
+    if (!system->drift_monitor) return 0;
+
+    OBIVoxDriftState state;
+    int changed = obivox_drift_update(system->drift_monitor, observation, &state);
+    if (changed <= 0) return changed;
+
+    // Same cascade the per-call drift check runs, once per transition
+    bool should_cascade = false;
+    if (obivox_handle_drift(system, state.magnitude, &should_cascade) != 0) return -1;
+    if (should_cascade && system->recovery_attempts < 3) {
+        system->recovery_attempts++;
+        system->fault_tolerance_enabled = true;
+    }
+    return 1;
+}
@@ -0,0 +1,160 @@
+/**
+ * obivox_engine.c
+ * Shared immutable engine and per-stream sessions
+ * A session is a private OBIVoxNLMSystem view whose mutable fields never
+ * leave the session; shared resources are borrowed from the engine
+ */
+
+#include "obivox/nlm_engine.h"
+#include "obivox/nlm_variation.h"
+#include "obivox/nlm_features.h"
+#include "obivox/nlm_denoise.h"
+#include "obivox/nlm_vad.h"
+#include "obivox/nlm_drift.h"
+#include "obivox/nlm_models.h"
+#include <stdlib.h>
+
+struct obivox_engine {
+    // Template every session starts from; never written after create
+    OBIVoxNLMSystem config;
+
+    // System built by obivox_nlm_init when no config was supplied
+    OBIVoxNLMSystem* owned;
+};
+
+struct obivox_session {
+    OBIVoxEngine* engine;
+    OBIVoxNLMSystem system;
+};
+
+// ============================================================================
+// Engine Lifecycle
+// ============================================================================
+
+int obivox_engine_create(const OBIVoxNLMSystem* config, OBIVoxEngine** engine) {
+    if (!engine) return -1;
+
+    OBIVoxEngine* e = calloc(1, sizeof(OBIVoxEngine));
+    if (!e) return -1;
+
+    if (!config) {
+        if (obivox_nlm_init(&e->owned) != 0) {
+            free(e);
+            return -1;
+        }
+        config = e->owned;
+    }
+
+    e->config = *config;
+
+    // Analysis scratch is per session, never shared
+    e->config.vad = NULL;
+    e->config.variation_engine = NULL;
+    e->config.feature_extractor = NULL;
+    e->config.denoiser = NULL;
+    e->config.drift_monitor = NULL;
+
+    // Codec contexts come from the shared model pool per session
+    e->config.codec_engine.whisper_context = NULL;
+    e->config.codec_engine.coqui_context = NULL;
+    e->config.codec_engine.vosk_context = NULL;
+
+    *engine = e;
+    return 0;
+}
+
+void obivox_engine_destroy(OBIVoxEngine* engine) {
+    if (!engine) return;
+    obivox_nlm_destroy(engine->owned);
+    free(engine);
+}
+
+const OBIVoxNLMSystem* obivox_engine_config(const OBIVoxEngine* engine) {
+    return engine ? &engine->config : NULL;
+}
+
+// ============================================================================
+// Sessions
+// ============================================================================
+
+int obivox_session_open(OBIVoxEngine* engine, OBIVoxSession** session) {
+    if (!engine || !session) return -1;
+
+    OBIVoxSession* s = calloc(1, sizeof(OBIVoxSession));
+    if (!s) return -1;
+
+    s->engine = engine;
+    s->system = engine->config;
+
+    if (obivox_vad_create(NULL, &s->system.vad) != 0) goto fail;
+    if (obivox_variation_engine_create(NULL, &s->system.variation_engine) != 0) goto fail;
+    if (obivox_feature_extractor_create(NULL, s->system.pool, &s->system.feature_extractor) != 0) {
+        goto fail;
+    }
+    if (obivox_denoiser_create(NULL, &s->system.denoiser) != 0) goto fail;
+
+    // Warm contexts for every registered codec; a pool at its bound
+    // leaves that codec NULL until the session acquires one itself
+    if (obivox_models_bind(s->system.models, &s->system.codec_engine) < 0) goto fail;
+
+    *session = s;
+    return 0;
+
+fail:
+    obivox_session_close(s);
+    return -1;
+}
+
+OBIVoxNLMSystem* obivox_session_system(OBIVoxSession* session) {
+    return session ? &session->system : NULL;
+}
+
+void obivox_session_reset(OBIVoxSession* session) {
+    if (!session) return;
+
+    OBIVoxVAD* vad = session->system.vad;
+    OBIVoxVariationEngine* scratch = session->system.variation_engine;
+    OBIVoxFeatureExtractor* features = session->system.feature_extractor;
+    OBIVoxWorkerPool* pool = session->system.pool;
+    OBIVoxDenoiser* denoiser = session->system.denoiser;
+    OBIVoxDriftMonitor* drift = session->system.drift_monitor;
+    CodecEngine codecs = session->system.codec_engine;
+    session->system = session->engine->config;
+    session->system.vad = vad;
+    session->system.variation_engine = scratch;
+    session->system.feature_extractor = features;
+    session->system.pool = pool;
+    session->system.denoiser = denoiser;
+    session->system.drift_monitor = drift;
+    obivox_drift_reset(drift);
+    session->system.codec_engine.whisper_context = codecs.whisper_context;
+    session->system.codec_engine.coqui_context = codecs.coqui_context;
+    session->system.codec_engine.vosk_context = codecs.vosk_context;
+}
+
+void obivox_session_close(OBIVoxSession* session) {
+    if (!session) return;
+    obivox_models_unbind(session->system.models, &session->system.codec_engine);
+    obivox_drift_monitor_destroy(session->system.drift_monitor);
+    obivox_denoiser_destroy(session->system.denoiser);
+    obivox_feature_extractor_destroy(session->system.feature_extractor);
+    obivox_variation_engine_destroy(session->system.variation_engine);
+    obivox_vad_destroy(session->system.vad);
+    free(session);
+}
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+int obivox_nlm_attach_pool(OBIVoxNLMSystem* system, OBIVoxWorkerPool* pool) {
+    if (!system) return -1;
+
+    // Block counts follow the pool's workers, so the extractor is rebuilt
+    OBIVoxFeatureExtractor* features = NULL;
+    if (obivox_feature_extractor_create(NULL, pool, &features) != 0) return -1;
+    obivox_feature_extractor_destroy(system->feature_extractor);
+    system->feature_extractor = features;
+    system->pool = pool;
+    return 0;
+}
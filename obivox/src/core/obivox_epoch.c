@@ -0,0 +1,177 @@
+/**
+ * obivox_epoch.c
+ * Three-epoch reclamation: memory retired in epoch e is freed once the
+ * global epoch reaches e + 2, which needs every active reader to have
+ * announced the current epoch in between
+ */
+
+#include "core/obivox_epoch.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// state = (epoch << 1) | active; 0 = quiescent
+typedef struct epoch_record {
+    _Alignas(64) atomic_uint_fast64_t state;
+    uint32_t nesting;
+    atomic_bool in_use;
+    struct epoch_record* next;
+} EpochRecord;
+
+typedef struct limbo_entry {
+    void* ptr;
+    void (*free_fn)(void*);
+    uint64_t epoch;
+    struct limbo_entry* next;
+} LimboEntry;
+
+static atomic_uint_fast64_t global_epoch;
+static _Atomic(EpochRecord*) records;
+
+static pthread_mutex_t limbo_lock = PTHREAD_MUTEX_INITIALIZER;
+static LimboEntry* limbo_head;
+static LimboEntry* limbo_tail;
+
+static pthread_once_t key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t record_key;
+static _Thread_local EpochRecord* local_record;
+
+// ============================================================================
+// Thread Records
+// ============================================================================
+
+static void record_release(void* record) {
+    EpochRecord* r = record;
+    atomic_store_explicit(&r->state, 0, memory_order_release);
+    r->nesting = 0;
+    atomic_store_explicit(&r->in_use, false, memory_order_release);
+}
+
+static void key_create(void) {
+    pthread_key_create(&record_key, record_release);
+}
+
+static EpochRecord* epoch_record(void) {
+    if (local_record) return local_record;
+    pthread_once(&key_once, key_create);
+
+    // Records are never freed; exited threads hand theirs back for reuse
+    EpochRecord* r = atomic_load_explicit(&records, memory_order_acquire);
+    for (; r; r = r->next) {
+        bool expected = false;
+        if (atomic_compare_exchange_strong(&r->in_use, &expected, true)) break;
+    }
+
+    if (!r) {
+        r = aligned_alloc(64, sizeof(EpochRecord));
+        if (!r) return NULL;
+        atomic_init(&r->state, 0);
+        atomic_init(&r->in_use, true);
+        r->nesting = 0;
+        r->next = atomic_load_explicit(&records, memory_order_relaxed);
+        while (!atomic_compare_exchange_weak_explicit(&records, &r->next, r,
+                                                      memory_order_release,
+                                                      memory_order_relaxed)) {
+        }
+    }
+
+    local_record = r;
+    pthread_setspecific(record_key, r);
+    return r;
+}
+
+// ============================================================================
+// Read Side
+// ============================================================================
+
+int obivox_epoch_enter(void) {
+    EpochRecord* r = epoch_record();
+    if (!r) return -1;
+
+    if (r->nesting++ == 0) {
+        uint64_t epoch = atomic_load_explicit(&global_epoch, memory_order_relaxed);
+        atomic_store_explicit(&r->state, (epoch << 1) | 1, memory_order_relaxed);
+
+        // Announcement must be visible before any shared pointer is read
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+    return 0;
+}
+
+void obivox_epoch_exit(void) {
+    EpochRecord* r = local_record;
+    if (!r || r->nesting == 0) return;
+    if (--r->nesting == 0) {
+        atomic_store_explicit(&r->state, 0, memory_order_release);
+    }
+}
+
+// ============================================================================
+// Reclamation (limbo_lock held)
+// ============================================================================
+
+static void epoch_try_advance(void) {
+    uint64_t epoch = atomic_load_explicit(&global_epoch, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    for (EpochRecord* r = atomic_load_explicit(&records, memory_order_acquire); r; r = r->next) {
+        uint64_t state = atomic_load_explicit(&r->state, memory_order_acquire);
+        if ((state & 1) && (state >> 1) != epoch) return;
+    }
+    atomic_compare_exchange_strong(&global_epoch, &epoch, epoch + 1);
+}
+
+static void epoch_collect(void) {
+    uint64_t epoch = atomic_load_explicit(&global_epoch, memory_order_acquire);
+    while (limbo_head && limbo_head->epoch + 2 <= epoch) {
+        LimboEntry* entry = limbo_head;
+        limbo_head = entry->next;
+        if (!limbo_head) limbo_tail = NULL;
+        entry->free_fn(entry->ptr);
+        free(entry);
+    }
+}
+
+void obivox_epoch_retire(void* ptr, void (*free_fn)(void*)) {
+    if (!ptr || !free_fn) return;
+
+    LimboEntry* entry = malloc(sizeof(LimboEntry));
+    if (!entry) {
+        // No room to defer: wait out a full grace period instead
+        obivox_epoch_synchronize();
+        free_fn(ptr);
+        return;
+    }
+
+    pthread_mutex_lock(&limbo_lock);
+    entry->ptr = ptr;
+    entry->free_fn = free_fn;
+    entry->epoch = atomic_load_explicit(&global_epoch, memory_order_acquire);
+    entry->next = NULL;
+    if (limbo_tail) {
+        limbo_tail->next = entry;
+    } else {
+        limbo_head = entry;
+    }
+    limbo_tail = entry;
+
+    epoch_try_advance();
+    epoch_collect();
+    pthread_mutex_unlock(&limbo_lock);
+}
+
+void obivox_epoch_synchronize(void) {
+    uint64_t target = atomic_load_explicit(&global_epoch, memory_order_acquire) + 2;
+    for (;;) {
+        pthread_mutex_lock(&limbo_lock);
+        epoch_try_advance();
+        epoch_collect();
+        bool done = atomic_load_explicit(&global_epoch, memory_order_acquire) >= target;
+        pthread_mutex_unlock(&limbo_lock);
+        if (done) break;
+        sched_yield();
+    }
+}
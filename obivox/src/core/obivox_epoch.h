@@ -0,0 +1,31 @@
+/**
+ * obivox_epoch.h
+ * Epoch-based reclamation for read-mostly shared structures
+ * Readers bracket access with enter/exit and never block; writers
+ * publish a new version, then retire the old memory
+ */
+
+#ifndef OBIVOX_EPOCH_H
+#define OBIVOX_EPOCH_H
+
+/**
+ * Begin a read-side critical section (nests); -1 if the thread record
+ * could not be allocated
+ */
+int obivox_epoch_enter(void);
+
+void obivox_epoch_exit(void);
+
+/**
+ * Free ptr with free_fn once no reader can still hold it; thread-safe
+ * Must be called after ptr was unlinked from every published version
+ */
+void obivox_epoch_retire(void* ptr, void (*free_fn)(void*));
+
+/**
+ * Wait until everything retired so far has been freed
+ * Never call from inside a read-side critical section
+ */
+void obivox_epoch_synchronize(void);
+
+#endif // OBIVOX_EPOCH_H
@@ -0,0 +1,346 @@
+/**
+ * obivox_feedback.c
+ * Feedback coalescing: records fold into (speaker, dialect, codec) groups
+ * of accepted / corrected counts in an open-addressed table; a flush turns
+ * the groups into one coordinate step and one Atlas write per codec and
+ * per named group
+ */
+
+#include "obivox/nlm_feedback.h"
+#include "obivox/nlm_atlas.h"
+#include "obivox/nlm_codec.h"
+#include "obivox/nlm_drift.h"
+#include "core/nlm_internal.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Moving-average weight of one outcome (per-record feedback used 0.1)
+#define FEEDBACK_ALPHA  0.1f
+
+typedef struct {
+    uint64_t hash;              // 0 = empty slot
+    char* speaker;
+    char* dialect;
+    int codec;
+    uint32_t accepted;
+    uint32_t corrected;
+} FeedbackGroup;
+
+struct obivox_feedback_buffer {
+    OBIVoxNLMSystem* system;
+    OBIVoxFeedbackPolicy policy;
+    FeedbackGroup* groups;      // Power-of-two table, at most max_groups used
+    uint32_t table_size;
+    uint64_t oldest_ns;
+    OBIVoxFeedbackStats stats;
+};
+
+static uint64_t fnv1a(uint64_t h, const char* s) {
+    if (s) {
+        for (; *s; s++) {
+            h ^= (unsigned char)*s;
+            h *= 0x100000001b3ull;
+        }
+    }
+    h ^= 0xff;  // Separator: ("ab", NULL) and ("a", "b") differ
+    return h * 0x100000001b3ull;
+}
+
+static uint64_t group_hash(const char* speaker, const char* dialect, int codec) {
+    uint64_t h = fnv1a(fnv1a(0xcbf29ce484222325ull, speaker), dialect);
+    h ^= (uint32_t)codec;
+    h *= 0x100000001b3ull;
+    return h ? h : 1;
+}
+
+static bool same_string(const char* a, const char* b) {
+    if (!a || !b) return a == b;
+    return strcmp(a, b) == 0;
+}
+
+static int resolve_codec(const OBIVoxNLMSystem* system, int codec) {
+    if (codec >= 0) return codec;
+    return system->codec_engine.active_codec == CODEC_ADAPTIVE ?
+        system->codec_engine.selected_codec : (int)system->codec_engine.active_codec;
+}
+
+// Find or claim the slot of a group; NULL when the table would overflow
+static FeedbackGroup* group_slot(
+    FeedbackGroup* table,
+    uint32_t size,
+    uint32_t* used,
+    uint32_t limit,
+    const char* speaker,
+    const char* dialect,
+    int codec) {
+
+    uint64_t hash = group_hash(speaker, dialect, codec);
+    for (uint32_t i = (uint32_t)hash & (size - 1); ; i = (i + 1) & (size - 1)) {
+        FeedbackGroup* g = &table[i];
+        if (g->hash == 0) {
+            if (*used >= limit) return NULL;
+            (*used)++;
+            g->hash = hash;
+            g->codec = codec;
+            return g;
+        }
+        if (g->hash == hash && g->codec == codec &&
+            same_string(g->speaker, speaker) && same_string(g->dialect, dialect)) {
+            return g;
+        }
+    }
+}
+
+// ============================================================================
+// Apply
+// ============================================================================
+
+typedef struct {
+    uint32_t accepted;
+    uint32_t corrected;
+} FeedbackOutcome;
+
+// n steps of c += (outcome - c) * alpha with every outcome replaced by
+// the batch mean: c * (1 - alpha)^n + (1 - (1 - alpha)^n) * mean. The
+// sequential EMA weighs late outcomes more, so this is its average over
+// arrival orders, not its value for the order the records came in
+static void feedback_confidence(OBIVoxAtlasEntry* entry, void* context) {
+    const FeedbackOutcome* outcome = context;
+    uint32_t n = outcome->accepted + outcome->corrected;
+    float keep = powf(1.0f - FEEDBACK_ALPHA, (float)n);
+    float acceptance = (float)outcome->accepted / (float)n;
+    entry->confidence_score = entry->confidence_score * keep + (1.0f - keep) * acceptance;
+}
+
+static void feedback_profile(OBIVoxAtlasEntry* entry, void* context) {
+    const FeedbackOutcome* outcome = context;
+    uint32_t n = outcome->accepted + outcome->corrected;
+    float keep = powf(1.0f - FEEDBACK_ALPHA, (float)n);
+    feedback_confidence(entry, context);
+    entry->dynamic_cost = entry->dynamic_cost * keep +
+                          (1.0f - keep) * ((float)outcome->corrected / (float)n);
+}
+
+static uint32_t apply_groups(OBIVoxNLMSystem* system, const FeedbackGroup* table, uint32_t size) {
+    uint32_t writes = 0;
+    uint32_t corrected = 0;
+    FeedbackOutcome per_codec[CODEC_ADAPTIVE + 1] = {{0}};
+
+    for (uint32_t i = 0; i < size; i++) {
+        const FeedbackGroup* g = &table[i];
+        if (g->hash == 0) continue;
+        corrected += g->corrected;
+        if (g->codec >= 0 && g->codec <= CODEC_ADAPTIVE) {
+            per_codec[g->codec].accepted += g->accepted;
+            per_codec[g->codec].corrected += g->corrected;
+        }
+
+        // Named groups keep their own profile
+        if (system->atlas && (g->speaker || g->dialect)) {
+            char operation[64];
+            snprintf(operation, sizeof(operation), "%s/%s",
+                     g->dialect ? g->dialect : "", g->speaker ? g->speaker : "");
+            FeedbackOutcome outcome = { g->accepted, g->corrected };
+            obivox_atlas_update(system->atlas, OBIVOX_ATLAS_SERVICE_FEEDBACK, operation,
+                                feedback_profile, &outcome);
+            writes++;
+        }
+    }
+
+    // Sequential steps only ever add and clamp, so their sum is exact
+    if (corrected > 0) {
+        system->current_position.y_axis = fminf(system->current_position.y_axis + 0.1f * corrected, 1.0f);
+        system->current_position.z_axis = fminf(system->current_position.z_axis + 0.05f * corrected, 1.0f);
+    }
+
+    // One write per codec: routing lookups from other sessions keep
+    // running while each update publishes
+    for (int codec = 0; codec <= CODEC_ADAPTIVE && system->atlas; codec++) {
+        if (per_codec[codec].accepted + per_codec[codec].corrected == 0) continue;
+        obivox_atlas_update(system->atlas, OBIVOX_ATLAS_SERVICE_CODEC, obivox_codec_name(codec),
+                            feedback_confidence, &per_codec[codec]);
+        writes++;
+    }
+
+    // Reset drift once: a human has looked at this regime
+    system->drift_magnitude = 0.0f;
+    system->recovery_attempts = 0;
+    obivox_drift_rebase(system->drift_monitor);
+    return writes;
+}
+
+static void group_count(FeedbackGroup* g, const HumanFeedback* feedback) {
+    if (feedback->suggested_correction) {
+        g->corrected++;
+    } else {
+        g->accepted++;
+    }
+}
+
+int obivox_incorporate_feedback_batch(
+    OBIVoxNLMSystem* system,
+    const OBIVoxFeedbackRecord* records,
+    uint32_t count) {
+
+    if (!system || (!records && count > 0)) return -1;
+    if (count == 0) return 0;
+
+    // Borrowed strings: the table only lives for this call
+    uint32_t size = 16;
+    while (size < count * 2) size *= 2;
+    FeedbackGroup stack[16];
+    FeedbackGroup* table = size <= 16 ? stack : calloc(size, sizeof(FeedbackGroup));
+    if (!table) return -1;
+    if (table == stack) memset(stack, 0, sizeof(stack));
+
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const OBIVoxFeedbackRecord* r = &records[i];
+        FeedbackGroup* g = group_slot(table, size, &used, size, r->speaker, r->dialect,
+                                      resolve_codec(system, r->codec));
+        g->speaker = (char*)r->speaker;
+        g->dialect = (char*)r->dialect;
+        group_count(g, &r->feedback);
+    }
+
+    apply_groups(system, table, size);
+    if (table != stack) free(table);
+    return 0;
+}
+
+// ============================================================================
+// Feedback Buffer
+// ============================================================================
+
+void obivox_feedback_policy_default(OBIVoxFeedbackPolicy* policy) {
+    if (!policy) return;
+    policy->max_records = 256;
+    policy->max_delay_ms = 1000;
+    policy->max_groups = 64;
+}
+
+int obivox_feedback_buffer_create(
+    OBIVoxNLMSystem* system,
+    const OBIVoxFeedbackPolicy* policy,
+    OBIVoxFeedbackBuffer** buffer) {
+
+    if (!system || !buffer) return -1;
+    *buffer = NULL;
+
+    OBIVoxFeedbackPolicy p;
+    if (policy) {
+        p = *policy;
+    } else {
+        obivox_feedback_policy_default(&p);
+    }
+    if (p.max_records == 0 || p.max_groups == 0) return -1;
+
+    OBIVoxFeedbackBuffer* b = calloc(1, sizeof(OBIVoxFeedbackBuffer));
+    if (!b) return -1;
+    b->system = system;
+    b->policy = p;
+
+    // At most half full, so probes stay short
+    b->table_size = 16;
+    while (b->table_size < p.max_groups * 2) b->table_size *= 2;
+    b->groups = calloc(b->table_size, sizeof(FeedbackGroup));
+    if (!b->groups) {
+        free(b);
+        return -1;
+    }
+
+    *buffer = b;
+    return 0;
+}
+
+void obivox_feedback_buffer_destroy(OBIVoxFeedbackBuffer* buffer) {
+    if (!buffer) return;
+    obivox_feedback_buffer_flush(buffer);
+    free(buffer->groups);
+    free(buffer);
+}
+
+int obivox_feedback_buffer_flush(OBIVoxFeedbackBuffer* buffer) {
+    if (!buffer) return -1;
+    if (buffer->stats.pending == 0) return 0;
+
+    buffer->stats.atlas_writes += apply_groups(buffer->system, buffer->groups, buffer->table_size);
+    buffer->stats.flushes++;
+
+    for (uint32_t i = 0; i < buffer->table_size; i++) {
+        FeedbackGroup* g = &buffer->groups[i];
+        if (g->hash == 0) continue;
+        free(g->speaker);
+        free(g->dialect);
+        *g = (FeedbackGroup){0};
+    }
+    buffer->stats.pending = 0;
+    buffer->stats.groups = 0;
+    return 0;
+}
+
+static bool buffer_overdue(const OBIVoxFeedbackBuffer* buffer, uint64_t now) {
+    return buffer->stats.pending > 0 &&
+           now - buffer->oldest_ns >= (uint64_t)buffer->policy.max_delay_ms * 1000000ull;
+}
+
+int obivox_feedback_buffer_add(OBIVoxFeedbackBuffer* buffer, const OBIVoxFeedbackRecord* record) {
+    if (!buffer || !record) return -1;
+
+    int codec = resolve_codec(buffer->system, record->codec);
+    FeedbackGroup* g = group_slot(buffer->groups, buffer->table_size, &buffer->stats.groups,
+                                  buffer->policy.max_groups, record->speaker, record->dialect, codec);
+    int flushed = 0;
+    if (!g) {
+        // Out of groups: apply what is held, then start over
+        obivox_feedback_buffer_flush(buffer);
+        buffer->stats.group_flushes++;
+        flushed = 1;
+        g = group_slot(buffer->groups, buffer->table_size, &buffer->stats.groups,
+                       buffer->policy.max_groups, record->speaker, record->dialect, codec);
+    }
+    if (g->accepted + g->corrected == 0) {
+        g->speaker = record->speaker ? strdup(record->speaker) : NULL;
+        g->dialect = record->dialect ? strdup(record->dialect) : NULL;
+        if ((record->speaker && !g->speaker) || (record->dialect && !g->dialect)) {
+            free(g->speaker);
+            free(g->dialect);
+            *g = (FeedbackGroup){0};
+            buffer->stats.groups--;
+            return -1;
+        }
+    }
+
+    uint64_t now = obivox_now_ns();
+    if (buffer->stats.pending == 0) buffer->oldest_ns = now;
+    group_count(g, &record->feedback);
+    buffer->stats.pending++;
+    buffer->stats.records++;
+
+    if (buffer->stats.pending >= buffer->policy.max_records) {
+        buffer->stats.count_flushes++;
+        obivox_feedback_buffer_flush(buffer);
+        return 1;
+    }
+    if (buffer_overdue(buffer, now)) {
+        buffer->stats.time_flushes++;
+        obivox_feedback_buffer_flush(buffer);
+        return 1;
+    }
+    return flushed;
+}
+
+int obivox_feedback_buffer_poll(OBIVoxFeedbackBuffer* buffer) {
+    if (!buffer) return -1;
+    if (!buffer_overdue(buffer, obivox_now_ns())) return 0;
+    buffer->stats.time_flushes++;
+    obivox_feedback_buffer_flush(buffer);
+    return 1;
+}
+
+void obivox_feedback_buffer_stats(const OBIVoxFeedbackBuffer* buffer, OBIVoxFeedbackStats* stats) {
+    if (!buffer || !stats) return;
+    *stats = buffer->stats;
+}
@@ -0,0 +1,592 @@
+/**
+ * obivox_loader.c
+ * Plugin loader: dlopen over a plugin directory, one FIFO of batch jobs
+ * per plugin drained by that plugin's workers. Workers pin themselves to
+ * the placement's CPUs and prefer its node for every page they fault in,
+ * so contexts created on them (prewarm, or the first request) are local
+ */
+
+#define _GNU_SOURCE
+#include "obivox/nlm_loader.h"
+#include "core/nlm_internal.h"
+#include <dirent.h>
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#ifdef __APPLE__
+#define PLUGIN_SUFFIX  ".dylib"
+#else
+#define PLUGIN_SUFFIX  ".so"
+#endif
+
+// set_mempolicy / mbind without libnuma
+#define LOADER_MPOL_PREFERRED  1
+#define LOADER_MAX_NODES       1024
+
+typedef struct loader_job {
+    const OBIVoxBuffer* inputs;
+    OBIVoxBuffer* outputs;
+    uint32_t count;
+    OBIVoxLoaderDone done;
+    void* user_data;
+    uint64_t queued_ns;
+    struct loader_job* next;
+} LoaderJob;
+
+struct obivox_loaded_plugin {
+    OBIVoxPluginHandle* handle;
+    void* library;
+    char* path;
+    char* stem;                 // File name without PLUGIN_SUFFIX
+
+    int numa_node;
+    bool has_cpus;
+#ifdef __linux__
+    cpu_set_t cpus;
+#endif
+    bool prewarm;
+
+    pthread_t* threads;
+    uint32_t num_workers;
+    uint32_t started;
+    atomic_uint pinned;
+    atomic_uint bound;          // Workers whose memory policy took effect
+
+    pthread_mutex_t lock;
+    pthread_cond_t available;
+    pthread_cond_t warmed;
+    LoaderJob* head;
+    LoaderJob* tail;
+    uint32_t queued;
+    uint32_t warming;           // Workers holding their prewarm context
+    uint32_t ready;             // Workers placed (and warmed) and serving
+    bool shutdown;
+
+    uint64_t jobs;
+    uint64_t items;
+    uint64_t queue_ns;
+};
+
+struct obivox_plugin_loader {
+    OBIVoxPluginRegistry* registry;
+    OBIVoxLoadedPlugin** plugins;
+    uint32_t count;
+    OBIVoxLoaderStats stats;
+};
+
+// ============================================================================
+// Topology
+// ============================================================================
+
+#ifdef __linux__
+// "0-3,8,10-11" into set; returns the number of CPUs added
+static uint32_t parse_cpulist(const char* list, cpu_set_t* set) {
+    uint32_t added = 0;
+    const char* p = list;
+    while (*p) {
+        while (*p == ',' || *p == ' ' || *p == '\n' || *p == '\t') p++;
+        if (*p < '0' || *p > '9') break;
+        char* end;
+        long first = strtol(p, &end, 10);
+        long last = first;
+        if (*end == '-') last = strtol(end + 1, &end, 10);
+        for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET((int)cpu, set);
+            added++;
+        }
+        p = end;
+    }
+    return added;
+}
+
+static uint32_t node_cpus(int node, cpu_set_t* set) {
+    char path[96];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+    FILE* f = fopen(path, "r");
+    if (!f) return 0;
+    char list[4096];
+    size_t n = fread(list, 1, sizeof(list) - 1, f);
+    fclose(f);
+    list[n] = '\0';
+    return parse_cpulist(list, set);
+}
+
+static bool node_mask(int node, unsigned long* mask, size_t words) {
+    if (node < 0 || node >= LOADER_MAX_NODES) return false;
+    memset(mask, 0, words * sizeof(unsigned long));
+    mask[node / (8 * sizeof(unsigned long))] |= 1ul << (node % (8 * sizeof(unsigned long)));
+    return true;
+}
+#endif
+
+// Affinity and memory policy are per thread, so each worker sets its own
+static void place_current_thread(OBIVoxLoadedPlugin* p) {
+#ifdef __linux__
+    if (p->has_cpus && pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &p->cpus) == 0) {
+        atomic_fetch_add_explicit(&p->pinned, 1, memory_order_relaxed);
+    }
+    unsigned long mask[LOADER_MAX_NODES / (8 * sizeof(unsigned long))];
+    if (node_mask(p->numa_node, mask, sizeof(mask) / sizeof(mask[0])) &&
+        syscall(SYS_set_mempolicy, LOADER_MPOL_PREFERRED, mask, (unsigned long)LOADER_MAX_NODES) == 0) {
+        atomic_fetch_add_explicit(&p->bound, 1, memory_order_relaxed);
+    }
+#else
+    (void)p;
+#endif
+}
+
+// ============================================================================
+// Workers
+// ============================================================================
+
+static void prewarm(OBIVoxLoadedPlugin* p) {
+    // Every worker holds a context until all have one, so each creates
+    // its own instead of reusing a sibling's (thread-safe plugins share)
+    OBIVoxPluginStream* stream = NULL;
+    obivox_plugin_stream_open(p->handle, &stream);
+
+    pthread_mutex_lock(&p->lock);
+    p->warming++;
+    pthread_cond_broadcast(&p->warmed);
+    while (p->warming < p->num_workers && !p->shutdown) {
+        pthread_cond_wait(&p->warmed, &p->lock);
+    }
+    pthread_mutex_unlock(&p->lock);
+
+    obivox_plugin_stream_close(stream);
+}
+
+static void* worker_main(void* arg) {
+    OBIVoxLoadedPlugin* p = arg;
+    place_current_thread(p);
+    if (p->prewarm) prewarm(p);
+
+    pthread_mutex_lock(&p->lock);
+    p->ready++;
+    pthread_cond_broadcast(&p->warmed);
+    for (;;) {
+        while (!p->head && !p->shutdown) pthread_cond_wait(&p->available, &p->lock);
+        LoaderJob* job = p->head;
+        if (!job) break;
+
+        p->head = job->next;
+        if (!p->head) p->tail = NULL;
+        p->queued--;
+        p->queue_ns += obivox_now_ns() - job->queued_ns;
+        pthread_mutex_unlock(&p->lock);
+
+        int status = obivox_plugin_process_batch(p->handle, job->inputs, job->outputs, job->count);
+        if (job->done) job->done(status, job->user_data);
+
+        pthread_mutex_lock(&p->lock);
+        p->jobs++;
+        p->items += job->count;
+        free(job);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+static void stop_workers(OBIVoxLoadedPlugin* p) {
+    pthread_mutex_lock(&p->lock);
+    p->shutdown = true;
+    pthread_cond_broadcast(&p->available);
+    pthread_cond_broadcast(&p->warmed);
+    pthread_mutex_unlock(&p->lock);
+    for (uint32_t i = 0; i < p->started; i++) pthread_join(p->threads[i], NULL);
+    p->started = 0;
+}
+
+static int start_workers(OBIVoxLoadedPlugin* p) {
+    p->threads = calloc(p->num_workers, sizeof(pthread_t));
+    if (!p->threads) return -1;
+    for (uint32_t i = 0; i < p->num_workers; i++) {
+        if (pthread_create(&p->threads[i], NULL, worker_main, p) != 0) {
+            // Siblings must not wait for a worker that never started
+            pthread_mutex_lock(&p->lock);
+            p->num_workers = p->started;
+            pthread_cond_broadcast(&p->warmed);
+            pthread_mutex_unlock(&p->lock);
+            return -1;
+        }
+        p->started++;
+    }
+
+    // Placement results are final once create returns
+    pthread_mutex_lock(&p->lock);
+    while (p->ready < p->started) pthread_cond_wait(&p->warmed, &p->lock);
+    pthread_mutex_unlock(&p->lock);
+    return 0;
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+static const OBIVoxPluginPlacement* find_placement(const OBIVoxLoaderConfig* config,
+                                                   const char* name, const char* stem) {
+    const OBIVoxPluginPlacement* fallback = NULL;
+    for (uint32_t i = 0; i < config->placement_count; i++) {
+        const OBIVoxPluginPlacement* placement = &config->placements[i];
+        if (!placement->name) {
+            if (!fallback) fallback = placement;
+        } else if (strcmp(placement->name, name) == 0 || strcmp(placement->name, stem) == 0) {
+            return placement;
+        }
+    }
+    return fallback;
+}
+
+static void apply_placement(OBIVoxLoadedPlugin* p, const OBIVoxPluginPlacement* placement) {
+    p->numa_node = placement ? placement->numa_node : -1;
+    p->num_workers = placement && placement->workers ? placement->workers : 1;
+#ifdef __linux__
+    CPU_ZERO(&p->cpus);
+    if (placement && placement->cpus) {
+        p->has_cpus = parse_cpulist(placement->cpus, &p->cpus) > 0;
+    } else if (p->numa_node >= 0) {
+        p->has_cpus = node_cpus(p->numa_node, &p->cpus) > 0;
+    }
+#endif
+}
+
+static void loaded_free(OBIVoxLoadedPlugin* p) {
+    if (!p) return;
+    pthread_mutex_destroy(&p->lock);
+    pthread_cond_destroy(&p->available);
+    pthread_cond_destroy(&p->warmed);
+    free(p->threads);
+    free(p->path);
+    free(p->stem);
+    free(p);
+}
+
+// Returns the registered plugin, or NULL (library closed) when the object
+// is not a plugin, is rejected or duplicates a registered name
+static OBIVoxLoadedPlugin* load_object(OBIVoxPluginLoader* loader, const char* directory,
+                                       const char* file) {
+    size_t length = strlen(directory) + strlen(file) + 2;
+    char* path = malloc(length);
+    if (!path) return NULL;
+    snprintf(path, length, "%s/%s", directory, file);
+
+    void* library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (!library) {
+        free(path);
+        return NULL;
+    }
+
+    OBIVoxPluginHandle* handle = NULL;
+    int ret = -1;
+    OBIVoxPluginEntryFn entry = (OBIVoxPluginEntryFn)dlsym(library, OBIVOX_PLUGIN_ENTRY_SYMBOL);
+    if (entry) {
+        const OBIVoxPluginV2* table = entry(OBIVOX_PLUGIN_ABI_VERSION);
+        if (table) ret = obivox_plugins_register(loader->registry, table, &handle);
+    } else {
+        const OBIVoxPlugin* legacy = dlsym(library, OBIVOX_PLUGIN_V1_SYMBOL);
+        if (legacy) ret = obivox_plugins_register_v1(loader->registry, legacy, &handle);
+    }
+
+    // 1: the name belongs to an object loaded earlier
+    OBIVoxLoadedPlugin* p = ret == 0 ? calloc(1, sizeof(OBIVoxLoadedPlugin)) : NULL;
+    if (!p) {
+        // A registration that lost its bookkeeping keeps its code mapped
+        if (ret != 0) dlclose(library);
+        free(path);
+        return NULL;
+    }
+
+    p->handle = handle;
+    p->library = library;
+    p->path = path;
+    size_t stem_length = strlen(file) - strlen(PLUGIN_SUFFIX);
+    p->stem = strndup(file, stem_length);
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->available, NULL);
+    pthread_cond_init(&p->warmed, NULL);
+    atomic_init(&p->pinned, 0);
+    atomic_init(&p->bound, 0);
+    return p;
+}
+
+static int name_compare(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+static bool is_plugin_file(const char* name) {
+    size_t n = strlen(name), s = strlen(PLUGIN_SUFFIX);
+    return name[0] != '.' && n > s && strcmp(name + n - s, PLUGIN_SUFFIX) == 0;
+}
+
+// Sorted names of the directory's shared objects
+static int scan_directory(const char* directory, char*** names, uint32_t* count) {
+    *names = NULL;
+    *count = 0;
+    DIR* dir = opendir(directory);
+    if (!dir) return 0;
+
+    uint32_t capacity = 0;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (!is_plugin_file(entry->d_name)) continue;
+        if (*count == capacity) {
+            capacity = capacity ? capacity * 2 : 8;
+            char** grown = realloc(*names, capacity * sizeof(char*));
+            if (!grown) break;
+            *names = grown;
+        }
+        (*names)[*count] = strdup(entry->d_name);
+        if ((*names)[*count]) (*count)++;
+    }
+    closedir(dir);
+
+    if (*count > 1) qsort(*names, *count, sizeof(char*), name_compare);
+    return 0;
+}
+
+// ============================================================================
+// Loader API
+// ============================================================================
+
+void obivox_loader_config_default(OBIVoxLoaderConfig* config) {
+    if (!config) return;
+    memset(config, 0, sizeof(*config));
+    config->directory = OBIVOX_PLUGIN_DIRECTORY;
+    config->prewarm = true;
+}
+
+int obivox_loader_create(const OBIVoxLoaderConfig* config, OBIVoxPluginLoader** loader) {
+    if (!loader) return -1;
+
+    OBIVoxLoaderConfig defaults;
+    if (!config) {
+        obivox_loader_config_default(&defaults);
+        config = &defaults;
+    }
+    const char* directory = config->directory ? config->directory : OBIVOX_PLUGIN_DIRECTORY;
+
+    OBIVoxPluginLoader* l = calloc(1, sizeof(OBIVoxPluginLoader));
+    if (!l) return -1;
+    if (obivox_plugins_create(config->atlas, &l->registry) != 0) {
+        free(l);
+        return -1;
+    }
+
+    char** names = NULL;
+    uint32_t count = 0;
+    scan_directory(directory, &names, &count);
+    l->stats.scanned = count;
+    l->plugins = calloc(count ? count : 1, sizeof(OBIVoxLoadedPlugin*));
+
+    int ret = l->plugins ? 0 : -1;
+    for (uint32_t i = 0; i < count && ret == 0; i++) {
+        OBIVoxLoadedPlugin* p = load_object(l, directory, names[i]);
+        if (!p) {
+            l->stats.failed++;
+            continue;
+        }
+
+        OBIVoxPluginInfo info;
+        obivox_plugin_info(p->handle, &info);
+        apply_placement(p, find_placement(config, info.name, p->stem));
+        p->prewarm = config->prewarm;
+
+        l->plugins[l->count++] = p;
+        l->stats.loaded++;
+        ret = start_workers(p);
+    }
+    for (uint32_t i = 0; i < count; i++) free(names[i]);
+    free(names);
+
+    if (ret != 0) {
+        obivox_loader_destroy(l);
+        return -1;
+    }
+    *loader = l;
+    return 0;
+}
+
+void obivox_loader_destroy(OBIVoxPluginLoader* loader) {
+    if (!loader) return;
+
+    for (uint32_t i = 0; i < loader->count; i++) stop_workers(loader->plugins[i]);
+
+    // Contexts are destroyed by code inside the objects, so unload last
+    obivox_plugins_destroy(loader->registry);
+    for (uint32_t i = 0; i < loader->count; i++) {
+        dlclose(loader->plugins[i]->library);
+        loaded_free(loader->plugins[i]);
+    }
+    free(loader->plugins);
+    free(loader);
+}
+
+OBIVoxPluginRegistry* obivox_loader_registry(OBIVoxPluginLoader* loader) {
+    return loader ? loader->registry : NULL;
+}
+
+void obivox_loader_stats(const OBIVoxPluginLoader* loader, OBIVoxLoaderStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (loader) *stats = loader->stats;
+}
+
+uint32_t obivox_loader_count(const OBIVoxPluginLoader* loader) {
+    return loader ? loader->count : 0;
+}
+
+OBIVoxLoadedPlugin* obivox_loader_plugin(OBIVoxPluginLoader* loader, uint32_t index) {
+    if (!loader || index >= loader->count) return NULL;
+    return loader->plugins[index];
+}
+
+OBIVoxLoadedPlugin* obivox_loader_find(OBIVoxPluginLoader* loader, const char* name) {
+    if (!loader || !name) return NULL;
+    for (uint32_t i = 0; i < loader->count; i++) {
+        OBIVoxLoadedPlugin* p = loader->plugins[i];
+        OBIVoxPluginInfo info;
+        obivox_plugin_info(p->handle, &info);
+        if (strcmp(info.name, name) == 0 || strcmp(p->stem, name) == 0) return p;
+    }
+    return NULL;
+}
+
+OBIVoxPluginHandle* obivox_loader_handle(OBIVoxLoadedPlugin* plugin) {
+    return plugin ? plugin->handle : NULL;
+}
+
+void obivox_loader_info(OBIVoxLoadedPlugin* plugin, OBIVoxLoadedInfo* info) {
+    if (!info) return;
+    memset(info, 0, sizeof(*info));
+    if (!plugin) return;
+
+    OBIVoxPluginInfo table;
+    obivox_plugin_info(plugin->handle, &table);
+    info->name = table.name;
+    info->path = plugin->path;
+    info->numa_node = plugin->numa_node;
+    info->pinned_workers = atomic_load_explicit(&plugin->pinned, memory_order_relaxed);
+    info->memory_bound = plugin->numa_node >= 0 &&
+        atomic_load_explicit(&plugin->bound, memory_order_relaxed) == plugin->started;
+
+    pthread_mutex_lock(&plugin->lock);
+    info->workers = plugin->started;
+    info->jobs = plugin->jobs;
+    info->items = plugin->items;
+    info->queue_ns = plugin->queue_ns;
+    info->queued = plugin->queued;
+    pthread_mutex_unlock(&plugin->lock);
+}
+
+// ============================================================================
+// Placed Execution
+// ============================================================================
+
+int obivox_loader_submit(
+    OBIVoxLoadedPlugin* plugin,
+    const OBIVoxBuffer* inputs,
+    OBIVoxBuffer* outputs,
+    uint32_t count,
+    OBIVoxLoaderDone done,
+    void* user_data) {
+
+    if (!plugin || !inputs || !outputs) return -1;
+
+    LoaderJob* job = malloc(sizeof(LoaderJob));
+    if (!job) return -1;
+    job->inputs = inputs;
+    job->outputs = outputs;
+    job->count = count;
+    job->done = done;
+    job->user_data = user_data;
+    job->next = NULL;
+    job->queued_ns = obivox_now_ns();
+
+    pthread_mutex_lock(&plugin->lock);
+    if (plugin->shutdown || plugin->started == 0) {
+        pthread_mutex_unlock(&plugin->lock);
+        free(job);
+        return -1;
+    }
+    if (plugin->tail) {
+        plugin->tail->next = job;
+    } else {
+        plugin->head = job;
+    }
+    plugin->tail = job;
+    plugin->queued++;
+    pthread_cond_signal(&plugin->available);
+    pthread_mutex_unlock(&plugin->lock);
+    return 0;
+}
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t finished;
+    bool done;
+    int status;
+} LoaderWait;
+
+static void wait_done(int status, void* user_data) {
+    LoaderWait* w = user_data;
+    pthread_mutex_lock(&w->lock);
+    w->status = status;
+    w->done = true;
+    pthread_cond_signal(&w->finished);
+    pthread_mutex_unlock(&w->lock);
+}
+
+int obivox_loader_process_batch(
+    OBIVoxLoadedPlugin* plugin,
+    const OBIVoxBuffer* inputs,
+    OBIVoxBuffer* outputs,
+    uint32_t count) {
+
+    LoaderWait w = { .done = false, .status = -1 };
+    pthread_mutex_init(&w.lock, NULL);
+    pthread_cond_init(&w.finished, NULL);
+
+    int ret = obivox_loader_submit(plugin, inputs, outputs, count, wait_done, &w);
+    if (ret == 0) {
+        pthread_mutex_lock(&w.lock);
+        while (!w.done) pthread_cond_wait(&w.finished, &w.lock);
+        pthread_mutex_unlock(&w.lock);
+        ret = w.status;
+    }
+
+    pthread_cond_destroy(&w.finished);
+    pthread_mutex_destroy(&w.lock);
+    return ret;
+}
+
+void* obivox_loader_alloc(OBIVoxLoadedPlugin* plugin, size_t bytes) {
+    if (!plugin || bytes == 0) return NULL;
+
+    void* buffer = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED) return NULL;
+
+#ifdef __linux__
+    // Untouched pages: the policy decides where each first fault lands
+    unsigned long mask[LOADER_MAX_NODES / (8 * sizeof(unsigned long))];
+    if (node_mask(plugin->numa_node, mask, sizeof(mask) / sizeof(mask[0]))) {
+        syscall(SYS_mbind, buffer, bytes, LOADER_MPOL_PREFERRED, mask,
+                (unsigned long)LOADER_MAX_NODES, 0u);
+    }
+#endif
+    return buffer;
+}
+
+void obivox_loader_free(OBIVoxLoadedPlugin* plugin, void* buffer, size_t bytes) {
+    (void)plugin;
+    if (buffer) munmap(buffer, bytes);
+}
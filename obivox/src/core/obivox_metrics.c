@@ -0,0 +1,291 @@
+/**
+ * obivox_metrics.c
+ * Sharded stage histograms (log-linear, four buckets per octave of
+ * nanoseconds); a thread keeps its shard for life, so records are
+ * uncontended relaxed adds and reads merge every shard
+ */
+
+#include "obivox/nlm_metrics.h"
+#include "core/nlm_internal.h"
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define METRICS_SHARDS       32
+#define HISTOGRAM_BUCKETS    160   // Up to 2^41 ns (about 36 minutes)
+
+typedef struct {
+    atomic_uint_fast64_t buckets[HISTOGRAM_BUCKETS];
+    atomic_uint_fast64_t count;
+    atomic_uint_fast64_t total_ns;
+    atomic_uint_fast64_t max_ns;
+} StageHistogram;
+
+typedef struct {
+    _Alignas(64) StageHistogram stages[OBIVOX_STAGE_COUNT];
+    atomic_uint_fast64_t counters[OBIVOX_COUNTER_COUNT];
+} MetricsShard;
+
+struct obivox_metrics {
+    OBIVoxMetricsConfig config;
+    atomic_uint_fast64_t next_export_ns;
+    MetricsShard shards[METRICS_SHARDS];
+};
+
+static atomic_uint next_shard;
+static _Thread_local int32_t thread_shard = -1;
+
+static MetricsShard* metrics_shard(OBIVoxMetrics* metrics) {
+    if (thread_shard < 0) {
+        thread_shard = (int32_t)(atomic_fetch_add_explicit(&next_shard, 1, memory_order_relaxed) % METRICS_SHARDS);
+    }
+    return &metrics->shards[thread_shard];
+}
+
+static const char* const stage_names[OBIVOX_STAGE_COUNT] = {
+    [OBIVOX_STAGE_TOTAL]         = "total",
+    [OBIVOX_STAGE_CACHE]         = "cache",
+    [OBIVOX_STAGE_DRIFT]         = "drift",
+    [OBIVOX_STAGE_VAD]           = "vad",
+    [OBIVOX_STAGE_VARIATION]     = "variation",
+    [OBIVOX_STAGE_DENOISE]       = "denoise",
+    [OBIVOX_STAGE_NORMALIZATION] = "normalization",
+    [OBIVOX_STAGE_FEATURES]      = "features",
+    [OBIVOX_STAGE_MAPPING]       = "nlm_mapping",
+    [OBIVOX_STAGE_CODEC_SELECT]  = "codec_select",
+    [OBIVOX_STAGE_CODEC]         = "codec",
+    [OBIVOX_STAGE_G2P]           = "g2p",
+    [OBIVOX_STAGE_SYNTHESIS]     = "synthesis",
+    [OBIVOX_STAGE_DECODE]        = "decode",
+    [OBIVOX_STAGE_VALIDATION]    = "validation",
+};
+
+static const char* const counter_names[OBIVOX_COUNTER_COUNT] = {
+    [OBIVOX_COUNTER_REQUESTS]       = "requests",
+    [OBIVOX_COUNTER_ERRORS]         = "errors",
+    [OBIVOX_COUNTER_CACHE_HITS]     = "cache_hits",
+    [OBIVOX_COUNTER_SAMPLES_IN]     = "samples_in",
+    [OBIVOX_COUNTER_SAMPLES_VOICED] = "samples_voiced",
+    [OBIVOX_COUNTER_TEXT_BYTES_IN]  = "text_bytes_in",
+    [OBIVOX_COUNTER_SAMPLES_OUT]    = "samples_out",
+    [OBIVOX_COUNTER_TEXT_BYTES_OUT] = "text_bytes_out",
+};
+
+const char* obivox_stage_name(OBIVoxStage stage) {
+    return (unsigned)stage < OBIVOX_STAGE_COUNT ? stage_names[stage] : "unknown";
+}
+
+const char* obivox_counter_name(OBIVoxCounter counter) {
+    return (unsigned)counter < OBIVOX_COUNTER_COUNT ? counter_names[counter] : "unknown";
+}
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+static uint64_t merged_quantile(const uint64_t* buckets, uint64_t total, uint64_t max_ns, double q) {
+    if (total == 0) return 0;
+
+    uint64_t rank = (uint64_t)(q * (double)(total - 1)) + 1;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            uint64_t mid = obivox_histogram_midpoint(i);
+            return mid < max_ns ? mid : max_ns;
+        }
+    }
+    return max_ns;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+void obivox_metrics_config_default(OBIVoxMetricsConfig* config) {
+    if (!config) return;
+    config->callback = NULL;
+    config->user_data = NULL;
+    config->export_interval_ms = 10000;
+}
+
+int obivox_metrics_create(const OBIVoxMetricsConfig* config, OBIVoxMetrics** metrics) {
+    if (!metrics) return -1;
+    *metrics = NULL;
+
+    OBIVoxMetrics* m = aligned_alloc(64, sizeof(OBIVoxMetrics));
+    if (!m) return -1;
+    memset(m, 0, sizeof(OBIVoxMetrics));
+
+    if (config) {
+        m->config = *config;
+    } else {
+        obivox_metrics_config_default(&m->config);
+    }
+    if (m->config.export_interval_ms == 0) m->config.export_interval_ms = 10000;
+    atomic_init(&m->next_export_ns,
+                obivox_metrics_now() + (uint64_t)m->config.export_interval_ms * 1000000ull);
+
+    *metrics = m;
+    return 0;
+}
+
+void obivox_metrics_destroy(OBIVoxMetrics* metrics) {
+    free(metrics);
+}
+
+// ============================================================================
+// Recording
+// ============================================================================
+
+uint64_t obivox_metrics_now(void) {
+    return obivox_now_ns();
+}
+
+// Push export, claimed by one recording thread per interval
+static void maybe_export(OBIVoxMetrics* metrics, uint64_t now) {
+    uint64_t due = atomic_load_explicit(&metrics->next_export_ns, memory_order_relaxed);
+    if (now < due) return;
+
+    uint64_t next = now + (uint64_t)metrics->config.export_interval_ms * 1000000ull;
+    if (!atomic_compare_exchange_strong_explicit(&metrics->next_export_ns, &due, next,
+                                                 memory_order_relaxed, memory_order_relaxed)) {
+        return;
+    }
+    OBIVoxMetricsSnapshot snapshot;
+    obivox_metrics_snapshot(metrics, &snapshot);
+    metrics->config.callback(&snapshot, metrics->config.user_data);
+}
+
+void obivox_metrics_record(OBIVoxMetrics* metrics, OBIVoxStage stage, uint64_t duration_ns) {
+    if (!metrics || (unsigned)stage >= OBIVOX_STAGE_COUNT) return;
+
+    StageHistogram* h = &metrics_shard(metrics)->stages[stage];
+    atomic_fetch_add_explicit(&h->buckets[obivox_histogram_bucket(duration_ns, HISTOGRAM_BUCKETS)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&h->count, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&h->total_ns, duration_ns, memory_order_relaxed);
+
+    // Shared only when threads outnumber shards, so this rarely retries
+    uint64_t max = atomic_load_explicit(&h->max_ns, memory_order_relaxed);
+    while (duration_ns > max &&
+           !atomic_compare_exchange_weak_explicit(&h->max_ns, &max, duration_ns,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+uint64_t obivox_metrics_span_end(OBIVoxMetrics* metrics, OBIVoxStage stage, uint64_t start_ns) {
+    uint64_t now = obivox_metrics_now();
+    uint64_t duration = now > start_ns ? now - start_ns : 0;
+    obivox_metrics_record(metrics, stage, duration);
+    if (metrics && stage == OBIVOX_STAGE_TOTAL && metrics->config.callback) {
+        maybe_export(metrics, now);
+    }
+    return duration;
+}
+
+void obivox_metrics_add(OBIVoxMetrics* metrics, OBIVoxCounter counter, uint64_t value) {
+    if (!metrics || (unsigned)counter >= OBIVOX_COUNTER_COUNT) return;
+    atomic_fetch_add_explicit(&metrics_shard(metrics)->counters[counter], value, memory_order_relaxed);
+}
+
+// ============================================================================
+// Export
+// ============================================================================
+
+void obivox_metrics_snapshot(OBIVoxMetrics* metrics, OBIVoxMetricsSnapshot* snapshot) {
+    if (!snapshot) return;
+    memset(snapshot, 0, sizeof(*snapshot));
+    if (!metrics) return;
+
+    uint64_t buckets[HISTOGRAM_BUCKETS];
+    for (int stage = 0; stage < OBIVOX_STAGE_COUNT; stage++) {
+        OBIVoxStageStats* out = &snapshot->stages[stage];
+        memset(buckets, 0, sizeof(buckets));
+        uint64_t in_buckets = 0;
+
+        for (int s = 0; s < METRICS_SHARDS; s++) {
+            StageHistogram* h = &metrics->shards[s].stages[stage];
+            out->count += atomic_load_explicit(&h->count, memory_order_relaxed);
+            out->total_ns += atomic_load_explicit(&h->total_ns, memory_order_relaxed);
+            uint64_t max = atomic_load_explicit(&h->max_ns, memory_order_relaxed);
+            if (max > out->max_ns) out->max_ns = max;
+            for (int i = 0; i < HISTOGRAM_BUCKETS; i++) {
+                uint64_t n = atomic_load_explicit(&h->buckets[i], memory_order_relaxed);
+                buckets[i] += n;
+                in_buckets += n;
+            }
+        }
+
+        out->p50_ns = merged_quantile(buckets, in_buckets, out->max_ns, 0.50);
+        out->p95_ns = merged_quantile(buckets, in_buckets, out->max_ns, 0.95);
+        out->p99_ns = merged_quantile(buckets, in_buckets, out->max_ns, 0.99);
+    }
+
+    for (int c = 0; c < OBIVOX_COUNTER_COUNT; c++) {
+        for (int s = 0; s < METRICS_SHARDS; s++) {
+            snapshot->counters[c] += atomic_load_explicit(&metrics->shards[s].counters[c], memory_order_relaxed);
+        }
+    }
+}
+
+// snprintf into the remaining capacity, tracking the untruncated length
+static void append(char* buffer, size_t capacity, size_t* length, const char* format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static void append(char* buffer, size_t capacity, size_t* length, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    char* at = *length < capacity ? buffer + *length : NULL;
+    size_t room = *length < capacity ? capacity - *length : 0;
+    int n = vsnprintf(at, room, format, args);
+    va_end(args);
+    if (n > 0) *length += (size_t)n;
+}
+
+int obivox_metrics_export_prometheus(OBIVoxMetrics* metrics, char* buffer, size_t capacity) {
+    if (!metrics || (!buffer && capacity > 0)) return -1;
+
+    OBIVoxMetricsSnapshot snapshot;
+    obivox_metrics_snapshot(metrics, &snapshot);
+
+    size_t length = 0;
+    if (capacity > 0) buffer[0] = '\0';
+    append(buffer, capacity, &length,
+           "# HELP obivox_stage_latency_seconds Latency of each conversion stage\n"
+           "# TYPE obivox_stage_latency_seconds summary\n");
+    for (int stage = 0; stage < OBIVOX_STAGE_COUNT; stage++) {
+        const OBIVoxStageStats* s = &snapshot.stages[stage];
+        const char* name = stage_names[stage];
+        const struct { const char* label; uint64_t ns; } quantiles[] = {
+            { "0.5", s->p50_ns }, { "0.95", s->p95_ns }, { "0.99", s->p99_ns },
+        };
+        for (int q = 0; q < 3; q++) {
+            append(buffer, capacity, &length,
+                   "obivox_stage_latency_seconds{stage=\"%s\",quantile=\"%s\"} %.9f\n",
+                   name, quantiles[q].label, quantiles[q].ns / 1e9);
+        }
+        append(buffer, capacity, &length,
+               "obivox_stage_latency_seconds_sum{stage=\"%s\"} %.9f\n"
+               "obivox_stage_latency_seconds_count{stage=\"%s\"} %llu\n",
+               name, s->total_ns / 1e9, name, (unsigned long long)s->count);
+    }
+    for (int c = 0; c < OBIVOX_COUNTER_COUNT; c++) {
+        append(buffer, capacity, &length,
+               "# TYPE obivox_%s_total counter\nobivox_%s_total %llu\n",
+               counter_names[c], counter_names[c], (unsigned long long)snapshot.counters[c]);
+    }
+
+    return length > (size_t)INT32_MAX ? -1 : (int)length;
+}
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+int obivox_nlm_attach_metrics(OBIVoxNLMSystem* system, OBIVoxMetrics* metrics) {
+    if (!system) return -1;
+    system->metrics = metrics;
+    return 0;
+}
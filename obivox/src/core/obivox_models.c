@@ -0,0 +1,384 @@
+/**
+ * obivox_models.c
+ * Codec model manager: one load per codec, a bounded warm pool of
+ * inference contexts, and optional shared read-only weight mappings
+ */
+
+#include "obivox/nlm_models.h"
+#include "core/nlm_internal.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct {
+    const OBIVoxModelBackend* backend;
+    OBIVoxModelConfig config;
+    char* model_path;
+
+    pthread_mutex_t lock;
+    pthread_cond_t changed;      // Load finished or a context came back
+    bool loading;
+    bool loaded;
+    void* model;
+    void* mapping;
+    size_t mapped_bytes;
+
+    // Idle contexts, most recently released on top (warmest caches)
+    void** idle;
+    uint32_t idle_count;
+    uint32_t idle_capacity;
+    uint32_t contexts;
+
+    uint64_t load_ns;
+    uint64_t acquires;
+    uint64_t cold_creates;
+    uint64_t waits;
+} ModelSlot;
+
+struct obivox_model_manager {
+    ModelSlot slots[OBIVOX_MODEL_CODECS];
+};
+
+static ModelSlot* model_slot(OBIVoxModelManager* manager, int codec) {
+    if (!manager || codec < 0 || codec >= OBIVOX_MODEL_CODECS) return NULL;
+    return &manager->slots[codec];
+}
+
+// ============================================================================
+// Manager Lifecycle
+// ============================================================================
+
+int obivox_models_create(OBIVoxModelManager** manager) {
+    if (!manager) return -1;
+
+    OBIVoxModelManager* m = calloc(1, sizeof(OBIVoxModelManager));
+    if (!m) return -1;
+
+    for (int i = 0; i < OBIVOX_MODEL_CODECS; i++) {
+        pthread_mutex_init(&m->slots[i].lock, NULL);
+        pthread_cond_init(&m->slots[i].changed, NULL);
+    }
+
+    *manager = m;
+    return 0;
+}
+
+static void slot_unload(ModelSlot* slot) {
+    const OBIVoxModelBackend* backend = slot->backend;
+
+    for (uint32_t i = 0; i < slot->idle_count; i++) {
+        backend->context_destroy(slot->idle[i]);
+    }
+    slot->contexts -= slot->idle_count;
+    slot->idle_count = 0;
+
+    if (slot->loaded && backend->unload) backend->unload(slot->model);
+    if (slot->mapping) munmap(slot->mapping, slot->mapped_bytes);
+
+    slot->model = NULL;
+    slot->mapping = NULL;
+    slot->mapped_bytes = 0;
+    slot->loaded = false;
+}
+
+void obivox_models_destroy(OBIVoxModelManager* manager) {
+    if (!manager) return;
+
+    for (int i = 0; i < OBIVOX_MODEL_CODECS; i++) {
+        ModelSlot* slot = &manager->slots[i];
+        if (slot->backend) slot_unload(slot);
+        free(slot->idle);
+        free(slot->model_path);
+        pthread_mutex_destroy(&slot->lock);
+        pthread_cond_destroy(&slot->changed);
+    }
+    free(manager);
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+static int map_weights(const char* path, void** mapping, size_t* size) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return -1;
+    }
+
+    // MAP_SHARED read-only: every process mapping this file shares the
+    // page-cache copy; the mapping outlives the descriptor
+    void* mapped = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return -1;
+
+    madvise(mapped, (size_t)st.st_size, MADV_WILLNEED);
+    *mapping = mapped;
+    *size = (size_t)st.st_size;
+    return 0;
+}
+
+static int reserve_idle(ModelSlot* slot, uint32_t extra) {
+    if (slot->idle_count + extra <= slot->idle_capacity) return 0;
+
+    uint32_t capacity = slot->idle_capacity ? slot->idle_capacity : 4;
+    while (capacity < slot->idle_count + extra) capacity *= 2;
+
+    void** grown = realloc(slot->idle, capacity * sizeof(void*));
+    if (!grown) return -1;
+    slot->idle = grown;
+    slot->idle_capacity = capacity;
+    return 0;
+}
+
+static int push_idle(ModelSlot* slot, void* context) {
+    if (reserve_idle(slot, 1) != 0) return -1;
+    slot->idle[slot->idle_count++] = context;
+    return 0;
+}
+
+// Called with the slot lock held; drops it while the backend loads so
+// stats and other codecs never wait on a multi-second load
+static int slot_load(ModelSlot* slot) {
+    while (slot->loading) pthread_cond_wait(&slot->changed, &slot->lock);
+    if (slot->loaded) return 0;
+
+    slot->loading = true;
+    pthread_mutex_unlock(&slot->lock);
+
+    const OBIVoxModelBackend* backend = slot->backend;
+    uint64_t start = obivox_now_ns();
+    void* model = NULL;
+    void* mapping = NULL;
+    size_t mapped_bytes = 0;
+    int ret = 0;
+
+    if (slot->config.mmap_weights) ret = map_weights(slot->model_path, &mapping, &mapped_bytes);
+    if (ret == 0) {
+        ret = backend->load(slot->model_path, mapping, mapped_bytes, &model);
+    }
+
+    // Warm contexts exist before the first request needs one
+    uint32_t warm = slot->config.warm_contexts;
+    if (slot->config.max_contexts && warm > slot->config.max_contexts) {
+        warm = slot->config.max_contexts;
+    }
+    void** contexts = warm ? calloc(warm, sizeof(void*)) : NULL;
+    uint32_t created = 0;
+    if (ret == 0 && warm && !contexts) ret = -1;
+    while (ret == 0 && created < warm) {
+        ret = backend->context_create(model, &contexts[created]);
+        if (ret == 0) created++;
+    }
+
+    pthread_mutex_lock(&slot->lock);
+
+    if (ret == 0) ret = reserve_idle(slot, created);
+    if (ret == 0) {
+        for (uint32_t i = 0; i < created; i++) {
+            slot->idle[slot->idle_count++] = contexts[i];
+        }
+        slot->contexts += created;
+        slot->model = model;
+        slot->mapping = mapping;
+        slot->mapped_bytes = mapped_bytes;
+        slot->loaded = true;
+        slot->load_ns = obivox_now_ns() - start;
+    } else {
+        for (uint32_t i = 0; i < created; i++) backend->context_destroy(contexts[i]);
+        if (model && backend->unload) backend->unload(model);
+        if (mapping) munmap(mapping, mapped_bytes);
+    }
+    free(contexts);
+
+    slot->loading = false;
+    pthread_cond_broadcast(&slot->changed);
+    return ret == 0 ? 0 : -1;
+}
+
+int obivox_models_register(
+    OBIVoxModelManager* manager,
+    int codec,
+    const OBIVoxModelBackend* backend,
+    const OBIVoxModelConfig* config) {
+
+    ModelSlot* slot = model_slot(manager, codec);
+    if (!slot || !backend || !config || !backend->load ||
+        !backend->context_create || !backend->context_destroy) {
+        return -1;
+    }
+    if (config->mmap_weights && !config->model_path) return -1;
+
+    char* path = NULL;
+    if (config->model_path) {
+        path = strdup(config->model_path);
+        if (!path) return -1;
+    }
+
+    pthread_mutex_lock(&slot->lock);
+    if (slot->backend) {
+        // Re-registering would strand contexts already handed out
+        pthread_mutex_unlock(&slot->lock);
+        free(path);
+        return -1;
+    }
+
+    slot->backend = backend;
+    slot->config = *config;
+    slot->config.model_path = path;
+    slot->model_path = path;
+
+    int ret = config->preload ? slot_load(slot) : 0;
+    pthread_mutex_unlock(&slot->lock);
+    return ret;
+}
+
+// ============================================================================
+// Context Pool
+// ============================================================================
+
+int obivox_models_acquire(
+    OBIVoxModelManager* manager,
+    int codec,
+    bool wait,
+    void** context) {
+
+    ModelSlot* slot = model_slot(manager, codec);
+    if (!slot || !context) return -1;
+    *context = NULL;
+
+    pthread_mutex_lock(&slot->lock);
+    if (!slot->backend || slot_load(slot) != 0) {
+        pthread_mutex_unlock(&slot->lock);
+        return -1;
+    }
+
+    uint32_t max = slot->config.max_contexts;
+    bool counted_wait = false;
+    while (slot->idle_count == 0 && max && slot->contexts >= max) {
+        if (!wait) {
+            pthread_mutex_unlock(&slot->lock);
+            return 1;
+        }
+        if (!counted_wait) {
+            slot->waits++;
+            counted_wait = true;
+        }
+        pthread_cond_wait(&slot->changed, &slot->lock);
+    }
+
+    slot->acquires++;
+    if (slot->idle_count > 0) {
+        *context = slot->idle[--slot->idle_count];
+        pthread_mutex_unlock(&slot->lock);
+        return 0;
+    }
+
+    // Grow the pool; the slot counts the context before creating it so
+    // concurrent acquires respect max_contexts
+    slot->contexts++;
+    slot->cold_creates++;
+    void* model = slot->model;
+    const OBIVoxModelBackend* backend = slot->backend;
+    pthread_mutex_unlock(&slot->lock);
+
+    if (backend->context_create(model, context) == 0) return 0;
+
+    pthread_mutex_lock(&slot->lock);
+    slot->contexts--;
+    pthread_cond_broadcast(&slot->changed);
+    pthread_mutex_unlock(&slot->lock);
+    *context = NULL;
+    return -1;
+}
+
+void obivox_models_release(OBIVoxModelManager* manager, int codec, void* context) {
+    ModelSlot* slot = model_slot(manager, codec);
+    if (!slot || !context || !slot->backend) return;
+
+    if (slot->backend->context_reset) slot->backend->context_reset(context);
+
+    pthread_mutex_lock(&slot->lock);
+    if (push_idle(slot, context) != 0) {
+        slot->backend->context_destroy(context);
+        slot->contexts--;
+    }
+    pthread_cond_signal(&slot->changed);
+    pthread_mutex_unlock(&slot->lock);
+}
+
+static void** codec_field(CodecEngine* codecs, int codec) {
+    switch (codec) {
+        case CODEC_WHISPER: return &codecs->whisper_context;
+        case CODEC_COQUI:   return &codecs->coqui_context;
+        case CODEC_VOSK:    return &codecs->vosk_context;
+        default:            return NULL;
+    }
+}
+
+int obivox_models_bind(OBIVoxModelManager* manager, CodecEngine* codecs) {
+    if (!manager || !codecs) return -1;
+
+    int ret = 0;
+    for (int codec = 0; codec < OBIVOX_MODEL_CODECS; codec++) {
+        void** field = codec_field(codecs, codec);
+        *field = NULL;
+        const OBIVoxModelBackend* backend = obivox_models_backend(manager, codec);
+        if (!backend) continue;
+        if (codec == CODEC_WHISPER && codecs->whisper_batcher && backend->run_batch) continue;
+
+        // A pool at its bound leaves the field NULL; callers acquire later
+        if (obivox_models_acquire(manager, codec, false, field) < 0) ret = -1;
+    }
+    return ret;
+}
+
+void obivox_models_unbind(OBIVoxModelManager* manager, CodecEngine* codecs) {
+    if (!manager || !codecs) return;
+
+    for (int codec = 0; codec < OBIVOX_MODEL_CODECS; codec++) {
+        void** field = codec_field(codecs, codec);
+        obivox_models_release(manager, codec, *field);
+        *field = NULL;
+    }
+}
+
+const OBIVoxModelBackend* obivox_models_backend(OBIVoxModelManager* manager, int codec) {
+    ModelSlot* slot = model_slot(manager, codec);
+    if (!slot) return NULL;
+
+    pthread_mutex_lock(&slot->lock);
+    const OBIVoxModelBackend* backend = slot->backend;
+    pthread_mutex_unlock(&slot->lock);
+    return backend;
+}
+
+void obivox_models_stats(
+    OBIVoxModelManager* manager,
+    int codec,
+    OBIVoxModelStats* stats) {
+
+    ModelSlot* slot = model_slot(manager, codec);
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!slot) return;
+
+    pthread_mutex_lock(&slot->lock);
+    stats->registered = slot->backend != NULL;
+    stats->loaded = slot->loaded;
+    stats->load_ns = slot->load_ns;
+    stats->mapped_bytes = slot->mapped_bytes;
+    stats->contexts = slot->contexts;
+    stats->idle = slot->idle_count;
+    stats->acquires = slot->acquires;
+    stats->cold_creates = slot->cold_creates;
+    stats->waits = slot->waits;
+    pthread_mutex_unlock(&slot->lock);
+}
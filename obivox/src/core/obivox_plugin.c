@@ -0,0 +1,590 @@
+/**
+ * obivox_plugin.c
+ * Plugin registry for ABI v2: versioned table copies, a context pool per
+ * plugin (one shared context when thread-safe), descriptor checks before
+ * every call, batch splitting at max_batch and per-plugin timing for
+ * routing. v1 tables dispatch through the same paths
+ */
+
+#include "obivox/nlm_plugin.h"
+#include "obivox/nlm_atlas.h"
+#include "core/nlm_internal.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Table prefix every v2 plugin provides: up to and including process
+#define PLUGIN_V2_MIN_SIZE  (offsetof(OBIVoxPluginV2, process) + sizeof(void*))
+
+struct obivox_plugin_handle {
+    OBIVoxPluginV2 table;       // Zero past the plugin's struct_size
+    OBIVoxPlugin legacy;        // abi 1: the original table
+    uint32_t abi_version;
+
+    pthread_mutex_t lock;
+    void** idle;                // Exclusive contexts, warmest on top
+    uint32_t idle_count;
+    uint32_t idle_capacity;
+    uint32_t contexts;
+    void* shared;               // Thread-safe plugins: the one pooled context
+    uint32_t streams;
+
+    atomic_uint_fast64_t calls;
+    atomic_uint_fast64_t items;
+    atomic_uint_fast64_t failures;
+    atomic_uint_fast64_t process_ns;
+
+    // Every context ever created, for destroy
+    void** all;
+    uint32_t all_capacity;
+};
+
+struct obivox_plugin_stream {
+    OBIVoxPluginHandle* handle;
+    void* context;
+    bool exclusive;             // Returned to the idle pool on close
+};
+
+struct obivox_plugin_registry {
+    OBIVoxAtlas* atlas;
+    pthread_mutex_t lock;
+    OBIVoxPluginHandle* plugins[OBIVOX_PLUGIN_MAX];
+    _Atomic uint32_t count;
+};
+
+// ============================================================================
+// Buffer Descriptors
+// ============================================================================
+
+size_t obivox_sample_size(OBIVoxSampleFormat format) {
+    switch (format) {
+        case OBIVOX_SAMPLE_F32: return sizeof(float);
+        case OBIVOX_SAMPLE_S16: return sizeof(int16_t);
+        case OBIVOX_SAMPLE_S32: return sizeof(int32_t);
+        case OBIVOX_SAMPLE_U8:  return sizeof(uint8_t);
+        default:                return 1;
+    }
+}
+
+void obivox_buffer_pcm(
+    OBIVoxBuffer* buffer,
+    void* data,
+    OBIVoxSampleFormat format,
+    uint16_t channels,
+    uint32_t frames,
+    uint32_t sample_rate) {
+
+    if (!buffer) return;
+    memset(buffer, 0, sizeof(*buffer));
+    buffer->data = data;
+    buffer->format = (uint16_t)format;
+    buffer->channels = channels ? channels : 1;
+    buffer->frames = frames;
+    buffer->sample_rate = sample_rate;
+    buffer->bytes = (size_t)frames * buffer->channels * obivox_sample_size(format);
+}
+
+void obivox_buffer_text(OBIVoxBuffer* buffer, const char* text, size_t length) {
+    if (!buffer) return;
+    memset(buffer, 0, sizeof(*buffer));
+    buffer->data = (void*)text;
+    buffer->bytes = length;
+    buffer->format = OBIVOX_SAMPLE_TEXT;
+}
+
+size_t obivox_buffer_span(const OBIVoxBuffer* buffer) {
+    if (!buffer) return 0;
+    if (buffer->format == OBIVOX_SAMPLE_BYTES || buffer->format == OBIVOX_SAMPLE_TEXT) {
+        return buffer->bytes;
+    }
+    if (buffer->format > OBIVOX_SAMPLE_U8) return SIZE_MAX;
+    if (buffer->frames == 0) return 0;
+
+    size_t sample = obivox_sample_size((OBIVoxSampleFormat)buffer->format);
+    size_t channels = buffer->channels ? buffer->channels : 1;
+    int64_t channel_stride = buffer->channel_stride ? buffer->channel_stride : (int64_t)sample;
+    int64_t frame_stride = buffer->frame_stride ? buffer->frame_stride
+                                                : (int64_t)(channels * sample);
+    if (channel_stride < (int64_t)sample || frame_stride < (int64_t)sample) return SIZE_MAX;
+
+    return (size_t)(buffer->frames - 1) * (size_t)frame_stride +
+           (channels - 1) * (size_t)channel_stride + sample;
+}
+
+static bool ranges_overlap(const OBIVoxBuffer* a, size_t a_bytes, const OBIVoxBuffer* b, size_t b_bytes) {
+    uintptr_t a0 = (uintptr_t)a->data, b0 = (uintptr_t)b->data;
+    return a_bytes > 0 && b_bytes > 0 && a0 < b0 + b_bytes && b0 < a0 + a_bytes;
+}
+
+static bool input_valid(const OBIVoxPluginHandle* h, const OBIVoxBuffer* input) {
+    size_t span = obivox_buffer_span(input);
+    if (span == SIZE_MAX || span > input->bytes) return false;
+    if (span > 0 && !input->data) return false;
+
+    // BYTES tables take any descriptor as it comes
+    const OBIVoxPluginV2* t = &h->table;
+    if (t->input_format != OBIVOX_SAMPLE_BYTES && input->format != t->input_format) return false;
+    return t->input_rate == 0 || input->sample_rate == t->input_rate;
+}
+
+static bool output_valid(const OBIVoxPluginHandle* h, const OBIVoxBuffer* input,
+                         const OBIVoxBuffer* output) {
+    const OBIVoxPluginV2* t = &h->table;
+    if (!output->data) {
+        return (t->capabilities & OBIVOX_PLUGIN_CAP_OUTPUT_VIEWS) != 0;
+    }
+    if (t->capabilities & OBIVOX_PLUGIN_CAP_IN_PLACE) return true;
+    return !ranges_overlap(input, input->bytes, output, output->bytes);
+}
+
+// ============================================================================
+// Dispatch (v1 tables adapted here)
+// ============================================================================
+
+static int plugin_init(OBIVoxPluginHandle* h, void** context) {
+    *context = NULL;
+    if (h->abi_version == 1) return h->legacy.init(context) ? 0 : -1;
+    return h->table.init(context);
+}
+
+static void plugin_destroy(OBIVoxPluginHandle* h, void* context) {
+    if (h->abi_version == 1) {
+        if (h->legacy.destroy) h->legacy.destroy(context);
+    } else {
+        h->table.destroy(context);
+    }
+}
+
+static int plugin_call(OBIVoxPluginHandle* h, void* context,
+                       const OBIVoxBuffer* input, OBIVoxBuffer* output) {
+    if (h->abi_version == 1) return h->legacy.process(context, input->data, output->data);
+    return h->table.process(context, input, output);
+}
+
+// Views are tagged with their context so release reaches the right one
+static void mark_views(void* context, OBIVoxBuffer* outputs, const bool* viewed, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (viewed[i] && outputs[i].data) {
+            outputs[i].flags |= OBIVOX_BUFFER_VIEW;
+            outputs[i].owner = context;
+        }
+    }
+}
+
+static int run_items(OBIVoxPluginHandle* h, void* context,
+                     const OBIVoxBuffer* inputs, OBIVoxBuffer* outputs, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (!input_valid(h, &inputs[i]) || !output_valid(h, &inputs[i], &outputs[i])) {
+            atomic_fetch_add_explicit(&h->failures, 1, memory_order_relaxed);
+            return -1;
+        }
+    }
+
+    bool viewed_local[32];
+    bool* viewed = count <= 32 ? viewed_local : malloc(count * sizeof(bool));
+    if (!viewed) return -1;
+    for (uint32_t i = 0; i < count; i++) viewed[i] = outputs[i].data == NULL;
+
+    uint64_t start = obivox_now_ns();
+    int ret = 0;
+    uint64_t calls = 0;
+    if (h->table.process_batch && count > 1) {
+        uint32_t chunk = h->table.max_batch ? h->table.max_batch : count;
+        for (uint32_t done = 0; done < count && ret == 0; done += chunk) {
+            uint32_t n = count - done < chunk ? count - done : chunk;
+            ret = h->table.process_batch(context, inputs + done, outputs + done, n) == 0 ? 0 : -1;
+            calls++;
+        }
+    } else {
+        for (uint32_t i = 0; i < count && ret == 0; i++) {
+            ret = plugin_call(h, context, &inputs[i], &outputs[i]) == 0 ? 0 : -1;
+            calls++;
+        }
+    }
+    uint64_t elapsed = obivox_now_ns() - start;
+
+    mark_views(context, outputs, viewed, count);
+    if (viewed != viewed_local) free(viewed);
+
+    atomic_fetch_add_explicit(&h->calls, calls, memory_order_relaxed);
+    if (ret == 0) {
+        atomic_fetch_add_explicit(&h->items, count, memory_order_relaxed);
+        atomic_fetch_add_explicit(&h->process_ns, elapsed, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&h->failures, 1, memory_order_relaxed);
+    }
+    return ret;
+}
+
+// ============================================================================
+// Context Pool
+// ============================================================================
+
+static bool remember_context(OBIVoxPluginHandle* h, void* context) {
+    if (h->contexts == h->all_capacity) {
+        uint32_t capacity = h->all_capacity ? h->all_capacity * 2 : 4;
+        void** all = realloc(h->all, capacity * sizeof(void*));
+        void** idle = realloc(h->idle, capacity * sizeof(void*));
+        if (all) h->all = all;
+        if (idle) h->idle = idle;
+        if (!all || !idle) return false;
+        h->all_capacity = capacity;
+        h->idle_capacity = capacity;
+    }
+    h->all[h->contexts++] = context;
+    return true;
+}
+
+// exclusive: the caller keeps the context to itself (streams, or plugins
+// that are not thread-safe)
+static int context_acquire(OBIVoxPluginHandle* h, bool exclusive, void** context) {
+    bool thread_safe = (h->table.capabilities & OBIVOX_PLUGIN_CAP_THREAD_SAFE) != 0;
+    if (!exclusive && !thread_safe) exclusive = true;
+
+    pthread_mutex_lock(&h->lock);
+    if (!exclusive && h->shared) {
+        *context = h->shared;
+        pthread_mutex_unlock(&h->lock);
+        return 0;
+    }
+    if (exclusive && h->idle_count > 0) {
+        *context = h->idle[--h->idle_count];
+        pthread_mutex_unlock(&h->lock);
+        return 0;
+    }
+    pthread_mutex_unlock(&h->lock);
+
+    // init runs unlocked: model loads must not stall other callers
+    void* created = NULL;
+    if (plugin_init(h, &created) != 0) return -1;
+
+    pthread_mutex_lock(&h->lock);
+    if (!remember_context(h, created)) {
+        pthread_mutex_unlock(&h->lock);
+        plugin_destroy(h, created);
+        return -1;
+    }
+    if (!exclusive) {
+        if (h->shared) {
+            // Lost a race to create the shared context; pool the spare
+            h->idle[h->idle_count++] = created;
+            created = h->shared;
+        } else {
+            h->shared = created;
+        }
+    }
+    pthread_mutex_unlock(&h->lock);
+
+    *context = created;
+    return 0;
+}
+
+static void context_release(OBIVoxPluginHandle* h, void* context, bool exclusive) {
+    bool thread_safe = (h->table.capabilities & OBIVOX_PLUGIN_CAP_THREAD_SAFE) != 0;
+    if (!exclusive && thread_safe) return;
+
+    if (h->table.reset) h->table.reset(context);
+    pthread_mutex_lock(&h->lock);
+    h->idle[h->idle_count++] = context;
+    pthread_mutex_unlock(&h->lock);
+}
+
+// ============================================================================
+// Registry
+// ============================================================================
+
+int obivox_plugins_create(OBIVoxAtlas* atlas, OBIVoxPluginRegistry** registry) {
+    if (!registry) return -1;
+
+    OBIVoxPluginRegistry* r = calloc(1, sizeof(OBIVoxPluginRegistry));
+    if (!r) return -1;
+    r->atlas = atlas;
+    pthread_mutex_init(&r->lock, NULL);
+    atomic_init(&r->count, 0);
+
+    *registry = r;
+    return 0;
+}
+
+void obivox_plugins_destroy(OBIVoxPluginRegistry* registry) {
+    if (!registry) return;
+
+    uint32_t count = atomic_load_explicit(&registry->count, memory_order_acquire);
+    for (uint32_t i = 0; i < count; i++) {
+        OBIVoxPluginHandle* h = registry->plugins[i];
+        for (uint32_t c = 0; c < h->contexts; c++) plugin_destroy(h, h->all[c]);
+        pthread_mutex_destroy(&h->lock);
+        free(h->all);
+        free(h->idle);
+        free(h);
+    }
+    pthread_mutex_destroy(&registry->lock);
+    free(registry);
+}
+
+static OBIVoxPluginHandle* find_published(OBIVoxPluginRegistry* registry, const char* name) {
+    uint32_t count = atomic_load_explicit(&registry->count, memory_order_acquire);
+    for (uint32_t i = 0; i < count; i++) {
+        if (strcmp(registry->plugins[i]->table.name, name) == 0) return registry->plugins[i];
+    }
+    return NULL;
+}
+
+static int registry_add(OBIVoxPluginRegistry* registry, OBIVoxPluginHandle* h,
+                        OBIVoxPluginHandle** handle) {
+    pthread_mutex_lock(&registry->lock);
+
+    OBIVoxPluginHandle* existing = find_published(registry, h->table.name);
+    uint32_t count = atomic_load_explicit(&registry->count, memory_order_relaxed);
+    if (existing || count == OBIVOX_PLUGIN_MAX) {
+        pthread_mutex_unlock(&registry->lock);
+        free(h);
+        if (handle) *handle = existing;
+        return existing ? 1 : -1;
+    }
+
+    pthread_mutex_init(&h->lock, NULL);
+    atomic_init(&h->calls, 0);
+    atomic_init(&h->items, 0);
+    atomic_init(&h->failures, 0);
+    atomic_init(&h->process_ns, 0);
+
+    // Published after it is complete; readers scan without the lock
+    registry->plugins[count] = h;
+    atomic_store_explicit(&registry->count, count + 1, memory_order_release);
+    pthread_mutex_unlock(&registry->lock);
+
+    // Discoverable through the Atlas; re-registering keeps learned stats
+    if (registry->atlas) {
+        obivox_atlas_update(registry->atlas, OBIVOX_ATLAS_SERVICE_PLUGIN,
+                            h->table.name, NULL, NULL);
+    }
+
+    if (handle) *handle = h;
+    return 0;
+}
+
+int obivox_plugins_register(
+    OBIVoxPluginRegistry* registry,
+    const OBIVoxPluginV2* plugin,
+    OBIVoxPluginHandle** handle) {
+
+    if (!registry || !plugin) return -1;
+    if (plugin->abi_version != OBIVOX_PLUGIN_ABI_VERSION) return -1;
+    if (plugin->struct_size < PLUGIN_V2_MIN_SIZE) return -1;
+
+    OBIVoxPluginHandle* h = calloc(1, sizeof(OBIVoxPluginHandle));
+    if (!h) return -1;
+
+    // Older, shorter tables leave the optional tail zero (absent)
+    size_t copied = plugin->struct_size < sizeof(OBIVoxPluginV2)
+                        ? plugin->struct_size : sizeof(OBIVoxPluginV2);
+    memcpy(&h->table, plugin, copied);
+    h->abi_version = OBIVOX_PLUGIN_ABI_VERSION;
+
+    const OBIVoxPluginV2* t = &h->table;
+    bool views = (t->capabilities & OBIVOX_PLUGIN_CAP_OUTPUT_VIEWS) != 0;
+    if (!t->name || !t->init || !t->destroy || !t->process || (views && !t->release) ||
+        t->input_format > OBIVOX_SAMPLE_U8 || t->output_format > OBIVOX_SAMPLE_U8) {
+        free(h);
+        return -1;
+    }
+    return registry_add(registry, h, handle);
+}
+
+int obivox_plugins_register_v1(
+    OBIVoxPluginRegistry* registry,
+    const OBIVoxPlugin* plugin,
+    OBIVoxPluginHandle** handle) {
+
+    if (!registry || !plugin || !plugin->name || !plugin->init || !plugin->process) return -1;
+
+    OBIVoxPluginHandle* h = calloc(1, sizeof(OBIVoxPluginHandle));
+    if (!h) return -1;
+    h->legacy = *plugin;
+    h->abi_version = 1;
+
+    // Nothing is declared: exclusive contexts, one item per call, any input
+    h->table.abi_version = 1;
+    h->table.struct_size = sizeof(OBIVoxPluginV2);
+    h->table.name = plugin->name;
+    h->table.version = plugin->version;
+    h->table.preferred_batch = 1;
+    h->table.max_batch = 1;
+    return registry_add(registry, h, handle);
+}
+
+OBIVoxPluginHandle* obivox_plugins_find(OBIVoxPluginRegistry* registry, const char* name) {
+    if (!registry || !name) return NULL;
+    return find_published(registry, name);
+}
+
+OBIVoxPluginHandle* obivox_plugins_route(
+    OBIVoxPluginRegistry* registry,
+    const OBIVoxPluginQuery* query) {
+
+    if (!registry || !query) return NULL;
+
+    OBIVoxPluginHandle* best = NULL;
+    double best_ns = 0.0;
+    uint32_t count = atomic_load_explicit(&registry->count, memory_order_acquire);
+    for (uint32_t i = 0; i < count; i++) {
+        OBIVoxPluginHandle* h = registry->plugins[i];
+        const OBIVoxPluginV2* t = &h->table;
+        if (query->name && strcmp(query->name, t->name) != 0) continue;
+        if ((t->capabilities & query->capabilities) != query->capabilities) continue;
+        if (t->input_format != OBIVOX_SAMPLE_BYTES && t->input_format != query->input_format) continue;
+        if (t->output_format != OBIVOX_SAMPLE_BYTES && t->output_format != query->output_format) continue;
+        if (t->input_rate && query->input_rate && t->input_rate != query->input_rate) continue;
+
+        uint64_t items = atomic_load_explicit(&h->items, memory_order_relaxed);
+        double per_item = items
+            ? (double)atomic_load_explicit(&h->process_ns, memory_order_relaxed) / (double)items
+            : 0.0;
+        if (!best || per_item < best_ns) {
+            best = h;
+            best_ns = per_item;
+        }
+    }
+    return best;
+}
+
+int obivox_plugin_info(const OBIVoxPluginHandle* handle, OBIVoxPluginInfo* info) {
+    if (!handle || !info) return -1;
+    const OBIVoxPluginV2* t = &handle->table;
+    info->name = t->name;
+    info->version = t->version;
+    info->abi_version = handle->abi_version;
+    info->capabilities = t->capabilities;
+    info->preferred_batch = t->preferred_batch ? t->preferred_batch : 1;
+    info->max_batch = t->max_batch;
+    info->input_format = t->input_format;
+    info->output_format = t->output_format;
+    info->input_rate = t->input_rate;
+    return 0;
+}
+
+void obivox_plugin_stats(OBIVoxPluginHandle* handle, OBIVoxPluginStats* stats) {
+    if (!handle || !stats) return;
+    stats->calls = atomic_load_explicit(&handle->calls, memory_order_relaxed);
+    stats->items = atomic_load_explicit(&handle->items, memory_order_relaxed);
+    stats->failures = atomic_load_explicit(&handle->failures, memory_order_relaxed);
+    stats->process_ns = atomic_load_explicit(&handle->process_ns, memory_order_relaxed);
+    pthread_mutex_lock(&handle->lock);
+    stats->contexts = handle->contexts;
+    stats->idle = handle->idle_count + (handle->shared ? 1 : 0);
+    stats->streams = handle->streams;
+    pthread_mutex_unlock(&handle->lock);
+}
+
+// ============================================================================
+// Processing
+// ============================================================================
+
+int obivox_plugin_process(
+    OBIVoxPluginHandle* handle,
+    const OBIVoxBuffer* input,
+    OBIVoxBuffer* output) {
+
+    return obivox_plugin_process_batch(handle, input, output, 1);
+}
+
+int obivox_plugin_process_batch(
+    OBIVoxPluginHandle* handle,
+    const OBIVoxBuffer* inputs,
+    OBIVoxBuffer* outputs,
+    uint32_t count) {
+
+    if (!handle || !inputs || !outputs) return -1;
+    if (count == 0) return 0;
+
+    void* context = NULL;
+    if (context_acquire(handle, false, &context) != 0) return -1;
+    int ret = run_items(handle, context, inputs, outputs, count);
+    context_release(handle, context, false);
+    return ret;
+}
+
+void obivox_plugin_release(OBIVoxPluginHandle* handle, OBIVoxBuffer* view) {
+    if (!handle || !view || !(view->flags & OBIVOX_BUFFER_VIEW)) return;
+    if (handle->table.release) handle->table.release(view->owner, view);
+    view->data = NULL;
+    view->bytes = 0;
+    view->frames = 0;
+    view->flags &= ~OBIVOX_BUFFER_VIEW;
+    view->owner = NULL;
+}
+
+int obivox_plugin_stream_open(OBIVoxPluginHandle* handle, OBIVoxPluginStream** stream) {
+    if (!handle || !stream) return -1;
+
+    OBIVoxPluginStream* s = calloc(1, sizeof(OBIVoxPluginStream));
+    if (!s) return -1;
+    s->handle = handle;
+
+    // Streaming state is per context, so only stateless thread-safe
+    // plugins share theirs
+    const OBIVoxPluginV2* t = &handle->table;
+    s->exclusive = (t->capabilities & OBIVOX_PLUGIN_CAP_STREAMING) ||
+                   !(t->capabilities & OBIVOX_PLUGIN_CAP_THREAD_SAFE);
+    if (context_acquire(handle, s->exclusive, &s->context) != 0) {
+        free(s);
+        return -1;
+    }
+
+    pthread_mutex_lock(&handle->lock);
+    handle->streams++;
+    pthread_mutex_unlock(&handle->lock);
+
+    *stream = s;
+    return 0;
+}
+
+int obivox_plugin_stream_process(
+    OBIVoxPluginStream* stream,
+    const OBIVoxBuffer* input,
+    OBIVoxBuffer* output) {
+
+    if (!stream || !input || !output) return -1;
+    return run_items(stream->handle, stream->context, input, output, 1);
+}
+
+int obivox_plugin_stream_flush(OBIVoxPluginStream* stream, OBIVoxBuffer* output) {
+    if (!stream || !output) return -1;
+
+    OBIVoxPluginHandle* h = stream->handle;
+    if (!h->table.flush) {
+        if (output->data) output->bytes = 0;
+        output->frames = 0;
+        return 0;
+    }
+    if (!output->data && !(h->table.capabilities & OBIVOX_PLUGIN_CAP_OUTPUT_VIEWS)) return -1;
+
+    bool viewed = output->data == NULL;
+    int ret = h->table.flush(stream->context, output) == 0 ? 0 : -1;
+    mark_views(stream->context, output, &viewed, 1);
+    return ret;
+}
+
+void obivox_plugin_stream_close(OBIVoxPluginStream* stream) {
+    if (!stream) return;
+
+    OBIVoxPluginHandle* h = stream->handle;
+    context_release(h, stream->context, stream->exclusive);
+    pthread_mutex_lock(&h->lock);
+    h->streams--;
+    pthread_mutex_unlock(&h->lock);
+    free(stream);
+}
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+int obivox_nlm_attach_plugins(OBIVoxNLMSystem* system, OBIVoxPluginRegistry* registry) {
+    if (!system) return -1;
+    system->plugins = registry;
+    return 0;
+}
@@ -0,0 +1,304 @@
+/**
+ * obivox_pool.c
+ * Work-stealing worker pool: one deque per worker, owners pop their newest
+ * task, idle workers steal the oldest task from a peer
+ */
+
+#include "obivox/nlm_engine.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define DEQUE_INITIAL_CAPACITY  64
+
+typedef struct {
+    OBIVoxTaskFn fn;
+    void* arg;
+} PoolTask;
+
+typedef struct pool_worker {
+    struct obivox_worker_pool* pool;
+    uint32_t index;
+    pthread_t thread;
+    OBIVoxSession* session;
+
+    // Ring deque: top = head (oldest, stolen), bottom = head + count
+    pthread_mutex_t lock;
+    PoolTask* tasks;
+    uint32_t capacity;
+    uint32_t head;
+    uint32_t count;
+
+    atomic_uint_fast64_t stolen;
+} PoolWorker;
+
+struct obivox_worker_pool {
+    PoolWorker* workers;
+    uint32_t num_workers;
+    uint32_t started;
+
+    // Sleep / completion bookkeeping
+    pthread_mutex_t idle_lock;
+    pthread_cond_t work_available;
+    pthread_cond_t all_done;
+    uint64_t pending;      // Submitted and not yet finished
+    uint64_t submitted;
+    bool shutdown;
+
+    atomic_int queued;     // Tasks sitting in deques
+    atomic_uint next_worker;
+};
+
+static _Thread_local PoolWorker* current_worker;
+
+// ============================================================================
+// Per-Worker Deque
+// ============================================================================
+
+static int deque_push(PoolWorker* w, PoolTask task) {
+    pthread_mutex_lock(&w->lock);
+    if (w->count == w->capacity) {
+        uint32_t capacity = w->capacity ? w->capacity * 2 : DEQUE_INITIAL_CAPACITY;
+        PoolTask* grown = malloc(capacity * sizeof(PoolTask));
+        if (!grown) {
+            pthread_mutex_unlock(&w->lock);
+            return -1;
+        }
+        for (uint32_t i = 0; i < w->count; i++) {
+            grown[i] = w->tasks[(w->head + i) % w->capacity];
+        }
+        free(w->tasks);
+        w->tasks = grown;
+        w->capacity = capacity;
+        w->head = 0;
+    }
+    w->tasks[(w->head + w->count) % w->capacity] = task;
+    w->count++;
+    pthread_mutex_unlock(&w->lock);
+    return 0;
+}
+
+// Owner end: newest task, keeps the working set hot in this core's cache
+static bool deque_pop_bottom(PoolWorker* w, PoolTask* task) {
+    pthread_mutex_lock(&w->lock);
+    bool found = w->count > 0;
+    if (found) {
+        w->count--;
+        *task = w->tasks[(w->head + w->count) % w->capacity];
+    }
+    pthread_mutex_unlock(&w->lock);
+    return found;
+}
+
+// Thief end: oldest task, least likely to share data with the owner
+static bool deque_steal_top(PoolWorker* w, PoolTask* task) {
+    if (pthread_mutex_trylock(&w->lock) != 0) return false;
+    bool found = w->count > 0;
+    if (found) {
+        *task = w->tasks[w->head];
+        w->head = (w->head + 1) % w->capacity;
+        w->count--;
+    }
+    pthread_mutex_unlock(&w->lock);
+    return found;
+}
+
+// ============================================================================
+// Worker Loop
+// ============================================================================
+
+static bool worker_find_task(PoolWorker* self, PoolTask* task) {
+    OBIVoxWorkerPool* pool = self->pool;
+
+    if (deque_pop_bottom(self, task)) return true;
+
+    for (uint32_t i = 1; i < pool->num_workers; i++) {
+        PoolWorker* victim = &pool->workers[(self->index + i) % pool->num_workers];
+        if (deque_steal_top(victim, task)) {
+            atomic_fetch_add_explicit(&self->stolen, 1, memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void* worker_main(void* arg) {
+    PoolWorker* self = arg;
+    OBIVoxWorkerPool* pool = self->pool;
+    current_worker = self;
+
+    for (;;) {
+        PoolTask task;
+        if (worker_find_task(self, &task)) {
+            atomic_fetch_sub_explicit(&pool->queued, 1, memory_order_relaxed);
+            task.fn(self->session, task.arg);
+
+            pthread_mutex_lock(&pool->idle_lock);
+            if (--pool->pending == 0) {
+                pthread_cond_broadcast(&pool->all_done);
+            }
+            pthread_mutex_unlock(&pool->idle_lock);
+            continue;
+        }
+
+        // Nothing local or stealable: sleep until a submit or shutdown.
+        // Submitters bump queued under idle_lock, so no wakeup is lost
+        pthread_mutex_lock(&pool->idle_lock);
+        while (atomic_load_explicit(&pool->queued, memory_order_relaxed) <= 0 &&
+               !pool->shutdown) {
+            pthread_cond_wait(&pool->work_available, &pool->idle_lock);
+        }
+        bool done = pool->shutdown &&
+                    atomic_load_explicit(&pool->queued, memory_order_relaxed) <= 0;
+        pthread_mutex_unlock(&pool->idle_lock);
+        if (done) break;
+    }
+
+    current_worker = NULL;
+    return NULL;
+}
+
+// ============================================================================
+// Pool API
+// ============================================================================
+
+int obivox_pool_create(
+    OBIVoxEngine* engine,
+    uint32_t num_workers,
+    OBIVoxWorkerPool** pool) {
+
+    if (!pool) return -1;
+
+    if (num_workers == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        num_workers = online > 0 ? (uint32_t)online : 1;
+    }
+
+    OBIVoxWorkerPool* p = calloc(1, sizeof(OBIVoxWorkerPool));
+    if (!p) return -1;
+
+    p->workers = calloc(num_workers, sizeof(PoolWorker));
+    if (!p->workers) {
+        free(p);
+        return -1;
+    }
+    p->num_workers = num_workers;
+    pthread_mutex_init(&p->idle_lock, NULL);
+    pthread_cond_init(&p->work_available, NULL);
+    pthread_cond_init(&p->all_done, NULL);
+    atomic_init(&p->queued, 0);
+    atomic_init(&p->next_worker, 0);
+
+    for (uint32_t i = 0; i < num_workers; i++) {
+        PoolWorker* w = &p->workers[i];
+        w->pool = p;
+        w->index = i;
+        pthread_mutex_init(&w->lock, NULL);
+        if (engine && obivox_session_open(engine, &w->session) != 0) {
+            obivox_pool_destroy(p);
+            return -1;
+        }
+
+        // Tasks split their feature extraction across this same pool
+        if (w->session &&
+            obivox_nlm_attach_pool(obivox_session_system(w->session), p) != 0) {
+            obivox_pool_destroy(p);
+            return -1;
+        }
+    }
+
+    for (uint32_t i = 0; i < num_workers; i++) {
+        if (pthread_create(&p->workers[i].thread, NULL, worker_main, &p->workers[i]) != 0) {
+            obivox_pool_destroy(p);
+            return -1;
+        }
+        p->started++;
+    }
+
+    *pool = p;
+    return 0;
+}
+
+int obivox_pool_submit(OBIVoxWorkerPool* pool, OBIVoxTaskFn fn, void* arg) {
+    if (!pool || !fn) return -1;
+
+    PoolWorker* target = current_worker;
+    if (!target || target->pool != pool) {
+        uint32_t next = atomic_fetch_add_explicit(&pool->next_worker, 1, memory_order_relaxed);
+        target = &pool->workers[next % pool->num_workers];
+    }
+
+    // Count the task before it becomes stealable: a worker that runs it
+    // first must not take pending to zero (or below) under a live wait
+    pthread_mutex_lock(&pool->idle_lock);
+    pool->pending++;
+    pool->submitted++;
+    atomic_fetch_add_explicit(&pool->queued, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&pool->idle_lock);
+
+    PoolTask task = { fn, arg };
+    int ret = deque_push(target, task);
+
+    pthread_mutex_lock(&pool->idle_lock);
+    if (ret != 0) {
+        pool->pending--;
+        pool->submitted--;
+        atomic_fetch_sub_explicit(&pool->queued, 1, memory_order_relaxed);
+        if (pool->pending == 0) pthread_cond_broadcast(&pool->all_done);
+    } else {
+        pthread_cond_signal(&pool->work_available);
+    }
+    pthread_mutex_unlock(&pool->idle_lock);
+    return ret;
+}
+
+void obivox_pool_wait(OBIVoxWorkerPool* pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->idle_lock);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->all_done, &pool->idle_lock);
+    }
+    pthread_mutex_unlock(&pool->idle_lock);
+}
+
+void obivox_pool_stats(OBIVoxWorkerPool* pool, OBIVoxPoolStats* stats) {
+    if (!pool || !stats) return;
+
+    pthread_mutex_lock(&pool->idle_lock);
+    stats->workers = pool->num_workers;
+    stats->submitted = pool->submitted;
+    stats->executed = pool->submitted - pool->pending;
+    pthread_mutex_unlock(&pool->idle_lock);
+
+    stats->stolen = 0;
+    for (uint32_t i = 0; i < pool->num_workers; i++) {
+        stats->stolen += atomic_load_explicit(&pool->workers[i].stolen, memory_order_relaxed);
+    }
+}
+
+void obivox_pool_destroy(OBIVoxWorkerPool* pool) {
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->idle_lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_available);
+    pthread_mutex_unlock(&pool->idle_lock);
+
+    for (uint32_t i = 0; i < pool->started; i++) {
+        pthread_join(pool->workers[i].thread, NULL);
+    }
+
+    for (uint32_t i = 0; i < pool->num_workers; i++) {
+        PoolWorker* w = &pool->workers[i];
+        obivox_session_close(w->session);
+        pthread_mutex_destroy(&w->lock);
+        free(w->tasks);
+    }
+
+    pthread_cond_destroy(&pool->all_done);
+    pthread_cond_destroy(&pool->work_available);
+    pthread_mutex_destroy(&pool->idle_lock);
+    free(pool->workers);
+    free(pool);
+}
@@ -0,0 +1,349 @@
+/**
+ * obivox_snapshot.c
+ * System snapshots: a header, a fixed-layout system record, a string pool
+ * and the Atlas index and lexicon images, each section at a 64-byte
+ * offset. Nothing holds a pointer, so the file maps at any address
+ */
+
+#include "obivox/nlm_snapshot.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SNAPSHOT_MAGIC       "OBVXSNP"
+#define SNAPSHOT_VERSION     1
+#define SNAPSHOT_BYTE_ORDER  0x01020304u
+#define SNAPSHOT_ALIGN       64
+#define SNAPSHOT_DIALECTS    16
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;        // SNAPSHOT_BYTE_ORDER as the writer saw it
+    uint32_t entry_bytes;       // sizeof(OBIVoxAtlasEntry) of the writer
+    uint32_t reserved;
+    uint64_t system_offset;     // SnapshotSystem
+    uint64_t strings_offset;    // NUL-terminated dialect markers
+    uint64_t strings_bytes;
+    uint64_t atlas_offset;      // obivox_atlas_index_serialize image
+    uint64_t atlas_bytes;
+    uint64_t lexicon_offset;    // obivox_lexicon_blob, 0 bytes = built-in
+    uint64_t lexicon_bytes;
+    uint64_t total_bytes;
+} SnapshotHeader;
+
+// Fixed-width copy of the configuration scalars of OBIVoxNLMSystem
+typedef struct {
+    float position[4];          // x, y, z, confidence
+    float coherence_threshold;
+    float variation_tolerance;
+    float phenomenological_integrity;
+    float experiential_authenticity;
+    uint32_t normalization_mode;
+    uint32_t tree_mode;
+    int32_t active_codec;
+    int32_t selected_codec;
+    uint8_t lisp_mitigation;
+    uint8_t stutter_detection;
+    uint8_t accent_normalization;
+    uint8_t fault_tolerance_enabled;
+    uint32_t dialect_count;
+    uint32_t dialect_offsets[SNAPSHOT_DIALECTS];
+} SnapshotSystem;
+
+struct obivox_snapshot {
+    uint8_t* base;
+    size_t bytes;
+    const SnapshotHeader* header;
+    const SnapshotSystem* system;
+    const char* strings;
+
+    // Views over the mapping
+    OBIVoxAtlasIndex* atlas;
+    OBIVoxLexicon* lexicon;
+};
+
+static uint64_t snapshot_align(uint64_t offset) {
+    return (offset + SNAPSHOT_ALIGN - 1) & ~(uint64_t)(SNAPSHOT_ALIGN - 1);
+}
+
+// ============================================================================
+// Save
+// ============================================================================
+
+static void capture_system(const OBIVoxNLMSystem* system, SnapshotSystem* out,
+                           char* strings, uint64_t* strings_bytes) {
+    memset(out, 0, sizeof(*out));
+    out->position[0] = system->current_position.x_axis;
+    out->position[1] = system->current_position.y_axis;
+    out->position[2] = system->current_position.z_axis;
+    out->position[3] = system->current_position.confidence;
+    out->coherence_threshold = system->coherence_threshold;
+
+    const PhoneticAccessibility* a = &system->accessibility;
+    out->variation_tolerance = a->variation_tolerance;
+    out->phenomenological_integrity = a->phenomenological_integrity;
+    out->experiential_authenticity = a->experiential_authenticity;
+    out->normalization_mode = (uint32_t)a->normalization_mode;
+    out->lisp_mitigation = a->lisp_mitigation;
+    out->stutter_detection = a->stutter_detection;
+    out->accent_normalization = a->accent_normalization;
+    out->fault_tolerance_enabled = system->fault_tolerance_enabled;
+
+    out->tree_mode = (uint32_t)system->current_tree_mode;
+    out->active_codec = (int32_t)system->codec_engine.active_codec;
+    out->selected_codec = system->codec_engine.selected_codec;
+
+    // Markers are packed in order; NULL entries are dropped
+    uint64_t used = 0;
+    for (uint8_t i = 0; i < a->dialect_count && i < SNAPSHOT_DIALECTS; i++) {
+        const char* marker = a->dialect_markers[i];
+        if (!marker) continue;
+        size_t length = strlen(marker) + 1;
+        if (strings) memcpy(strings + used, marker, length);
+        out->dialect_offsets[out->dialect_count++] = (uint32_t)used;
+        used += length;
+    }
+    *strings_bytes = used;
+}
+
+static int write_all(int fd, const void* data, size_t bytes) {
+    const uint8_t* p = data;
+    while (bytes > 0) {
+        ssize_t n = write(fd, p, bytes);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -1;
+        p += n;
+        bytes -= (size_t)n;
+    }
+    return 0;
+}
+
+int obivox_snapshot_save(OBIVoxNLMSystem* system, const char* path) {
+    if (!system || !system->atlas || !path) return -1;
+
+    OBIVoxAtlasIndex* index = NULL;
+    if (obivox_atlas_build_index(system->atlas, &index) != 0) return -1;
+
+    size_t atlas_bytes = 0;
+    size_t lexicon_bytes = 0;
+    const void* lexicon = system->lexicon ? obivox_lexicon_blob(system->lexicon, &lexicon_bytes) : NULL;
+    obivox_atlas_index_serialize(index, NULL, 0, &atlas_bytes);
+
+    SnapshotSystem record;
+    uint64_t strings_bytes = 0;
+    capture_system(system, &record, NULL, &strings_bytes);
+
+    SnapshotHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    h.version = SNAPSHOT_VERSION;
+    h.byte_order = SNAPSHOT_BYTE_ORDER;
+    h.entry_bytes = sizeof(OBIVoxAtlasEntry);
+    h.system_offset = snapshot_align(sizeof(SnapshotHeader));
+    h.strings_offset = snapshot_align(h.system_offset + sizeof(SnapshotSystem));
+    h.strings_bytes = strings_bytes;
+    h.atlas_offset = snapshot_align(h.strings_offset + strings_bytes);
+    h.atlas_bytes = atlas_bytes;
+    h.lexicon_offset = snapshot_align(h.atlas_offset + atlas_bytes);
+    h.lexicon_bytes = lexicon_bytes;
+    h.total_bytes = snapshot_align(h.lexicon_offset + lexicon_bytes);
+
+    // Build the whole image, then write it once
+    uint8_t* image = calloc(1, (size_t)h.total_bytes);
+    if (!image) {
+        obivox_atlas_index_destroy(index);
+        return -1;
+    }
+    memcpy(image, &h, sizeof(h));
+    capture_system(system, &record, (char*)image + h.strings_offset, &strings_bytes);
+    memcpy(image + h.system_offset, &record, sizeof(record));
+    int ret = obivox_atlas_index_serialize(index, image + h.atlas_offset, atlas_bytes, &atlas_bytes);
+    if (lexicon) memcpy(image + h.lexicon_offset, lexicon, lexicon_bytes);
+    obivox_atlas_index_destroy(index);
+
+    // Truncating a file someone has mapped would fault their reads, so
+    // the new image goes to a private name and replaces the old by rename
+    char temporary[4096];
+    int fd = -1;
+    if (ret == 0 &&
+        snprintf(temporary, sizeof(temporary), "%s.%ld.tmp", path, (long)getpid()) < (int)sizeof(temporary)) {
+        fd = open(temporary, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    }
+    if (fd < 0) {
+        free(image);
+        return -1;
+    }
+    ret = write_all(fd, image, (size_t)h.total_bytes);
+    if (fsync(fd) != 0) ret = -1;
+    if (close(fd) != 0) ret = -1;
+    free(image);
+
+    if (ret == 0 && rename(temporary, path) != 0) ret = -1;
+    if (ret != 0) unlink(temporary);
+    return ret;
+}
+
+// ============================================================================
+// Open
+// ============================================================================
+
+static bool section_valid(uint64_t offset, uint64_t bytes, uint64_t total) {
+    return offset % SNAPSHOT_ALIGN == 0 && offset <= total && bytes <= total - offset;
+}
+
+static bool snapshot_valid(const SnapshotHeader* h, size_t bytes) {
+    if (bytes < sizeof(SnapshotHeader)) return false;
+    if (memcmp(h->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) return false;
+    if (h->version != SNAPSHOT_VERSION || h->byte_order != SNAPSHOT_BYTE_ORDER) return false;
+    if (h->entry_bytes != sizeof(OBIVoxAtlasEntry) || h->total_bytes != bytes) return false;
+    if (h->system_offset < sizeof(SnapshotHeader) ||
+        !section_valid(h->system_offset, sizeof(SnapshotSystem), bytes)) return false;
+    if (!section_valid(h->strings_offset, h->strings_bytes, bytes)) return false;
+    if (!section_valid(h->atlas_offset, h->atlas_bytes, bytes)) return false;
+    if (!section_valid(h->lexicon_offset, h->lexicon_bytes, bytes)) return false;
+
+    const uint8_t* base = (const uint8_t*)h;
+    const SnapshotSystem* s = (const SnapshotSystem*)(base + h->system_offset);
+    if (s->dialect_count > SNAPSHOT_DIALECTS) return false;
+    if (s->dialect_count > 0 &&
+        (h->strings_bytes == 0 || base[h->strings_offset + h->strings_bytes - 1] != '\0')) return false;
+    for (uint32_t i = 0; i < s->dialect_count; i++) {
+        if (s->dialect_offsets[i] >= h->strings_bytes) return false;
+    }
+    return s->tree_mode <= TREE_MODE_HYBRID &&
+           s->active_codec >= CODEC_WHISPER && s->active_codec <= CODEC_ADAPTIVE;
+}
+
+int obivox_snapshot_open(const char* path, OBIVoxSnapshot** snapshot) {
+    if (!path || !snapshot) return -1;
+    *snapshot = NULL;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return -1;
+    }
+    size_t bytes = (size_t)st.st_size;
+
+    // Shared and read-only: every process maps the same page-cache pages
+    void* map = mmap(NULL, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    OBIVoxSnapshot* s = calloc(1, sizeof(OBIVoxSnapshot));
+    if (!s) {
+        munmap(map, bytes);
+        return -1;
+    }
+    s->base = map;
+    s->bytes = bytes;
+    s->header = map;
+
+    const SnapshotHeader* h = s->header;
+    if (!snapshot_valid(h, bytes) ||
+        obivox_atlas_index_open(s->base + h->atlas_offset, (size_t)h->atlas_bytes, &s->atlas) != 0 ||
+        (h->lexicon_bytes > 0 &&
+         obivox_lexicon_open(s->base + h->lexicon_offset, (size_t)h->lexicon_bytes, &s->lexicon) != 0)) {
+        obivox_snapshot_close(s);
+        return -1;
+    }
+    s->system = (const SnapshotSystem*)(s->base + h->system_offset);
+    s->strings = (const char*)(s->base + h->strings_offset);
+
+    *snapshot = s;
+    return 0;
+}
+
+void obivox_snapshot_close(OBIVoxSnapshot* snapshot) {
+    if (!snapshot) return;
+    obivox_lexicon_destroy(snapshot->lexicon);
+    obivox_atlas_index_destroy(snapshot->atlas);
+    munmap(snapshot->base, snapshot->bytes);
+    free(snapshot);
+}
+
+void obivox_snapshot_info(const OBIVoxSnapshot* snapshot, OBIVoxSnapshotInfo* info) {
+    if (!info) return;
+    memset(info, 0, sizeof(*info));
+    if (!snapshot) return;
+
+    info->version = snapshot->header->version;
+    info->bytes = snapshot->bytes;
+    info->atlas_entries = obivox_atlas_index_count(snapshot->atlas);
+    info->dialects = snapshot->system->dialect_count;
+    if (snapshot->lexicon) {
+        OBIVoxLexiconStats stats;
+        obivox_lexicon_stats(snapshot->lexicon, &stats);
+        info->lexicon_entries = stats.entries;
+    }
+}
+
+const OBIVoxAtlasIndex* obivox_snapshot_atlas(const OBIVoxSnapshot* snapshot) {
+    return snapshot ? snapshot->atlas : NULL;
+}
+
+OBIVoxLexicon* obivox_snapshot_lexicon(const OBIVoxSnapshot* snapshot) {
+    return snapshot ? snapshot->lexicon : NULL;
+}
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+int obivox_nlm_apply_snapshot(OBIVoxNLMSystem* system, const OBIVoxSnapshot* snapshot) {
+    if (!system || !system->atlas || !snapshot) return -1;
+
+    // Mode only after the contents loaded, so a failed load leaves the
+    // Atlas as it was; on any failure the rest of the system is untouched
+    const SnapshotSystem* s = snapshot->system;
+    if (obivox_atlas_load_index(system->atlas, snapshot->atlas) != 0) return -1;
+    if (obivox_atlas_set_mode(system->atlas, (TreeMode)s->tree_mode) != 0) return -1;
+    system->current_tree_mode = (TreeMode)s->tree_mode;
+
+    system->current_position.x_axis = s->position[0];
+    system->current_position.y_axis = s->position[1];
+    system->current_position.z_axis = s->position[2];
+    system->current_position.confidence = s->position[3];
+    system->coherence_threshold = s->coherence_threshold;
+    system->fault_tolerance_enabled = s->fault_tolerance_enabled != 0;
+
+    PhoneticAccessibility* a = &system->accessibility;
+    a->lisp_mitigation = s->lisp_mitigation != 0;
+    a->stutter_detection = s->stutter_detection != 0;
+    a->accent_normalization = s->accent_normalization != 0;
+    a->variation_tolerance = s->variation_tolerance;
+    a->normalization_mode = (NormalizationMode)s->normalization_mode;
+    a->phenomenological_integrity = s->phenomenological_integrity;
+    a->experiential_authenticity = s->experiential_authenticity;
+
+    // Borrowed from the read-only mapping, like caller-supplied markers
+    memset(a->dialect_markers, 0, sizeof(a->dialect_markers));
+    a->dialect_count = (uint8_t)s->dialect_count;
+    for (uint32_t i = 0; i < s->dialect_count; i++) {
+        a->dialect_markers[i] = (char*)(snapshot->strings + s->dialect_offsets[i]);
+    }
+
+    system->codec_engine.active_codec = s->active_codec;
+    system->codec_engine.selected_codec = s->selected_codec;
+    system->lexicon = snapshot->lexicon;
+    return 0;
+}
+
+int obivox_nlm_init_snapshot(const OBIVoxSnapshot* snapshot, OBIVoxNLMSystem** system) {
+    if (!system) return -1;
+    if (obivox_nlm_init(system) != 0) return -1;
+    if (snapshot && obivox_nlm_apply_snapshot(*system, snapshot) != 0) {
+        obivox_nlm_destroy(*system);
+        *system = NULL;
+        return -1;
+    }
+    return 0;
+}
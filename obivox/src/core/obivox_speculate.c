@@ -0,0 +1,367 @@
+/**
+ * obivox_speculate.c
+ * Fast codec inline, slow codec on the worker pool; cancellation is a
+ * flag the backend polls, and a slow job cancelled before it starts never
+ * takes a context
+ */
+
+#include "obivox/nlm_speculate.h"
+#include "core/nlm_internal.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AGREEMENT_MAX_WORDS  512
+
+struct obivox_speculator {
+    OBIVoxModelManager* models;
+    OBIVoxWorkerPool* pool;
+    OBIVoxSpeculateConfig config;
+
+    pthread_mutex_t lock;
+    OBIVoxSpeculateStats stats;
+};
+
+// Who owns a queued job: the pool task once it starts, or the caller
+// when it cancels first - then the task only frees it
+enum {
+    JOB_QUEUED = 0,
+    JOB_RUNNING,
+    JOB_ABANDONED
+};
+
+typedef struct {
+    OBIVoxSpeculator* owner;
+    OBIVoxBatchItem item;
+    char text[OBIVOX_SPECULATE_TEXT_MAX];
+    atomic_bool cancel;
+    atomic_int state;
+    bool ran;                  // Reached the backend
+
+    pthread_mutex_t lock;
+    pthread_cond_t finished;
+    bool done;
+    uint64_t run_ns;
+    uint64_t stopped_ns;
+} SlowJob;
+
+// ============================================================================
+// Speculator Lifecycle
+// ============================================================================
+
+void obivox_speculate_config_default(OBIVoxSpeculateConfig* config) {
+    if (!config) return;
+    config->fast_codec = CODEC_VOSK;
+    config->slow_codec = CODEC_WHISPER;
+    config->accept_confidence = 0.85f;
+    config->agreement_threshold = 0.8f;
+    config->cancel_grace_us = 20000;
+}
+
+int obivox_speculate_create(
+    OBIVoxModelManager* models,
+    OBIVoxWorkerPool* pool,
+    const OBIVoxSpeculateConfig* config,
+    OBIVoxSpeculator** speculator) {
+
+    if (!models || !speculator) return -1;
+
+    OBIVoxSpeculateConfig defaults;
+    if (!config) {
+        obivox_speculate_config_default(&defaults);
+        config = &defaults;
+    }
+    if (config->fast_codec < 0 || config->fast_codec >= OBIVOX_MODEL_CODECS ||
+        config->slow_codec < 0 || config->slow_codec >= OBIVOX_MODEL_CODECS ||
+        config->fast_codec == config->slow_codec) {
+        return -1;
+    }
+
+    OBIVoxSpeculator* s = calloc(1, sizeof(OBIVoxSpeculator));
+    if (!s) return -1;
+
+    s->models = models;
+    s->pool = pool;
+    s->config = *config;
+    pthread_mutex_init(&s->lock, NULL);
+
+    *speculator = s;
+    return 0;
+}
+
+void obivox_speculate_destroy(OBIVoxSpeculator* speculator) {
+    if (!speculator) return;
+    pthread_mutex_destroy(&speculator->lock);
+    free(speculator);
+}
+
+// ============================================================================
+// Codec Execution
+// ============================================================================
+
+// One item through a pooled context; *ran tells whether the backend was
+// reached, which a cancel raised while waiting for a context prevents
+static void run_codec(
+    OBIVoxSpeculator* s,
+    int codec,
+    OBIVoxBatchItem* item,
+    bool* ran) {
+
+    *ran = false;
+    item->status = -1;
+
+    const OBIVoxModelBackend* backend = obivox_models_backend(s->models, codec);
+    if (!backend || !backend->run_batch) return;
+
+    if (item->cancel && atomic_load(item->cancel)) {
+        item->status = OBIVOX_BATCH_CANCELLED;
+        return;
+    }
+
+    void* context = NULL;
+    if (obivox_models_acquire(s->models, codec, true, &context) != 0) return;
+
+    if (item->cancel && atomic_load(item->cancel)) {
+        item->status = OBIVOX_BATCH_CANCELLED;
+    } else {
+        *ran = true;
+        item->status = 0;
+        if (backend->run_batch(context, item, 1) != 0 && item->status == 0) {
+            item->status = -1;
+        }
+    }
+    obivox_models_release(s->models, codec, context);
+}
+
+static void slow_job_free(SlowJob* job) {
+    pthread_cond_destroy(&job->finished);
+    pthread_mutex_destroy(&job->lock);
+    free(job);
+}
+
+static void slow_task(OBIVoxSession* session, void* arg) {
+    (void)session;
+    SlowJob* job = arg;
+
+    // Cancelled while queued: the caller has already returned
+    int expected = JOB_QUEUED;
+    if (!atomic_compare_exchange_strong(&job->state, &expected, JOB_RUNNING)) {
+        slow_job_free(job);
+        return;
+    }
+
+    uint64_t start = obivox_now_ns();
+    run_codec(job->owner, job->owner->config.slow_codec, &job->item, &job->ran);
+    uint64_t stopped = obivox_now_ns();
+
+    // The caller may free the job as soon as done is visible
+    pthread_mutex_lock(&job->lock);
+    job->run_ns = stopped - start;
+    job->stopped_ns = stopped;
+    job->done = true;
+    pthread_cond_signal(&job->finished);
+    pthread_mutex_unlock(&job->lock);
+}
+
+// ============================================================================
+// Cross-Codec Agreement
+// ============================================================================
+
+static uint32_t tokenize(const char* text, uint32_t* words) {
+    uint32_t count = 0;
+    const unsigned char* p = (const unsigned char*)text;
+
+    while (*p && count < AGREEMENT_MAX_WORDS) {
+        while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') p++;
+        if (!*p) break;
+
+        // FNV-1a, case-folded
+        uint32_t hash = 2166136261u;
+        while (*p && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r') {
+            unsigned char c = *p++;
+            if (c >= 'A' && c <= 'Z') c = (unsigned char)(c - 'A' + 'a');
+            hash = (hash ^ c) * 16777619u;
+        }
+        words[count++] = hash;
+    }
+    return count;
+}
+
+float obivox_transcript_agreement(const char* a, const char* b) {
+    if (!a || !b) return 0.0f;
+
+    uint32_t wa[AGREEMENT_MAX_WORDS];
+    uint32_t wb[AGREEMENT_MAX_WORDS];
+    uint32_t na = tokenize(a, wa);
+    uint32_t nb = tokenize(b, wb);
+    if (na == 0 && nb == 0) return 1.0f;
+
+    // Two-row word edit distance
+    uint32_t rows[2][AGREEMENT_MAX_WORDS + 1];
+    uint32_t* prev = rows[0];
+    uint32_t* curr = rows[1];
+    for (uint32_t j = 0; j <= nb; j++) prev[j] = j;
+
+    for (uint32_t i = 1; i <= na; i++) {
+        curr[0] = i;
+        for (uint32_t j = 1; j <= nb; j++) {
+            uint32_t substitute = prev[j - 1] + (wa[i - 1] != wb[j - 1]);
+            uint32_t remove = prev[j] + 1;
+            uint32_t insert = curr[j - 1] + 1;
+            uint32_t best = substitute < remove ? substitute : remove;
+            curr[j] = best < insert ? best : insert;
+        }
+        uint32_t* swap = prev;
+        prev = curr;
+        curr = swap;
+    }
+
+    uint32_t longest = na > nb ? na : nb;
+    return 1.0f - (float)prev[nb] / (float)longest;
+}
+
+// ============================================================================
+// Speculative Run
+// ============================================================================
+
+int obivox_speculate_run(
+    OBIVoxSpeculator* speculator,
+    const float* audio,
+    uint32_t num_samples,
+    uint32_t sample_rate,
+    char* text,
+    size_t text_capacity,
+    OBIVoxSpeculateResult* result) {
+
+    OBIVoxSpeculator* s = speculator;
+    if (!s || !text || text_capacity == 0 || !result || (!audio && num_samples > 0)) {
+        return -1;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->fast_codec = s->config.fast_codec;
+    result->slow_codec = s->config.slow_codec;
+    result->agreement = -1.0f;
+    uint64_t start = obivox_now_ns();
+
+    // Heap so a job cancelled while still queued can outlive this call
+    SlowJob* job = malloc(sizeof(SlowJob));
+    if (!job) return -1;
+    job->owner = s;
+    job->item = (OBIVoxBatchItem){
+        .audio = audio,
+        .num_samples = num_samples,
+        .sample_rate = sample_rate,
+        .text = job->text,
+        .text_capacity = sizeof(job->text),
+        .cancel = &job->cancel
+    };
+    job->text[0] = '\0';
+    atomic_init(&job->cancel, false);
+    atomic_init(&job->state, JOB_QUEUED);
+    job->ran = false;
+    job->done = false;
+    job->run_ns = 0;
+    job->stopped_ns = 0;
+    pthread_mutex_init(&job->lock, NULL);
+    pthread_cond_init(&job->finished, NULL);
+
+    bool parallel = s->pool && obivox_pool_submit(s->pool, slow_task, job) == 0;
+
+    // Fast codec on the calling thread while the slow one decodes
+    OBIVoxBatchItem fast = {
+        .audio = audio,
+        .num_samples = num_samples,
+        .sample_rate = sample_rate,
+        .text = text,
+        .text_capacity = text_capacity
+    };
+    text[0] = '\0';
+    bool fast_ran;
+    run_codec(s, s->config.fast_codec, &fast, &fast_ran);
+    result->fast_ns = obivox_now_ns() - start;
+
+    bool accepted = fast.status == 0 && fast.confidence >= s->config.accept_confidence;
+    bool abandoned = false;
+    uint64_t cancel_ns = 0;
+
+    if (parallel) {
+        if (accepted) {
+            cancel_ns = obivox_now_ns();
+            atomic_store(&job->cancel, true);
+
+            // Not started yet: hand the job to the task to free and return
+            // without waiting for a worker to reach it
+            int expected = JOB_QUEUED;
+            abandoned = atomic_compare_exchange_strong(&job->state, &expected, JOB_ABANDONED);
+        }
+        if (!abandoned) {
+            pthread_mutex_lock(&job->lock);
+            while (!job->done) pthread_cond_wait(&job->finished, &job->lock);
+            pthread_mutex_unlock(&job->lock);
+        }
+    } else if (!accepted) {
+        slow_task(NULL, job);
+    } else {
+        job->item.status = OBIVOX_BATCH_CANCELLED;
+    }
+
+    int slow_status = abandoned ? OBIVOX_BATCH_CANCELLED : job->item.status;
+    bool slow_ok = slow_status == 0;
+    bool fast_ok = fast.status == 0;
+    bool slow_ran = !abandoned && job->ran;
+    uint64_t stopped_ns = abandoned ? cancel_ns : job->stopped_ns;
+    result->slow_cancelled = slow_status == OBIVOX_BATCH_CANCELLED;
+    result->slow_ns = slow_ok ? job->run_ns : 0;
+
+    if (fast_ok && slow_ok) {
+        result->agreement = obivox_transcript_agreement(text, job->text);
+        result->agreed = result->agreement >= s->config.agreement_threshold;
+    }
+
+    // A slow transcript that finished anyway is the better one
+    int ret = 0;
+    if (slow_ok) {
+        size_t length = strnlen(job->text, sizeof(job->text) - 1);
+        if (length >= text_capacity) length = text_capacity - 1;
+        memcpy(text, job->text, length);
+        text[length] = '\0';
+        result->codec = s->config.slow_codec;
+        result->confidence = job->item.confidence;
+    } else if (fast_ok) {
+        result->codec = s->config.fast_codec;
+        result->confidence = fast.confidence;
+    } else {
+        text[0] = '\0';
+        ret = -1;
+    }
+    if (!abandoned) slow_job_free(job);
+    result->total_ns = obivox_now_ns() - start;
+
+    pthread_mutex_lock(&s->lock);
+    s->stats.runs++;
+    if (ret == 0 && result->codec == s->config.fast_codec) s->stats.fast_accepted++;
+    if (ret == 0 && result->codec == s->config.slow_codec) s->stats.slow_used++;
+    if (result->slow_cancelled && parallel) {
+        if (slow_ran) s->stats.cancelled_running++;
+        else s->stats.cancelled_queued++;
+
+        uint64_t latency = stopped_ns > cancel_ns ? stopped_ns - cancel_ns : 0;
+        if (latency > s->stats.max_cancel_ns) s->stats.max_cancel_ns = latency;
+        if (latency > (uint64_t)s->config.cancel_grace_us * 1000) s->stats.overdue_cancels++;
+    }
+    if (result->agreement >= 0.0f && !result->agreed) s->stats.disagreements++;
+    pthread_mutex_unlock(&s->lock);
+
+    return ret;
+}
+
+void obivox_speculate_stats(OBIVoxSpeculator* speculator, OBIVoxSpeculateStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!speculator) return;
+
+    pthread_mutex_lock(&speculator->lock);
+    *stats = speculator->stats;
+    pthread_mutex_unlock(&speculator->lock);
+}
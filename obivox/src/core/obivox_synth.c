@@ -0,0 +1,431 @@
+/**
+ * obivox_synth.c
+ * Streaming synthesis: one worker per stream splits the text into
+ * phrases and voices each phoneme straight into a fixed PCM ring. The
+ * reader (or the worker itself, in push mode) drains the ring, so a
+ * phrase plays while the next one is guided and voiced
+ */
+
+#include "obivox/nlm_synth.h"
+#include "obivox/nlm_lexicon.h"
+#include "obivox/nlm_metrics.h"
+#include "core/nlm_internal.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SYNTH_PHRASE_DEFAULT  96
+#define SYNTH_CHUNK_DEFAULT   (OBIVOX_SYNTH_SAMPLE_RATE / 50)   // 20 ms
+#define SYNTH_RING_DEFAULT    (OBIVOX_SYNTH_SAMPLE_RATE * 2)
+
+// Bytes that end a phrase, and those swallowed after it
+#define PHRASE_TERMINATORS    ".!?;:,\n"
+#define PHRASE_TRAILERS       ".!?;:,\n\r\t \"')]"
+
+struct obivox_synth_stream {
+    OBIVoxNLMSystem* system;
+    PhoneticAccessibility accessibility;
+    OBIVoxSynthConfig config;
+
+    // Fixed at open: the ring, one phoneme of scratch, one push chunk
+    // and one phrase of text
+    float* ring;
+    uint32_t capacity;
+    uint32_t read_at;
+    uint32_t write_at;
+    uint32_t buffered;
+    float* scratch;
+    float* chunk;
+    char* phrase;
+
+    pthread_t worker;
+    pthread_mutex_t lock;
+    pthread_cond_t work;        // Worker: a text is pending or shutdown
+    pthread_cond_t space;       // Worker: the reader freed ring space
+    pthread_cond_t idle;        // Waiters: the worker left the text
+
+    // Utterance state, under lock
+    const char* text;
+    size_t length;
+    OBIVoxLexicon* lexicon;
+    OBIVoxMetrics* metrics;
+    uint64_t begin_ns;
+    bool busy;                  // Begun and not yet delivered
+    bool pending;               // Begun, worker has not taken it
+    bool active;                // Worker is voicing it
+    bool voiced;                // Worker is done with it
+    bool started;               // Prebuffer met: delivery may run
+    bool cancel;
+    bool shutdown;
+
+    OBIVoxSynthStats stats;
+};
+
+// Under lock
+static void start_delivery(OBIVoxSynthStream* s) {
+    if (s->started) return;
+    s->started = true;
+    s->stats.first_audio_ns = obivox_now_ns() - s->begin_ns;
+}
+
+// ============================================================================
+// Phrase Splitting
+// ============================================================================
+
+// Bytes of the next phrase: through a terminator and what trails it, else
+// up to the last space within max, else max (never inside a UTF-8 sequence)
+static size_t next_phrase(const char* text, size_t available, size_t max) {
+    size_t limit = available < max ? available : max;
+    for (size_t i = 0; i < limit; i++) {
+        if (text[i] == '\0' || !strchr(PHRASE_TERMINATORS, text[i])) continue;
+        i++;
+        while (i < limit && text[i] != '\0' && strchr(PHRASE_TRAILERS, text[i])) i++;
+        return i;
+    }
+    if (available <= max) return available;
+
+    for (size_t i = limit; i > 0; i--) {
+        if (text[i - 1] == ' ' || text[i - 1] == '\t') return i;
+    }
+    size_t i = limit;
+    while (i > 0 && ((unsigned char)text[i] & 0xC0) == 0x80) i--;
+    return i > 0 ? i : limit;
+}
+
+// ============================================================================
+// Ring
+// ============================================================================
+
+// Under lock: copy out up to count samples
+static uint32_t ring_take(OBIVoxSynthStream* s, float* pcm, uint32_t count) {
+    uint32_t n = count < s->buffered ? count : s->buffered;
+    uint32_t first = s->capacity - s->read_at;
+    if (first > n) first = n;
+    memcpy(pcm, s->ring + s->read_at, first * sizeof(float));
+    memcpy(pcm + first, s->ring, (n - first) * sizeof(float));
+    s->read_at = (s->read_at + n) % s->capacity;
+    s->buffered -= n;
+    return n;
+}
+
+// Push mode: hand full chunks (and on final, the tail) to the callback
+static void deliver(OBIVoxSynthStream* s, bool final) {
+    uint32_t chunk = s->config.chunk_samples;
+    pthread_mutex_lock(&s->lock);
+    while (s->started && !s->cancel &&
+           (s->buffered >= chunk || (final && s->buffered > 0))) {
+        uint32_t n = ring_take(s, s->chunk, chunk);
+        pthread_mutex_unlock(&s->lock);
+        s->config.on_chunk(s->chunk, n, s->config.user_data);
+        pthread_mutex_lock(&s->lock);
+    }
+    pthread_mutex_unlock(&s->lock);
+}
+
+// Append voiced samples, waiting for the reader when the ring is full;
+// -1 when the utterance was cancelled
+static int ring_write(OBIVoxSynthStream* s, const float* pcm, uint32_t count) {
+    while (count > 0) {
+        pthread_mutex_lock(&s->lock);
+        while (s->buffered == s->capacity && !s->cancel) {
+            // A full ring plays whatever the prebuffer asked for
+            start_delivery(s);
+            if (s->config.on_chunk) break;
+            pthread_cond_wait(&s->space, &s->lock);
+        }
+        if (s->cancel) {
+            pthread_mutex_unlock(&s->lock);
+            return -1;
+        }
+
+        uint32_t n = s->capacity - s->buffered;
+        if (n > count) n = count;
+        uint32_t first = s->capacity - s->write_at;
+        if (first > n) first = n;
+        memcpy(s->ring + s->write_at, pcm, first * sizeof(float));
+        memcpy(s->ring, pcm + first, (n - first) * sizeof(float));
+        s->write_at = (s->write_at + n) % s->capacity;
+        s->buffered += n;
+        if (s->buffered > s->stats.peak_buffered) s->stats.peak_buffered = s->buffered;
+        if (s->config.prebuffer_samples > 0 && s->buffered >= s->config.prebuffer_samples) {
+            start_delivery(s);
+        }
+        pthread_mutex_unlock(&s->lock);
+
+        pcm += n;
+        count -= n;
+        if (s->config.on_chunk) deliver(s, false);
+    }
+    return 0;
+}
+
+// ============================================================================
+// Worker
+// ============================================================================
+
+// Voice a guide phoneme by phoneme; returns samples, -1 on cancel
+static int64_t voice_guide(OBIVoxSynthStream* s, const char* guide, uint64_t* voice_ns) {
+    int64_t samples = 0;
+    const char* line = guide;
+    while (*line) {
+        bool marked = *line == '*';
+        const char* phonemes = strchr(line, '\t');
+        const char* end = strchr(line, '\n');
+        if (!phonemes || !end) break;
+
+        for (const char* p = phonemes + 1; p < end;) {
+            size_t n = strcspn(p, " \n");
+            uint64_t start = s->metrics ? obivox_metrics_now() : 0;
+            size_t voiced = obivox_synthesize_phoneme(p, n, marked, s->scratch, OBIVOX_SYNTH_PHONEME);
+            if (s->metrics) *voice_ns += obivox_metrics_now() - start;
+            if (ring_write(s, s->scratch, (uint32_t)voiced) != 0) return -1;
+            samples += voiced;
+            p += n;
+            if (*p == ' ') p++;
+        }
+
+        memset(s->scratch, 0, OBIVOX_SYNTH_WORD_GAP * sizeof(float));
+        if (ring_write(s, s->scratch, OBIVOX_SYNTH_WORD_GAP) != 0) return -1;
+        samples += OBIVOX_SYNTH_WORD_GAP;
+        line = end + 1;
+    }
+    return samples;
+}
+
+static void voice_utterance(OBIVoxSynthStream* s) {
+    const char* text = s->text;
+    size_t remaining = s->length;
+    OBIVoxMetrics* metrics = s->metrics;
+
+    while (remaining > 0) {
+        size_t n = next_phrase(text, remaining, s->config.max_phrase_bytes);
+        memcpy(s->phrase, text, n);
+        s->phrase[n] = '\0';
+        text += n;
+        remaining -= n;
+
+        // Time-to-first-audio is this call plus one phrase of voicing
+        char* guide = NULL;
+        uint64_t span = metrics ? obivox_metrics_now() : 0;
+        int ret = obivox_generate_pronunciation_guide_lexicon(s->lexicon, s->phrase,
+                                                              &s->accessibility, &guide);
+        if (metrics) obivox_metrics_span_end(metrics, OBIVOX_STAGE_G2P, span);
+        if (ret != 0) break;
+
+        uint64_t voice_ns = 0;
+        int64_t samples = voice_guide(s, guide, &voice_ns);
+        free(guide);
+        if (samples < 0) return;
+
+        if (metrics) {
+            obivox_metrics_record(metrics, OBIVOX_STAGE_SYNTHESIS, voice_ns);
+            obivox_metrics_add(metrics, OBIVOX_COUNTER_TEXT_BYTES_IN, n);
+            obivox_metrics_add(metrics, OBIVOX_COUNTER_SAMPLES_OUT, (uint64_t)samples);
+        }
+
+        pthread_mutex_lock(&s->lock);
+        s->stats.phrases++;
+        s->stats.samples += (uint64_t)samples;
+        if (s->config.prebuffer_samples == 0 && samples > 0) start_delivery(s);
+        pthread_mutex_unlock(&s->lock);
+        if (s->config.on_chunk) deliver(s, false);
+    }
+
+    // Whatever is left plays now, prebuffer met or not
+    pthread_mutex_lock(&s->lock);
+    start_delivery(s);
+    pthread_mutex_unlock(&s->lock);
+    if (s->config.on_chunk) deliver(s, true);
+}
+
+static void* worker_main(void* arg) {
+    OBIVoxSynthStream* s = arg;
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (!s->pending && !s->shutdown) pthread_cond_wait(&s->work, &s->lock);
+        if (s->shutdown) break;
+        s->pending = false;
+        s->active = true;
+        pthread_mutex_unlock(&s->lock);
+
+        voice_utterance(s);
+
+        pthread_mutex_lock(&s->lock);
+        s->active = false;
+        s->voiced = true;
+        if (s->config.on_chunk) s->busy = false;
+        pthread_cond_broadcast(&s->idle);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+// ============================================================================
+// Streaming Synthesis API
+// ============================================================================
+
+void obivox_synth_config_default(OBIVoxSynthConfig* config) {
+    if (!config) return;
+    memset(config, 0, sizeof(*config));
+    config->max_phrase_bytes = SYNTH_PHRASE_DEFAULT;
+    config->ring_samples = SYNTH_RING_DEFAULT;
+    config->chunk_samples = SYNTH_CHUNK_DEFAULT;
+}
+
+static void stream_free(OBIVoxSynthStream* s) {
+    pthread_cond_destroy(&s->idle);
+    pthread_cond_destroy(&s->space);
+    pthread_cond_destroy(&s->work);
+    pthread_mutex_destroy(&s->lock);
+    free(s->phrase);
+    free(s->chunk);
+    free(s->scratch);
+    free(s->ring);
+    free(s);
+}
+
+int obivox_synth_open(
+    OBIVoxNLMSystem* system,
+    const OBIVoxSynthConfig* config,
+    OBIVoxSynthStream** stream) {
+
+    if (!system || !stream) return -1;
+
+    OBIVoxSynthStream* s = calloc(1, sizeof(OBIVoxSynthStream));
+    if (!s) return -1;
+
+    if (config) {
+        s->config = *config;
+    } else {
+        obivox_synth_config_default(&s->config);
+    }
+    OBIVoxSynthConfig* c = &s->config;
+    if (c->max_phrase_bytes == 0) c->max_phrase_bytes = SYNTH_PHRASE_DEFAULT;
+    if (c->ring_samples == 0) c->ring_samples = SYNTH_RING_DEFAULT;
+    if (c->chunk_samples == 0) c->chunk_samples = SYNTH_CHUNK_DEFAULT;
+    if (c->chunk_samples > c->ring_samples) c->chunk_samples = c->ring_samples;
+    if (c->prebuffer_samples > c->ring_samples) c->prebuffer_samples = c->ring_samples;
+
+    s->system = system;
+    s->accessibility = system->accessibility;
+    s->capacity = c->ring_samples;
+    s->ring = malloc((size_t)s->capacity * sizeof(float));
+    s->scratch = malloc(OBIVOX_SYNTH_PHONEME * sizeof(float));
+    if (c->on_chunk) s->chunk = malloc((size_t)c->chunk_samples * sizeof(float));
+    s->phrase = malloc((size_t)c->max_phrase_bytes + 1);
+    pthread_mutex_init(&s->lock, NULL);
+    pthread_cond_init(&s->work, NULL);
+    pthread_cond_init(&s->space, NULL);
+    pthread_cond_init(&s->idle, NULL);
+
+    if (!s->ring || !s->scratch || !s->phrase || (c->on_chunk && !s->chunk) ||
+        pthread_create(&s->worker, NULL, worker_main, s) != 0) {
+        stream_free(s);
+        return -1;
+    }
+
+    *stream = s;
+    return 0;
+}
+
+int obivox_synth_begin(OBIVoxSynthStream* stream, const char* text, size_t length) {
+    if (!stream || !text) return -1;
+    if (length == 0) length = strlen(text);
+
+    pthread_mutex_lock(&stream->lock);
+    if (stream->busy) {
+        pthread_mutex_unlock(&stream->lock);
+        return 1;
+    }
+    stream->text = text;
+    stream->length = length;
+    stream->lexicon = stream->system->lexicon;
+    stream->metrics = stream->system->metrics;
+    stream->begin_ns = obivox_now_ns();
+    stream->busy = true;
+    stream->pending = true;
+    stream->voiced = false;
+    stream->started = false;
+    stream->stats.utterances++;
+    pthread_cond_signal(&stream->work);
+    pthread_mutex_unlock(&stream->lock);
+    return 0;
+}
+
+int obivox_synth_read(
+    OBIVoxSynthStream* stream,
+    float* pcm,
+    uint32_t capacity,
+    uint32_t* samples) {
+
+    if (!stream || !samples || (!pcm && capacity > 0) || stream->config.on_chunk) return -1;
+
+    pthread_mutex_lock(&stream->lock);
+    uint32_t n = 0;
+    if (stream->started) {
+        n = ring_take(stream, pcm, capacity);
+        if (n > 0) pthread_cond_signal(&stream->space);
+        if (n < capacity && !stream->voiced) stream->stats.underruns++;
+    }
+    *samples = n;
+
+    // The utterance ends when the last voiced sample is read
+    int ret = 0;
+    if (!stream->busy || (stream->voiced && stream->buffered == 0)) {
+        if (stream->busy) {
+            stream->busy = false;
+            pthread_cond_broadcast(&stream->idle);
+        }
+        ret = 1;
+    }
+    pthread_mutex_unlock(&stream->lock);
+    return ret;
+}
+
+int obivox_synth_wait(OBIVoxSynthStream* stream) {
+    if (!stream) return -1;
+    pthread_mutex_lock(&stream->lock);
+    while (stream->busy && !stream->voiced) pthread_cond_wait(&stream->idle, &stream->lock);
+    pthread_mutex_unlock(&stream->lock);
+    return 0;
+}
+
+int obivox_synth_cancel(OBIVoxSynthStream* stream) {
+    if (!stream) return -1;
+
+    pthread_mutex_lock(&stream->lock);
+    stream->cancel = true;
+    stream->pending = false;
+    pthread_cond_signal(&stream->space);
+    while (stream->active) pthread_cond_wait(&stream->idle, &stream->lock);
+
+    stream->read_at = stream->write_at = stream->buffered = 0;
+    stream->busy = false;
+    stream->voiced = true;
+    stream->cancel = false;
+    pthread_cond_broadcast(&stream->idle);
+    pthread_mutex_unlock(&stream->lock);
+    return 0;
+}
+
+void obivox_synth_stats(OBIVoxSynthStream* stream, OBIVoxSynthStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!stream) return;
+    pthread_mutex_lock(&stream->lock);
+    *stats = stream->stats;
+    pthread_mutex_unlock(&stream->lock);
+}
+
+void obivox_synth_close(OBIVoxSynthStream* stream) {
+    if (!stream) return;
+    obivox_synth_cancel(stream);
+
+    pthread_mutex_lock(&stream->lock);
+    stream->shutdown = true;
+    pthread_cond_signal(&stream->work);
+    pthread_mutex_unlock(&stream->lock);
+    pthread_join(stream->worker, NULL);
+    stream_free(stream);
+}
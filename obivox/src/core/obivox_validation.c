@@ -0,0 +1,534 @@
+/**
+ * obivox_validation.c
+ * Ticketed validation queue: a fixed slot table (capacity bounds every
+ * outstanding ticket), FIFOs of tickets waiting for and claimed by
+ * reviewers and of resolutions, and one feedback thread applying those
+ * in batches
+ */
+
+#include "obivox/nlm_validation.h"
+#include "obivox/nlm_feedback.h"
+#include "core/nlm_internal.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef enum {
+    SLOT_FREE = 0,
+    SLOT_WAITING,               // In the waiting FIFO
+    SLOT_CLAIMED,               // Taken by a reviewer, in the claimed FIFO
+    SLOT_RESOLVED,              // In the resolved FIFO
+    SLOT_APPLYING               // Taken by the feedback thread
+} SlotState;
+
+typedef struct {
+    OBIVoxTicket ticket;
+    SlotState state;
+    char* text;
+    char* correction;
+    float confidence;
+    uint64_t submitted_ns;
+    uint64_t listed_ns;         // Entered its current list
+
+    // Waiting and claimed FIFOs are doubly linked (tickets resolve out of
+    // order); the resolved FIFO and the free stack use next only
+    int32_t next;
+    int32_t prev;
+} ValidationSlot;
+
+typedef struct {
+    int32_t head;
+    int32_t tail;
+} SlotList;
+
+struct obivox_validation_queue {
+    OBIVoxValidationConfig config;
+    OBIVoxNLMSystem* learner;
+
+    pthread_mutex_t lock;
+    pthread_cond_t work;            // Feedback thread: resolution, flush or stop
+    pthread_cond_t space;           // Blocked submitters: a slot was freed
+    pthread_cond_t applied;         // Flushers: a batch was applied
+
+    ValidationSlot* slots;
+    int32_t free_head;
+    SlotList waiting;
+    SlotList claimed;
+    SlotList resolved;
+    uint32_t resolved_count;
+    uint32_t sequence;
+
+    pthread_t thread;
+    bool stopping;
+    bool flush_requested;
+    uint32_t blocked_submitters;    // Inside the space wait; destroy waits them out
+
+    // Feedback-thread scratch: slot indices of the batch being applied
+    // and its records
+    int32_t* taken;
+    OBIVoxFeedbackRecord* records;
+
+    OBIVoxValidationStats stats;
+};
+
+static struct timespec deadline_at(uint64_t ns) {
+    struct timespec ts = { .tv_sec = ns / 1000000000ull, .tv_nsec = ns % 1000000000ull };
+    return ts;
+}
+
+// Ticket: sequence in the high half (never 0), slot index in the low half
+static ValidationSlot* slot_for(OBIVoxValidationQueue* q, OBIVoxTicket ticket) {
+    uint32_t index = (uint32_t)ticket;
+    if (ticket == 0 || index >= q->config.capacity) return NULL;
+    ValidationSlot* slot = &q->slots[index];
+    return slot->ticket == ticket ? slot : NULL;
+}
+
+// ============================================================================
+// Slot Lists (lock held)
+// ============================================================================
+
+static void list_append(OBIVoxValidationQueue* q, SlotList* list, int32_t index, uint64_t now) {
+    ValidationSlot* slot = &q->slots[index];
+    slot->next = -1;
+    slot->prev = list->tail;
+    slot->listed_ns = now;
+    if (list->tail >= 0) q->slots[list->tail].next = index;
+    else list->head = index;
+    list->tail = index;
+}
+
+static int32_t list_pop(OBIVoxValidationQueue* q, SlotList* list) {
+    int32_t index = list->head;
+    if (index < 0) return -1;
+    list->head = q->slots[index].next;
+    if (list->head >= 0) q->slots[list->head].prev = -1;
+    else list->tail = -1;
+    return index;
+}
+
+static void list_unlink(OBIVoxValidationQueue* q, SlotList* list, int32_t index) {
+    ValidationSlot* slot = &q->slots[index];
+    if (slot->prev >= 0) q->slots[slot->prev].next = slot->next;
+    else list->head = slot->next;
+    if (slot->next >= 0) q->slots[slot->next].prev = slot->prev;
+    else list->tail = slot->prev;
+    slot->next = slot->prev = -1;
+}
+
+static void slot_release(OBIVoxValidationQueue* q, int32_t index) {
+    ValidationSlot* slot = &q->slots[index];
+    free(slot->text);
+    free(slot->correction);
+    slot->text = NULL;
+    slot->correction = NULL;
+    slot->ticket = 0;
+    slot->state = SLOT_FREE;
+    slot->next = q->free_head;
+    q->free_head = index;
+    q->stats.outstanding--;
+}
+
+// Both FIFOs are in entry order, so the expired are at their heads; a
+// claim gets the same time again, so an abandoned review frees its slot
+static bool expire_list(OBIVoxValidationQueue* q, SlotList* list, uint64_t now, uint64_t ttl) {
+    bool freed = false;
+    while (list->head >= 0 && now - q->slots[list->head].listed_ns >= ttl) {
+        int32_t index = list_pop(q, list);
+        if (list == &q->waiting) q->stats.waiting--;
+        slot_release(q, index);
+        q->stats.expired++;
+        freed = true;
+    }
+    return freed;
+}
+
+static void expire_tickets(OBIVoxValidationQueue* q, uint64_t now) {
+    if (q->config.expire_ms == 0) return;
+    uint64_t ttl = (uint64_t)q->config.expire_ms * 1000000ull;
+    bool freed = expire_list(q, &q->waiting, now, ttl);
+    freed |= expire_list(q, &q->claimed, now, ttl);
+    if (freed) pthread_cond_broadcast(&q->space);
+}
+
+// ============================================================================
+// Feedback Thread
+// ============================================================================
+
+static bool batch_due(OBIVoxValidationQueue* q, uint64_t now) {
+    if (q->resolved_count == 0) return false;
+    if (q->resolved_count >= q->config.batch_size || q->flush_requested || q->stopping) return true;
+    uint64_t interval = (uint64_t)q->config.flush_interval_ms * 1000000ull;
+    return now - q->slots[q->resolved.head].listed_ns >= interval;
+}
+
+// Earliest time a batch falls due or a ticket expires; 0 = none
+static uint64_t next_wakeup(OBIVoxValidationQueue* q) {
+    uint64_t wake = 0;
+    if (q->resolved_count > 0) {
+        wake = q->slots[q->resolved.head].listed_ns +
+               (uint64_t)q->config.flush_interval_ms * 1000000ull;
+    }
+    const SlotList* lists[] = { &q->waiting, &q->claimed };
+    for (int i = 0; i < 2 && q->config.expire_ms > 0; i++) {
+        if (lists[i]->head < 0) continue;
+        uint64_t expiry = q->slots[lists[i]->head].listed_ns +
+                          (uint64_t)q->config.expire_ms * 1000000ull;
+        if (wake == 0 || expiry < wake) wake = expiry;
+    }
+    return wake;
+}
+
+// One coalesced pass over the learner per batch (nlm_feedback.h)
+static void apply_batch(OBIVoxValidationQueue* q, uint32_t count) {
+    if (q->learner) {
+        for (uint32_t i = 0; i < count; i++) {
+            ValidationSlot* slot = &q->slots[q->taken[i]];
+            q->records[i] = (OBIVoxFeedbackRecord){
+                .feedback = {
+                    .requires_confirmation = false,
+                    .confidence_threshold = 0.954f,
+                    .suggested_correction = slot->correction,
+                    .original_interpretation = slot->text
+                },
+                .codec = -1
+            };
+        }
+        obivox_incorporate_feedback_batch(q->learner, q->records, count);
+    }
+    for (uint32_t i = 0; i < count && q->config.on_applied; i++) {
+        ValidationSlot* slot = &q->slots[q->taken[i]];
+        q->config.on_applied(slot->ticket, slot->text, slot->correction, q->config.user_data);
+    }
+}
+
+static void* feedback_thread(void* arg) {
+    OBIVoxValidationQueue* q = arg;
+
+    pthread_mutex_lock(&q->lock);
+    for (;;) {
+        uint64_t now = obivox_now_ns();
+        expire_tickets(q, now);
+
+        if (!batch_due(q, now)) {
+            if (q->stopping) break;
+            if (q->resolved_count == 0) q->flush_requested = false;
+
+            uint64_t wake = next_wakeup(q);
+            if (wake == 0) {
+                pthread_cond_wait(&q->work, &q->lock);
+            } else {
+                struct timespec deadline = deadline_at(wake);
+                pthread_cond_timedwait(&q->work, &q->lock, &deadline);
+            }
+            continue;
+        }
+
+        uint32_t count = 0;
+        while (count < q->config.batch_size && q->resolved.head >= 0) {
+            int32_t index = list_pop(q, &q->resolved);
+            q->slots[index].state = SLOT_APPLYING;
+            q->taken[count++] = index;
+        }
+        q->resolved_count -= count;
+
+        // Reviewers and submitters keep going while the learner updates
+        pthread_mutex_unlock(&q->lock);
+        apply_batch(q, count);
+        pthread_mutex_lock(&q->lock);
+
+        for (uint32_t i = 0; i < count; i++) slot_release(q, q->taken[i]);
+        q->stats.applied += count;
+        q->stats.batches++;
+        pthread_cond_broadcast(&q->space);
+        pthread_cond_broadcast(&q->applied);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return NULL;
+}
+
+// ============================================================================
+// Queue Lifecycle
+// ============================================================================
+
+void obivox_validation_config_default(OBIVoxValidationConfig* config) {
+    if (!config) return;
+    config->capacity = 1024;
+    config->confidence_threshold = 0.85f;
+    config->block_timeout_ms = 0;
+    config->batch_size = 32;
+    config->flush_interval_ms = 100;
+    config->expire_ms = 600000;
+    config->on_applied = NULL;
+    config->user_data = NULL;
+}
+
+int obivox_validation_queue_create(
+    OBIVoxNLMSystem* learner,
+    const OBIVoxValidationConfig* config,
+    OBIVoxValidationQueue** queue) {
+
+    if (!queue) return -1;
+    *queue = NULL;
+
+    OBIVoxValidationConfig c;
+    if (config) {
+        c = *config;
+    } else {
+        obivox_validation_config_default(&c);
+    }
+    if (c.capacity == 0 || c.capacity > INT32_MAX || c.batch_size == 0) return -1;
+
+    OBIVoxValidationQueue* q = calloc(1, sizeof(OBIVoxValidationQueue));
+    if (!q) return -1;
+    q->config = c;
+    q->learner = learner;
+    q->slots = calloc(c.capacity, sizeof(ValidationSlot));
+    q->taken = calloc(c.batch_size, sizeof(int32_t));
+    q->records = calloc(c.batch_size, sizeof(OBIVoxFeedbackRecord));
+    if (!q->slots || !q->taken || !q->records) {
+        free(q->slots);
+        free(q->taken);
+        free(q->records);
+        free(q);
+        return -1;
+    }
+
+    // Free stack in index order
+    for (uint32_t i = 0; i < c.capacity; i++) {
+        q->slots[i].next = i + 1 < c.capacity ? (int32_t)i + 1 : -1;
+        q->slots[i].prev = -1;
+    }
+    q->free_head = 0;
+    q->waiting = q->claimed = q->resolved = (SlotList){ -1, -1 };
+
+    // Deadlines are absolute monotonic times
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&q->work, &attr);
+    pthread_cond_init(&q->space, &attr);
+    pthread_condattr_destroy(&attr);
+    pthread_cond_init(&q->applied, NULL);
+    pthread_mutex_init(&q->lock, NULL);
+
+    if (pthread_create(&q->thread, NULL, feedback_thread, q) != 0) {
+        pthread_cond_destroy(&q->work);
+        pthread_cond_destroy(&q->space);
+        pthread_cond_destroy(&q->applied);
+        pthread_mutex_destroy(&q->lock);
+        free(q->slots);
+        free(q->taken);
+        free(q->records);
+        free(q);
+        return -1;
+    }
+
+    *queue = q;
+    return 0;
+}
+
+void obivox_validation_queue_destroy(OBIVoxValidationQueue* queue) {
+    if (!queue) return;
+
+    // The thread drains the resolved FIFO before it exits; submitters
+    // blocked on a full queue fail, and must leave before the condition
+    // variables go
+    pthread_mutex_lock(&queue->lock);
+    queue->stopping = true;
+    pthread_cond_signal(&queue->work);
+    pthread_cond_broadcast(&queue->space);
+    while (queue->blocked_submitters > 0) {
+        pthread_cond_wait(&queue->space, &queue->lock);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    pthread_join(queue->thread, NULL);
+
+    for (uint32_t i = 0; i < queue->config.capacity; i++) {
+        free(queue->slots[i].text);
+        free(queue->slots[i].correction);
+    }
+    pthread_cond_destroy(&queue->work);
+    pthread_cond_destroy(&queue->space);
+    pthread_cond_destroy(&queue->applied);
+    pthread_mutex_destroy(&queue->lock);
+    free(queue->slots);
+    free(queue->taken);
+    free(queue->records);
+    free(queue);
+}
+
+// ============================================================================
+// Producers
+// ============================================================================
+
+int obivox_validation_submit(
+    OBIVoxValidationQueue* queue,
+    const char* text,
+    float confidence,
+    bool force,
+    OBIVoxTicket* ticket) {
+
+    if (!queue || !text || !ticket) return -1;
+    *ticket = 0;
+
+    if (!force && confidence >= queue->config.confidence_threshold) {
+        pthread_mutex_lock(&queue->lock);
+        queue->stats.confident++;
+        pthread_mutex_unlock(&queue->lock);
+        return 0;
+    }
+
+    // Copy outside the lock; a rejected submission frees it again
+    char* copy = strdup(text);
+    if (!copy) return -1;
+
+    pthread_mutex_lock(&queue->lock);
+    if (queue->free_head < 0 && queue->config.block_timeout_ms > 0 && !queue->stopping) {
+        queue->stats.blocked++;
+        queue->blocked_submitters++;
+        struct timespec deadline = deadline_at(obivox_now_ns() +
+            (uint64_t)queue->config.block_timeout_ms * 1000000ull);
+        while (queue->free_head < 0 && !queue->stopping) {
+            if (pthread_cond_timedwait(&queue->space, &queue->lock, &deadline) != 0) break;
+        }
+        queue->blocked_submitters--;
+        if (queue->stopping) pthread_cond_broadcast(&queue->space);
+    }
+    if (queue->stopping) {
+        pthread_mutex_unlock(&queue->lock);
+        free(copy);
+        return -1;
+    }
+    if (queue->free_head < 0) {
+        queue->stats.rejected++;
+        pthread_mutex_unlock(&queue->lock);
+        free(copy);
+        return 1;
+    }
+
+    int32_t index = queue->free_head;
+    ValidationSlot* slot = &queue->slots[index];
+    queue->free_head = slot->next;
+
+    if (++queue->sequence == 0) queue->sequence = 1;
+    slot->ticket = ((uint64_t)queue->sequence << 32) | (uint32_t)index;
+    slot->state = SLOT_WAITING;
+    slot->text = copy;
+    slot->correction = NULL;
+    slot->confidence = confidence;
+    slot->submitted_ns = obivox_now_ns();
+    list_append(queue, &queue->waiting, index, slot->submitted_ns);
+
+    queue->stats.submitted++;
+    queue->stats.waiting++;
+    queue->stats.outstanding++;
+    *ticket = slot->ticket;
+
+    // The thread may need an expiry deadline for its first waiting ticket
+    if (queue->waiting.head == index && queue->config.expire_ms > 0) {
+        pthread_cond_signal(&queue->work);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return 0;
+}
+
+// ============================================================================
+// Reviewers
+// ============================================================================
+
+int obivox_validation_next(OBIVoxValidationQueue* queue, OBIVoxValidationRequest* request) {
+    if (!queue || !request) return -1;
+
+    pthread_mutex_lock(&queue->lock);
+    int32_t index = list_pop(queue, &queue->waiting);
+    if (index < 0) {
+        pthread_mutex_unlock(&queue->lock);
+        return 1;
+    }
+    queue->stats.waiting--;
+
+    ValidationSlot* slot = &queue->slots[index];
+    slot->state = SLOT_CLAIMED;
+    list_append(queue, &queue->claimed, index, obivox_now_ns());
+    bool arm = queue->claimed.head == index && queue->config.expire_ms > 0;
+    if (arm) pthread_cond_signal(&queue->work);
+    request->ticket = slot->ticket;
+    request->text = slot->text;
+    request->confidence = slot->confidence;
+    request->submitted_ns = slot->submitted_ns;
+    pthread_mutex_unlock(&queue->lock);
+    return 0;
+}
+
+int obivox_validation_resolve(OBIVoxValidationQueue* queue, OBIVoxTicket ticket, const char* correction) {
+    if (!queue) return -1;
+
+    char* copy = NULL;
+    if (correction) {
+        copy = strdup(correction);
+        if (!copy) return -1;
+    }
+
+    pthread_mutex_lock(&queue->lock);
+    ValidationSlot* slot = slot_for(queue, ticket);
+    if (!slot || (slot->state != SLOT_WAITING && slot->state != SLOT_CLAIMED)) {
+        pthread_mutex_unlock(&queue->lock);
+        free(copy);
+        return -1;
+    }
+
+    int32_t index = (int32_t)(slot - queue->slots);
+    if (slot->state == SLOT_WAITING) {
+        list_unlink(queue, &queue->waiting, index);
+        queue->stats.waiting--;
+    } else {
+        list_unlink(queue, &queue->claimed, index);
+    }
+    slot->state = SLOT_RESOLVED;
+    slot->correction = copy;
+    list_append(queue, &queue->resolved, index, obivox_now_ns());
+    queue->resolved_count++;
+
+    queue->stats.resolved++;
+    if (copy) queue->stats.corrected++;
+
+    // Wake for a full batch, or to arm the flush deadline
+    if (queue->resolved_count == 1 || queue->resolved_count >= queue->config.batch_size) {
+        pthread_cond_signal(&queue->work);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return 0;
+}
+
+int obivox_validation_flush(OBIVoxValidationQueue* queue) {
+    if (!queue) return -1;
+
+    pthread_mutex_lock(&queue->lock);
+    uint64_t target = queue->stats.resolved;
+    queue->flush_requested = true;
+    pthread_cond_signal(&queue->work);
+    while (queue->stats.applied < target) {
+        pthread_cond_wait(&queue->applied, &queue->lock);
+    }
+    pthread_mutex_unlock(&queue->lock);
+    return 0;
+}
+
+void obivox_validation_stats(OBIVoxValidationQueue* queue, OBIVoxValidationStats* stats) {
+    if (!queue || !stats) return;
+    pthread_mutex_lock(&queue->lock);
+    *stats = queue->stats;
+    pthread_mutex_unlock(&queue->lock);
+}
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+int obivox_nlm_attach_validation(OBIVoxNLMSystem* system, OBIVoxValidationQueue* queue) {
+    if (!system) return -1;
+    system->validation = queue;
+    return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * kernels_neon.c
+ * AArch64 NEON feature kernels (NEON is mandatory on AArch64)
+ */
+
+#include "dsp/obivox_kernels.h"
+
+#if defined(__aarch64__)
+
+#include <arm_neon.h>
+
+static uint64_t neon_zero_crossings(const float* x, uint32_t n, float previous) {
+    if (n == 0) return 0;
+
+    uint64_t count = ((x[0] > 0) != (previous > 0)) ? 1 : 0;
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    uint32x4_t acc = vdupq_n_u32(0);
+    uint32_t i = 1;
+
+    for (; i + 4 <= n; i += 4) {
+        uint32x4_t cur = vcgtq_f32(vld1q_f32(x + i), zero);
+        uint32x4_t prev = vcgtq_f32(vld1q_f32(x + i - 1), zero);
+        acc = vaddq_u32(acc, vshrq_n_u32(veorq_u32(cur, prev), 31));
+    }
+    count += vaddvq_u32(acc);
+
+    for (; i < n; i++) {
+        if ((x[i] > 0) != (x[i-1] > 0)) count++;
+    }
+    return count;
+}
+
+static float neon_dot(const float* a, const float* b, uint32_t n) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f), acc1 = vdupq_n_f32(0.0f);
+    uint32_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+
+    float total = vaddvq_f32(vaddq_f32(acc0, acc1));
+    for (; i < n; i++) {
+        total += a[i] * b[i];
+    }
+    return total;
+}
+
+static float neon_sum(const float* x, uint32_t n) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f), acc1 = vdupq_n_f32(0.0f);
+    uint32_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vaddq_f32(acc0, vld1q_f32(x + i));
+        acc1 = vaddq_f32(acc1, vld1q_f32(x + i + 4));
+    }
+
+    float total = vaddvq_f32(vaddq_f32(acc0, acc1));
+    for (; i < n; i++) {
+        total += x[i];
+    }
+    return total;
+}
+
+static float neon_diff_energy(const float* x, uint32_t n) {
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    uint32_t i = 1;
+
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t d = vsubq_f32(vld1q_f32(x + i), vld1q_f32(x + i - 1));
+        acc = vfmaq_f32(acc, d, d);
+    }
+
+    float total = vaddvq_f32(acc);
+    for (; i < n; i++) {
+        float diff = x[i] - x[i-1];
+        total += diff * diff;
+    }
+    return total;
+}
+
+// 4-lane prefix scan of y[i] = a*x[i] + k*y[i-1], see kernels_x86.c
+static float neon_lisp_filter(float* x, uint32_t n, float gain, float previous) {
+    const float k = gain, k2 = k * k;
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t va = vdupq_n_f32(1.0f - gain);
+    const float32x4_t vk = vdupq_n_f32(k);
+    const float32x4_t vk2 = vdupq_n_f32(k2);
+    const float carry_lanes[4] = { k, k2, k2 * k, k2 * k2 };
+    const float32x4_t carry = vld1q_f32(carry_lanes);
+
+    uint32_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vmulq_f32(va, vld1q_f32(x + i));
+        v = vfmaq_f32(v, vk, vextq_f32(zero, v, 3));
+        v = vfmaq_f32(v, vk2, vextq_f32(zero, v, 2));
+        v = vfmaq_f32(v, carry, vdupq_n_f32(previous));
+        vst1q_f32(x + i, v);
+        previous = vgetq_lane_f32(v, 3);
+    }
+    for (; i < n; i++) {
+        x[i] = x[i] - ((x[i] - previous) * gain);
+        previous = x[i];
+    }
+    return previous;
+}
+
+const OBIVoxKernels obivox_kernels_neon = {
+    .isa = OBIVOX_ISA_NEON,
+    .name = "neon",
+    .zero_crossings = neon_zero_crossings,
+    .dot = neon_dot,
+    .sum = neon_sum,
+    .diff_energy = neon_diff_energy,
+    .lisp_filter = neon_lisp_filter
+};
+
+#endif // __aarch64__
@@ -0,0 +1,283 @@
+/**
+ * kernels_x86.c
+ * AVX2/FMA and AVX-512F feature kernels
+ * Built with per-function target attributes so the rest of the library
+ * keeps the baseline ISA; only dispatch decides whether these run
+ */
+
+#include "dsp/obivox_kernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+#define AVX2 __attribute__((target("avx2,fma")))
+#define AVX512 __attribute__((target("avx512f")))
+
+// ============================================================================
+// AVX2 / FMA
+// ============================================================================
+
+AVX2 static inline float avx2_hsum(__m256 v) {
+    __m128 lo = _mm256_castps256_ps128(v);
+    __m128 hi = _mm256_extractf128_ps(v, 1);
+    lo = _mm_add_ps(lo, hi);
+    lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+    lo = _mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+    return _mm_cvtss_f32(lo);
+}
+
+AVX2 static uint64_t avx2_zero_crossings(const float* x, uint32_t n, float previous) {
+    if (n == 0) return 0;
+
+    uint64_t count = ((x[0] > 0) != (previous > 0)) ? 1 : 0;
+    const __m256 zero = _mm256_setzero_ps();
+    uint32_t i = 1;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256 cur = _mm256_cmp_ps(_mm256_loadu_ps(x + i), zero, _CMP_GT_OQ);
+        __m256 prev = _mm256_cmp_ps(_mm256_loadu_ps(x + i - 1), zero, _CMP_GT_OQ);
+        count += (uint64_t)__builtin_popcount(_mm256_movemask_ps(_mm256_xor_ps(cur, prev)));
+    }
+    for (; i < n; i++) {
+        if ((x[i] > 0) != (x[i-1] > 0)) count++;
+    }
+    return count;
+}
+
+AVX2 static float avx2_dot(const float* a, const float* b, uint32_t n) {
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    uint32_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), acc3);
+    }
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+
+    float total = avx2_hsum(_mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+    for (; i < n; i++) {
+        total += a[i] * b[i];
+    }
+    return total;
+}
+
+AVX2 static float avx2_sum(const float* x, uint32_t n) {
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    uint32_t i = 0;
+
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(x + i));
+        acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(x + i + 8));
+    }
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(x + i));
+    }
+
+    float total = avx2_hsum(_mm256_add_ps(acc0, acc1));
+    for (; i < n; i++) {
+        total += x[i];
+    }
+    return total;
+}
+
+AVX2 static float avx2_diff_energy(const float* x, uint32_t n) {
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    uint32_t i = 1;
+
+    for (; i + 16 <= n; i += 16) {
+        __m256 d0 = _mm256_sub_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(x + i - 1));
+        __m256 d1 = _mm256_sub_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(x + i + 7));
+        acc0 = _mm256_fmadd_ps(d0, d0, acc0);
+        acc1 = _mm256_fmadd_ps(d1, d1, acc1);
+    }
+
+    float total = avx2_hsum(_mm256_add_ps(acc0, acc1));
+    for (; i < n; i++) {
+        float diff = x[i] - x[i-1];
+        total += diff * diff;
+    }
+    return total;
+}
+
+// One-pole recurrence y[i] = a*x[i] + k*y[i-1] as an 8-lane prefix scan:
+// three shifted FMAs spread k^1, k^2, k^4, then k^(j+1) carries y[-1]
+AVX2 static float avx2_lisp_filter(float* x, uint32_t n, float gain, float previous) {
+    const float a = 1.0f - gain;
+    const float k = gain;
+    const float k2 = k * k, k4 = k2 * k2;
+
+    const __m256 va = _mm256_set1_ps(a);
+    const __m256 c1 = _mm256_setr_ps(0, k, k, k, k, k, k, k);
+    const __m256 c2 = _mm256_setr_ps(0, 0, k2, k2, k2, k2, k2, k2);
+    const __m256 c4 = _mm256_setr_ps(0, 0, 0, 0, k4, k4, k4, k4);
+    const __m256 carry = _mm256_setr_ps(k, k2, k2 * k, k4, k4 * k, k4 * k2, k4 * k2 * k, k4 * k4);
+    const __m256i s1 = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+    const __m256i s2 = _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5);
+    const __m256i s4 = _mm256_setr_epi32(0, 0, 0, 0, 0, 1, 2, 3);
+    const __m256i last = _mm256_set1_epi32(7);
+
+    uint32_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_mul_ps(va, _mm256_loadu_ps(x + i));
+        v = _mm256_fmadd_ps(c1, _mm256_permutevar8x32_ps(v, s1), v);
+        v = _mm256_fmadd_ps(c2, _mm256_permutevar8x32_ps(v, s2), v);
+        v = _mm256_fmadd_ps(c4, _mm256_permutevar8x32_ps(v, s4), v);
+        v = _mm256_fmadd_ps(carry, _mm256_set1_ps(previous), v);
+        _mm256_storeu_ps(x + i, v);
+        previous = _mm256_cvtss_f32(_mm256_permutevar8x32_ps(v, last));
+    }
+    for (; i < n; i++) {
+        x[i] = x[i] - ((x[i] - previous) * gain);
+        previous = x[i];
+    }
+    return previous;
+}
+
+const OBIVoxKernels obivox_kernels_avx2 = {
+    .isa = OBIVOX_ISA_AVX2,
+    .name = "avx2",
+    .zero_crossings = avx2_zero_crossings,
+    .dot = avx2_dot,
+    .sum = avx2_sum,
+    .diff_energy = avx2_diff_energy,
+    .lisp_filter = avx2_lisp_filter
+};
+
+// ============================================================================
+// AVX-512F
+// ============================================================================
+
+AVX512 static uint64_t avx512_zero_crossings(const float* x, uint32_t n, float previous) {
+    if (n == 0) return 0;
+
+    uint64_t count = ((x[0] > 0) != (previous > 0)) ? 1 : 0;
+    const __m512 zero = _mm512_setzero_ps();
+    uint32_t i = 1;
+
+    for (; i + 16 <= n; i += 16) {
+        __mmask16 cur = _mm512_cmp_ps_mask(_mm512_loadu_ps(x + i), zero, _CMP_GT_OQ);
+        __mmask16 prev = _mm512_cmp_ps_mask(_mm512_loadu_ps(x + i - 1), zero, _CMP_GT_OQ);
+        count += (uint64_t)__builtin_popcount((unsigned)(cur ^ prev));
+    }
+    for (; i < n; i++) {
+        if ((x[i] > 0) != (x[i-1] > 0)) count++;
+    }
+    return count;
+}
+
+AVX512 static float avx512_dot(const float* a, const float* b, uint32_t n) {
+    __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+    uint32_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+    }
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+    }
+    if (i < n) {
+        __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+        acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + i), _mm512_maskz_loadu_ps(m, b + i), acc1);
+    }
+
+    return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+AVX512 static float avx512_sum(const float* x, uint32_t n) {
+    __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+    uint32_t i = 0;
+
+    for (; i + 32 <= n; i += 32) {
+        acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(x + i));
+        acc1 = _mm512_add_ps(acc1, _mm512_loadu_ps(x + i + 16));
+    }
+    for (; i + 16 <= n; i += 16) {
+        acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(x + i));
+    }
+
+    float total = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+    for (; i < n; i++) {
+        total += x[i];
+    }
+    return total;
+}
+
+AVX512 static float avx512_diff_energy(const float* x, uint32_t n) {
+    __m512 acc = _mm512_setzero_ps();
+    uint32_t i = 1;
+
+    for (; i + 16 <= n; i += 16) {
+        __m512 d = _mm512_sub_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(x + i - 1));
+        acc = _mm512_fmadd_ps(d, d, acc);
+    }
+
+    float total = _mm512_reduce_add_ps(acc);
+    for (; i < n; i++) {
+        float diff = x[i] - x[i-1];
+        total += diff * diff;
+    }
+    return total;
+}
+
+// 16-lane version of the AVX2 scan: shifts of 1, 2, 4 and 8 lanes
+AVX512 static float avx512_lisp_filter(float* x, uint32_t n, float gain, float previous) {
+    const float k = gain;
+    float powers[17];
+    powers[0] = 1.0f;
+    for (int p = 1; p <= 16; p++) powers[p] = powers[p-1] * k;
+
+    float coeff[4][16];
+    int shift_idx[4][16];
+    for (int s = 0; s < 4; s++) {
+        int shift = 1 << s;
+        for (int j = 0; j < 16; j++) {
+            coeff[s][j] = j >= shift ? powers[shift] : 0.0f;
+            shift_idx[s][j] = j >= shift ? j - shift : 0;
+        }
+    }
+
+    const __m512 va = _mm512_set1_ps(1.0f - gain);
+    const __m512 carry = _mm512_loadu_ps(powers + 1);
+    __m512 c[4];
+    __m512i idx[4];
+    for (int s = 0; s < 4; s++) {
+        c[s] = _mm512_loadu_ps(coeff[s]);
+        idx[s] = _mm512_loadu_si512((const void*)shift_idx[s]);
+    }
+    const __m512i last = _mm512_set1_epi32(15);
+
+    uint32_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 v = _mm512_mul_ps(va, _mm512_loadu_ps(x + i));
+        for (int s = 0; s < 4; s++) {
+            v = _mm512_fmadd_ps(c[s], _mm512_permutexvar_ps(idx[s], v), v);
+        }
+        v = _mm512_fmadd_ps(carry, _mm512_set1_ps(previous), v);
+        _mm512_storeu_ps(x + i, v);
+        previous = _mm512_cvtss_f32(_mm512_permutexvar_ps(last, v));
+    }
+    for (; i < n; i++) {
+        x[i] = x[i] - ((x[i] - previous) * gain);
+        previous = x[i];
+    }
+    return previous;
+}
+
+const OBIVoxKernels obivox_kernels_avx512 = {
+    .isa = OBIVOX_ISA_AVX512,
+    .name = "avx512",
+    .zero_crossings = avx512_zero_crossings,
+    .dot = avx512_dot,
+    .sum = avx512_sum,
+    .diff_energy = avx512_diff_energy,
+    .lisp_filter = avx512_lisp_filter
+};
+
+#endif // __x86_64__ || __i386__
@@ -0,0 +1,171 @@
+/**
+ * obivox_fft.c
+ * Radix-2 real FFT: n real samples packed as an n/2-point complex
+ * transform, then split into even/odd spectra
+ */
+
+#include "dsp/obivox_fft.h"
+#include <math.h>
+#include <stdlib.h>
+
+struct obivox_fft_plan {
+    uint32_t n;
+    uint32_t half;        // Complex transform size
+    uint32_t* bitrev;     // half entries
+    float* cos_table;     // cos(2*pi*k/n), k < n/2
+    float* sin_table;     // sin(2*pi*k/n), k < n/2
+};
+
+OBIVoxFFTPlan* obivox_fft_plan_create(uint32_t n) {
+    if (n < 4 || (n & (n - 1)) != 0) return NULL;
+
+    OBIVoxFFTPlan* plan = calloc(1, sizeof(OBIVoxFFTPlan));
+    if (!plan) return NULL;
+
+    plan->n = n;
+    plan->half = n / 2;
+    plan->bitrev = malloc(plan->half * sizeof(uint32_t));
+    plan->cos_table = malloc(plan->half * sizeof(float));
+    plan->sin_table = malloc(plan->half * sizeof(float));
+    if (!plan->bitrev || !plan->cos_table || !plan->sin_table) {
+        obivox_fft_plan_destroy(plan);
+        return NULL;
+    }
+
+    uint32_t bits = 0;
+    while ((1u << bits) < plan->half) bits++;
+    for (uint32_t i = 0; i < plan->half; i++) {
+        uint32_t r = 0;
+        for (uint32_t b = 0; b < bits; b++) {
+            r |= ((i >> b) & 1u) << (bits - 1 - b);
+        }
+        plan->bitrev[i] = r;
+    }
+
+    for (uint32_t k = 0; k < plan->half; k++) {
+        double angle = 2.0 * M_PI * k / n;
+        plan->cos_table[k] = (float)cos(angle);
+        plan->sin_table[k] = (float)sin(angle);
+    }
+
+    return plan;
+}
+
+void obivox_fft_plan_destroy(OBIVoxFFTPlan* plan) {
+    if (!plan) return;
+    free(plan->bitrev);
+    free(plan->cos_table);
+    free(plan->sin_table);
+    free(plan);
+}
+
+uint32_t obivox_fft_size(const OBIVoxFFTPlan* plan) {
+    return plan ? plan->n : 0;
+}
+
+// In-place complex transform of plan->half points; sign -1 forward, +1 inverse
+static void fft_complex(const OBIVoxFFTPlan* plan, float* re, float* im, float sign) {
+    const uint32_t m = plan->half;
+
+    for (uint32_t i = 0; i < m; i++) {
+        uint32_t j = plan->bitrev[i];
+        if (j > i) {
+            float tr = re[i]; re[i] = re[j]; re[j] = tr;
+            float ti = im[i]; im[i] = im[j]; im[j] = ti;
+        }
+    }
+
+    for (uint32_t len = 2; len <= m; len <<= 1) {
+        uint32_t span = len / 2;
+        uint32_t stride = plan->n / len;
+        for (uint32_t i = 0; i < m; i += len) {
+            for (uint32_t j = 0; j < span; j++) {
+                float wr = plan->cos_table[j * stride];
+                float wi = sign * plan->sin_table[j * stride];
+                uint32_t a = i + j;
+                uint32_t b = a + span;
+                float vr = re[b] * wr - im[b] * wi;
+                float vi = re[b] * wi + im[b] * wr;
+                re[b] = re[a] - vr;
+                im[b] = im[a] - vi;
+                re[a] += vr;
+                im[a] += vi;
+            }
+        }
+    }
+}
+
+void obivox_fft_real_forward(
+    const OBIVoxFFTPlan* plan,
+    const float* input,
+    float* re,
+    float* im) {
+
+    const uint32_t m = plan->half;
+
+    for (uint32_t k = 0; k < m; k++) {
+        re[k] = input[2 * k];
+        im[k] = input[2 * k + 1];
+    }
+    fft_complex(plan, re, im, -1.0f);
+
+    // Split Z = FFT(even + i*odd) into X[k] = E[k] + W^k O[k]
+    float z0r = re[0], z0i = im[0];
+    re[0] = z0r + z0i;  im[0] = 0.0f;
+    re[m] = z0r - z0i;  im[m] = 0.0f;
+
+    for (uint32_t k = 1; k <= m / 2; k++) {
+        float a = re[k], b = im[k];
+        float c = re[m - k], d = im[m - k];
+        float wc = plan->cos_table[k], ws = plan->sin_table[k];
+
+        float er = 0.5f * (a + c), ei = 0.5f * (b - d);
+        float or_ = 0.5f * (b + d), oi = -0.5f * (a - c);
+
+        // W^k = (cos, -sin), W^(m-k) = (-cos, -sin)
+        re[k] = er + (or_ * wc + oi * ws);
+        im[k] = ei + (oi * wc - or_ * ws);
+        re[m - k] = er - (or_ * wc + oi * ws);
+        im[m - k] = -ei + (oi * wc - or_ * ws);
+    }
+}
+
+void obivox_fft_real_inverse(
+    const OBIVoxFFTPlan* plan,
+    float* re,
+    float* im,
+    float* output) {
+
+    const uint32_t m = plan->half;
+
+    // Rebuild Z[k] = E[k] + i O[k] from the half spectrum
+    float x0 = re[0], xm = re[m];
+    re[0] = 0.5f * (x0 + xm);
+    im[0] = 0.5f * (x0 - xm);
+
+    for (uint32_t k = 1; k <= m / 2; k++) {
+        float a = re[k], b = im[k];
+        float c = re[m - k], d = im[m - k];
+        float wc = plan->cos_table[k], ws = plan->sin_table[k];
+
+        float er = 0.5f * (a + c), ei = 0.5f * (b - d);
+        float dr = 0.5f * (a - c), di = 0.5f * (b + d);
+
+        // O[k] = D * conj(W^k) = D * (cos, sin)
+        float or_ = dr * wc - di * ws, oi = dr * ws + di * wc;
+        re[k] = er - oi;
+        im[k] = ei + or_;
+
+        // Mirror bin: E[m-k] = conj(E[k]), O[m-k] = conj(O[k])
+        re[m - k] = er + oi;
+        im[m - k] = -ei + or_;
+    }
+
+    fft_complex(plan, re, im, 1.0f);
+
+    const float scale = 1.0f / m;
+    for (uint32_t k = 0; k < m; k++) {
+        output[2 * k] = re[k] * scale;
+        output[2 * k + 1] = im[k] * scale;
+    }
+}
@@ -0,0 +1,46 @@
+/**
+ * obivox_fft.h
+ * Radix-2 real FFT with reusable plans for the spectral engines
+ * Internal - plans are immutable after creation and may be shared
+ * between threads; scratch stays with the caller
+ */
+
+#ifndef OBIVOX_FFT_H
+#define OBIVOX_FFT_H
+
+#include <stdint.h>
+
+typedef struct obivox_fft_plan OBIVoxFFTPlan;
+
+/**
+ * Plan a real FFT of size n (power of two, n >= 4)
+ */
+OBIVoxFFTPlan* obivox_fft_plan_create(uint32_t n);
+
+void obivox_fft_plan_destroy(OBIVoxFFTPlan* plan);
+
+uint32_t obivox_fft_size(const OBIVoxFFTPlan* plan);
+
+/**
+ * Forward transform of n real samples into n/2 + 1 bins (unscaled)
+ * re and im must each hold n/2 + 1 floats; input is not modified
+ */
+void obivox_fft_real_forward(
+    const OBIVoxFFTPlan* plan,
+    const float* input,
+    float* re,
+    float* im
+);
+
+/**
+ * Inverse of obivox_fft_real_forward, scaled by 1/n
+ * re and im are used as scratch and are overwritten
+ */
+void obivox_fft_real_inverse(
+    const OBIVoxFFTPlan* plan,
+    float* re,
+    float* im,
+    float* output
+);
+
+#endif // OBIVOX_FFT_H
@@ -0,0 +1,111 @@
+/**
+ * obivox_kernels.c
+ * Scalar reference kernels and runtime ISA dispatch
+ */
+
+#include "dsp/obivox_kernels.h"
+#include <pthread.h>
+
+// ============================================================================
+// Scalar Reference Kernels
+// ============================================================================
+
+static uint64_t scalar_zero_crossings(const float* x, uint32_t n, float previous) {
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        if ((x[i] > 0) != (previous > 0)) count++;
+        previous = x[i];
+    }
+    return count;
+}
+
+static float scalar_dot(const float* a, const float* b, uint32_t n) {
+    float acc = 0.0f;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += a[i] * b[i];
+    }
+    return acc;
+}
+
+static float scalar_sum(const float* x, uint32_t n) {
+    float acc = 0.0f;
+    for (uint32_t i = 0; i < n; i++) {
+        acc += x[i];
+    }
+    return acc;
+}
+
+static float scalar_diff_energy(const float* x, uint32_t n) {
+    float acc = 0.0f;
+    for (uint32_t i = 1; i < n; i++) {
+        float diff = x[i] - x[i-1];
+        acc += diff * diff;
+    }
+    return acc;
+}
+
+static float scalar_lisp_filter(float* x, uint32_t n, float gain, float previous) {
+    for (uint32_t i = 0; i < n; i++) {
+        float diff = x[i] - previous;
+        x[i] = x[i] - (diff * gain);
+        previous = x[i];
+    }
+    return previous;
+}
+
+const OBIVoxKernels obivox_kernels_scalar = {
+    .isa = OBIVOX_ISA_SCALAR,
+    .name = "scalar",
+    .zero_crossings = scalar_zero_crossings,
+    .dot = scalar_dot,
+    .sum = scalar_sum,
+    .diff_energy = scalar_diff_energy,
+    .lisp_filter = scalar_lisp_filter
+};
+
+// ============================================================================
+// Runtime Dispatch
+// ============================================================================
+
+static const OBIVoxKernels* active_kernels = &obivox_kernels_scalar;
+static pthread_once_t active_once = PTHREAD_ONCE_INIT;
+
+const OBIVoxKernels* obivox_kernels_for_isa(OBIVoxISA isa) {
+    switch (isa) {
+    case OBIVOX_ISA_SCALAR:
+        return &obivox_kernels_scalar;
+#if defined(__x86_64__) || defined(__i386__)
+    case OBIVOX_ISA_AVX2:
+        __builtin_cpu_init();
+        return (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            ? &obivox_kernels_avx2 : NULL;
+    case OBIVOX_ISA_AVX512:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f") ? &obivox_kernels_avx512 : NULL;
+#endif
+#if defined(__aarch64__)
+    case OBIVOX_ISA_NEON:
+        return &obivox_kernels_neon;  // Mandatory on AArch64
+#endif
+    default:
+        return NULL;
+    }
+}
+
+static void select_kernels(void) {
+    static const OBIVoxISA preference[] = {
+        OBIVOX_ISA_AVX512, OBIVOX_ISA_AVX2, OBIVOX_ISA_NEON
+    };
+    for (unsigned i = 0; i < sizeof(preference) / sizeof(preference[0]); i++) {
+        const OBIVoxKernels* k = obivox_kernels_for_isa(preference[i]);
+        if (k) {
+            active_kernels = k;
+            return;
+        }
+    }
+}
+
+const OBIVoxKernels* obivox_kernels(void) {
+    pthread_once(&active_once, select_kernels);
+    return active_kernels;
+}
@@ -0,0 +1,62 @@
+/**
+ * obivox_kernels.h
+ * Internal float kernel layer for the feature stage hot loops
+ * One table per instruction set, selected once at runtime
+ */
+
+#ifndef OBIVOX_KERNELS_H
+#define OBIVOX_KERNELS_H
+
+#include <stdint.h>
+
+typedef enum {
+    OBIVOX_ISA_SCALAR = 0,
+    OBIVOX_ISA_AVX2,
+    OBIVOX_ISA_AVX512,
+    OBIVOX_ISA_NEON,
+    OBIVOX_ISA_COUNT
+} OBIVoxISA;
+
+typedef struct {
+    OBIVoxISA isa;
+    const char* name;
+
+    // Count i where (x[i] > 0) != (x[i-1] > 0), with x[-1] = previous
+    uint64_t (*zero_crossings)(const float* x, uint32_t n, float previous);
+
+    // Sum of a[i] * b[i]
+    float (*dot)(const float* a, const float* b, uint32_t n);
+
+    // Sum of x[i]
+    float (*sum)(const float* x, uint32_t n);
+
+    // Sum of (x[i] - x[i-1])^2 for i >= 1
+    float (*diff_energy)(const float* x, uint32_t n);
+
+    // In place y[i] = x[i] - gain * (x[i] - y[i-1]), y[-1] = previous
+    // Returns y[n-1] so callers can chain blocks
+    float (*lisp_filter)(float* x, uint32_t n, float gain, float previous);
+} OBIVoxKernels;
+
+/**
+ * Best table for this CPU; resolved on first call, then constant
+ */
+const OBIVoxKernels* obivox_kernels(void);
+
+/**
+ * Table for a specific ISA, or NULL if not built in or not supported
+ * by this CPU (benchmarks and cross-checks)
+ */
+const OBIVoxKernels* obivox_kernels_for_isa(OBIVoxISA isa);
+
+// Per-ISA tables, defined by the translation unit for that ISA
+extern const OBIVoxKernels obivox_kernels_scalar;
+#if defined(__x86_64__) || defined(__i386__)
+extern const OBIVoxKernels obivox_kernels_avx2;
+extern const OBIVoxKernels obivox_kernels_avx512;
+#endif
+#if defined(__aarch64__)
+extern const OBIVoxKernels obivox_kernels_neon;
+#endif
+
+#endif // OBIVOX_KERNELS_H
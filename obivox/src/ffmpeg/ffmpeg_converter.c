@@ -0,0 +1,255 @@
+/**
+ * ffmpeg_converter.c
+ * Reusable stream-copy remuxer: format lookups, packet and stream map
+ * survive across inputs; batch mode runs one converter per core
+ */
+
+#include "obivox/nlm_ffmpeg.h"
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+struct obivox_converter {
+    AVOutputFormat* output_format;
+    AVInputFormat* input_hint;
+    AVPacket* packet;
+    int* stream_map;
+    unsigned stream_map_size;
+};
+
+// ============================================================================
+// Converter Lifecycle
+// ============================================================================
+
+int obivox_converter_create(const char* target_format, OBIVoxConverter** converter) {
+    if (!target_format || !converter) return AVERROR(EINVAL);
+
+    OBIVoxConverter* c = calloc(1, sizeof(OBIVoxConverter));
+    if (!c) return AVERROR(ENOMEM);
+
+    // Resolved once instead of per output file
+    c->output_format = av_guess_format(target_format, NULL, NULL);
+    c->packet = av_packet_alloc();
+    if (!c->output_format || !c->packet) {
+        int ret = c->output_format ? AVERROR(ENOMEM) : AVERROR_MUXER_NOT_FOUND;
+        obivox_converter_destroy(c);
+        return ret;
+    }
+
+    *converter = c;
+    return 0;
+}
+
+void obivox_converter_destroy(OBIVoxConverter* converter) {
+    if (!converter) return;
+    av_packet_free(&converter->packet);
+    free(converter->stream_map);
+    free(converter);
+}
+
+// ============================================================================
+// Conversion
+// ============================================================================
+
+static int open_input(OBIVoxConverter* c, const char* path, AVFormatContext** input) {
+    // Batches are usually one container; skip probing when the last
+    // demuxer accepts this file too
+    if (c->input_hint) {
+        if (avformat_open_input(input, path, c->input_hint, NULL) >= 0) return 0;
+        *input = NULL;
+    }
+
+    int ret = avformat_open_input(input, path, NULL, NULL);
+    if (ret >= 0) c->input_hint = (*input)->iformat;
+    return ret;
+}
+
+static int map_streams(OBIVoxConverter* c, AVFormatContext* input, AVFormatContext* output) {
+    if (input->nb_streams > c->stream_map_size) {
+        int* grown = realloc(c->stream_map, input->nb_streams * sizeof(int));
+        if (!grown) return AVERROR(ENOMEM);
+        c->stream_map = grown;
+        c->stream_map_size = input->nb_streams;
+    }
+
+    int mapped = 0;
+    for (unsigned i = 0; i < input->nb_streams; i++) {
+        AVStream* in_stream = input->streams[i];
+
+        // Audio conversion: video, subtitle and data streams are dropped
+        if (in_stream->codecpar->codec_type != AVMEDIA_TYPE_AUDIO) {
+            c->stream_map[i] = -1;
+            continue;
+        }
+
+        AVStream* out_stream = avformat_new_stream(output, NULL);
+        if (!out_stream) return AVERROR(ENOMEM);
+
+        int ret = avcodec_parameters_copy(out_stream->codecpar, in_stream->codecpar);
+        if (ret < 0) return ret;
+
+        // Source container tags rarely mean the same thing in the target
+        out_stream->codecpar->codec_tag = 0;
+        out_stream->time_base = in_stream->time_base;
+        c->stream_map[i] = mapped++;
+    }
+
+    return mapped > 0 ? 0 : AVERROR_STREAM_NOT_FOUND;
+}
+
+int obivox_converter_convert(
+    OBIVoxConverter* converter,
+    const char* input_path,
+    const char* output_path) {
+
+    if (!converter || !input_path || !output_path) return AVERROR(EINVAL);
+
+    AVFormatContext* input = NULL;
+    AVFormatContext* output = NULL;
+    AVPacket* packet = converter->packet;
+
+    int ret = open_input(converter, input_path, &input);
+    if (ret < 0) return ret;
+
+    ret = avformat_find_stream_info(input, NULL);
+    if (ret < 0) goto cleanup;
+
+    ret = avformat_alloc_output_context2(&output, converter->output_format, NULL, output_path);
+    if (ret < 0) goto cleanup;
+
+    ret = map_streams(converter, input, output);
+    if (ret < 0) goto cleanup;
+
+    if (!(output->oformat->flags & AVFMT_NOFILE)) {
+        ret = avio_open(&output->pb, output_path, AVIO_FLAG_WRITE);
+        if (ret < 0) goto cleanup;
+    }
+
+    // The muxer may replace the suggested time bases here
+    ret = avformat_write_header(output, NULL);
+    if (ret < 0) goto cleanup;
+
+    while ((ret = av_read_frame(input, packet)) >= 0) {
+        int index = packet->stream_index;
+        if ((unsigned)index >= input->nb_streams || converter->stream_map[index] < 0) {
+            av_packet_unref(packet);
+            continue;
+        }
+
+        AVStream* in_stream = input->streams[index];
+        AVStream* out_stream = output->streams[converter->stream_map[index]];
+
+        packet->stream_index = out_stream->index;
+        av_packet_rescale_ts(packet, in_stream->time_base, out_stream->time_base);
+        packet->pos = -1;
+
+        // Takes the packet reference whether or not it succeeds
+        ret = av_interleaved_write_frame(output, packet);
+        if (ret < 0) goto cleanup;
+    }
+    if (ret != AVERROR_EOF) goto cleanup;
+
+    ret = av_write_trailer(output);
+
+cleanup:
+    av_packet_unref(packet);
+    if (output && !(output->oformat->flags & AVFMT_NOFILE)) {
+        avio_closep(&output->pb);
+    }
+    avformat_free_context(output);
+    avformat_close_input(&input);
+
+    return ret < 0 ? ret : 0;
+}
+
+// ============================================================================
+// Batch Mode
+// ============================================================================
+
+typedef struct {
+    OBIVoxConverter* converter;
+    OBIVoxConvertJob* jobs;
+    uint32_t count;
+    atomic_uint* next_job;
+    atomic_uint* failed;
+} BatchWorker;
+
+static void* batch_worker(void* arg) {
+    BatchWorker* w = arg;
+    for (;;) {
+        uint32_t job = atomic_fetch_add_explicit(w->next_job, 1, memory_order_relaxed);
+        if (job >= w->count) break;
+
+        OBIVoxConvertJob* j = &w->jobs[job];
+        j->result = obivox_converter_convert(w->converter, j->input_path, j->output_path);
+        if (j->result < 0) {
+            atomic_fetch_add_explicit(w->failed, 1, memory_order_relaxed);
+        }
+    }
+    return NULL;
+}
+
+int obivox_convert_batch(
+    const char* target_format,
+    OBIVoxConvertJob* jobs,
+    uint32_t count,
+    uint32_t num_threads) {
+
+    if (!target_format || (!jobs && count > 0)) return -1;
+    if (count == 0) return 0;
+
+    if (num_threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = online > 0 ? (uint32_t)online : 1;
+    }
+    if (num_threads > count) num_threads = count;
+
+    BatchWorker* workers = calloc(num_threads, sizeof(BatchWorker));
+    pthread_t* threads = calloc(num_threads, sizeof(pthread_t));
+    if (!workers || !threads) {
+        free(workers);
+        free(threads);
+        return -1;
+    }
+
+    atomic_uint next_job;
+    atomic_uint failed;
+    atomic_init(&next_job, 0);
+    atomic_init(&failed, 0);
+
+    // Every converter exists before any job starts, so a failure here
+    // leaves every job untouched
+    int ret = 0;
+    for (uint32_t i = 0; i < num_threads && ret == 0; i++) {
+        workers[i].jobs = jobs;
+        workers[i].count = count;
+        workers[i].next_job = &next_job;
+        workers[i].failed = &failed;
+        if (obivox_converter_create(target_format, &workers[i].converter) < 0) ret = -1;
+    }
+
+    uint32_t started = 0;
+    if (ret == 0) {
+        // The calling thread works too
+        for (uint32_t i = 1; i < num_threads; i++) {
+            if (pthread_create(&threads[i], NULL, batch_worker, &workers[i]) != 0) break;
+            started++;
+        }
+        batch_worker(&workers[0]);
+        for (uint32_t i = 1; i <= started; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        ret = (int)atomic_load(&failed);
+    }
+
+    for (uint32_t i = 0; i < num_threads; i++) {
+        obivox_converter_destroy(workers[i].converter);
+    }
+    free(workers);
+    free(threads);
+    return ret;
+}
@@ -0,0 +1,246 @@
+/**
+ * ffmpeg_pipeline.c
+ * Demux + decode + resample in one pass from memory or caller I/O into
+ * a reusable mono float32 PCM buffer
+ */
+
+#include "obivox/nlm_ffmpeg.h"
+#include <libavformat/avformat.h>
+#include <libavcodec/avcodec.h>
+#include <libswresample/swresample.h>
+#include <libavutil/channel_layout.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AVIO_BUFFER_SIZE  (32 * 1024)
+
+// ============================================================================
+// PCM Buffer
+// ============================================================================
+
+static int pcm_reserve(OBIVoxPCMBuffer* pcm, uint64_t samples) {
+    if (samples <= pcm->capacity) return 0;
+    if (samples > UINT32_MAX) return AVERROR(ERANGE);
+
+    uint64_t capacity = pcm->capacity ? pcm->capacity : OBIVOX_DECODE_RATE;
+    while (capacity < samples) capacity *= 2;
+    if (capacity > UINT32_MAX) capacity = UINT32_MAX;
+
+    float* grown = realloc(pcm->samples, capacity * sizeof(float));
+    if (!grown) return AVERROR(ENOMEM);
+    pcm->samples = grown;
+    pcm->capacity = (uint32_t)capacity;
+    return 0;
+}
+
+void obivox_pcm_release(OBIVoxPCMBuffer* pcm) {
+    if (!pcm) return;
+    free(pcm->samples);
+    memset(pcm, 0, sizeof(*pcm));
+}
+
+int obivox_pcm_borrow(const OBIVoxPCMBuffer* pcm, AudioFeatures* features) {
+    if (!pcm || !features || !pcm->samples) return -1;
+    features->raw_audio = pcm->samples;
+    features->num_samples = pcm->num_samples;
+    features->sample_rate = pcm->sample_rate;
+    return 0;
+}
+
+// ============================================================================
+// Decode + Resample
+// ============================================================================
+
+// Converts straight into the tail of the PCM buffer - no staging copy
+static int resample_into(SwrContext* swr, const uint8_t** input, int in_samples,
+                         OBIVoxPCMBuffer* pcm) {
+    int capacity = swr_get_out_samples(swr, in_samples);
+    if (capacity <= 0) return 0;
+
+    int ret = pcm_reserve(pcm, (uint64_t)pcm->num_samples + capacity);
+    if (ret < 0) return ret;
+
+    uint8_t* out = (uint8_t*)(pcm->samples + pcm->num_samples);
+    int converted = swr_convert(swr, &out, capacity, input, in_samples);
+    if (converted < 0) return converted;
+
+    pcm->num_samples += (uint32_t)converted;
+    return 0;
+}
+
+// packet == NULL drains the decoder
+static int decode_packet(AVCodecContext* decoder, SwrContext* swr,
+                         const AVPacket* packet, AVFrame* frame,
+                         OBIVoxPCMBuffer* pcm) {
+    int ret = avcodec_send_packet(decoder, packet);
+    if (ret < 0 && ret != AVERROR_EOF) return ret;
+
+    for (;;) {
+        ret = avcodec_receive_frame(decoder, frame);
+        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) return 0;
+        if (ret < 0) return ret;
+
+        ret = resample_into(swr, (const uint8_t**)frame->extended_data,
+                            frame->nb_samples, pcm);
+        av_frame_unref(frame);
+        if (ret < 0) return ret;
+    }
+}
+
+static int decode_format(AVFormatContext* format, OBIVoxPCMBuffer* pcm) {
+    AVCodecContext* decoder = NULL;
+    SwrContext* swr = NULL;
+    AVPacket* packet = NULL;
+    AVFrame* frame = NULL;
+
+    int ret = avformat_find_stream_info(format, NULL);
+    if (ret < 0) return ret;
+
+    AVCodec* codec = NULL;
+    int stream = av_find_best_stream(format, AVMEDIA_TYPE_AUDIO, -1, -1, &codec, 0);
+    if (stream < 0) return stream;
+
+    decoder = avcodec_alloc_context3(codec);
+    if (!decoder) return AVERROR(ENOMEM);
+
+    ret = avcodec_parameters_to_context(decoder, format->streams[stream]->codecpar);
+    if (ret < 0) goto cleanup;
+    ret = avcodec_open2(decoder, codec, NULL);
+    if (ret < 0) goto cleanup;
+
+    int64_t in_layout = decoder->channel_layout
+        ? (int64_t)decoder->channel_layout
+        : av_get_default_channel_layout(decoder->channels);
+
+    // Downmix, convert and resample in the one libswresample pass
+    swr = swr_alloc_set_opts(NULL,
+                             AV_CH_LAYOUT_MONO, AV_SAMPLE_FMT_FLT, OBIVOX_DECODE_RATE,
+                             in_layout, decoder->sample_fmt, decoder->sample_rate,
+                             0, NULL);
+    if (!swr) {
+        ret = AVERROR(ENOMEM);
+        goto cleanup;
+    }
+    ret = swr_init(swr);
+    if (ret < 0) goto cleanup;
+
+    packet = av_packet_alloc();
+    frame = av_frame_alloc();
+    if (!packet || !frame) {
+        ret = AVERROR(ENOMEM);
+        goto cleanup;
+    }
+
+    pcm->num_samples = 0;
+    pcm->sample_rate = OBIVOX_DECODE_RATE;
+
+    while ((ret = av_read_frame(format, packet)) >= 0) {
+        if (packet->stream_index == stream) {
+            ret = decode_packet(decoder, swr, packet, frame, pcm);
+        }
+        av_packet_unref(packet);
+        if (ret < 0) goto cleanup;
+    }
+    if (ret != AVERROR_EOF) goto cleanup;
+
+    // Drain the decoder, then whatever the resampler still buffers
+    ret = decode_packet(decoder, swr, NULL, frame, pcm);
+    if (ret >= 0) ret = resample_into(swr, NULL, 0, pcm);
+
+cleanup:
+    av_frame_free(&frame);
+    av_packet_free(&packet);
+    swr_free(&swr);
+    avcodec_free_context(&decoder);
+    return ret < 0 ? ret : 0;
+}
+
+int obivox_decode_avio(void* avio_context, OBIVoxPCMBuffer* pcm) {
+    if (!avio_context || !pcm) return AVERROR(EINVAL);
+
+    AVFormatContext* format = avformat_alloc_context();
+    if (!format) return AVERROR(ENOMEM);
+
+    format->pb = avio_context;
+    format->flags |= AVFMT_FLAG_CUSTOM_IO;
+
+    // On failure avformat_open_input frees the context itself
+    int ret = avformat_open_input(&format, NULL, NULL, NULL);
+    if (ret < 0) return ret;
+
+    ret = decode_format(format, pcm);
+    avformat_close_input(&format);
+    return ret;
+}
+
+int obivox_decode_callbacks(
+    void* opaque,
+    OBIVoxReadFn read,
+    OBIVoxSeekFn seek,
+    OBIVoxPCMBuffer* pcm) {
+
+    if (!read || !pcm) return AVERROR(EINVAL);
+
+    uint8_t* buffer = av_malloc(AVIO_BUFFER_SIZE);
+    if (!buffer) return AVERROR(ENOMEM);
+
+    AVIOContext* io = avio_alloc_context(buffer, AVIO_BUFFER_SIZE, 0, opaque,
+                                         read, NULL, seek);
+    if (!io) {
+        av_free(buffer);
+        return AVERROR(ENOMEM);
+    }
+
+    int ret = obivox_decode_avio(io, pcm);
+
+    // The context may have replaced its buffer while probing
+    av_freep(&io->buffer);
+    avio_context_free(&io);
+    return ret;
+}
+
+// ============================================================================
+// Memory Input
+// ============================================================================
+
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+} MemoryInput;
+
+static int memory_read(void* opaque, uint8_t* buffer, int size) {
+    MemoryInput* in = opaque;
+    size_t remaining = in->size - in->position;
+    if (remaining == 0) return AVERROR_EOF;
+
+    size_t n = (size_t)size < remaining ? (size_t)size : remaining;
+    memcpy(buffer, in->data + in->position, n);
+    in->position += n;
+    return (int)n;
+}
+
+static int64_t memory_seek(void* opaque, int64_t offset, int whence) {
+    MemoryInput* in = opaque;
+    int64_t base;
+
+    switch (whence & ~AVSEEK_FORCE) {
+    case AVSEEK_SIZE: return (int64_t)in->size;
+    case SEEK_SET:    base = 0; break;
+    case SEEK_CUR:    base = (int64_t)in->position; break;
+    case SEEK_END:    base = (int64_t)in->size; break;
+    default:          return AVERROR(EINVAL);
+    }
+
+    int64_t target = base + offset;
+    if (target < 0 || target > (int64_t)in->size) return AVERROR(EINVAL);
+    in->position = (size_t)target;
+    return target;
+}
+
+int obivox_decode_memory(const void* data, size_t size, OBIVoxPCMBuffer* pcm) {
+    if (!data || size == 0 || !pcm) return AVERROR(EINVAL);
+
+    MemoryInput input = { data, size, 0 };
+    return obivox_decode_callbacks(&input, memory_read, memory_seek, pcm);
+}
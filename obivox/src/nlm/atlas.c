@@ -0,0 +1,358 @@
+/**
+ * atlas.c
+ * Shared NLM-Atlas: readers walk an immutable published tree with no
+ * locks; writers path-copy, swap the root and retire old nodes through
+ * epoch-based reclamation. TREE_MODE_HYBRID chooses AVL or RB balancing
+ * from the observed read/write ratio and migrates by copy-and-swap
+ */
+
+#include "nlm/atlas_internal.h"
+#include "core/obivox_epoch.h"
+#include "core/nlm_internal.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ATLAS_SHARDS          64
+#define ATLAS_WINDOW          4096     // Operations between HYBRID evaluations
+#define ATLAS_SHARD_WINDOW    (ATLAS_WINDOW / ATLAS_SHARDS)
+#define HYBRID_STRICT_RATIO   0.90f    // Read share that pays for AVL
+#define HYBRID_RELAXED_RATIO  0.70f    // Below this, RB; in between, stay
+#define HYBRID_STABLE_WINDOWS 4        // Agreeing windows before migrating
+
+// Per-thread-group counters so lookups never share a cache line
+typedef struct {
+    _Alignas(64) atomic_uint_fast64_t lookups;
+    atomic_uint_fast64_t depth;
+    atomic_uint_fast64_t writes;
+} AtlasShard;
+
+struct obivox_atlas {
+    // Current version; nodes reachable from it are never written again
+    // (apart from the relaxed access_frequency counters)
+    _Atomic(NLMAtlasNode*) root;
+
+    // Serialises writers, migrations and evaluation state below
+    pthread_mutex_t writer_lock;
+    atomic_int mode;
+    TreeMode balancing;
+    uint32_t nodes;
+    uint64_t evaluated_lookups;
+    uint64_t evaluated_writes;
+    float window_read_ratio;
+    uint32_t agreeing_windows;
+    uint64_t rotations;
+    uint64_t migrations;
+    uint64_t migration_ns;
+
+    AtlasShard shards[ATLAS_SHARDS];
+};
+
+static atomic_uint next_shard;
+static _Thread_local int32_t thread_shard = -1;
+
+static AtlasShard* atlas_shard(OBIVoxAtlas* atlas) {
+    if (thread_shard < 0) {
+        thread_shard = (int32_t)(atomic_fetch_add_explicit(&next_shard, 1, memory_order_relaxed) % ATLAS_SHARDS);
+    }
+    return &atlas->shards[thread_shard];
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+int obivox_atlas_create(TreeMode mode, OBIVoxAtlas** atlas) {
+    if (!atlas) return -1;
+
+    OBIVoxAtlas* a = calloc(1, sizeof(OBIVoxAtlas));
+    if (!a) return -1;
+
+    atomic_init(&a->root, NULL);
+    pthread_mutex_init(&a->writer_lock, NULL);
+    atomic_init(&a->mode, mode);
+    a->balancing = (mode == TREE_MODE_RB) ? TREE_MODE_RB : TREE_MODE_AVL;
+    a->window_read_ratio = 1.0f;
+
+    *atlas = a;
+    return 0;
+}
+
+void obivox_atlas_destroy(OBIVoxAtlas* atlas) {
+    if (!atlas) return;
+
+    // Drain versions retired by this Atlas before the caller unloads
+    obivox_epoch_synchronize();
+    obivox_atlas_free(atomic_load_explicit(&atlas->root, memory_order_relaxed));
+    pthread_mutex_destroy(&atlas->writer_lock);
+    free(atlas);
+}
+
+// ============================================================================
+// Retirement
+// ============================================================================
+
+typedef struct {
+    uint32_t count;
+    NLMAtlasNode* nodes[];
+} RetiredNodes;
+
+static void retired_nodes_free(void* batch) {
+    RetiredNodes* r = batch;
+    for (uint32_t i = 0; i < r->count; i++) free(r->nodes[i]);
+    free(r);
+}
+
+static void retired_tree_free(void* root) {
+    obivox_atlas_free(root);
+}
+
+static void atlas_retire_nodes(NLMAtlasNode** nodes, uint32_t count) {
+    if (count == 0) return;
+
+    RetiredNodes* batch = malloc(sizeof(RetiredNodes) + count * sizeof(NLMAtlasNode*));
+    if (!batch) {
+        obivox_epoch_synchronize();
+        for (uint32_t i = 0; i < count; i++) free(nodes[i]);
+        return;
+    }
+    batch->count = count;
+    memcpy(batch->nodes, nodes, count * sizeof(NLMAtlasNode*));
+    obivox_epoch_retire(batch, retired_nodes_free);
+}
+
+// ============================================================================
+// Migration (writer_lock held)
+// ============================================================================
+
+static int atlas_migrate(OBIVoxAtlas* atlas, TreeMode balancing) {
+    uint64_t start = obivox_now_ns();
+
+    // Readers keep using the old version while the copy is built
+    NLMAtlasNode* current = atomic_load_explicit(&atlas->root, memory_order_relaxed);
+    NLMAtlasNode* rebuilt = NULL;
+    uint32_t count = 0;
+    if (obivox_atlas_tree_rebuild(current, balancing, &rebuilt, &count) != 0) {
+        return -1;
+    }
+
+    atomic_store_explicit(&atlas->root, rebuilt, memory_order_release);
+    atlas->balancing = balancing;
+
+    // Every node of the old version is unique to it after a full rebuild
+    if (current) obivox_epoch_retire(current, retired_tree_free);
+
+    atlas->nodes = count;
+    atlas->migrations++;
+    atlas->migration_ns += obivox_now_ns() - start;
+    return 0;
+}
+
+static void atlas_evaluate(OBIVoxAtlas* atlas) {
+    uint64_t lookups = 0, writes = 0;
+    for (uint32_t i = 0; i < ATLAS_SHARDS; i++) {
+        lookups += atomic_load_explicit(&atlas->shards[i].lookups, memory_order_relaxed);
+        writes += atomic_load_explicit(&atlas->shards[i].writes, memory_order_relaxed);
+    }
+
+    uint64_t window_lookups = lookups - atlas->evaluated_lookups;
+    uint64_t window_writes = writes - atlas->evaluated_writes;
+    if (window_lookups + window_writes < ATLAS_WINDOW) return;
+
+    atlas->evaluated_lookups = lookups;
+    atlas->evaluated_writes = writes;
+    atlas->window_read_ratio = (float)window_lookups / (float)(window_lookups + window_writes);
+
+    if (atomic_load_explicit(&atlas->mode, memory_order_relaxed) != TREE_MODE_HYBRID) return;
+
+    // Hysteresis band plus a run of agreeing windows keeps mixed traffic
+    // from paying for a full restructure on every swing
+    TreeMode target = atlas->balancing;
+    if (atlas->window_read_ratio >= HYBRID_STRICT_RATIO) {
+        target = TREE_MODE_AVL;
+    } else if (atlas->window_read_ratio <= HYBRID_RELAXED_RATIO) {
+        target = TREE_MODE_RB;
+    }
+    if (target == atlas->balancing) {
+        atlas->agreeing_windows = 0;
+    } else if (++atlas->agreeing_windows >= HYBRID_STABLE_WINDOWS) {
+        atlas->agreeing_windows = 0;
+        atlas_migrate(atlas, target);
+    }
+}
+
+int obivox_atlas_set_mode(OBIVoxAtlas* atlas, TreeMode mode) {
+    if (!atlas) return -1;
+
+    pthread_mutex_lock(&atlas->writer_lock);
+    atomic_store_explicit(&atlas->mode, mode, memory_order_relaxed);
+
+    // HYBRID keeps the current layout until a window says otherwise
+    int ret = 0;
+    if (mode != TREE_MODE_HYBRID && mode != atlas->balancing) {
+        ret = atlas_migrate(atlas, mode);
+    }
+    pthread_mutex_unlock(&atlas->writer_lock);
+    return ret;
+}
+
+// ============================================================================
+// Reads / Writes
+// ============================================================================
+
+static void atlas_assign(OBIVoxAtlasEntry* entry, void* context) {
+    *entry = *(const OBIVoxAtlasEntry*)context;
+}
+
+int obivox_atlas_update(
+    OBIVoxAtlas* atlas,
+    const char* service,
+    const char* operation,
+    OBIVoxAtlasUpdateFn update,
+    void* context) {
+
+    if (!atlas || !service || !operation) return -1;
+
+    pthread_mutex_lock(&atlas->writer_lock);
+
+    NLMAtlasNode* current = atomic_load_explicit(&atlas->root, memory_order_relaxed);
+    NLMAtlasNode* next = NULL;
+    NLMAtlasNode* retired[OBIVOX_ATLAS_MAX_RETIRED];
+    uint32_t retired_count = 0;
+    uint32_t rotations = 0;
+    int ret = obivox_atlas_tree_update_cow(current, atlas->balancing, service, operation,
+                                           update, context, &next,
+                                           retired, &retired_count, &rotations);
+    if (ret >= 0) {
+        atomic_store_explicit(&atlas->root, next, memory_order_release);
+        atlas_retire_nodes(retired, retired_count);
+
+        if (ret == 1) atlas->nodes++;
+        atlas->rotations += rotations;
+
+        AtlasShard* shard = atlas_shard(atlas);
+        atomic_fetch_add_explicit(&shard->writes, 1, memory_order_relaxed);
+        atlas_evaluate(atlas);
+    }
+
+    pthread_mutex_unlock(&atlas->writer_lock);
+    return ret;
+}
+
+int obivox_atlas_upsert(
+    OBIVoxAtlas* atlas,
+    const char* service,
+    const char* operation,
+    const OBIVoxAtlasEntry* values) {
+
+    if (!values) return -1;
+    return obivox_atlas_update(atlas, service, operation, atlas_assign, (void*)values);
+}
+
+int obivox_atlas_lookup(
+    OBIVoxAtlas* atlas,
+    const char* service,
+    const char* operation,
+    OBIVoxAtlasEntry* entry) {
+
+    if (!atlas || !service || !operation || !entry) return -1;
+
+    if (obivox_epoch_enter() != 0) return -1;
+
+    uint32_t depth = 0;
+    NLMAtlasNode* root = atomic_load_explicit(&atlas->root, memory_order_acquire);
+    NLMAtlasNode* node = obivox_atlas_tree_find_depth(root, service, operation, &depth);
+    if (node) {
+        entry->x_coord = node->x_coord;
+        entry->y_coord = node->y_coord;
+        entry->z_coord = node->z_coord;
+        entry->dynamic_cost = node->dynamic_cost;
+        entry->confidence_score = node->confidence_score;
+        __atomic_fetch_add(&node->access_frequency, 1, __ATOMIC_RELAXED);
+    }
+    obivox_epoch_exit();
+
+    AtlasShard* shard = atlas_shard(atlas);
+    uint64_t seen = atomic_fetch_add_explicit(&shard->lookups, 1, memory_order_relaxed) + 1;
+    atomic_fetch_add_explicit(&shard->depth, depth, memory_order_relaxed);
+
+    // Pure read traffic still needs evaluating; whoever crosses a shard
+    // window tries once and never waits for the writer lock
+    if (seen % ATLAS_SHARD_WINDOW == 0 &&
+        atomic_load_explicit(&atlas->mode, memory_order_relaxed) == TREE_MODE_HYBRID &&
+        pthread_mutex_trylock(&atlas->writer_lock) == 0) {
+        atlas_evaluate(atlas);
+        pthread_mutex_unlock(&atlas->writer_lock);
+    }
+
+    return node ? 0 : -1;
+}
+
+// ============================================================================
+// Flat Images
+// ============================================================================
+
+int obivox_atlas_build_index(OBIVoxAtlas* atlas, OBIVoxAtlasIndex** index) {
+    if (!atlas || !index) return -1;
+
+    // The published version is immutable, so the walk needs no lock
+    if (obivox_epoch_enter() != 0) return -1;
+    int ret = obivox_atlas_index_build(
+        atomic_load_explicit(&atlas->root, memory_order_acquire), index);
+    obivox_epoch_exit();
+    return ret;
+}
+
+int obivox_atlas_load_index(OBIVoxAtlas* atlas, const OBIVoxAtlasIndex* index) {
+    if (!atlas || !index) return -1;
+
+    pthread_mutex_lock(&atlas->writer_lock);
+
+    NLMAtlasNode* loaded = NULL;
+    uint32_t count = 0;
+    if (obivox_atlas_tree_build_index(index, atlas->balancing, &loaded, &count) != 0) {
+        pthread_mutex_unlock(&atlas->writer_lock);
+        return -1;
+    }
+
+    NLMAtlasNode* current = atomic_load_explicit(&atlas->root, memory_order_relaxed);
+    atomic_store_explicit(&atlas->root, loaded, memory_order_release);
+    if (current) obivox_epoch_retire(current, retired_tree_free);
+    atlas->nodes = count;
+
+    pthread_mutex_unlock(&atlas->writer_lock);
+    return 0;
+}
+
+// ============================================================================
+// Metrics
+// ============================================================================
+
+void obivox_atlas_metrics(OBIVoxAtlas* atlas, OBIVoxAtlasMetrics* metrics) {
+    if (!atlas || !metrics) return;
+    memset(metrics, 0, sizeof(*metrics));
+
+    uint64_t depth = 0;
+    for (uint32_t i = 0; i < ATLAS_SHARDS; i++) {
+        metrics->lookups += atomic_load_explicit(&atlas->shards[i].lookups, memory_order_relaxed);
+        metrics->writes += atomic_load_explicit(&atlas->shards[i].writes, memory_order_relaxed);
+        depth += atomic_load_explicit(&atlas->shards[i].depth, memory_order_relaxed);
+    }
+    metrics->mean_lookup_depth = metrics->lookups ? (float)depth / (float)metrics->lookups : 0.0f;
+
+    pthread_mutex_lock(&atlas->writer_lock);
+    metrics->mode = (TreeMode)atomic_load_explicit(&atlas->mode, memory_order_relaxed);
+    metrics->balancing = atlas->balancing;
+    metrics->nodes = atlas->nodes;
+    if (obivox_epoch_enter() == 0) {
+        metrics->height = obivox_atlas_tree_height(
+            atomic_load_explicit(&atlas->root, memory_order_acquire));
+        obivox_epoch_exit();
+    }
+    metrics->window_read_ratio = atlas->window_read_ratio;
+    metrics->rotations = atlas->rotations;
+    metrics->migrations = atlas->migrations;
+    metrics->migration_ns = atlas->migration_ns;
+    pthread_mutex_unlock(&atlas->writer_lock);
+}
@@ -0,0 +1,442 @@
+/**
+ * atlas_index.c
+ * Flat NLM-Atlas index: interned name pairs as 64-bit keys in an
+ * Eytzinger-ordered array, hot payload in a parallel array, names cold
+ */
+
+#include "nlm/atlas_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define INDEX_ALIGN     64
+#define INDEX_NAME_MAX  63
+
+#define IMAGE_MAGIC     "OBVXIDX"
+#define IMAGE_VERSION   1
+
+typedef struct {
+    uint32_t service_id;
+    uint32_t operation_id;
+} AtlasCold;
+
+struct obivox_atlas_index {
+    uint32_t count;
+
+    // 1-based, slot 0 unused; keys[8k..8k+7] are the great-grandchildren
+    // of k and share one cache line
+    OBIVoxAtlasKey* keys;
+    OBIVoxAtlasEntry* entries;
+    AtlasCold* cold;
+
+    // Name interning: open addressing over id + 1 (0 = empty slot)
+    uint32_t* slots;
+    uint32_t slot_mask;
+    uint32_t* name_hashes;
+    uint32_t* name_offsets;
+    uint32_t name_count;
+    char* names;
+    size_t names_len;
+
+    // Eytzinger slot of the i-th entry in (service, operation) order
+    uint32_t* order;
+
+    // Arrays point into a caller-owned image (obivox_atlas_index_open)
+    bool borrowed;
+};
+
+// Serialized index: every array at an INDEX_ALIGN offset from the start
+// of the image, so a mapped copy is used in place
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint32_t slot_mask;
+    uint32_t name_count;
+    uint64_t keys_offset;       // OBIVoxAtlasKey[count + 1]
+    uint64_t entries_offset;    // OBIVoxAtlasEntry[count + 1]
+    uint64_t cold_offset;       // AtlasCold[count + 1]
+    uint64_t order_offset;      // uint32_t[count]
+    uint64_t slots_offset;      // uint32_t[slot_mask + 1]
+    uint64_t hashes_offset;     // uint32_t[name_count]
+    uint64_t name_offsets_offset;
+    uint64_t names_offset;
+    uint64_t names_bytes;
+    uint64_t total_bytes;
+} IndexImage;
+
+// Build-time record, sorted by key before the Eytzinger permutation
+typedef struct {
+    OBIVoxAtlasKey key;
+    OBIVoxAtlasEntry entry;
+    AtlasCold cold;
+    uint32_t rank;              // Position in tree (name) order
+} AtlasRecord;
+
+// ============================================================================
+// Name Interning
+// ============================================================================
+
+static uint32_t name_hash(const char* name) {
+    // FNV-1a over at most the stored name length
+    uint32_t h = 2166136261u;
+    for (uint32_t i = 0; i < INDEX_NAME_MAX && name[i]; i++) {
+        h = (h ^ (uint8_t)name[i]) * 16777619u;
+    }
+    return h;
+}
+
+static int64_t intern_find(const OBIVoxAtlasIndex* index, const char* name, uint32_t hash) {
+    if (!index->slots) return -1;
+    for (uint32_t slot = hash & index->slot_mask;; slot = (slot + 1) & index->slot_mask) {
+        uint32_t entry = index->slots[slot];
+        if (entry == 0) return -1;
+        uint32_t id = entry - 1;
+        if (index->name_hashes[id] == hash &&
+            strncmp(index->names + index->name_offsets[id], name, INDEX_NAME_MAX) == 0) {
+            return id;
+        }
+    }
+}
+
+static int64_t intern_add(OBIVoxAtlasIndex* index, const char* name) {
+    uint32_t hash = name_hash(name);
+    int64_t found = intern_find(index, name, hash);
+    if (found >= 0) return found;
+
+    size_t length = strnlen(name, INDEX_NAME_MAX);
+    uint32_t id = index->name_count++;
+    index->name_hashes[id] = hash;
+    index->name_offsets[id] = (uint32_t)index->names_len;
+    memcpy(index->names + index->names_len, name, length);
+    index->names[index->names_len + length] = '\0';
+    index->names_len += length + 1;
+
+    uint32_t slot = hash & index->slot_mask;
+    while (index->slots[slot] != 0) slot = (slot + 1) & index->slot_mask;
+    index->slots[slot] = id + 1;
+    return id;
+}
+
+// ============================================================================
+// Build
+// ============================================================================
+
+static void tree_collect(OBIVoxAtlasIndex* index, const NLMAtlasNode* node,
+                         AtlasRecord* records, uint32_t* n) {
+    if (!node) return;
+    tree_collect(index, node->left, records, n);
+
+    AtlasRecord* r = &records[*n];
+    r->rank = (*n)++;
+    r->cold.service_id = (uint32_t)intern_add(index, node->service);
+    r->cold.operation_id = (uint32_t)intern_add(index, node->operation);
+    r->key = ((OBIVoxAtlasKey)r->cold.service_id << 32) | r->cold.operation_id;
+    r->entry.x_coord = node->x_coord;
+    r->entry.y_coord = node->y_coord;
+    r->entry.z_coord = node->z_coord;
+    r->entry.dynamic_cost = node->dynamic_cost;
+    r->entry.confidence_score = node->confidence_score;
+
+    tree_collect(index, node->right, records, n);
+}
+
+static int record_compare(const void* a, const void* b) {
+    OBIVoxAtlasKey ka = ((const AtlasRecord*)a)->key;
+    OBIVoxAtlasKey kb = ((const AtlasRecord*)b)->key;
+    return (ka > kb) - (ka < kb);
+}
+
+// In-order walk of the implicit tree places sorted records in BFS order
+static uint32_t eytzinger_fill(OBIVoxAtlasIndex* index, const AtlasRecord* sorted,
+                               uint32_t next, uint32_t k) {
+    if (k > index->count) return next;
+    next = eytzinger_fill(index, sorted, next, 2 * k);
+    index->keys[k] = sorted[next].key;
+    index->entries[k] = sorted[next].entry;
+    index->cold[k] = sorted[next].cold;
+    index->order[sorted[next].rank] = (uint32_t)k;
+    next++;
+    return eytzinger_fill(index, sorted, next, 2 * k + 1);
+}
+
+static void* aligned_calloc(size_t count, size_t size) {
+    size_t bytes = (count * size + INDEX_ALIGN - 1) & ~(size_t)(INDEX_ALIGN - 1);
+    void* buffer = aligned_alloc(INDEX_ALIGN, bytes);
+    if (buffer) memset(buffer, 0, bytes);
+    return buffer;
+}
+
+int obivox_atlas_index_build(const NLMAtlasNode* root, OBIVoxAtlasIndex** index) {
+    if (!index) return -1;
+
+    OBIVoxAtlasIndex* idx = calloc(1, sizeof(OBIVoxAtlasIndex));
+    if (!idx) return -1;
+
+    uint32_t count = obivox_atlas_tree_count(root);
+    uint32_t max_names = count * 2;
+    uint32_t slots = 16;
+    while (slots < max_names * 2) slots *= 2;
+
+    idx->count = count;
+    idx->keys = aligned_calloc(count + 1, sizeof(OBIVoxAtlasKey));
+    idx->entries = aligned_calloc(count + 1, sizeof(OBIVoxAtlasEntry));
+    idx->cold = calloc(count + 1, sizeof(AtlasCold));
+    idx->slots = calloc(slots, sizeof(uint32_t));
+    idx->slot_mask = slots - 1;
+    idx->name_hashes = calloc(max_names + 1, sizeof(uint32_t));
+    idx->name_offsets = calloc(max_names + 1, sizeof(uint32_t));
+    idx->names = malloc((size_t)max_names * (INDEX_NAME_MAX + 1) + 1);
+    idx->order = calloc(count + 1, sizeof(uint32_t));
+
+    AtlasRecord* records = calloc(count + 1, sizeof(AtlasRecord));
+
+    if (!idx->keys || !idx->entries || !idx->cold || !idx->slots ||
+        !idx->name_hashes || !idx->name_offsets || !idx->names || !idx->order || !records) {
+        free(records);
+        obivox_atlas_index_destroy(idx);
+        return -1;
+    }
+
+    uint32_t n = 0;
+    tree_collect(idx, root, records, &n);
+    qsort(records, count, sizeof(AtlasRecord), record_compare);
+    eytzinger_fill(idx, records, 0, 1);
+    free(records);
+
+    *index = idx;
+    return 0;
+}
+
+void obivox_atlas_index_destroy(OBIVoxAtlasIndex* index) {
+    if (!index) return;
+    if (index->borrowed) {
+        free(index);
+        return;
+    }
+    free(index->keys);
+    free(index->entries);
+    free(index->cold);
+    free(index->slots);
+    free(index->name_hashes);
+    free(index->name_offsets);
+    free(index->names);
+    free(index->order);
+    free(index);
+}
+
+uint32_t obivox_atlas_index_count(const OBIVoxAtlasIndex* index) {
+    return index ? index->count : 0;
+}
+
+// ============================================================================
+// Images
+// ============================================================================
+
+static uint64_t image_align(uint64_t offset) {
+    return (offset + INDEX_ALIGN - 1) & ~(uint64_t)(INDEX_ALIGN - 1);
+}
+
+static size_t image_layout(const OBIVoxAtlasIndex* index, IndexImage* h) {
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+    h->version = IMAGE_VERSION;
+    h->count = index->count;
+    h->slot_mask = index->slot_mask;
+    h->name_count = index->name_count;
+
+    uint64_t at = image_align(sizeof(IndexImage));
+    h->keys_offset = at;
+    at = image_align(at + (uint64_t)(index->count + 1) * sizeof(OBIVoxAtlasKey));
+    h->entries_offset = at;
+    at = image_align(at + (uint64_t)(index->count + 1) * sizeof(OBIVoxAtlasEntry));
+    h->cold_offset = at;
+    at = image_align(at + (uint64_t)(index->count + 1) * sizeof(AtlasCold));
+    h->order_offset = at;
+    at = image_align(at + (uint64_t)index->count * sizeof(uint32_t));
+    h->slots_offset = at;
+    at = image_align(at + ((uint64_t)index->slot_mask + 1) * sizeof(uint32_t));
+    h->hashes_offset = at;
+    at = image_align(at + (uint64_t)index->name_count * sizeof(uint32_t));
+    h->name_offsets_offset = at;
+    at = image_align(at + (uint64_t)index->name_count * sizeof(uint32_t));
+    h->names_offset = at;
+    h->names_bytes = index->names_len;
+    h->total_bytes = image_align(at + index->names_len);
+    return (size_t)h->total_bytes;
+}
+
+int obivox_atlas_index_serialize(
+    const OBIVoxAtlasIndex* index,
+    void* buffer,
+    size_t capacity,
+    size_t* bytes) {
+
+    if (!index || !bytes) return -1;
+
+    IndexImage h;
+    size_t total = image_layout(index, &h);
+    *bytes = total;
+    if (!buffer) return 0;
+    if (capacity < total) return -1;
+
+    uint8_t* out = buffer;
+    memset(out, 0, total);
+    memcpy(out, &h, sizeof(h));
+    memcpy(out + h.keys_offset, index->keys, (index->count + 1) * sizeof(OBIVoxAtlasKey));
+    memcpy(out + h.entries_offset, index->entries, (index->count + 1) * sizeof(OBIVoxAtlasEntry));
+    memcpy(out + h.cold_offset, index->cold, (index->count + 1) * sizeof(AtlasCold));
+    memcpy(out + h.order_offset, index->order, index->count * sizeof(uint32_t));
+    memcpy(out + h.slots_offset, index->slots, ((size_t)index->slot_mask + 1) * sizeof(uint32_t));
+    memcpy(out + h.hashes_offset, index->name_hashes, index->name_count * sizeof(uint32_t));
+    memcpy(out + h.name_offsets_offset, index->name_offsets, index->name_count * sizeof(uint32_t));
+    memcpy(out + h.names_offset, index->names, index->names_len);
+    return 0;
+}
+
+// Structural checks only, O(count + names): enough that no lookup on a
+// damaged image reads outside it or probes forever
+static bool image_valid(const IndexImage* h, const uint8_t* base, size_t bytes) {
+    if (bytes < sizeof(IndexImage) || (uintptr_t)base % sizeof(uint64_t) != 0) return false;
+    if (memcmp(h->magic, IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) != 0) return false;
+    if (h->version != IMAGE_VERSION || h->total_bytes != bytes) return false;
+    if (h->slot_mask == 0 || (h->slot_mask & (h->slot_mask + 1)) != 0) return false;
+    if (h->name_count > h->slot_mask || h->count > UINT32_MAX / 2) return false;
+
+    const OBIVoxAtlasIndex shape = {
+        .count = h->count, .slot_mask = h->slot_mask, .name_count = h->name_count,
+        .names_len = (size_t)h->names_bytes
+    };
+    IndexImage expected;
+    if (h->names_bytes > bytes || image_layout(&shape, &expected) != bytes) return false;
+    if (memcmp(&expected, h, sizeof(expected)) != 0) return false;
+
+    const char* names = (const char*)(base + h->names_offset);
+    if (h->names_bytes > 0 && names[h->names_bytes - 1] != '\0') return false;
+    if (h->name_count > 0 && h->names_bytes == 0) return false;
+
+    const uint32_t* offsets = (const uint32_t*)(base + h->name_offsets_offset);
+    for (uint32_t i = 0; i < h->name_count; i++) {
+        if (offsets[i] >= h->names_bytes) return false;
+    }
+    const uint32_t* slots = (const uint32_t*)(base + h->slots_offset);
+    for (uint32_t i = 0; i <= h->slot_mask; i++) {
+        if (slots[i] > h->name_count) return false;
+    }
+    const AtlasCold* cold = (const AtlasCold*)(base + h->cold_offset);
+    for (uint32_t k = 1; k <= h->count; k++) {
+        if (cold[k].service_id >= h->name_count || cold[k].operation_id >= h->name_count) return false;
+    }
+    const uint32_t* order = (const uint32_t*)(base + h->order_offset);
+    for (uint32_t i = 0; i < h->count; i++) {
+        if (order[i] == 0 || order[i] > h->count) return false;
+    }
+    return true;
+}
+
+int obivox_atlas_index_open(const void* image, size_t bytes, OBIVoxAtlasIndex** index) {
+    if (!image || !index) return -1;
+
+    const uint8_t* base = image;
+    const IndexImage* h = image;
+    if (!image_valid(h, base, bytes)) return -1;
+
+    OBIVoxAtlasIndex* idx = calloc(1, sizeof(OBIVoxAtlasIndex));
+    if (!idx) return -1;
+
+    // Never written through: lookups only read, and destroy skips the arrays
+    uint8_t* b = (uint8_t*)base;
+    idx->count = h->count;
+    idx->keys = (OBIVoxAtlasKey*)(b + h->keys_offset);
+    idx->entries = (OBIVoxAtlasEntry*)(b + h->entries_offset);
+    idx->cold = (AtlasCold*)(b + h->cold_offset);
+    idx->order = (uint32_t*)(b + h->order_offset);
+    idx->slots = (uint32_t*)(b + h->slots_offset);
+    idx->slot_mask = h->slot_mask;
+    idx->name_hashes = (uint32_t*)(b + h->hashes_offset);
+    idx->name_offsets = (uint32_t*)(b + h->name_offsets_offset);
+    idx->name_count = h->name_count;
+    idx->names = (char*)(b + h->names_offset);
+    idx->names_len = (size_t)h->names_bytes;
+    idx->borrowed = true;
+
+    *index = idx;
+    return 0;
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+int obivox_atlas_index_key(
+    const OBIVoxAtlasIndex* index,
+    const char* service,
+    const char* operation,
+    OBIVoxAtlasKey* key) {
+
+    if (!index || !service || !operation || !key) return -1;
+
+    int64_t service_id = intern_find(index, service, name_hash(service));
+    if (service_id < 0) return -1;
+    int64_t operation_id = intern_find(index, operation, name_hash(operation));
+    if (operation_id < 0) return -1;
+
+    *key = ((OBIVoxAtlasKey)service_id << 32) | (uint32_t)operation_id;
+    return 0;
+}
+
+const OBIVoxAtlasEntry* obivox_atlas_index_find(
+    const OBIVoxAtlasIndex* index,
+    OBIVoxAtlasKey key) {
+
+    if (!index || index->count == 0) return NULL;
+
+    // Branch-free descent; the prefetch covers the line three levels down
+    const OBIVoxAtlasKey* keys = index->keys;
+    uint32_t n = index->count;
+    uint64_t k = 1;
+    while (k <= n) {
+        __builtin_prefetch(keys + 8 * k);
+        k = 2 * k + (keys[k] < key);
+    }
+
+    // Undo the trailing right turns to land on the lower bound
+    k >>= __builtin_ffsll((long long)~k);
+    if (k == 0 || keys[k] != key) return NULL;
+    return &index->entries[k];
+}
+
+const OBIVoxAtlasEntry* obivox_atlas_index_lookup(
+    const OBIVoxAtlasIndex* index,
+    const char* service,
+    const char* operation) {
+
+    OBIVoxAtlasKey key;
+    if (obivox_atlas_index_key(index, service, operation, &key) != 0) return NULL;
+    return obivox_atlas_index_find(index, key);
+}
+
+const OBIVoxAtlasEntry* obivox_atlas_index_entry(
+    const OBIVoxAtlasIndex* index,
+    uint32_t position) {
+
+    if (!index || position >= index->count) return NULL;
+    return &index->entries[index->order[position]];
+}
+
+const char* obivox_atlas_index_service(
+    const OBIVoxAtlasIndex* index,
+    const OBIVoxAtlasEntry* entry) {
+
+    if (!index || !entry) return NULL;
+    const AtlasCold* cold = &index->cold[entry - index->entries];
+    return index->names + index->name_offsets[cold->service_id];
+}
+
+const char* obivox_atlas_index_operation(
+    const OBIVoxAtlasIndex* index,
+    const OBIVoxAtlasEntry* entry) {
+
+    if (!index || !entry) return NULL;
+    const AtlasCold* cold = &index->cold[entry - index->entries];
+    return index->names + index->name_offsets[cold->operation_id];
+}
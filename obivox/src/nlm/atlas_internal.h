@@ -0,0 +1,88 @@
+/**
+ * atlas_internal.h
+ * Pointer-tree primitives shared by the Atlas container and index builder
+ */
+
+#ifndef OBIVOX_ATLAS_INTERNAL_H
+#define OBIVOX_ATLAS_INTERNAL_H
+
+#include "obivox/nlm_atlas.h"
+
+// Deepest path the copy-on-write update handles: RB height <= 2 log2(n + 1)
+#define OBIVOX_ATLAS_MAX_DEPTH  96
+
+// Originals one copy-on-write update may replace: its path plus uncles
+#define OBIVOX_ATLAS_MAX_RETIRED  (OBIVOX_ATLAS_MAX_DEPTH * 2)
+
+/**
+ * obivox_atlas_insert with the balancing named explicitly (TREE_MODE_AVL
+ * or TREE_MODE_RB) and the number of rotations it performed
+ */
+int obivox_atlas_tree_insert(
+    NLMAtlasNode** root,
+    TreeMode balancing,
+    const char* service,
+    const char* operation,
+    NLMAtlasNode** node,
+    uint32_t* rotations
+);
+
+/**
+ * Persistent insert-or-update: copies the search path (and any RB uncle it
+ * recolours), applies update to the copied or created node's payload and
+ * rebalances the copies only. Published nodes are never written, so
+ * readers may walk root concurrently. Parent links are not maintained.
+ * The replaced originals are returned in retired (OBIVOX_ATLAS_MAX_RETIRED)
+ * Returns 1 when created, 0 when updated, -1 on error (nothing changed)
+ */
+int obivox_atlas_tree_update_cow(
+    NLMAtlasNode* root,
+    TreeMode balancing,
+    const char* service,
+    const char* operation,
+    OBIVoxAtlasUpdateFn update,
+    void* context,
+    NLMAtlasNode** new_root,
+    NLMAtlasNode** retired,
+    uint32_t* retired_count,
+    uint32_t* rotations
+);
+
+/**
+ * Find reporting the number of nodes visited
+ */
+NLMAtlasNode* obivox_atlas_tree_find_depth(
+    NLMAtlasNode* root,
+    const char* service,
+    const char* operation,
+    uint32_t* depth
+);
+
+/**
+ * Copy the tree into freshly allocated nodes, perfectly balanced and
+ * valid for both AVL heights and RB colours, tagged with balancing.
+ * The source tree is only read
+ */
+int obivox_atlas_tree_rebuild(
+    const NLMAtlasNode* root,
+    TreeMode balancing,
+    NLMAtlasNode** rebuilt,
+    uint32_t* count
+);
+
+/**
+ * Fresh nodes for every entry of a flat index, built balanced as by
+ * obivox_atlas_tree_rebuild straight from the index's tree order
+ */
+int obivox_atlas_tree_build_index(
+    const OBIVoxAtlasIndex* index,
+    TreeMode balancing,
+    NLMAtlasNode** built,
+    uint32_t* count
+);
+
+uint32_t obivox_atlas_tree_count(const NLMAtlasNode* root);
+
+uint32_t obivox_atlas_tree_height(const NLMAtlasNode* root);
+
+#endif // OBIVOX_ATLAS_INTERNAL_H
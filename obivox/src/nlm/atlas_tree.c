@@ -0,0 +1,625 @@
+/**
+ * atlas_tree.c
+ * NLM-Atlas pointer tree: NLMAtlasNode ordered by (service, operation)
+ * with AVL (height) or red-black (color) balancing
+ */
+
+#include "nlm/atlas_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ATLAS_NAME_MAX  63
+
+// ============================================================================
+// Ordering
+// ============================================================================
+
+static int atlas_compare(const char* service, const char* operation, const NLMAtlasNode* node) {
+    int c = strncmp(service, node->service, ATLAS_NAME_MAX);
+    if (c != 0) return c;
+    return strncmp(operation, node->operation, ATLAS_NAME_MAX);
+}
+
+// ============================================================================
+// Rotations
+// ============================================================================
+
+static inline int node_height(const NLMAtlasNode* node) {
+    return node ? node->height : 0;
+}
+
+static inline void update_height(NLMAtlasNode* node) {
+    int l = node_height(node->left);
+    int r = node_height(node->right);
+    node->height = 1 + (l > r ? l : r);
+}
+
+static void replace_child(NLMAtlasNode** root, NLMAtlasNode* parent,
+                          NLMAtlasNode* old_child, NLMAtlasNode* new_child) {
+    if (!parent) {
+        *root = new_child;
+    } else if (parent->left == old_child) {
+        parent->left = new_child;
+    } else {
+        parent->right = new_child;
+    }
+    if (new_child) new_child->parent = parent;
+}
+
+static NLMAtlasNode* rotate_left(NLMAtlasNode** root, NLMAtlasNode* x) {
+    NLMAtlasNode* y = x->right;
+    x->right = y->left;
+    if (y->left) y->left->parent = x;
+    replace_child(root, x->parent, x, y);
+    y->left = x;
+    x->parent = y;
+    return y;
+}
+
+static NLMAtlasNode* rotate_right(NLMAtlasNode** root, NLMAtlasNode* x) {
+    NLMAtlasNode* y = x->left;
+    x->left = y->right;
+    if (y->right) y->right->parent = x;
+    replace_child(root, x->parent, x, y);
+    y->right = x;
+    x->parent = y;
+    return y;
+}
+
+// ============================================================================
+// AVL Balancing (strict - read-heavy TTS)
+// ============================================================================
+
+static uint32_t avl_rebalance(NLMAtlasNode** root, NLMAtlasNode* node) {
+    uint32_t rotations = 0;
+    while (node) {
+        update_height(node);
+        int balance = node_height(node->left) - node_height(node->right);
+
+        if (balance > 1) {
+            if (node_height(node->left->left) < node_height(node->left->right)) {
+                NLMAtlasNode* left = rotate_left(root, node->left);
+                update_height(left->left);
+                update_height(left);
+                rotations++;
+            }
+            node = rotate_right(root, node);
+            rotations++;
+            update_height(node->right);
+            update_height(node);
+        } else if (balance < -1) {
+            if (node_height(node->right->right) < node_height(node->right->left)) {
+                NLMAtlasNode* right = rotate_right(root, node->right);
+                update_height(right->right);
+                update_height(right);
+                rotations++;
+            }
+            node = rotate_left(root, node);
+            rotations++;
+            update_height(node->left);
+            update_height(node);
+        }
+        node = node->parent;
+    }
+    return rotations;
+}
+
+// ============================================================================
+// Red-Black Balancing (relaxed - write-heavy STT)
+// ============================================================================
+
+static uint32_t rb_insert_fixup(NLMAtlasNode** root, NLMAtlasNode* node) {
+    uint32_t rotations = 0;
+    while (node->parent && node->parent->color == RED) {
+        NLMAtlasNode* parent = node->parent;
+        NLMAtlasNode* grand = parent->parent;
+
+        if (parent == grand->left) {
+            NLMAtlasNode* uncle = grand->right;
+            if (uncle && uncle->color == RED) {
+                parent->color = BLACK;
+                uncle->color = BLACK;
+                grand->color = RED;
+                node = grand;
+                continue;
+            }
+            if (node == parent->right) {
+                node = parent;
+                rotate_left(root, node);
+                parent = node->parent;
+                rotations++;
+            }
+            parent->color = BLACK;
+            grand->color = RED;
+            rotate_right(root, grand);
+            rotations++;
+        } else {
+            NLMAtlasNode* uncle = grand->left;
+            if (uncle && uncle->color == RED) {
+                parent->color = BLACK;
+                uncle->color = BLACK;
+                grand->color = RED;
+                node = grand;
+                continue;
+            }
+            if (node == parent->left) {
+                node = parent;
+                rotate_right(root, node);
+                parent = node->parent;
+                rotations++;
+            }
+            parent->color = BLACK;
+            grand->color = RED;
+            rotate_left(root, grand);
+            rotations++;
+        }
+    }
+    (*root)->color = BLACK;
+    return rotations;
+}
+
+// ============================================================================
+// Tree API
+// ============================================================================
+
+int obivox_atlas_insert(
+    NLMAtlasNode** root,
+    TreeMode mode,
+    const char* service,
+    const char* operation,
+    NLMAtlasNode** node) {
+
+    // A bare tree has no workload history; HYBRID starts out strict
+    TreeMode balancing = (mode == TREE_MODE_RB) ? TREE_MODE_RB : TREE_MODE_AVL;
+    return obivox_atlas_tree_insert(root, balancing, service, operation, node, NULL);
+}
+
+int obivox_atlas_tree_insert(
+    NLMAtlasNode** root,
+    TreeMode balancing,
+    const char* service,
+    const char* operation,
+    NLMAtlasNode** node,
+    uint32_t* rotations) {
+
+    if (rotations) *rotations = 0;
+    if (!root || !service || !operation) return -1;
+
+    NLMAtlasNode* parent = NULL;
+    NLMAtlasNode* cursor = *root;
+    int c = 0;
+    while (cursor) {
+        c = atlas_compare(service, operation, cursor);
+        if (c == 0) {
+            if (node) *node = cursor;
+            return 0;
+        }
+        parent = cursor;
+        cursor = c < 0 ? cursor->left : cursor->right;
+    }
+
+    NLMAtlasNode* created = calloc(1, sizeof(NLMAtlasNode));
+    if (!created) return -1;
+
+    strncpy(created->service, service, ATLAS_NAME_MAX);
+    strncpy(created->operation, operation, ATLAS_NAME_MAX);
+    created->mode = balancing;
+    created->height = 1;
+    created->color = RED;
+    created->confidence_score = 0.954f;
+    created->parent = parent;
+
+    if (!parent) {
+        *root = created;
+    } else if (c < 0) {
+        parent->left = created;
+    } else {
+        parent->right = created;
+    }
+
+    uint32_t performed = (balancing == TREE_MODE_RB)
+        ? rb_insert_fixup(root, created)
+        : avl_rebalance(root, parent);
+    if (rotations) *rotations = performed;
+
+    if (node) *node = created;
+    return 1;
+}
+
+NLMAtlasNode* obivox_atlas_find(
+    NLMAtlasNode* root,
+    const char* service,
+    const char* operation) {
+
+    uint32_t depth;
+    return obivox_atlas_tree_find_depth(root, service, operation, &depth);
+}
+
+NLMAtlasNode* obivox_atlas_tree_find_depth(
+    NLMAtlasNode* root,
+    const char* service,
+    const char* operation,
+    uint32_t* depth) {
+
+    *depth = 0;
+    if (!service || !operation) return NULL;
+
+    while (root) {
+        (*depth)++;
+        int c = atlas_compare(service, operation, root);
+        if (c == 0) return root;
+        root = c < 0 ? root->left : root->right;
+    }
+    return NULL;
+}
+
+void obivox_atlas_free(NLMAtlasNode* root) {
+    if (!root) return;
+    obivox_atlas_free(root->left);
+    obivox_atlas_free(root->right);
+    free(root);
+}
+
+// ============================================================================
+// Migration Rebuild
+// ============================================================================
+
+uint32_t obivox_atlas_tree_count(const NLMAtlasNode* root) {
+    return root ? 1 + obivox_atlas_tree_count(root->left) + obivox_atlas_tree_count(root->right) : 0;
+}
+
+uint32_t obivox_atlas_tree_height(const NLMAtlasNode* root) {
+    if (!root) return 0;
+    uint32_t l = obivox_atlas_tree_height(root->left);
+    uint32_t r = obivox_atlas_tree_height(root->right);
+    return 1 + (l > r ? l : r);
+}
+
+// Field-wise copy: lookups may be counting on the source concurrently
+static void node_copy_into(NLMAtlasNode* copy, const NLMAtlasNode* node) {
+    memcpy(copy->service, node->service, sizeof(copy->service));
+    memcpy(copy->operation, node->operation, sizeof(copy->operation));
+    copy->x_coord = node->x_coord;
+    copy->y_coord = node->y_coord;
+    copy->z_coord = node->z_coord;
+    copy->mode = node->mode;
+    copy->height = node->height;
+    copy->color = node->color;
+    copy->dynamic_cost = node->dynamic_cost;
+    copy->confidence_score = node->confidence_score;
+    copy->access_frequency = __atomic_load_n(&node->access_frequency, __ATOMIC_RELAXED);
+    copy->left = node->left;
+    copy->right = node->right;
+    copy->parent = NULL;
+}
+
+static void collect_in_order(const NLMAtlasNode* node, NLMAtlasNode** copies, uint32_t* n) {
+    if (!node) return;
+    collect_in_order(node->left, copies, n);
+    node_copy_into(copies[(*n)++], node);
+    collect_in_order(node->right, copies, n);
+}
+
+// Midpoint splits leave every NULL link at depth D or D + 1; colouring
+// the deepest level red (when it is not full) equalises black heights
+static NLMAtlasNode* build_balanced(NLMAtlasNode** nodes, int64_t lo, int64_t hi,
+                                    NLMAtlasNode* parent, int depth, int red_depth,
+                                    TreeMode balancing) {
+    if (lo > hi) return NULL;
+    int64_t mid = lo + (hi - lo) / 2;
+    NLMAtlasNode* node = nodes[mid];
+    node->parent = parent;
+    node->mode = balancing;
+    node->left = build_balanced(nodes, lo, mid - 1, node, depth + 1, red_depth, balancing);
+    node->right = build_balanced(nodes, mid + 1, hi, node, depth + 1, red_depth, balancing);
+    update_height(node);
+    node->color = (depth == red_depth) ? RED : BLACK;
+    return node;
+}
+
+int obivox_atlas_tree_rebuild(
+    const NLMAtlasNode* root,
+    TreeMode balancing,
+    NLMAtlasNode** rebuilt,
+    uint32_t* count) {
+
+    if (!rebuilt) return -1;
+
+    uint32_t n = obivox_atlas_tree_count(root);
+    *rebuilt = NULL;
+    if (count) *count = n;
+    if (n == 0) return 0;
+
+    NLMAtlasNode** nodes = malloc(n * sizeof(NLMAtlasNode*));
+    if (!nodes) return -1;
+    for (uint32_t i = 0; i < n; i++) {
+        nodes[i] = malloc(sizeof(NLMAtlasNode));
+        if (!nodes[i]) {
+            while (i > 0) free(nodes[--i]);
+            free(nodes);
+            return -1;
+        }
+    }
+
+    uint32_t filled = 0;
+    collect_in_order(root, nodes, &filled);
+
+    int deepest = 0;
+    while (((uint64_t)2 << deepest) - 1 < n) deepest++;
+    bool perfect = (((uint64_t)2 << deepest) - 1) == n;
+
+    *rebuilt = build_balanced(nodes, 0, (int64_t)n - 1, NULL, 0,
+                              perfect ? -1 : deepest, balancing);
+    free(nodes);
+    return 0;
+}
+
+int obivox_atlas_tree_build_index(
+    const OBIVoxAtlasIndex* index,
+    TreeMode balancing,
+    NLMAtlasNode** built,
+    uint32_t* count) {
+
+    if (!built) return -1;
+
+    uint32_t n = obivox_atlas_index_count(index);
+    *built = NULL;
+    if (count) *count = n;
+    if (n == 0) return 0;
+
+    NLMAtlasNode** nodes = malloc(n * sizeof(NLMAtlasNode*));
+    if (!nodes) return -1;
+
+    // Positions are already in tree order, so no sort and no rotations
+    for (uint32_t i = 0; i < n; i++) {
+        nodes[i] = calloc(1, sizeof(NLMAtlasNode));
+        if (!nodes[i]) {
+            while (i > 0) free(nodes[--i]);
+            free(nodes);
+            return -1;
+        }
+        const OBIVoxAtlasEntry* entry = obivox_atlas_index_entry(index, i);
+        NLMAtlasNode* node = nodes[i];
+        strncpy(node->service, obivox_atlas_index_service(index, entry), ATLAS_NAME_MAX);
+        strncpy(node->operation, obivox_atlas_index_operation(index, entry), ATLAS_NAME_MAX);
+        node->x_coord = entry->x_coord;
+        node->y_coord = entry->y_coord;
+        node->z_coord = entry->z_coord;
+        node->dynamic_cost = entry->dynamic_cost;
+        node->confidence_score = entry->confidence_score;
+    }
+
+    int deepest = 0;
+    while (((uint64_t)2 << deepest) - 1 < n) deepest++;
+    bool perfect = (((uint64_t)2 << deepest) - 1) == n;
+
+    *built = build_balanced(nodes, 0, (int64_t)n - 1, NULL, 0,
+                            perfect ? -1 : deepest, balancing);
+    free(nodes);
+    return 0;
+}
+
+// ============================================================================
+// Copy-on-Write Update (shared Atlas)
+// ============================================================================
+
+// Rotations on private copies; parent links are not kept
+static NLMAtlasNode* cow_rotate_left(NLMAtlasNode* x) {
+    NLMAtlasNode* y = x->right;
+    x->right = y->left;
+    y->left = x;
+    return y;
+}
+
+static NLMAtlasNode* cow_rotate_right(NLMAtlasNode* x) {
+    NLMAtlasNode* y = x->left;
+    x->left = y->right;
+    y->right = x;
+    return y;
+}
+
+static void cow_relink(NLMAtlasNode** path, int64_t i, NLMAtlasNode** root,
+                       NLMAtlasNode* old_child, NLMAtlasNode* new_child) {
+    if (i < 0) {
+        *root = new_child;
+    } else if (path[i]->left == old_child) {
+        path[i]->left = new_child;
+    } else {
+        path[i]->right = new_child;
+    }
+}
+
+// Only the inserted side grew, so every rotated node is a fresh copy
+static uint32_t cow_avl_rebalance(NLMAtlasNode** path, int64_t top, NLMAtlasNode** root) {
+    uint32_t rotations = 0;
+    for (int64_t i = top; i >= 0; i--) {
+        NLMAtlasNode* node = path[i];
+        update_height(node);
+        int balance = node_height(node->left) - node_height(node->right);
+        NLMAtlasNode* replaced = node;
+
+        if (balance > 1) {
+            if (node_height(node->left->left) < node_height(node->left->right)) {
+                node->left = cow_rotate_left(node->left);
+                update_height(node->left->left);
+                update_height(node->left);
+                rotations++;
+            }
+            replaced = cow_rotate_right(node);
+            update_height(replaced->right);
+            update_height(replaced);
+            rotations++;
+        } else if (balance < -1) {
+            if (node_height(node->right->right) < node_height(node->right->left)) {
+                node->right = cow_rotate_right(node->right);
+                update_height(node->right->right);
+                update_height(node->right);
+                rotations++;
+            }
+            replaced = cow_rotate_left(node);
+            update_height(replaced->left);
+            update_height(replaced);
+            rotations++;
+        }
+
+        if (replaced != node) cow_relink(path, i - 1, root, node, replaced);
+    }
+    return rotations;
+}
+
+// path[0..z] are copies, path[z] the new red node. Recolouring an uncle
+// writes it, so uncles are copied from spares and their originals retired
+static uint32_t cow_rb_fixup(NLMAtlasNode** path, int64_t z, NLMAtlasNode** root,
+                             NLMAtlasNode** spares, uint32_t* spare_used,
+                             NLMAtlasNode** retired, uint32_t* retired_count) {
+    uint32_t rotations = 0;
+    while (z >= 2 && path[z - 1]->color == RED) {
+        NLMAtlasNode* node = path[z];
+        NLMAtlasNode* parent = path[z - 1];
+        NLMAtlasNode* grand = path[z - 2];
+        bool parent_left = (grand->left == parent);
+        NLMAtlasNode* uncle = parent_left ? grand->right : grand->left;
+
+        if (uncle && uncle->color == RED) {
+            NLMAtlasNode* copy = spares[(*spare_used)++];
+            node_copy_into(copy, uncle);
+            retired[(*retired_count)++] = uncle;
+            if (parent_left) grand->right = copy; else grand->left = copy;
+            parent->color = BLACK;
+            copy->color = BLACK;
+            grand->color = RED;
+            z -= 2;
+            continue;
+        }
+
+        NLMAtlasNode* top;
+        if (parent_left) {
+            if (node == parent->right) {
+                grand->left = cow_rotate_left(parent);
+                parent = node;
+                rotations++;
+            }
+            parent->color = BLACK;
+            grand->color = RED;
+            top = cow_rotate_right(grand);
+        } else {
+            if (node == parent->left) {
+                grand->right = cow_rotate_right(parent);
+                parent = node;
+                rotations++;
+            }
+            parent->color = BLACK;
+            grand->color = RED;
+            top = cow_rotate_left(grand);
+        }
+        rotations++;
+        cow_relink(path, z - 3, root, grand, top);
+        break;
+    }
+    (*root)->color = BLACK;
+    return rotations;
+}
+
+int obivox_atlas_tree_update_cow(
+    NLMAtlasNode* root,
+    TreeMode balancing,
+    const char* service,
+    const char* operation,
+    OBIVoxAtlasUpdateFn update,
+    void* context,
+    NLMAtlasNode** new_root,
+    NLMAtlasNode** retired,
+    uint32_t* retired_count,
+    uint32_t* rotations) {
+
+    *retired_count = 0;
+    *rotations = 0;
+    if (!service || !operation || !new_root) return -1;
+
+    NLMAtlasNode* originals[OBIVOX_ATLAS_MAX_DEPTH];
+    uint32_t depth = 0;
+    bool found = false;
+    for (NLMAtlasNode* cursor = root; cursor;) {
+        if (depth == OBIVOX_ATLAS_MAX_DEPTH) return -1;
+        int c = atlas_compare(service, operation, cursor);
+        originals[depth++] = cursor;
+        if (c == 0) {
+            found = true;
+            break;
+        }
+        cursor = c < 0 ? cursor->left : cursor->right;
+    }
+
+    // Allocate everything up front so failure leaves the tree untouched
+    uint32_t spare_count = (!found && balancing == TREE_MODE_RB) ? depth / 2 + 1 : 0;
+    uint32_t fresh = depth + (found ? 0 : 1) + spare_count;
+    NLMAtlasNode* nodes[OBIVOX_ATLAS_MAX_DEPTH * 2 + 2];
+    for (uint32_t i = 0; i < fresh; i++) {
+        nodes[i] = calloc(1, sizeof(NLMAtlasNode));
+        if (!nodes[i]) {
+            while (i > 0) free(nodes[--i]);
+            return -1;
+        }
+    }
+
+    NLMAtlasNode** path = nodes;
+    for (uint32_t i = 0; i < depth; i++) {
+        node_copy_into(path[i], originals[i]);
+        retired[(*retired_count)++] = originals[i];
+        if (i > 0) {
+            if (path[i - 1]->left == originals[i]) {
+                path[i - 1]->left = path[i];
+            } else {
+                path[i - 1]->right = path[i];
+            }
+        }
+    }
+
+    NLMAtlasNode* target;
+    if (found) {
+        target = path[depth - 1];
+    } else {
+        target = path[depth];
+        strncpy(target->service, service, ATLAS_NAME_MAX);
+        strncpy(target->operation, operation, ATLAS_NAME_MAX);
+        target->mode = balancing;
+        target->height = 1;
+        target->color = RED;
+        target->confidence_score = 0.954f;
+        if (depth > 0) {
+            if (atlas_compare(service, operation, path[depth - 1]) < 0) {
+                path[depth - 1]->left = target;
+            } else {
+                path[depth - 1]->right = target;
+            }
+        }
+    }
+
+    if (update) {
+        OBIVoxAtlasEntry entry = {
+            target->x_coord, target->y_coord, target->z_coord,
+            target->dynamic_cost, target->confidence_score
+        };
+        update(&entry, context);
+        target->x_coord = entry.x_coord;
+        target->y_coord = entry.y_coord;
+        target->z_coord = entry.z_coord;
+        target->dynamic_cost = entry.dynamic_cost;
+        target->confidence_score = entry.confidence_score;
+    }
+
+    NLMAtlasNode* top = path[0];
+    if (!found) {
+        if (balancing == TREE_MODE_RB) {
+            uint32_t spare_used = 0;
+            *rotations = cow_rb_fixup(path, depth, &top, nodes + depth + 1, &spare_used,
+                                      retired, retired_count);
+            while (spare_used < spare_count) free(nodes[depth + 1 + spare_used++]);
+        } else {
+            *rotations = cow_avl_rebalance(path, (int64_t)depth - 1, &top);
+        }
+    }
+
+    *new_root = top;
+    return found ? 0 : 1;
+}
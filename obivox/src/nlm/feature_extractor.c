@@ -0,0 +1,654 @@
+/**
+ * feature_extractor.c
+ * Stage-3 NLM feature extraction: one Hamming-windowed FFT per hop feeds
+ * energy and MFCC, an FFT-based YIN difference function feeds pitch.
+ * Frame blocks of both kinds run concurrently on the worker pool: the
+ * caller and pool helpers claim blocks from one counter, so the caller
+ * only ever waits on blocks already running
+ */
+
+#include "obivox/nlm_features.h"
+#include "dsp/obivox_fft.h"
+#include "dsp/obivox_kernels.h"
+#include "core/nlm_internal.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Mean power below this (about -60 dBFS) is silence, never voiced
+#define SILENCE_POWER      1e-6
+
+// Blocks per worker and feature kind; pitch blocks cost several times
+// more than spectral ones, so spare blocks let stealing even them out
+#define BLOCKS_PER_WORKER  2
+
+// Delta regression half-width (frames)
+#define DELTA_WIDTH        2
+
+typedef enum {
+    TASK_SPECTRAL,
+    TASK_PITCH
+} FeatureTaskKind;
+
+typedef struct {
+    struct obivox_feature_extractor* extractor;
+    FeatureTaskKind kind;
+    uint32_t first;
+    uint32_t last;
+
+    // Scratch sized for the task kind
+    float* frame;
+    float* padded;
+    float* re;
+    float* im;
+    float* re_b;
+    float* im_b;
+    float* work;          // Power spectrum or cross-correlation
+    float* curve;         // Log mel energies or YIN d'(tau)
+    double* prefix;
+} FeatureTask;
+
+struct obivox_feature_extractor {
+    OBIVoxFeatureConfig config;
+    OBIVoxWorkerPool* pool;
+
+    uint32_t hop;
+    uint32_t min_lag;
+    uint32_t max_lag;
+
+    OBIVoxFFTPlan* spectral_plan;
+    OBIVoxFFTPlan* pitch_plan;
+
+    // Shared by every spectral task
+    float* window;
+    float window_power;
+    uint32_t* mel_start;
+    uint32_t* mel_len;
+    uint32_t* mel_offset;
+    float* mel_weights;
+    float* dct;
+
+    FeatureTask* tasks;
+    uint32_t num_tasks;
+
+    // Current extraction
+    const float* audio;
+    uint32_t num_samples;
+    uint32_t frames;
+    uint32_t frame_capacity;
+    float* mfcc;
+    float* mfcc_delta;
+    float* pitch;
+    float* energy;
+    float* contour;              // Held, normalised pitch for AudioFeatures
+    float mfcc_mean[OBIVOX_MFCC_COEFFS];
+
+    // Blocks of the current extraction; claims packs their count (high
+    // half) and the next unclaimed index (low half)
+    FeatureTask** active;
+    _Atomic uint64_t claims;
+
+    // Completion of this extractor's blocks only, not the whole pool;
+    // helpers counts pool tasks queued or running, which destroy waits out
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+    uint32_t remaining;
+    uint32_t helpers;
+    uint32_t max_helpers;
+};
+
+void obivox_feature_config_default(OBIVoxFeatureConfig* config) {
+    if (!config) return;
+    config->sample_rate = 16000;
+    config->hop_ms = 10.0f;
+    config->frame_size = 512;
+    config->mel_filters = 26;
+    config->pitch_frame_size = 2048;
+    config->pitch_min_hz = 60.0f;
+    config->pitch_max_hz = 500.0f;
+    config->yin_threshold = 0.1f;
+}
+
+// ============================================================================
+// Shared Tables
+// ============================================================================
+
+static float hz_to_mel(float hz) {
+    return 2595.0f * log10f(1.0f + hz / 700.0f);
+}
+
+static float mel_to_hz(float mel) {
+    return 700.0f * (powf(10.0f, mel / 2595.0f) - 1.0f);
+}
+
+static int build_tables(struct obivox_feature_extractor* e) {
+    const OBIVoxFeatureConfig* c = &e->config;
+    uint32_t n = c->frame_size;
+    uint32_t bins = n / 2 + 1;
+    uint32_t filters = c->mel_filters;
+
+    e->window = malloc(n * sizeof(float));
+    e->mel_start = calloc(filters, sizeof(uint32_t));
+    e->mel_len = calloc(filters, sizeof(uint32_t));
+    e->mel_offset = calloc(filters, sizeof(uint32_t));
+    e->mel_weights = calloc((size_t)filters * bins, sizeof(float));
+    e->dct = malloc((size_t)OBIVOX_MFCC_COEFFS * filters * sizeof(float));
+    if (!e->window || !e->mel_start || !e->mel_len || !e->mel_offset ||
+        !e->mel_weights || !e->dct) {
+        return -1;
+    }
+
+    // Hamming, and its power for window-independent RMS
+    e->window_power = 0.0f;
+    for (uint32_t i = 0; i < n; i++) {
+        e->window[i] = 0.54f - 0.46f * cosf(2.0f * (float)M_PI * i / (n - 1));
+        e->window_power += e->window[i] * e->window[i];
+    }
+
+    // Triangular mel filters, stored as (first bin, length, weights)
+    float mel_high = hz_to_mel(c->sample_rate / 2.0f);
+    float bin_hz = (float)c->sample_rate / n;
+    uint32_t offset = 0;
+    for (uint32_t m = 0; m < filters; m++) {
+        float lo = mel_to_hz(mel_high * m / (filters + 1));
+        float center = mel_to_hz(mel_high * (m + 1) / (filters + 1));
+        float hi = mel_to_hz(mel_high * (m + 2) / (filters + 1));
+
+        e->mel_offset[m] = offset;
+        bool started = false;
+        for (uint32_t b = 0; b < bins; b++) {
+            float f = b * bin_hz;
+            float w = 0.0f;
+            if (f > lo && f < center) w = (f - lo) / (center - lo);
+            else if (f >= center && f < hi) w = (hi - f) / (hi - center);
+            if (w <= 0.0f) {
+                if (started) break;
+                continue;
+            }
+            if (!started) {
+                e->mel_start[m] = b;
+                started = true;
+            }
+            e->mel_weights[offset + e->mel_len[m]++] = w;
+        }
+        offset += e->mel_len[m];
+    }
+
+    // Orthonormal DCT-II rows
+    for (uint32_t k = 0; k < OBIVOX_MFCC_COEFFS; k++) {
+        float scale = sqrtf((k == 0 ? 1.0f : 2.0f) / filters);
+        for (uint32_t m = 0; m < filters; m++) {
+            e->dct[k * filters + m] = scale * cosf((float)M_PI * k * (m + 0.5f) / filters);
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// Extractor Lifecycle
+// ============================================================================
+
+static bool is_power_of_two(uint32_t n) {
+    return n >= 4 && (n & (n - 1)) == 0;
+}
+
+static int task_alloc(struct obivox_feature_extractor* e, FeatureTask* t) {
+    uint32_t n = t->kind == TASK_SPECTRAL ? e->config.frame_size : e->config.pitch_frame_size;
+    uint32_t bins = n / 2 + 1;
+
+    t->frame = malloc(n * sizeof(float));
+    t->re = malloc(bins * sizeof(float));
+    t->im = malloc(bins * sizeof(float));
+    t->work = malloc(n * sizeof(float));
+    if (!t->frame || !t->re || !t->im || !t->work) return -1;
+
+    if (t->kind == TASK_SPECTRAL) {
+        t->curve = malloc(e->config.mel_filters * sizeof(float));
+        return t->curve ? 0 : -1;
+    }
+
+    t->padded = calloc(n, sizeof(float));
+    t->re_b = malloc(bins * sizeof(float));
+    t->im_b = malloc(bins * sizeof(float));
+    t->curve = malloc((e->max_lag + 2) * sizeof(float));
+    t->prefix = malloc((n + 1) * sizeof(double));
+    return (t->padded && t->re_b && t->im_b && t->curve && t->prefix) ? 0 : -1;
+}
+
+int obivox_feature_extractor_create(
+    const OBIVoxFeatureConfig* config,
+    OBIVoxWorkerPool* pool,
+    OBIVoxFeatureExtractor** extractor) {
+
+    if (!extractor) return -1;
+
+    struct obivox_feature_extractor* e = calloc(1, sizeof(*e));
+    if (!e) return -1;
+
+    if (config) {
+        e->config = *config;
+    } else {
+        obivox_feature_config_default(&e->config);
+    }
+
+    OBIVoxFeatureConfig* c = &e->config;
+    e->pool = pool;
+    e->hop = (uint32_t)(c->sample_rate * c->hop_ms / 1000.0f);
+
+    // YIN integrates over half the frame, so lags stop there
+    uint32_t window = c->pitch_frame_size / 2;
+    if (c->pitch_min_hz > 0.0f) e->max_lag = (uint32_t)(c->sample_rate / c->pitch_min_hz);
+    if (e->max_lag == 0 || e->max_lag > window - 1) e->max_lag = window - 1;
+    e->min_lag = c->pitch_max_hz > 0.0f ? (uint32_t)(c->sample_rate / c->pitch_max_hz) : 2;
+    if (e->min_lag < 2) e->min_lag = 2;
+
+    if (c->sample_rate == 0 || e->hop == 0 || c->mel_filters == 0 ||
+        !is_power_of_two(c->frame_size) || !is_power_of_two(c->pitch_frame_size) ||
+        e->min_lag >= e->max_lag) {
+        free(e);
+        return -1;
+    }
+
+    pthread_mutex_init(&e->lock, NULL);
+    pthread_cond_init(&e->done, NULL);
+
+    uint32_t blocks = 1;
+    if (pool) {
+        OBIVoxPoolStats stats;
+        obivox_pool_stats(pool, &stats);
+        blocks = stats.workers * BLOCKS_PER_WORKER;
+        if (blocks == 0) blocks = 1;
+        e->max_helpers = stats.workers;
+    }
+    atomic_init(&e->claims, 0);
+
+    e->spectral_plan = obivox_fft_plan_create(c->frame_size);
+    e->pitch_plan = obivox_fft_plan_create(c->pitch_frame_size);
+    e->num_tasks = blocks * 2;
+    e->tasks = calloc(e->num_tasks, sizeof(FeatureTask));
+    e->active = calloc(e->num_tasks, sizeof(FeatureTask*));
+
+    int ret = (e->spectral_plan && e->pitch_plan && e->tasks && e->active) ? build_tables(e) : -1;
+    for (uint32_t i = 0; ret == 0 && i < e->num_tasks; i++) {
+        e->tasks[i].extractor = e;
+        e->tasks[i].kind = i < blocks ? TASK_SPECTRAL : TASK_PITCH;
+        ret = task_alloc(e, &e->tasks[i]);
+    }
+
+    if (ret != 0) {
+        obivox_feature_extractor_destroy(e);
+        return -1;
+    }
+
+    *extractor = e;
+    return 0;
+}
+
+void obivox_feature_extractor_destroy(OBIVoxFeatureExtractor* extractor) {
+    if (!extractor) return;
+    struct obivox_feature_extractor* e = extractor;
+
+    // Helpers left queued by earlier extractions still point here
+    pthread_mutex_lock(&e->lock);
+    while (e->helpers > 0) pthread_cond_wait(&e->done, &e->lock);
+    pthread_mutex_unlock(&e->lock);
+
+    for (uint32_t i = 0; e->tasks && i < e->num_tasks; i++) {
+        FeatureTask* t = &e->tasks[i];
+        free(t->frame);
+        free(t->padded);
+        free(t->re);
+        free(t->im);
+        free(t->re_b);
+        free(t->im_b);
+        free(t->work);
+        free(t->curve);
+        free(t->prefix);
+    }
+    free(e->tasks);
+    free(e->active);
+
+    obivox_fft_plan_destroy(e->spectral_plan);
+    obivox_fft_plan_destroy(e->pitch_plan);
+    free(e->window);
+    free(e->mel_start);
+    free(e->mel_len);
+    free(e->mel_offset);
+    free(e->mel_weights);
+    free(e->dct);
+    free(e->mfcc);
+    free(e->mfcc_delta);
+    free(e->pitch);
+    free(e->energy);
+    free(e->contour);
+
+    pthread_mutex_destroy(&e->lock);
+    pthread_cond_destroy(&e->done);
+    free(e);
+}
+
+// ============================================================================
+// Frame Blocks
+// ============================================================================
+
+// Frame of size samples centred on center, zero beyond the signal
+static void load_frame(const float* audio, uint32_t n, int64_t center, uint32_t size, float* out) {
+    int64_t start = center - size / 2;
+    if (start >= 0 && start + size <= n) {
+        memcpy(out, audio + start, size * sizeof(float));
+        return;
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        int64_t j = start + i;
+        out[i] = (j >= 0 && j < n) ? audio[j] : 0.0f;
+    }
+}
+
+static void run_spectral(struct obivox_feature_extractor* e, FeatureTask* t) {
+    const OBIVoxKernels* kernels = obivox_kernels();
+    uint32_t n = e->config.frame_size;
+    uint32_t bins = n / 2 + 1;
+    uint32_t filters = e->config.mel_filters;
+
+    for (uint32_t k = t->first; k < t->last; k++) {
+        float* x = t->frame;
+        load_frame(e->audio, e->num_samples, (int64_t)k * e->hop, n, x);
+        for (uint32_t i = 0; i < n; i++) x[i] *= e->window[i];
+
+        // Hamming energy from the same windowed frame the MFCC uses
+        e->energy[k] = sqrtf(kernels->dot(x, x, n) / e->window_power);
+
+        obivox_fft_real_forward(e->spectral_plan, x, t->re, t->im);
+        for (uint32_t b = 0; b < bins; b++) {
+            t->work[b] = t->re[b] * t->re[b] + t->im[b] * t->im[b];
+        }
+
+        for (uint32_t m = 0; m < filters; m++) {
+            float band = kernels->dot(
+                e->mel_weights + e->mel_offset[m],
+                t->work + e->mel_start[m],
+                e->mel_len[m]
+            );
+            t->curve[m] = logf(band + 1e-10f);
+        }
+
+        float* mfcc = e->mfcc + (size_t)k * OBIVOX_MFCC_COEFFS;
+        for (uint32_t c = 0; c < OBIVOX_MFCC_COEFFS; c++) {
+            mfcc[c] = kernels->dot(e->dct + c * filters, t->curve, filters);
+        }
+    }
+}
+
+static float yin_frame(struct obivox_feature_extractor* e, FeatureTask* t) {
+    uint32_t n = e->config.pitch_frame_size;
+    uint32_t w = n / 2;
+    uint32_t bins = n / 2 + 1;
+    const float* x = t->frame;
+
+    t->prefix[0] = 0.0;
+    for (uint32_t i = 0; i < n; i++) {
+        t->prefix[i + 1] = t->prefix[i] + (double)x[i] * x[i];
+    }
+    double e0 = t->prefix[w];
+    if (e0 < SILENCE_POWER * w) return 0.0f;
+
+    // r(tau) = sum_j x[j] x[j + tau] over the integration window, as the
+    // inverse of conj(FFT(window)) * FFT(frame); no wrap since tau < w
+    memcpy(t->padded, x, w * sizeof(float));
+    obivox_fft_real_forward(e->pitch_plan, t->padded, t->re, t->im);
+    obivox_fft_real_forward(e->pitch_plan, x, t->re_b, t->im_b);
+    for (uint32_t b = 0; b < bins; b++) {
+        float re = t->re[b] * t->re_b[b] + t->im[b] * t->im_b[b];
+        float im = t->re[b] * t->im_b[b] - t->im[b] * t->re_b[b];
+        t->re[b] = re;
+        t->im[b] = im;
+    }
+    obivox_fft_real_inverse(e->pitch_plan, t->re, t->im, t->work);
+
+    // Cumulative mean normalised difference d'(tau)
+    float* d = t->curve;
+    double running = 0.0;
+    d[0] = 1.0f;
+    for (uint32_t tau = 1; tau <= e->max_lag; tau++) {
+        double diff = e0 + (t->prefix[tau + w] - t->prefix[tau]) - 2.0 * t->work[tau];
+        if (diff < 0.0) diff = 0.0;
+        running += diff;
+        d[tau] = running > 0.0 ? (float)(diff * tau / running) : 1.0f;
+    }
+
+    // First dip under the threshold, followed down to its minimum
+    uint32_t tau = e->min_lag;
+    while (tau <= e->max_lag && d[tau] >= e->config.yin_threshold) tau++;
+    if (tau > e->max_lag) return 0.0f;
+    while (tau + 1 <= e->max_lag && d[tau + 1] < d[tau]) tau++;
+
+    float shift = 0.0f;
+    if (tau > e->min_lag && tau < e->max_lag) {
+        float denom = d[tau - 1] - 2.0f * d[tau] + d[tau + 1];
+        if (denom > 0.0f) shift = 0.5f * (d[tau - 1] - d[tau + 1]) / denom;
+        if (shift > 1.0f || shift < -1.0f) shift = 0.0f;
+    }
+    return (float)e->config.sample_rate / ((float)tau + shift);
+}
+
+static void run_pitch(struct obivox_feature_extractor* e, FeatureTask* t) {
+    uint32_t n = e->config.pitch_frame_size;
+    for (uint32_t k = t->first; k < t->last; k++) {
+        load_frame(e->audio, e->num_samples, (int64_t)k * e->hop, n, t->frame);
+        e->pitch[k] = yin_frame(e, t);
+    }
+}
+
+static FeatureTask* claim_block(struct obivox_feature_extractor* e) {
+    uint64_t word = atomic_load_explicit(&e->claims, memory_order_acquire);
+    do {
+        if ((uint32_t)word >= (uint32_t)(word >> 32)) return NULL;
+    } while (!atomic_compare_exchange_weak_explicit(&e->claims, &word, word + 1,
+                                                    memory_order_acq_rel,
+                                                    memory_order_acquire));
+    return e->active[(uint32_t)word];
+}
+
+// Run blocks until none is left unclaimed. A helper queued by an earlier
+// extraction may claim blocks of the current one, which is just as good
+static void run_blocks(struct obivox_feature_extractor* e) {
+    FeatureTask* t;
+    while ((t = claim_block(e)) != NULL) {
+        if (t->kind == TASK_SPECTRAL) {
+            run_spectral(e, t);
+        } else {
+            run_pitch(e, t);
+        }
+
+        pthread_mutex_lock(&e->lock);
+        if (--e->remaining == 0) pthread_cond_broadcast(&e->done);
+        pthread_mutex_unlock(&e->lock);
+    }
+}
+
+static void feature_helper_run(OBIVoxSession* session, void* arg) {
+    (void)session;
+    struct obivox_feature_extractor* e = arg;
+    run_blocks(e);
+
+    pthread_mutex_lock(&e->lock);
+    if (--e->helpers == 0) pthread_cond_broadcast(&e->done);
+    pthread_mutex_unlock(&e->lock);
+}
+
+// ============================================================================
+// Extraction
+// ============================================================================
+
+static int reserve_frames(struct obivox_feature_extractor* e, uint32_t frames) {
+    if (frames <= e->frame_capacity) return 0;
+
+    size_t coeffs = (size_t)frames * OBIVOX_MFCC_COEFFS;
+    float* mfcc = realloc(e->mfcc, coeffs * sizeof(float));
+    if (mfcc) e->mfcc = mfcc;
+    float* delta = realloc(e->mfcc_delta, coeffs * sizeof(float));
+    if (delta) e->mfcc_delta = delta;
+    float* pitch = realloc(e->pitch, frames * sizeof(float));
+    if (pitch) e->pitch = pitch;
+    float* energy = realloc(e->energy, frames * sizeof(float));
+    if (energy) e->energy = energy;
+    float* contour = realloc(e->contour, frames * sizeof(float));
+    if (contour) e->contour = contour;
+
+    if (!mfcc || !delta || !pitch || !energy || !contour) return -1;
+    e->frame_capacity = frames;
+    return 0;
+}
+
+static void compute_deltas(struct obivox_feature_extractor* e) {
+    float norm = 0.0f;
+    for (int d = 1; d <= DELTA_WIDTH; d++) norm += 2.0f * d * d;
+
+    int64_t last = (int64_t)e->frames - 1;
+    for (int64_t k = 0; k <= last; k++) {
+        float* out = e->mfcc_delta + k * OBIVOX_MFCC_COEFFS;
+        for (uint32_t c = 0; c < OBIVOX_MFCC_COEFFS; c++) {
+            float acc = 0.0f;
+            for (int d = 1; d <= DELTA_WIDTH; d++) {
+                int64_t ahead = k + d > last ? last : k + d;
+                int64_t behind = k - d < 0 ? 0 : k - d;
+                acc += d * (e->mfcc[ahead * OBIVOX_MFCC_COEFFS + c] -
+                            e->mfcc[behind * OBIVOX_MFCC_COEFFS + c]);
+            }
+            out[c] = acc / norm;
+        }
+    }
+}
+
+// Publish the per-frame contours as the AudioFeatures view, with the
+// running sums filled in the same pass
+static void fill_contours(struct obivox_feature_extractor* e, AudioFeatures* f) {
+    uint32_t frames = e->frames;
+
+    // Unvoiced frames repeat the last voiced pitch so voicing changes do
+    // not read as pitch movement; leading ones take the first voiced value
+    float held = 0.0f;
+    for (uint32_t k = 0; k < frames; k++) {
+        if (e->pitch[k] > 0.0f) {
+            held = e->pitch[k] / e->config.pitch_max_hz;
+            break;
+        }
+    }
+
+    double pitch_steps = 0.0;
+    double energy = 0.0;
+    for (uint32_t k = 0; k < frames; k++) {
+        if (e->pitch[k] > 0.0f) held = e->pitch[k] / e->config.pitch_max_hz;
+        if (k > 0) {
+            double step = held - e->contour[k - 1];
+            pitch_steps += step * step;
+        }
+        e->contour[k] = held;
+        energy += e->energy[k];
+    }
+
+    f->pitch_contour = e->contour;
+    f->energy_envelope = e->energy;
+    f->contour_frames = frames;
+    f->contour_frame_rate = (float)e->config.sample_rate / e->hop;
+    f->pitch_step_sum = pitch_steps;
+    f->energy_sum = energy;
+    f->contour_stats_frames = frames;
+}
+
+int obivox_feature_extract(
+    OBIVoxFeatureExtractor* extractor,
+    AudioFeatures* features,
+    OBIVoxFeatureFrames* frames) {
+
+    if (!extractor || !features) return -1;
+    if (!features->raw_audio && features->num_samples > 0) return -1;
+
+    struct obivox_feature_extractor* e = extractor;
+    uint64_t start = obivox_now_ns();
+
+    uint32_t n = features->num_samples;
+    uint32_t count = n > 0 ? (n + e->hop - 1) / e->hop : 0;
+    if (reserve_frames(e, count) != 0) return -1;
+
+    e->audio = features->raw_audio;
+    e->num_samples = n;
+    e->frames = count;
+
+    // Split the frames into blocks of each kind. Every block of the last
+    // extraction has finished and nothing is claimable, so stale helpers
+    // cannot see this until the claim word is published
+    uint32_t blocks = e->num_tasks / 2;
+    uint32_t active = 0;
+    for (uint32_t i = 0; i < e->num_tasks; i++) {
+        FeatureTask* t = &e->tasks[i];
+        uint32_t block = i % blocks;
+        t->first = (uint32_t)((uint64_t)block * count / blocks);
+        t->last = (uint32_t)((uint64_t)(block + 1) * count / blocks);
+        if (t->last > t->first) e->active[active++] = t;
+    }
+
+    // Top helpers up to one per worker (queued ones count), then claim
+    // blocks alongside them. Claimed blocks are running, so waiting for
+    // them is safe even from a task on the same pool
+    uint32_t wanted = 0;
+    pthread_mutex_lock(&e->lock);
+    e->remaining = active;
+    if (e->pool && active > 1 && e->helpers < e->max_helpers) {
+        wanted = e->max_helpers - e->helpers;
+        if (wanted > active - 1) wanted = active - 1;
+        e->helpers += wanted;
+    }
+    pthread_mutex_unlock(&e->lock);
+    atomic_store_explicit(&e->claims, (uint64_t)active << 32, memory_order_release);
+
+    for (uint32_t i = 0; i < wanted; i++) {
+        if (obivox_pool_submit(e->pool, feature_helper_run, e) != 0) {
+            pthread_mutex_lock(&e->lock);
+            e->helpers -= wanted - i;
+            if (e->helpers == 0) pthread_cond_broadcast(&e->done);
+            pthread_mutex_unlock(&e->lock);
+            break;
+        }
+    }
+    run_blocks(e);
+
+    pthread_mutex_lock(&e->lock);
+    while (e->remaining > 0) pthread_cond_wait(&e->done, &e->lock);
+    pthread_mutex_unlock(&e->lock);
+
+    compute_deltas(e);
+
+    memset(e->mfcc_mean, 0, sizeof(e->mfcc_mean));
+    for (uint32_t k = 0; k < count; k++) {
+        for (uint32_t c = 0; c < OBIVOX_MFCC_COEFFS; c++) {
+            e->mfcc_mean[c] += e->mfcc[(size_t)k * OBIVOX_MFCC_COEFFS + c];
+        }
+    }
+    for (uint32_t c = 0; count > 0 && c < OBIVOX_MFCC_COEFFS; c++) {
+        e->mfcc_mean[c] /= count;
+    }
+
+    fill_contours(e, features);
+    if (features->mfcc_features) {
+        memcpy(features->mfcc_features, e->mfcc_mean, sizeof(e->mfcc_mean));
+    } else {
+        features->mfcc_features = e->mfcc_mean;
+    }
+
+    double elapsed = (double)(obivox_now_ns() - start) * 1e-9;
+    if (frames) {
+        frames->frames = count;
+        frames->mfcc = e->mfcc;
+        frames->mfcc_delta = e->mfcc_delta;
+        frames->pitch_hz = e->pitch;
+        frames->energy = e->energy;
+        frames->elapsed_seconds = elapsed;
+        frames->real_time_factor = n > 0
+            ? (float)(elapsed / ((double)n / e->config.sample_rate))
+            : 0.0f;
+    }
+    return 0;
+}
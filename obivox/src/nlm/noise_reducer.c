@@ -0,0 +1,346 @@
+/**
+ * noise_reducer.c
+ * Stage-2 noise reduction: sqrt-Hann STFT at 50% overlap (the squared
+ * windows sum to one, so unmodified spectra reconstruct exactly), power
+ * spectral subtraction against a start-of-stream profile, and the lisp
+ * filter's magnitude response folded into the same per-bin gain
+ */
+
+#include "obivox/nlm_denoise.h"
+#include "dsp/obivox_fft.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Quiet-frame tracking once the profile is ready
+#define TRACK_RATE        0.05f
+#define TRACK_HEADROOM    2.0f
+
+struct obivox_denoiser {
+    OBIVoxDenoiseConfig config;
+    uint32_t frame_size;
+    uint32_t hop;
+    uint32_t bins;
+    float over_subtraction;
+    float floor_power;           // spectral_floor squared
+
+    OBIVoxFFTPlan* plan;
+    float* window;
+    float* input;                // Last frame of input; the hop fills [hop, frame)
+    float* ready;                // hop finished samples, emitted next hop
+    float* tail;                 // hop partial sums from the previous frame
+    float* frame;                // Windowed frame, then the inverse output
+    float* re;
+    float* im;
+    float* power;
+    float* noise;                // Noise power per bin
+    float* shaping;              // Per-bin lisp shaping, 1 when off
+    float* discard;              // frame_size samples for compensated output
+
+    // Start-of-stream profile: per-frame spectra kept until it completes
+    float* profile;
+    float* profile_energy;
+    uint32_t profile_frames;
+    uint32_t profiled;
+    uint64_t frames;
+    float noise_energy;
+    bool profile_ready;
+
+    uint32_t fill;               // Samples of the current hop received
+};
+
+void obivox_denoise_config_default(OBIVoxDenoiseConfig* config) {
+    if (!config) return;
+    config->sample_rate = 16000;
+    config->frame_size = 512;
+    config->profile_ms = 500.0f;
+    config->aggressiveness = 0.7f;
+    config->spectral_floor = 0.1f;
+    config->track_noise = true;
+}
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+int obivox_denoiser_create(const OBIVoxDenoiseConfig* config, OBIVoxDenoiser** denoiser) {
+    if (!denoiser) return -1;
+    *denoiser = NULL;
+
+    OBIVoxDenoiseConfig c;
+    if (config) {
+        c = *config;
+    } else {
+        obivox_denoise_config_default(&c);
+    }
+    if (c.frame_size < 16 || (c.frame_size & (c.frame_size - 1)) != 0) return -1;
+    if (c.sample_rate == 0 || c.aggressiveness < 0.0f) return -1;
+    if (c.spectral_floor < 0.0f || c.spectral_floor > 1.0f) return -1;
+
+    OBIVoxDenoiser* d = calloc(1, sizeof(OBIVoxDenoiser));
+    if (!d) return -1;
+    d->config = c;
+    d->frame_size = c.frame_size;
+    d->hop = c.frame_size / 2;
+    d->bins = c.frame_size / 2 + 1;
+    d->over_subtraction = 1.0f + c.aggressiveness;
+    d->floor_power = c.spectral_floor * c.spectral_floor;
+
+    double profile_samples = c.profile_ms * c.sample_rate / 1000.0;
+    d->profile_frames = (uint32_t)ceil(profile_samples / d->hop);
+    if (d->profile_frames == 0) d->profile_frames = 1;
+
+    d->plan = obivox_fft_plan_create(d->frame_size);
+    d->window = malloc(d->frame_size * sizeof(float));
+    d->input = malloc(d->frame_size * sizeof(float));
+    d->ready = malloc(d->hop * sizeof(float));
+    d->tail = malloc(d->hop * sizeof(float));
+    d->frame = malloc(d->frame_size * sizeof(float));
+    d->discard = malloc(d->frame_size * sizeof(float));
+    d->re = malloc(d->bins * sizeof(float));
+    d->im = malloc(d->bins * sizeof(float));
+    d->power = malloc(d->bins * sizeof(float));
+    d->noise = malloc(d->bins * sizeof(float));
+    d->shaping = malloc(d->bins * sizeof(float));
+    d->profile = malloc((size_t)d->profile_frames * d->bins * sizeof(float));
+    d->profile_energy = malloc(d->profile_frames * sizeof(float));
+    if (!d->plan || !d->window || !d->input || !d->ready || !d->tail || !d->frame ||
+        !d->discard || !d->re || !d->im || !d->power || !d->noise || !d->shaping ||
+        !d->profile || !d->profile_energy) {
+        obivox_denoiser_destroy(d);
+        return -1;
+    }
+
+    // Periodic sqrt-Hann for analysis and synthesis
+    for (uint32_t i = 0; i < d->frame_size; i++) {
+        d->window[i] = sqrtf(0.5f - 0.5f * cosf(2.0f * (float)M_PI * i / d->frame_size));
+    }
+    for (uint32_t k = 0; k < d->bins; k++) d->shaping[k] = 1.0f;
+
+    obivox_denoiser_reset(d);
+    *denoiser = d;
+    return 0;
+}
+
+void obivox_denoiser_destroy(OBIVoxDenoiser* denoiser) {
+    if (!denoiser) return;
+    obivox_fft_plan_destroy(denoiser->plan);
+    free(denoiser->window);
+    free(denoiser->input);
+    free(denoiser->ready);
+    free(denoiser->tail);
+    free(denoiser->frame);
+    free(denoiser->discard);
+    free(denoiser->re);
+    free(denoiser->im);
+    free(denoiser->power);
+    free(denoiser->noise);
+    free(denoiser->shaping);
+    free(denoiser->profile);
+    free(denoiser->profile_energy);
+    free(denoiser);
+}
+
+void obivox_denoiser_reset(OBIVoxDenoiser* denoiser) {
+    if (!denoiser) return;
+    memset(denoiser->input, 0, denoiser->frame_size * sizeof(float));
+    memset(denoiser->ready, 0, denoiser->hop * sizeof(float));
+    memset(denoiser->tail, 0, denoiser->hop * sizeof(float));
+    memset(denoiser->noise, 0, denoiser->bins * sizeof(float));
+    denoiser->profiled = 0;
+    denoiser->frames = 0;
+    denoiser->noise_energy = 0.0f;
+    denoiser->profile_ready = false;
+    denoiser->fill = 0;
+}
+
+int obivox_denoiser_set_lisp_shaping(OBIVoxDenoiser* denoiser, float gain) {
+    if (!denoiser || gain < 0.0f || gain >= 1.0f) return -1;
+
+    // |H| of y[n] = (1 - g) x[n] + g y[n-1], unity at DC
+    for (uint32_t k = 0; k < denoiser->bins; k++) {
+        float w = (float)M_PI * k / (denoiser->bins - 1);
+        float magnitude = sqrtf(1.0f - 2.0f * gain * cosf(w) + gain * gain);
+        denoiser->shaping[k] = (1.0f - gain) / magnitude;
+    }
+    return 0;
+}
+
+uint32_t obivox_denoiser_latency(const OBIVoxDenoiser* denoiser) {
+    return denoiser ? denoiser->frame_size : 0;
+}
+
+bool obivox_denoiser_profile_ready(const OBIVoxDenoiser* denoiser) {
+    return denoiser && denoiser->profile_ready;
+}
+
+// ============================================================================
+// Noise Profile
+// ============================================================================
+
+// Mean spectrum of the frames at or below the median profile energy
+static void profile_finish(OBIVoxDenoiser* d) {
+    uint32_t n = d->profiled;
+    float sorted[n];
+    memcpy(sorted, d->profile_energy, n * sizeof(float));
+    for (uint32_t i = 1; i < n; i++) {
+        float v = sorted[i];
+        uint32_t j = i;
+        for (; j > 0 && sorted[j - 1] > v; j--) sorted[j] = sorted[j - 1];
+        sorted[j] = v;
+    }
+    float median = sorted[(n - 1) / 2];
+
+    memset(d->noise, 0, d->bins * sizeof(float));
+    uint32_t used = 0;
+    for (uint32_t f = 0; f < n; f++) {
+        if (d->profile_energy[f] > median) continue;
+        const float* spectrum = d->profile + (size_t)f * d->bins;
+        for (uint32_t k = 0; k < d->bins; k++) d->noise[k] += spectrum[k];
+        used++;
+    }
+
+    d->noise_energy = 0.0f;
+    for (uint32_t k = 0; k < d->bins; k++) {
+        d->noise[k] /= (float)used;
+        d->noise_energy += d->noise[k];
+    }
+    d->profile_ready = true;
+}
+
+static void profile_update(OBIVoxDenoiser* d, float energy) {
+    // The first frame is half leading silence: provisional only
+    if (d->frames == 1) {
+        memcpy(d->noise, d->power, d->bins * sizeof(float));
+        return;
+    }
+
+    if (!d->profile_ready) {
+        // Until the profile completes, the per-bin minimum so far stands
+        // in for it (conservative: it under-subtracts)
+        memcpy(d->profile + (size_t)d->profiled * d->bins, d->power, d->bins * sizeof(float));
+        d->profile_energy[d->profiled++] = energy;
+        for (uint32_t k = 0; k < d->bins; k++) {
+            if (d->power[k] < d->noise[k]) d->noise[k] = d->power[k];
+        }
+        if (d->profiled == d->profile_frames) profile_finish(d);
+        return;
+    }
+
+    if (d->config.track_noise && energy < TRACK_HEADROOM * d->noise_energy) {
+        d->noise_energy = 0.0f;
+        for (uint32_t k = 0; k < d->bins; k++) {
+            d->noise[k] += TRACK_RATE * (d->power[k] - d->noise[k]);
+            d->noise_energy += d->noise[k];
+        }
+    }
+}
+
+// ============================================================================
+// STFT Frame
+// ============================================================================
+
+static void process_frame(OBIVoxDenoiser* d) {
+    const uint32_t n = d->frame_size;
+    const uint32_t hop = d->hop;
+
+    for (uint32_t i = 0; i < n; i++) d->frame[i] = d->input[i] * d->window[i];
+    obivox_fft_real_forward(d->plan, d->frame, d->re, d->im);
+
+    float energy = 0.0f;
+    for (uint32_t k = 0; k < d->bins; k++) {
+        d->power[k] = d->re[k] * d->re[k] + d->im[k] * d->im[k];
+        energy += d->power[k];
+    }
+    d->frames++;
+    profile_update(d, energy);
+
+    // Power subtraction with a floor, then the fricative shaping
+    for (uint32_t k = 0; k < d->bins; k++) {
+        float p = d->power[k];
+        float g2 = p > 0.0f ? 1.0f - d->over_subtraction * d->noise[k] / p : 0.0f;
+        float gain = g2 > d->floor_power ? sqrtf(g2) : d->config.spectral_floor;
+        gain *= d->shaping[k];
+        d->re[k] *= gain;
+        d->im[k] *= gain;
+    }
+
+    obivox_fft_real_inverse(d->plan, d->re, d->im, d->frame);
+
+    // Overlap-add: the first half completes the previous frame's tail
+    for (uint32_t i = 0; i < hop; i++) {
+        d->ready[i] = d->tail[i] + d->frame[i] * d->window[i];
+        d->tail[i] = d->frame[hop + i] * d->window[hop + i];
+    }
+    memmove(d->input, d->input + hop, hop * sizeof(float));
+}
+
+// input NULL streams zeros (flush)
+static void stream(OBIVoxDenoiser* d, const float* input, float* output, uint32_t num_samples) {
+    while (num_samples > 0) {
+        uint32_t take = d->hop - d->fill;
+        if (take > num_samples) take = num_samples;
+
+        // Consume input before writing output, so the two may alias
+        if (input) {
+            memcpy(d->input + d->hop + d->fill, input, take * sizeof(float));
+            input += take;
+        } else {
+            memset(d->input + d->hop + d->fill, 0, take * sizeof(float));
+        }
+        memmove(output, d->ready + d->fill, take * sizeof(float));
+        output += take;
+
+        d->fill += take;
+        num_samples -= take;
+        if (d->fill == d->hop) {
+            process_frame(d);
+            d->fill = 0;
+        }
+    }
+}
+
+// ============================================================================
+// Streaming API
+// ============================================================================
+
+int obivox_denoiser_process(
+    OBIVoxDenoiser* denoiser,
+    const float* input,
+    float* output,
+    uint32_t num_samples) {
+
+    if (!denoiser || (num_samples > 0 && (!input || !output))) return -1;
+    stream(denoiser, input, output, num_samples);
+    return 0;
+}
+
+int obivox_denoiser_flush(OBIVoxDenoiser* denoiser, float* output) {
+    if (!denoiser || !output) return -1;
+    stream(denoiser, NULL, output, denoiser->frame_size);
+    return 0;
+}
+
+int obivox_denoise_buffer(OBIVoxDenoiser* denoiser, float* audio, uint32_t num_samples) {
+    if (!denoiser || (!audio && num_samples > 0)) return -1;
+
+    obivox_denoiser_reset(denoiser);
+    const uint32_t latency = denoiser->frame_size;
+
+    // The leading silence is dropped; afterwards output lands one latency
+    // behind the input, in chunks that never overtake the unread input
+    uint32_t lead = num_samples < latency ? num_samples : latency;
+    stream(denoiser, audio, denoiser->discard, lead);
+    for (uint32_t at = lead; at < num_samples; ) {
+        uint32_t chunk = num_samples - at < latency ? num_samples - at : latency;
+        stream(denoiser, audio + at, audio + at - latency, chunk);
+        at += chunk;
+    }
+
+    // The flush holds the last min(n, latency) samples of the input
+    stream(denoiser, NULL, denoiser->discard, latency);
+    uint32_t count = num_samples < latency ? num_samples : latency;
+    uint32_t offset = num_samples < latency ? latency - num_samples : 0;
+    memcpy(audio + num_samples - count, denoiser->discard + offset, count * sizeof(float));
+    return 0;
+}
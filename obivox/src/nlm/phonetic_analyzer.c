@@ -0,0 +1,254 @@
+/**
+ * phonetic_analyzer.c
+ * Speech variation engine: one framing pass feeds the zero-crossing lisp
+ * heuristic and an FFT autocorrelation over the stutter lag range
+ */
+
+#include "obivox/nlm_variation.h"
+#include "dsp/obivox_fft.h"
+#include "dsp/obivox_kernels.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Mean power below this (about -60 dBFS) is silence, never a repetition
+#define SILENCE_POWER 1e-6
+
+struct obivox_variation_engine {
+    OBIVoxVariationConfig config;
+    uint32_t min_lag;
+    uint32_t max_lag;
+    uint32_t frame_size;     // Power of two >= 2 * max_lag
+    uint32_t hop_size;       // <= frame_size
+
+    OBIVoxFFTPlan* plan;     // 2 * frame_size, so lags never wrap
+
+    // Framing ring: the newest frame_fill samples start at ring_head
+    float* ring;
+    uint32_t ring_head;
+
+    // FFT input: the frame in [0, frame_size), zero padding after
+    float* frame;
+    float* spectrum_re;
+    float* spectrum_im;
+    float* autocorrelation;
+    double* energy_prefix;
+};
+
+void obivox_variation_config_default(OBIVoxVariationConfig* config) {
+    if (!config) return;
+    config->sample_rate = 16000;
+    config->min_lag_ms = 80.0f;
+    config->max_lag_ms = 400.0f;
+    config->hop_ms = 100.0f;
+    config->repetition_threshold = 0.8f;
+}
+
+// ============================================================================
+// Engine Lifecycle
+// ============================================================================
+
+int obivox_variation_engine_create(
+    const OBIVoxVariationConfig* config,
+    OBIVoxVariationEngine** engine) {
+
+    if (!engine) return -1;
+
+    OBIVoxVariationEngine* e = calloc(1, sizeof(OBIVoxVariationEngine));
+    if (!e) return -1;
+
+    if (config) {
+        e->config = *config;
+    } else {
+        obivox_variation_config_default(&e->config);
+    }
+    if (e->config.sample_rate == 0 ||
+        e->config.min_lag_ms <= 0.0f ||
+        e->config.hop_ms <= 0.0f ||
+        e->config.max_lag_ms < e->config.min_lag_ms) {
+        free(e);
+        return -1;
+    }
+
+    e->min_lag = (uint32_t)(e->config.min_lag_ms * e->config.sample_rate / 1000.0f);
+    e->max_lag = (uint32_t)(e->config.max_lag_ms * e->config.sample_rate / 1000.0f);
+    if (e->min_lag == 0) e->min_lag = 1;
+
+    e->frame_size = 2;
+    while (e->frame_size < 2 * e->max_lag) e->frame_size <<= 1;
+    e->hop_size = (uint32_t)(e->config.hop_ms * e->config.sample_rate / 1000.0f);
+    if (e->hop_size == 0) e->hop_size = 1;
+    if (e->hop_size > e->frame_size) e->hop_size = e->frame_size;
+
+    uint32_t fft_size = e->frame_size * 2;
+    uint32_t bins = fft_size / 2 + 1;
+
+    e->plan = obivox_fft_plan_create(fft_size);
+    e->ring = malloc(e->frame_size * sizeof(float));
+    e->frame = calloc(fft_size, sizeof(float));
+    e->spectrum_re = malloc(bins * sizeof(float));
+    e->spectrum_im = malloc(bins * sizeof(float));
+    e->autocorrelation = malloc(fft_size * sizeof(float));
+    e->energy_prefix = malloc((e->frame_size + 1) * sizeof(double));
+
+    if (!e->plan || !e->ring || !e->frame || !e->spectrum_re || !e->spectrum_im ||
+        !e->autocorrelation || !e->energy_prefix) {
+        obivox_variation_engine_destroy(e);
+        return -1;
+    }
+
+    *engine = e;
+    return 0;
+}
+
+void obivox_variation_engine_destroy(OBIVoxVariationEngine* engine) {
+    if (!engine) return;
+    obivox_fft_plan_destroy(engine->plan);
+    free(engine->ring);
+    free(engine->frame);
+    free(engine->spectrum_re);
+    free(engine->spectrum_im);
+    free(engine->autocorrelation);
+    free(engine->energy_prefix);
+    free(engine);
+}
+
+// ============================================================================
+// Frame Analysis
+// ============================================================================
+
+// Best normalised autocorrelation over [min_lag, max_lag] for the len
+// ring samples; returns 0 for silent or too-short frames. The energy
+// prefix pass also unrolls the ring into the FFT input
+static float analyze_frame(OBIVoxVariationEngine* e, uint32_t len, uint32_t* best_lag) {
+    float* x = e->frame;
+    double* prefix = e->energy_prefix;
+    uint32_t first = e->frame_size - e->ring_head;
+    if (first > len) first = len;
+
+    prefix[0] = 0.0;
+    for (uint32_t i = 0; i < first; i++) {
+        x[i] = e->ring[e->ring_head + i];
+        prefix[i + 1] = prefix[i] + (double)x[i] * x[i];
+    }
+    for (uint32_t i = first; i < len; i++) {
+        x[i] = e->ring[i - first];
+        prefix[i + 1] = prefix[i] + (double)x[i] * x[i];
+    }
+    if (len < e->frame_size) memset(x + len, 0, (e->frame_size - len) * sizeof(float));
+    if (prefix[len] < SILENCE_POWER * len) return 0.0f;
+
+    uint32_t max_lag = e->max_lag < len / 2 ? e->max_lag : len / 2;
+    if (max_lag < e->min_lag) return 0.0f;
+
+    // Wiener-Khinchin: r[L] = IFFT(|X|^2); zero padding to 2x keeps it linear
+    uint32_t bins = obivox_fft_size(e->plan) / 2 + 1;
+    obivox_fft_real_forward(e->plan, x, e->spectrum_re, e->spectrum_im);
+    for (uint32_t k = 0; k < bins; k++) {
+        float re = e->spectrum_re[k], im = e->spectrum_im[k];
+        e->spectrum_re[k] = re * re + im * im;
+        e->spectrum_im[k] = 0.0f;
+    }
+    obivox_fft_real_inverse(e->plan, e->spectrum_re, e->spectrum_im, e->autocorrelation);
+
+    float best = 0.0f;
+    for (uint32_t lag = e->min_lag; lag <= max_lag; lag++) {
+        double head = prefix[len - lag];
+        double tail = prefix[len] - prefix[lag];
+        double norm = sqrt(head * tail);
+        if (norm < SILENCE_POWER * (len - lag)) continue;
+
+        float r = (float)(e->autocorrelation[lag] / norm);
+        if (r > best) {
+            best = r;
+            *best_lag = lag;
+        }
+    }
+    return best;
+}
+
+// ============================================================================
+// Shared Framing Pass
+// ============================================================================
+
+int obivox_variation_engine_analyze(
+    OBIVoxVariationEngine* engine,
+    const float* audio,
+    uint32_t num_samples,
+    PhoneticAccessibility* accessibility,
+    OBIVoxVariationReport* report,
+    float* variation_score) {
+
+    if (!engine || !audio || !accessibility || !variation_score) return -1;
+
+    OBIVoxVariationEngine* e = engine;
+    const OBIVoxKernels* kernels = obivox_kernels();
+    OBIVoxVariationReport r = {0};
+    uint64_t zero_crossings = 0;
+    uint32_t frame_fill = 0;
+    uint32_t peak_lag = 0;
+    float previous = num_samples > 0 ? audio[0] : 0.0f;
+
+    // Each hop is read from the caller once: counted for ZCR while it is
+    // cache-hot, then written over the oldest samples of the ring
+    e->ring_head = 0;
+    for (uint32_t pos = 0; pos < num_samples; ) {
+        uint32_t chunk = num_samples - pos < e->hop_size ? num_samples - pos : e->hop_size;
+
+        if (frame_fill + chunk > e->frame_size) {
+            uint32_t drop = frame_fill + chunk - e->frame_size;
+            e->ring_head = (e->ring_head + drop) % e->frame_size;
+            frame_fill -= drop;
+        }
+
+        zero_crossings += kernels->zero_crossings(audio + pos, chunk, previous);
+        previous = audio[pos + chunk - 1];
+        uint32_t tail = (e->ring_head + frame_fill) % e->frame_size;
+        uint32_t run = e->frame_size - tail < chunk ? e->frame_size - tail : chunk;
+        memcpy(e->ring + tail, audio + pos, run * sizeof(float));
+        memcpy(e->ring, audio + pos + run, (chunk - run) * sizeof(float));
+        frame_fill += chunk;
+        pos += chunk;
+
+        // Analyze every full frame, plus a short tail-only buffer once
+        if (frame_fill == e->frame_size || (pos == num_samples && r.frames_analyzed == 0)) {
+            uint32_t lag = 0;
+            float peak = analyze_frame(e, frame_fill, &lag);
+            r.frames_analyzed++;
+
+            if (peak > e->config.repetition_threshold) {
+                r.repetition_score += 1.0f;
+            }
+            if (peak > r.peak_correlation) {
+                r.peak_correlation = peak;
+                peak_lag = lag;
+            }
+        }
+    }
+
+    r.zero_crossing_rate = num_samples > 0 ? (float)zero_crossings / num_samples : 0.0f;
+    r.peak_lag_ms = peak_lag * 1000.0f / e->config.sample_rate;
+
+    // High ZCR in fricatives may indicate lisp
+    if (r.zero_crossing_rate > 0.4f) {
+        accessibility->lisp_mitigation = true;
+    }
+
+    if (r.repetition_score > 3.0f) {
+        accessibility->stutter_detection = true;
+    }
+
+    // Calculate overall variation score
+    *variation_score = (r.zero_crossing_rate * 0.3f) +
+                       (r.repetition_score * 0.1f) +
+                       (accessibility->variation_tolerance * 0.6f);
+
+    // Preserve phenomenological integrity
+    if (*variation_score > 0.5f && accessibility->phenomenological_integrity > 0.9f) {
+        // High variation but high integrity - preserve speaker identity
+        accessibility->accent_normalization = false;
+    }
+
+    if (report) *report = r;
+    return 0;
+}
@@ -0,0 +1,826 @@
+/**
+ * pronunciation_lexicon.c
+ * Word-level G2P: a hash-and-displace minimal perfect hash over normalized
+ * words, one flat blob (header, displacements, slots, string pool) that is
+ * identical in memory and on disk, plus letter-to-sound rules for misses
+ */
+
+#include "obivox/nlm_lexicon.h"
+#include <ctype.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define LEXICON_MAGIC       "OBVXLEX"
+#define LEXICON_VERSION     1
+#define LEXICON_WORD_MAX    63
+#define LEXICON_EMPTY       UINT32_MAX
+
+// Keys per displacement bucket and slots per key (load 0.8)
+#define BUCKET_KEYS         4
+#define MAX_DISPLACEMENT    (1u << 20)
+#define MAX_SEEDS           8
+
+#define PRIME1 0x9E3779B97F4A7C15ULL
+
+// Offsets are from the start of the blob, so a mapped file needs no fixups
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t entries;
+    uint32_t buckets;
+    uint32_t slots;
+    uint64_t seed;
+    uint64_t disp_offset;       // uint32_t[buckets]
+    uint64_t slot_offset;       // LexiconSlot[slots]
+    uint64_t pool_offset;       // NUL-terminated words and phonemes
+    uint64_t pool_bytes;
+    uint64_t total_bytes;
+} LexiconHeader;
+
+typedef struct {
+    uint32_t word;              // Pool offset, LEXICON_EMPTY when unused
+    uint32_t phonemes;
+} LexiconSlot;
+
+struct obivox_lexicon {
+    uint8_t* base;
+    size_t bytes;
+    bool mapped;
+    bool borrowed;              // base belongs to the caller (obivox_lexicon_open)
+
+    const LexiconHeader* header;
+    const uint32_t* disp;
+    const LexiconSlot* slots;
+    const char* pool;
+
+    atomic_uint_fast64_t lookups;
+    atomic_uint_fast64_t misses;
+};
+
+// ============================================================================
+// Hashing
+// ============================================================================
+
+static uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static uint64_t word_hash(const char* word, size_t length, uint64_t seed) {
+    // FNV-1a, then finalized so bucket and slot bits are independent
+    uint64_t h = 14695981039346656037ULL ^ seed;
+    for (size_t i = 0; i < length; i++) {
+        h = (h ^ (uint8_t)word[i]) * 1099511628211ULL;
+    }
+    return mix64(h);
+}
+
+static uint32_t bucket_of(uint64_t h, uint32_t buckets) {
+    return (uint32_t)((h >> 32) % buckets);
+}
+
+static uint32_t slot_of(uint64_t h, uint32_t displacement, uint32_t slots) {
+    return (uint32_t)(mix64(h + (uint64_t)(displacement + 1) * PRIME1) % slots);
+}
+
+// ============================================================================
+// Normalization
+// ============================================================================
+
+// Lower-case letters and apostrophes only; returns length, 0 = not a word
+static size_t normalize_word(const char* word, size_t length, char* out) {
+    if (length == 0 || length > LEXICON_WORD_MAX) return 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)word[i];
+        if (!isalpha(c) && c != '\'') return 0;
+        out[i] = (char)tolower(c);
+    }
+    out[length] = '\0';
+    return length;
+}
+
+// Upper-case ARPAbet, stress digits dropped, single spaces; returns length
+static size_t normalize_phonemes(const char* phonemes, char* out, size_t capacity) {
+    size_t n = 0;
+    bool pending_space = false;
+    for (const char* p = phonemes; *p && *p != '\n' && *p != '\r'; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (isspace(c)) {
+            pending_space = n > 0;
+            continue;
+        }
+        if (!isalpha(c)) continue;
+        if (n + 2 >= capacity) break;
+        if (pending_space) out[n++] = ' ';
+        pending_space = false;
+        out[n++] = (char)toupper(c);
+    }
+    out[n] = '\0';
+    return n;
+}
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+typedef struct {
+    uint32_t word;
+    uint32_t phonemes;
+    uint32_t length;
+    uint64_t hash;              // Unseeded, for deduplication
+} BuildKey;
+
+static bool pool_append(char** pool, size_t* used, size_t* capacity,
+                        const char* s, size_t n, uint32_t* offset) {
+    if (*used + n + 1 > UINT32_MAX) return false;
+    if (*used + n + 1 > *capacity) {
+        size_t grown = *capacity ? *capacity * 2 : 4096;
+        while (grown < *used + n + 1) grown *= 2;
+        char* p = realloc(*pool, grown);
+        if (!p) return false;
+        *pool = p;
+        *capacity = grown;
+    }
+    memcpy(*pool + *used, s, n);
+    (*pool)[*used + n] = '\0';
+    *offset = (uint32_t)*used;
+    *used += n + 1;
+    return true;
+}
+
+// Place every bucket, largest first; false when some bucket runs out of
+// displacements under this seed
+static bool place_buckets(const BuildKey* keys, uint32_t count, const char* pool,
+                          uint64_t seed, uint32_t buckets, uint32_t slots,
+                          uint32_t* disp, LexiconSlot* table) {
+    bool ok = false;
+    uint64_t* hashes = malloc((size_t)count * sizeof(uint64_t) + 1);
+    uint32_t* start = calloc((size_t)buckets + 1, sizeof(uint32_t));
+    uint32_t* members = malloc((size_t)count * sizeof(uint32_t) + 1);
+    uint32_t* order = malloc((size_t)buckets * sizeof(uint32_t));
+    uint32_t* cursor = malloc((size_t)buckets * sizeof(uint32_t));
+    uint32_t* trial = malloc((size_t)count * sizeof(uint32_t) + 1);
+    uint32_t* by_size = NULL;
+    if (!hashes || !start || !members || !order || !cursor || !trial) goto done;
+
+    // Counting sort of keys into buckets
+    for (uint32_t i = 0; i < count; i++) {
+        hashes[i] = word_hash(pool + keys[i].word, keys[i].length, seed);
+        start[bucket_of(hashes[i], buckets) + 1]++;
+    }
+    uint32_t largest = 0;
+    for (uint32_t b = 0; b < buckets; b++) {
+        if (start[b + 1] > largest) largest = start[b + 1];
+        start[b + 1] += start[b];
+    }
+    memcpy(cursor, start, (size_t)buckets * sizeof(uint32_t));
+    for (uint32_t i = 0; i < count; i++) {
+        members[cursor[bucket_of(hashes[i], buckets)]++] = i;
+    }
+
+    // Non-empty buckets by size, descending (counting sort again, stable,
+    // so equal sizes keep bucket order); by_size[largest - size] is where
+    // that size's run starts
+    by_size = calloc((size_t)largest + 1, sizeof(uint32_t));
+    if (!by_size) goto done;
+    uint32_t n = 0;
+    for (uint32_t b = 0; b < buckets; b++) {
+        uint32_t size = start[b + 1] - start[b];
+        if (size > 0) by_size[largest - size + 1]++;
+    }
+    for (uint32_t k = 1; k <= largest; k++) by_size[k] += by_size[k - 1];
+    for (uint32_t b = 0; b < buckets; b++) {
+        uint32_t size = start[b + 1] - start[b];
+        if (size > 0) order[by_size[largest - size]++] = b;
+        n += size > 0;
+    }
+
+    for (uint32_t s = 0; s < slots; s++) table[s].word = LEXICON_EMPTY;
+    memset(disp, 0, (size_t)buckets * sizeof(uint32_t));
+
+    for (uint32_t o = 0; o < n; o++) {
+        uint32_t b = order[o];
+        uint32_t first = start[b];
+        uint32_t size = start[b + 1] - first;
+        bool placed = false;
+
+        for (uint32_t d = 0; d < MAX_DISPLACEMENT && !placed; d++) {
+            placed = true;
+            for (uint32_t k = 0; k < size && placed; k++) {
+                uint32_t slot = slot_of(hashes[members[first + k]], d, slots);
+                if (table[slot].word != LEXICON_EMPTY) placed = false;
+                for (uint32_t j = 0; j < k && placed; j++) {
+                    if (trial[j] == slot) placed = false;
+                }
+                trial[k] = slot;
+            }
+            if (placed) {
+                disp[b] = d;
+                for (uint32_t k = 0; k < size; k++) {
+                    const BuildKey* key = &keys[members[first + k]];
+                    table[trial[k]].word = key->word;
+                    table[trial[k]].phonemes = key->phonemes;
+                }
+            }
+        }
+        if (!placed) goto done;
+    }
+    ok = true;
+
+done:
+    free(hashes);
+    free(start);
+    free(members);
+    free(order);
+    free(cursor);
+    free(trial);
+    free(by_size);
+    return ok;
+}
+
+static void lexicon_bind(OBIVoxLexicon* lex, uint8_t* base, size_t bytes, bool mapped) {
+    lex->base = base;
+    lex->bytes = bytes;
+    lex->mapped = mapped;
+    lex->header = (const LexiconHeader*)base;
+    lex->disp = (const uint32_t*)(base + lex->header->disp_offset);
+    lex->slots = (const LexiconSlot*)(base + lex->header->slot_offset);
+    lex->pool = (const char*)(base + lex->header->pool_offset);
+    atomic_init(&lex->lookups, 0);
+    atomic_init(&lex->misses, 0);
+}
+
+int obivox_lexicon_build(
+    const OBIVoxLexiconEntry* entries,
+    uint32_t count,
+    OBIVoxLexicon** lexicon) {
+
+    if (!lexicon || (!entries && count > 0)) return -1;
+    *lexicon = NULL;
+
+    int result = -1;
+    char* pool = NULL;
+    size_t pool_used = 0, pool_capacity = 0;
+    BuildKey* keys = malloc((size_t)count * sizeof(BuildKey) + 1);
+    uint32_t dedup_mask = 15;
+    while (dedup_mask < (uint64_t)count * 2) dedup_mask = dedup_mask * 2 + 1;
+    uint32_t* dedup = malloc(((size_t)dedup_mask + 1) * sizeof(uint32_t));
+    uint8_t* blob = NULL;
+    if (!keys || !dedup) goto done;
+    memset(dedup, 0xFF, ((size_t)dedup_mask + 1) * sizeof(uint32_t));
+
+    // Normalize into the pool; words that repeat keep the first entry
+    uint32_t n = 0;
+    char word[LEXICON_WORD_MAX + 1];
+    char phonemes[256];
+    for (uint32_t i = 0; i < count; i++) {
+        if (!entries[i].word || !entries[i].phonemes) continue;
+        size_t length = normalize_word(entries[i].word, strlen(entries[i].word), word);
+        if (length == 0) continue;
+        size_t phoneme_length = normalize_phonemes(entries[i].phonemes, phonemes, sizeof(phonemes));
+        if (phoneme_length == 0) continue;
+
+        uint64_t h = word_hash(word, length, 0);
+        uint32_t slot = (uint32_t)h & dedup_mask;
+        bool duplicate = false;
+        while (dedup[slot] != LEXICON_EMPTY) {
+            const BuildKey* other = &keys[dedup[slot]];
+            if (other->hash == h && other->length == length &&
+                memcmp(pool + other->word, word, length) == 0) {
+                duplicate = true;
+                break;
+            }
+            slot = (slot + 1) & dedup_mask;
+        }
+        if (duplicate) continue;
+
+        BuildKey* key = &keys[n];
+        key->length = (uint32_t)length;
+        key->hash = h;
+        if (!pool_append(&pool, &pool_used, &pool_capacity, word, length, &key->word) ||
+            !pool_append(&pool, &pool_used, &pool_capacity, phonemes, phoneme_length, &key->phonemes)) {
+            goto done;
+        }
+        dedup[slot] = n++;
+    }
+
+    // Blob layout: header | disp[buckets] | slots[slots] | pool
+    uint32_t buckets = n / BUCKET_KEYS + 1;
+    uint32_t slots = n + n / 4 + 1;
+    size_t disp_offset = sizeof(LexiconHeader);
+    size_t slot_offset = (disp_offset + (size_t)buckets * sizeof(uint32_t) + 7) & ~(size_t)7;
+    size_t pool_offset = slot_offset + (size_t)slots * sizeof(LexiconSlot);
+    size_t total = pool_offset + pool_used;
+    blob = calloc(1, total);
+    if (!blob) goto done;
+    if (pool_used) memcpy(blob + pool_offset, pool, pool_used);
+
+    uint32_t* disp = (uint32_t*)(blob + disp_offset);
+    LexiconSlot* table = (LexiconSlot*)(blob + slot_offset);
+    uint64_t seed = 0;
+    bool placed = false;
+    for (uint32_t attempt = 0; attempt < MAX_SEEDS && !placed; attempt++) {
+        seed = mix64(PRIME1 * (attempt + 1));
+        placed = place_buckets(keys, n, pool, seed, buckets, slots, disp, table);
+    }
+    if (!placed) goto done;
+
+    LexiconHeader* header = (LexiconHeader*)blob;
+    memcpy(header->magic, LEXICON_MAGIC, sizeof(LEXICON_MAGIC));
+    header->version = LEXICON_VERSION;
+    header->entries = n;
+    header->buckets = buckets;
+    header->slots = slots;
+    header->seed = seed;
+    header->disp_offset = disp_offset;
+    header->slot_offset = slot_offset;
+    header->pool_offset = pool_offset;
+    header->pool_bytes = pool_used;
+    header->total_bytes = total;
+
+    OBIVoxLexicon* lex = calloc(1, sizeof(OBIVoxLexicon));
+    if (!lex) goto done;
+    lexicon_bind(lex, blob, total, false);
+    blob = NULL;
+    *lexicon = lex;
+    result = 0;
+
+done:
+    free(blob);
+    free(pool);
+    free(keys);
+    free(dedup);
+    return result;
+}
+
+// ============================================================================
+// Built-in Table
+// ============================================================================
+
+// Frequent words the letter-to-sound rules get wrong, sibilant-heavy ones
+// first since they drive lisp mitigation (pronunciations from CMUdict)
+static const OBIVoxLexiconEntry DEFAULT_ENTRIES[] = {
+    {"is", "IH Z"}, {"was", "W AA Z"}, {"has", "HH AE Z"}, {"his", "HH IH Z"},
+    {"as", "AE Z"}, {"does", "D AH Z"}, {"says", "S EH Z"}, {"said", "S EH D"},
+    {"yes", "Y EH S"}, {"this", "DH IH S"}, {"these", "DH IY Z"},
+    {"those", "DH OW Z"}, {"the", "DH AH"}, {"that", "DH AE T"},
+    {"they", "DH EY"}, {"them", "DH EH M"}, {"there", "DH EH R"},
+    {"their", "DH EH R"}, {"then", "DH EH N"}, {"than", "DH AE N"},
+    {"with", "W IH DH"}, {"thanks", "TH AE NG K S"}, {"think", "TH IH NG K"},
+    {"three", "TH R IY"}, {"thing", "TH IH NG"}, {"please", "P L IY Z"},
+    {"sure", "SH UH R"}, {"she", "SH IY"}, {"see", "S IY"}, {"so", "S OW"},
+    {"some", "S AH M"}, {"six", "S IH K S"}, {"seven", "S EH V AH N"},
+    {"zero", "Z IY R OW"}, {"because", "B IH K AH Z"}, {"voice", "V OY S"},
+    {"speech", "S P IY CH"}, {"sound", "S AW N D"}, {"message", "M EH S AH JH"},
+    {"system", "S IH S T AH M"}, {"question", "K W EH S CH AH N"},
+    {"answer", "AE N S ER"}, {"listen", "L IH S AH N"}, {"sister", "S IH S T ER"},
+    {"measure", "M EH ZH ER"}, {"vision", "V IH ZH AH N"},
+    {"usually", "Y UW ZH AH W AH L IY"}, {"science", "S AY AH N S"},
+    {"city", "S IH T IY"}, {"nice", "N AY S"}, {"just", "JH AH S T"},
+    {"change", "CH EY N JH"}, {"each", "IY CH"}, {"such", "S AH CH"},
+    {"a", "AH"}, {"i", "AY"}, {"and", "AE N D"}, {"of", "AH V"}, {"to", "T UW"},
+    {"two", "T UW"}, {"do", "D UW"}, {"you", "Y UW"}, {"your", "Y AO R"},
+    {"are", "AA R"}, {"what", "W AH T"}, {"who", "HH UW"}, {"where", "W EH R"},
+    {"one", "W AH N"}, {"four", "F AO R"}, {"five", "F AY V"}, {"eight", "EY T"},
+    {"nine", "N AY N"}, {"ten", "T EH N"}, {"hello", "HH AH L OW"},
+    {"have", "HH AE V"}, {"give", "G IH V"}, {"live", "L IH V"},
+    {"come", "K AH M"}, {"love", "L AH V"}, {"word", "W ER D"},
+    {"people", "P IY P AH L"}, {"could", "K UH D"}, {"would", "W UH D"},
+    {"should", "SH UH D"},
+};
+
+static OBIVoxLexicon* default_lexicon;
+static pthread_once_t default_once = PTHREAD_ONCE_INIT;
+
+static void default_build(void) {
+    uint32_t count = (uint32_t)(sizeof(DEFAULT_ENTRIES) / sizeof(DEFAULT_ENTRIES[0]));
+    if (obivox_lexicon_build(DEFAULT_ENTRIES, count, &default_lexicon) != 0) {
+        default_lexicon = NULL;
+    }
+}
+
+OBIVoxLexicon* obivox_lexicon_default(void) {
+    pthread_once(&default_once, default_build);
+    return default_lexicon;
+}
+
+// ============================================================================
+// Files
+// ============================================================================
+
+static bool header_valid(const LexiconHeader* h, size_t bytes) {
+    if (bytes < sizeof(LexiconHeader)) return false;
+    if (memcmp(h->magic, LEXICON_MAGIC, sizeof(LEXICON_MAGIC)) != 0) return false;
+    if (h->version != LEXICON_VERSION || h->total_bytes != bytes) return false;
+    if (h->buckets == 0 || h->slots == 0 || h->entries > h->slots) return false;
+    if (h->disp_offset < sizeof(LexiconHeader) || h->disp_offset % 4 != 0) return false;
+    if (h->slot_offset % 8 != 0 || h->slot_offset < h->disp_offset +
+        (uint64_t)h->buckets * sizeof(uint32_t)) return false;
+    if (h->pool_offset < h->slot_offset + (uint64_t)h->slots * sizeof(LexiconSlot)) return false;
+    if (h->pool_offset + h->pool_bytes != bytes) return false;
+    return h->pool_bytes == 0 || ((const char*)h)[bytes - 1] == '\0';
+}
+
+// Header layout, then every used slot's offsets inside the pool; with the
+// pool's trailing NUL, no string read from a slot can leave the blob
+static bool blob_valid(const void* blob, size_t bytes) {
+    const LexiconHeader* h = blob;
+    if (!header_valid(h, bytes)) return false;
+    const LexiconSlot* slots = (const LexiconSlot*)((const uint8_t*)blob + h->slot_offset);
+    for (uint32_t i = 0; i < h->slots; i++) {
+        if (slots[i].word == LEXICON_EMPTY) continue;
+        if (slots[i].word >= h->pool_bytes || slots[i].phonemes >= h->pool_bytes) return false;
+    }
+    return true;
+}
+
+// Borrowed entries over a writable copy of a CMUdict-style text file
+static int load_text(const char* data, size_t bytes, OBIVoxLexicon** lexicon) {
+    char* text = malloc(bytes + 1);
+    if (!text) return -1;
+    memcpy(text, data, bytes);
+    text[bytes] = '\0';
+
+    uint32_t capacity = 1024, count = 0;
+    OBIVoxLexiconEntry* entries = malloc(capacity * sizeof(OBIVoxLexiconEntry));
+    if (!entries) {
+        free(text);
+        return -1;
+    }
+
+    char* line = text;
+    while (line && *line) {
+        char* next = strchr(line, '\n');
+        if (next) *next++ = '\0';
+
+        char* word = line;
+        while (*word == ' ' || *word == '\t') word++;
+        char* end = word;
+        while (*end && *end != ' ' && *end != '\t' && *end != '\r') end++;
+        bool comment = strncmp(word, ";;;", 3) == 0;
+        bool variant = memchr(word, '(', (size_t)(end - word)) != NULL;
+        if (!comment && !variant && end > word && *end) {
+            *end = '\0';
+            if (count == capacity) {
+                OBIVoxLexiconEntry* grown = realloc(entries, (size_t)capacity * 2 * sizeof(OBIVoxLexiconEntry));
+                if (!grown) {
+                    free(entries);
+                    free(text);
+                    return -1;
+                }
+                entries = grown;
+                capacity *= 2;
+            }
+            entries[count].word = word;
+            entries[count].phonemes = end + 1;
+            count++;
+        }
+        line = next;
+    }
+
+    int result = obivox_lexicon_build(entries, count, lexicon);
+    free(entries);
+    free(text);
+    return result;
+}
+
+int obivox_lexicon_load(const char* path, OBIVoxLexicon** lexicon) {
+    if (!path || !lexicon) return -1;
+    *lexicon = NULL;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return -1;
+    }
+    size_t bytes = (size_t)st.st_size;
+    void* map = mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) return -1;
+
+    if (bytes >= sizeof(LEXICON_MAGIC) &&
+        memcmp(map, LEXICON_MAGIC, sizeof(LEXICON_MAGIC)) == 0) {
+        // Prebuilt: served in place, pages fault in on first lookup
+        if (!blob_valid(map, bytes)) {
+            munmap(map, bytes);
+            return -1;
+        }
+        OBIVoxLexicon* lex = calloc(1, sizeof(OBIVoxLexicon));
+        if (!lex) {
+            munmap(map, bytes);
+            return -1;
+        }
+        lexicon_bind(lex, map, bytes, true);
+        *lexicon = lex;
+        return 0;
+    }
+
+    int result = load_text(map, bytes, lexicon);
+    munmap(map, bytes);
+    return result;
+}
+
+int obivox_lexicon_open(const void* blob, size_t bytes, OBIVoxLexicon** lexicon) {
+    if (!blob || !lexicon) return -1;
+    *lexicon = NULL;
+    if ((uintptr_t)blob % sizeof(uint64_t) != 0) return -1;
+    if (!blob_valid(blob, bytes)) return -1;
+
+    OBIVoxLexicon* lex = calloc(1, sizeof(OBIVoxLexicon));
+    if (!lex) return -1;
+    lexicon_bind(lex, (uint8_t*)blob, bytes, true);
+    lex->borrowed = true;
+    *lexicon = lex;
+    return 0;
+}
+
+const void* obivox_lexicon_blob(const OBIVoxLexicon* lexicon, size_t* bytes) {
+    if (!lexicon) return NULL;
+    if (bytes) *bytes = lexicon->bytes;
+    return lexicon->base;
+}
+
+int obivox_lexicon_save(const OBIVoxLexicon* lexicon, const char* path) {
+    if (!lexicon || !path) return -1;
+    FILE* f = fopen(path, "wb");
+    if (!f) return -1;
+    size_t written = fwrite(lexicon->base, 1, lexicon->bytes, f);
+    int closed = fclose(f);
+    return written == lexicon->bytes && closed == 0 ? 0 : -1;
+}
+
+void obivox_lexicon_destroy(OBIVoxLexicon* lexicon) {
+    if (!lexicon || lexicon == default_lexicon) return;
+    if (lexicon->mapped && !lexicon->borrowed) {
+        munmap(lexicon->base, lexicon->bytes);
+    } else if (!lexicon->mapped) {
+        free(lexicon->base);
+    }
+    free(lexicon);
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+static const char* lookup_normalized(const OBIVoxLexicon* lex, const char* word, size_t length) {
+    const LexiconHeader* h = lex->header;
+    if (h->entries == 0) return NULL;
+    uint64_t hash = word_hash(word, length, h->seed);
+    uint32_t slot = slot_of(hash, lex->disp[bucket_of(hash, h->buckets)], h->slots);
+    const LexiconSlot* s = &lex->slots[slot];
+    if (s->word == LEXICON_EMPTY || (uint64_t)s->word + length >= h->pool_bytes) return NULL;
+    const char* stored = lex->pool + s->word;
+    if (memcmp(stored, word, length) != 0 || stored[length] != '\0') return NULL;
+    return lex->pool + s->phonemes;
+}
+
+const char* obivox_lexicon_lookup(OBIVoxLexicon* lexicon, const char* word, size_t length) {
+    if (!lexicon || !word) return NULL;
+    char normalized[LEXICON_WORD_MAX + 1];
+    length = normalize_word(word, length, normalized);
+    if (length == 0) return NULL;
+    return lookup_normalized(lexicon, normalized, length);
+}
+
+void obivox_lexicon_stats(const OBIVoxLexicon* lexicon, OBIVoxLexiconStats* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!lexicon) return;
+    stats->entries = lexicon->header->entries;
+    stats->slots = lexicon->header->slots;
+    stats->bytes = lexicon->bytes;
+    stats->mapped = lexicon->mapped;
+    stats->lookups = atomic_load_explicit(&lexicon->lookups, memory_order_relaxed);
+    stats->misses = atomic_load_explicit(&lexicon->misses, memory_order_relaxed);
+}
+
+// ============================================================================
+// Letter-to-Sound Fallback
+// ============================================================================
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} GuideBuffer;
+
+static bool guide_append(GuideBuffer* g, const char* s, size_t n) {
+    if (g->length + n + 1 > g->capacity) {
+        size_t grown = g->capacity * 2;
+        while (grown < g->length + n + 1) grown *= 2;
+        char* p = realloc(g->data, grown);
+        if (!p) return false;
+        g->data = p;
+        g->capacity = grown;
+    }
+    memcpy(g->data + g->length, s, n);
+    g->length += n;
+    g->data[g->length] = '\0';
+    return true;
+}
+
+// Longest grapheme first; the few context rules live in rules_pronounce
+static const struct {
+    const char* graphemes;
+    const char* phonemes;
+} LETTER_RULES[] = {
+    {"tion", "SH AH N"}, {"sion", "ZH AH N"}, {"ough", "AO"},
+    {"igh", "AY"}, {"tch", "CH"}, {"sch", "S K"},
+    {"sh", "SH"}, {"ch", "CH"}, {"th", "TH"}, {"ph", "F"}, {"wh", "W"},
+    {"ck", "K"}, {"ng", "NG"}, {"qu", "K W"}, {"kn", "N"}, {"wr", "R"},
+    {"ee", "IY"}, {"ea", "IY"}, {"oo", "UW"}, {"ou", "AW"}, {"ow", "OW"},
+    {"oi", "OY"}, {"oy", "OY"}, {"ai", "EY"}, {"ay", "EY"}, {"au", "AO"},
+    {"aw", "AO"}, {"ie", "IY"}, {"ei", "EY"}, {"er", "ER"}, {"ir", "ER"},
+    {"ur", "ER"}, {"ar", "AA R"}, {"or", "AO R"},
+    {"a", "AE"}, {"b", "B"}, {"c", "K"}, {"d", "D"}, {"e", "EH"}, {"f", "F"},
+    {"g", "G"}, {"h", "HH"}, {"i", "IH"}, {"j", "JH"}, {"k", "K"}, {"l", "L"},
+    {"m", "M"}, {"n", "N"}, {"o", "AA"}, {"p", "P"}, {"q", "K"}, {"r", "R"},
+    {"s", "S"}, {"t", "T"}, {"u", "AH"}, {"v", "V"}, {"w", "W"},
+    {"x", "K S"}, {"z", "Z"},
+};
+
+static bool is_vowel_letter(char c) {
+    return c == 'a' || c == 'e' || c == 'i' || c == 'o' || c == 'u';
+}
+
+static bool is_front_vowel_letter(char c) {
+    return c == 'e' || c == 'i' || c == 'y';
+}
+
+static bool rules_pronounce(const char* w, size_t n, GuideBuffer* g) {
+    // A final silent 'e' after a consonant ("make", "voice")
+    if (n > 2 && w[n - 1] == 'e' && !is_vowel_letter(w[n - 2])) n--;
+
+    bool first = true;
+    for (size_t i = 0; i < n;) {
+        const char* phonemes = NULL;
+        size_t used = 1;
+        char c = w[i];
+        char next = i + 1 < n ? w[i + 1] : '\0';
+
+        if (c == '\'') {
+            i++;
+            continue;
+        }
+        if (i > 0 && c == w[i - 1] && !is_vowel_letter(c)) {
+            // Doubled consonants sound once
+            i++;
+            continue;
+        }
+        if (c == 'c' && is_front_vowel_letter(next)) {
+            phonemes = "S";
+        } else if (c == 'g' && is_front_vowel_letter(next)) {
+            phonemes = "JH";
+        } else if (c == 'y') {
+            phonemes = i == 0 ? "Y" : (i + 1 == n ? "IY" : "IH");
+        } else {
+            for (size_t r = 0; r < sizeof(LETTER_RULES) / sizeof(LETTER_RULES[0]); r++) {
+                size_t len = strlen(LETTER_RULES[r].graphemes);
+                if (i + len <= n && memcmp(w + i, LETTER_RULES[r].graphemes, len) == 0) {
+                    phonemes = LETTER_RULES[r].phonemes;
+                    used = len;
+                    break;
+                }
+            }
+        }
+        if (phonemes) {
+            if (!first && !guide_append(g, " ", 1)) return false;
+            if (!guide_append(g, phonemes, strlen(phonemes))) return false;
+            first = false;
+        }
+        i += used;
+    }
+    return true;
+}
+
+// ============================================================================
+// Pronunciation Guide
+// ============================================================================
+
+static bool has_sibilant(const char* phonemes, size_t length) {
+    static const char* const SIBILANTS[] = {"S", "Z", "SH", "ZH", "CH", "JH", "TH", "DH"};
+    const char* p = phonemes;
+    const char* end = phonemes + length;
+    while (p < end) {
+        const char* stop = memchr(p, ' ', (size_t)(end - p));
+        if (!stop) stop = end;
+        size_t n = (size_t)(stop - p);
+        for (size_t i = 0; i < sizeof(SIBILANTS) / sizeof(SIBILANTS[0]); i++) {
+            if (strlen(SIBILANTS[i]) == n && memcmp(p, SIBILANTS[i], n) == 0) return true;
+        }
+        p = stop + 1;
+    }
+    return false;
+}
+
+int obivox_generate_pronunciation_guide_lexicon(
+    OBIVoxLexicon* lexicon,
+    const char* text,
+    const PhoneticAccessibility* accessibility,
+    char** phonetic_guide) {
+
+    if (!text || !phonetic_guide) return -1;
+    *phonetic_guide = NULL;
+    if (!lexicon) lexicon = obivox_lexicon_default();
+    bool mark = accessibility && accessibility->lisp_mitigation;
+
+    // About two guide bytes per text byte for lexicon words
+    GuideBuffer g = {0};
+    g.capacity = strlen(text) * 2 + 64;
+    g.data = malloc(g.capacity);
+    if (!g.data) return -1;
+    g.data[0] = '\0';
+
+    uint64_t lookups = 0, misses = 0;
+    char word[LEXICON_WORD_MAX + 1];
+    const char* p = text;
+    while (*p) {
+        while (*p && !isalpha((unsigned char)*p)) p++;
+        const char* start = p;
+        while (*p && (isalpha((unsigned char)*p) || *p == '\'')) p++;
+        size_t length = (size_t)(p - start);
+        if (length == 0) break;
+
+        // Tokens longer than any table word skip the lookup and go to the
+        // rules whole, from a copy of their own
+        size_t normalized = normalize_word(start, length, word);
+        const char* phonemes = NULL;
+        char* spelled = word;
+        if (normalized > 0 && lexicon) {
+            phonemes = lookup_normalized(lexicon, word, normalized);
+            lookups++;
+            if (!phonemes) misses++;
+        }
+        if (normalized == 0) {
+            spelled = malloc(length + 1);
+            if (!spelled) {
+                free(g.data);
+                return -1;
+            }
+            for (size_t i = 0; i < length; i++) spelled[i] = (char)tolower((unsigned char)start[i]);
+            spelled[length] = '\0';
+            normalized = length;
+        }
+
+        size_t line_start = g.length;
+        bool ok = guide_append(&g, "*", 1) &&
+                  guide_append(&g, spelled, normalized) &&
+                  guide_append(&g, "\t", 1);
+        size_t phonemes_start = g.length;
+        if (ok) {
+            ok = phonemes ? guide_append(&g, phonemes, strlen(phonemes))
+                          : rules_pronounce(spelled, normalized, &g);
+        }
+        if (ok) ok = guide_append(&g, "\n", 1);
+        if (spelled != word) free(spelled);
+        if (!ok) {
+            free(g.data);
+            return -1;
+        }
+
+        // Unmarked lines drop the marker written speculatively above
+        if (!mark || !has_sibilant(g.data + phonemes_start, g.length - 1 - phonemes_start)) {
+            memmove(g.data + line_start, g.data + line_start + 1, g.length - line_start);
+            g.length--;
+        }
+    }
+
+    if (lexicon) {
+        atomic_fetch_add_explicit(&lexicon->lookups, lookups, memory_order_relaxed);
+        atomic_fetch_add_explicit(&lexicon->misses, misses, memory_order_relaxed);
+    }
+    *phonetic_guide = g.data;
+    return 0;
+}
+
+int obivox_generate_pronunciation_guide(
+    const char* text,
+    const PhoneticAccessibility* accessibility,
+    char** phonetic_guide) {
+
+    return obivox_generate_pronunciation_guide_lexicon(NULL, text, accessibility, phonetic_guide);
+}
+
+// ============================================================================
+// System Integration
+// ============================================================================
+
+int obivox_nlm_attach_lexicon(OBIVoxNLMSystem* system, OBIVoxLexicon* lexicon) {
+    if (!system) return -1;
+    system->lexicon = lexicon;
+    return 0;
+}
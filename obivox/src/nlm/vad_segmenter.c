@@ -0,0 +1,403 @@
+/**
+ * vad_segmenter.c
+ * Energy/zero-crossing voice activity segmentation with min-silence
+ * hangover; fixed thresholds for whole buffers, tracked ones for streams
+ */
+
+#include "obivox/nlm_vad.h"
+#include "dsp/obivox_kernels.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Same -60 dBFS silence level the variation engine uses
+#define SILENCE_DB            -60.0f
+
+// A frame must sit this far above the floor before it can be speech
+#define MIN_MARGIN_DB         6.0f
+
+// Whole buffers with less dynamic range than this are all speech or all
+// noise; energy cannot tell which, so keep them rather than lose speech
+#define MIN_RANGE_DB          12.0f
+
+// Streaming trackers: the floor drops fast and creeps up, the peak
+// follows speech up at once and decays between utterances
+#define INITIAL_FLOOR_DB      -50.0f
+#define FLOOR_FALL            0.5f
+#define FLOOR_RISE_DB_PER_S   5.0f
+#define PEAK_DECAY_DB_PER_S   3.0f
+
+// Frame energy histogram for the whole-buffer floor/peak percentiles
+#define HIST_MIN_DB           -100.0f
+#define HIST_BIN_DB           0.5f
+#define HIST_BINS             220
+#define FLOOR_PERCENTILE      0.10f
+#define PEAK_PERCENTILE       0.95f
+
+struct obivox_vad {
+    OBIVoxVADConfig config;
+    uint32_t frame_size;
+    uint32_t min_silence_frames;
+    uint32_t min_speech_frames;
+    uint32_t padding;            // Samples
+    float floor_rise_db;         // Per frame
+    float peak_decay_db;         // Per frame
+
+    // Thresholds: tracked per frame (stream) or fixed per buffer
+    bool adaptive;
+    bool primed;
+    float floor_db;
+    float peak_db;
+
+    // Partial frame carried between pushes
+    uint32_t fill;
+    float energy;
+    uint64_t crossings;
+    float last_sample;
+    uint64_t samples;
+    uint64_t frames;
+
+    // Segment state machine
+    bool in_speech;
+    uint64_t start_frame;
+    uint64_t last_active_frame;
+    uint64_t prev_end;
+
+    OBIVoxSpeechSegment* segments;
+    uint32_t count;
+    uint32_t capacity;
+    bool taken;
+
+    // Whole-buffer frame features
+    float* frame_db;
+    float* frame_zcr;
+    uint32_t frame_capacity;
+};
+
+void obivox_vad_config_default(OBIVoxVADConfig* config) {
+    if (!config) return;
+    config->sample_rate = 16000;
+    config->frame_ms = 10.0f;
+    config->energy_threshold = 0.3f;
+    config->min_silence_ms = 300.0f;
+    config->min_speech_ms = 100.0f;
+    config->padding_ms = 50.0f;
+    config->zcr_threshold = 0.25f;
+}
+
+// ============================================================================
+// VAD Lifecycle
+// ============================================================================
+
+static uint32_t frames_for(float ms, float frame_ms) {
+    return (uint32_t)ceilf(ms / frame_ms);
+}
+
+int obivox_vad_create(const OBIVoxVADConfig* config, OBIVoxVAD** vad) {
+    if (!vad) return -1;
+
+    OBIVoxVAD* v = calloc(1, sizeof(OBIVoxVAD));
+    if (!v) return -1;
+
+    if (config) {
+        v->config = *config;
+    } else {
+        obivox_vad_config_default(&v->config);
+    }
+
+    OBIVoxVADConfig* c = &v->config;
+    if (c->sample_rate == 0 || c->frame_ms <= 0.0f) {
+        free(v);
+        return -1;
+    }
+
+    v->frame_size = (uint32_t)(c->sample_rate * c->frame_ms / 1000.0f);
+    if (v->frame_size == 0) v->frame_size = 1;
+    v->min_silence_frames = frames_for(c->min_silence_ms, c->frame_ms);
+    v->min_speech_frames = frames_for(c->min_speech_ms, c->frame_ms);
+    if (v->min_speech_frames == 0) v->min_speech_frames = 1;
+    v->padding = (uint32_t)(c->sample_rate * c->padding_ms / 1000.0f);
+    v->floor_rise_db = FLOOR_RISE_DB_PER_S * c->frame_ms / 1000.0f;
+    v->peak_decay_db = PEAK_DECAY_DB_PER_S * c->frame_ms / 1000.0f;
+
+    obivox_vad_reset(v);
+    *vad = v;
+    return 0;
+}
+
+void obivox_vad_reset(OBIVoxVAD* vad) {
+    if (!vad) return;
+    vad->adaptive = true;
+    vad->primed = false;
+    vad->floor_db = INITIAL_FLOOR_DB;
+    vad->peak_db = INITIAL_FLOOR_DB;
+    vad->fill = 0;
+    vad->energy = 0.0f;
+    vad->crossings = 0;
+    vad->last_sample = 0.0f;
+    vad->samples = 0;
+    vad->frames = 0;
+    vad->in_speech = false;
+    vad->start_frame = 0;
+    vad->last_active_frame = 0;
+    vad->prev_end = 0;
+    vad->count = 0;
+    vad->taken = false;
+}
+
+void obivox_vad_destroy(OBIVoxVAD* vad) {
+    if (!vad) return;
+    free(vad->segments);
+    free(vad->frame_db);
+    free(vad->frame_zcr);
+    free(vad);
+}
+
+bool obivox_vad_in_speech(const OBIVoxVAD* vad) {
+    return vad && vad->in_speech;
+}
+
+// ============================================================================
+// Frame Classification
+// ============================================================================
+
+static float energy_db(float energy, uint32_t n) {
+    return 10.0f * log10f(energy / (float)n + 1e-10f);
+}
+
+static void vad_track(OBIVoxVAD* v, float db) {
+    if (db < SILENCE_DB) return;
+
+    // Start from the first audible frame or the typical line floor,
+    // whichever is quieter, so a stream opening mid-word still triggers
+    if (!v->primed) {
+        v->floor_db = fminf(db, INITIAL_FLOOR_DB);
+        v->peak_db = db;
+        v->primed = true;
+        return;
+    }
+
+    if (db < v->floor_db) {
+        v->floor_db += (db - v->floor_db) * FLOOR_FALL;
+    } else {
+        v->floor_db = fminf(db, v->floor_db + v->floor_rise_db);
+    }
+    v->floor_db = fmaxf(v->floor_db, SILENCE_DB);
+
+    v->peak_db = db > v->peak_db ? db : fmaxf(v->peak_db - v->peak_decay_db, v->floor_db);
+}
+
+static bool vad_active(const OBIVoxVAD* v, float db, float zcr) {
+    if (db < SILENCE_DB) return false;
+
+    float range = v->peak_db - v->floor_db;
+    if (!v->adaptive && range < MIN_RANGE_DB) return true;
+
+    float voiced = v->floor_db + fmaxf(v->config.energy_threshold * range, MIN_MARGIN_DB);
+    if (db >= voiced) return true;
+
+    // Unvoiced consonants: quiet but dense in zero crossings
+    return zcr >= v->config.zcr_threshold && db >= v->floor_db + MIN_MARGIN_DB;
+}
+
+// ============================================================================
+// Segment State Machine
+// ============================================================================
+
+static int vad_emit(OBIVoxVAD* v, uint64_t first_frame, uint64_t end_frame) {
+    if (end_frame - first_frame < v->min_speech_frames) return 0;
+
+    uint64_t start = first_frame * v->frame_size;
+    start = start > v->padding ? start - v->padding : 0;
+    if (start < v->prev_end) start = v->prev_end;
+
+    uint64_t end = end_frame * v->frame_size + v->padding;
+    if (end > v->samples) end = v->samples;
+
+    if (v->count == v->capacity) {
+        uint32_t capacity = v->capacity ? v->capacity * 2 : 16;
+        OBIVoxSpeechSegment* grown = realloc(v->segments, capacity * sizeof(OBIVoxSpeechSegment));
+        if (!grown) return -1;
+        v->segments = grown;
+        v->capacity = capacity;
+    }
+
+    OBIVoxSpeechSegment* s = &v->segments[v->count++];
+    s->start_sample = start;
+    s->end_sample = end;
+    s->start_ms = start * 1000 / v->config.sample_rate;
+    s->end_ms = end * 1000 / v->config.sample_rate;
+
+    v->prev_end = end;
+    return 0;
+}
+
+static int vad_step(OBIVoxVAD* v, bool active) {
+    uint64_t frame = v->frames++;
+
+    if (active) {
+        if (!v->in_speech) {
+            v->in_speech = true;
+            v->start_frame = frame;
+        }
+        v->last_active_frame = frame;
+        return 0;
+    }
+
+    // Still in the hangover until min_silence of inactive frames
+    if (v->in_speech && frame - v->last_active_frame >= v->min_silence_frames) {
+        v->in_speech = false;
+        return vad_emit(v, v->start_frame, v->last_active_frame + 1);
+    }
+    return 0;
+}
+
+static int vad_close(OBIVoxVAD* v) {
+    if (!v->in_speech) return 0;
+    v->in_speech = false;
+    return vad_emit(v, v->start_frame, v->last_active_frame + 1);
+}
+
+static void vad_begin_output(OBIVoxVAD* v) {
+    if (v->taken) {
+        v->count = 0;
+        v->taken = false;
+    }
+}
+
+// ============================================================================
+// Whole Buffer
+// ============================================================================
+
+static float histogram_percentile(const uint32_t* histogram, uint32_t total, float p) {
+    uint32_t target = (uint32_t)(p * (float)total);
+    uint32_t seen = 0;
+    for (uint32_t b = 0; b < HIST_BINS; b++) {
+        seen += histogram[b];
+        if (seen > target) return HIST_MIN_DB + (b + 0.5f) * HIST_BIN_DB;
+    }
+    return HIST_MIN_DB + HIST_BINS * HIST_BIN_DB;
+}
+
+int obivox_vad_segment(
+    OBIVoxVAD* vad,
+    const float* audio,
+    uint32_t num_samples,
+    const OBIVoxSpeechSegment** segments,
+    uint32_t* count) {
+
+    if (!vad || (!audio && num_samples > 0) || !segments || !count) return -1;
+
+    obivox_vad_reset(vad);
+    vad->adaptive = false;
+
+    uint32_t frame_size = vad->frame_size;
+    uint32_t num_frames = (num_samples + frame_size - 1) / frame_size;
+    if (num_frames > vad->frame_capacity) {
+        float* db = realloc(vad->frame_db, num_frames * sizeof(float));
+        if (db) vad->frame_db = db;
+        float* zcr = realloc(vad->frame_zcr, num_frames * sizeof(float));
+        if (zcr) vad->frame_zcr = zcr;
+        if (!db || !zcr) return -1;
+        vad->frame_capacity = num_frames;
+    }
+
+    // Pass 1: per-frame energy and ZCR, plus the energy distribution
+    const OBIVoxKernels* kernels = obivox_kernels();
+    uint32_t histogram[HIST_BINS] = {0};
+    float previous = 0.0f;
+    for (uint32_t f = 0; f < num_frames; f++) {
+        const float* x = audio + (size_t)f * frame_size;
+        uint32_t n = num_samples - f * frame_size;
+        if (n > frame_size) n = frame_size;
+
+        float db = energy_db(kernels->dot(x, x, n), n);
+        vad->frame_db[f] = db;
+        vad->frame_zcr[f] = (float)kernels->zero_crossings(x, n, previous) / (float)n;
+        previous = x[n - 1];
+
+        int bin = (int)((db - HIST_MIN_DB) / HIST_BIN_DB);
+        if (bin < 0) bin = 0;
+        if (bin >= HIST_BINS) bin = HIST_BINS - 1;
+        histogram[bin]++;
+    }
+
+    if (num_frames > 0) {
+        vad->floor_db = fmaxf(histogram_percentile(histogram, num_frames, FLOOR_PERCENTILE), SILENCE_DB);
+        vad->peak_db = histogram_percentile(histogram, num_frames, PEAK_PERCENTILE);
+    }
+
+    // Pass 2: the streaming state machine against fixed thresholds
+    for (uint32_t f = 0; f < num_frames; f++) {
+        uint64_t end = (uint64_t)(f + 1) * frame_size;
+        vad->samples = end < num_samples ? end : num_samples;
+        if (vad_step(vad, vad_active(vad, vad->frame_db[f], vad->frame_zcr[f])) != 0) return -1;
+    }
+    if (vad_close(vad) != 0) return -1;
+
+    *segments = vad->segments;
+    *count = vad->count;
+    return 0;
+}
+
+// ============================================================================
+// Streaming
+// ============================================================================
+
+int obivox_vad_push(OBIVoxVAD* vad, const float* samples, uint32_t num_samples) {
+    if (!vad || (!samples && num_samples > 0)) return -1;
+
+    if (!vad->adaptive) obivox_vad_reset(vad);
+    vad_begin_output(vad);
+
+    const OBIVoxKernels* kernels = obivox_kernels();
+    bool voiced = vad->in_speech;
+
+    uint32_t i = 0;
+    while (i < num_samples) {
+        uint32_t step = vad->frame_size - vad->fill;
+        if (step > num_samples - i) step = num_samples - i;
+
+        const float* x = samples + i;
+        vad->energy += kernels->dot(x, x, step);
+        vad->crossings += kernels->zero_crossings(x, step, vad->last_sample);
+        vad->last_sample = x[step - 1];
+        vad->fill += step;
+        vad->samples += step;
+        i += step;
+
+        if (vad->fill < vad->frame_size) break;
+
+        float db = energy_db(vad->energy, vad->frame_size);
+        float zcr = (float)vad->crossings / (float)vad->frame_size;
+        vad_track(vad, db);
+        if (vad_step(vad, vad_active(vad, db, zcr)) != 0) return -1;
+        if (vad->in_speech) voiced = true;
+
+        vad->fill = 0;
+        vad->energy = 0.0f;
+        vad->crossings = 0;
+    }
+
+    return voiced ? 1 : 0;
+}
+
+int obivox_vad_flush(OBIVoxVAD* vad) {
+    if (!vad) return -1;
+    vad_begin_output(vad);
+    return vad_close(vad);
+}
+
+int obivox_vad_take_segments(
+    OBIVoxVAD* vad,
+    const OBIVoxSpeechSegment** segments,
+    uint32_t* count) {
+
+    if (!vad || !segments || !count) return -1;
+
+    vad_begin_output(vad);
+    *segments = vad->segments;
+    *count = vad->count;
+    vad->taken = true;
+    return 0;
+}
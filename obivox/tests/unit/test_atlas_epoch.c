@@ -0,0 +1,151 @@
+/**
+ * test_atlas_epoch.c
+ * Lock-free Atlas lookups under epoch-based reclamation: readers race a
+ * writer (and a balancing switch) and must never see a torn entry; COW
+ * updates must keep AVL / red-black invariants and key order
+ */
+
+#include "unit.h"
+#include "obivox/nlm_atlas.h"
+#include "nlm/atlas_internal.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define EPOCH_READERS   8
+#define EPOCH_WRITES    60000
+#define COW_KEYS        20000
+
+static OBIVoxAtlas* shared_atlas;
+static atomic_bool readers_stop;
+static atomic_long torn_reads;
+
+// Writers keep y == 3x; a reader seeing anything else saw a torn copy
+static void bump(OBIVoxAtlasEntry* entry, void* context) {
+    (void)context;
+    entry->x_coord++;
+    entry->y_coord = entry->x_coord * 3;
+    entry->confidence_score *= 0.99f;
+}
+
+static void* reader_main(void* arg) {
+    uint32_t x = (uint32_t)(uintptr_t)arg;
+    char service[32], operation[32];
+    OBIVoxAtlasEntry entry;
+    long hits = 0;
+    while (!atomic_load(&readers_stop)) {
+        x = x * 1664525u + 1013904223u;
+        snprintf(service, sizeof(service), "s%u", x % 40);
+        snprintf(operation, sizeof(operation), "o%u", (x >> 8) % 200);
+        if (obivox_atlas_lookup(shared_atlas, service, operation, &entry) == 0) {
+            hits++;
+            if (entry.y_coord != entry.x_coord * 3) atomic_fetch_add(&torn_reads, 1);
+        }
+    }
+    return (void*)hits;
+}
+
+void test_atlas_epoch_readers(void) {
+    UNIT_CHECK(obivox_atlas_create(TREE_MODE_HYBRID, &shared_atlas) == 0);
+    if (!shared_atlas) return;
+    atomic_store(&readers_stop, false);
+    atomic_store(&torn_reads, 0);
+
+    pthread_t readers[EPOCH_READERS];
+    for (uintptr_t i = 0; i < EPOCH_READERS; i++) {
+        UNIT_CHECK(pthread_create(&readers[i], NULL, reader_main, (void*)(i + 1)) == 0);
+    }
+
+    char service[32], operation[32];
+    for (uint32_t i = 0; i < EPOCH_WRITES; i++) {
+        uint32_t k = i * 2654435761u;
+        snprintf(service, sizeof(service), "s%u", k % 40);
+        snprintf(operation, sizeof(operation), "o%u", (k >> 8) % 200);
+        UNIT_CHECK(obivox_atlas_update(shared_atlas, service, operation, bump, NULL) >= 0);
+        // Readers mid-walk when the whole tree is rebuilt under them
+        if (i == EPOCH_WRITES / 2) UNIT_CHECK(obivox_atlas_set_mode(shared_atlas, TREE_MODE_RB) == 0);
+    }
+
+    atomic_store(&readers_stop, true);
+    long hits = 0;
+    for (int i = 0; i < EPOCH_READERS; i++) {
+        void* result;
+        pthread_join(readers[i], &result);
+        hits += (long)result;
+    }
+
+    OBIVoxAtlasMetrics metrics;
+    obivox_atlas_metrics(shared_atlas, &metrics);
+    UNIT_CHECK(atomic_load(&torn_reads) == 0);
+    UNIT_CHECK(hits > 0);
+    UNIT_CHECK(metrics.nodes > 0 && metrics.nodes <= 40 * 200);
+    obivox_atlas_destroy(shared_atlas);
+    shared_atlas = NULL;
+}
+
+// ============================================================================
+// COW Invariants
+// ============================================================================
+
+static int avl_height(const NLMAtlasNode* node) {
+    if (!node) return 0;
+    int l = avl_height(node->left), r = avl_height(node->right);
+    int h = 1 + (l > r ? l : r);
+    UNIT_CHECK(abs(l - r) <= 1 && node->height == h);
+    return h;
+}
+
+static int black_height(const NLMAtlasNode* node) {
+    if (!node) return 1;
+    if (node->color == RED) {
+        UNIT_CHECK(!(node->left && node->left->color == RED));
+        UNIT_CHECK(!(node->right && node->right->color == RED));
+    }
+    int l = black_height(node->left), r = black_height(node->right);
+    UNIT_CHECK(l == r);
+    return l + (node->color == BLACK);
+}
+
+static bool in_order(const NLMAtlasNode* node, const NLMAtlasNode** previous) {
+    if (!node) return true;
+    if (!in_order(node->left, previous)) return false;
+    if (*previous) {
+        int c = strcmp((*previous)->service, node->service);
+        if (c > 0 || (c == 0 && strcmp((*previous)->operation, node->operation) >= 0)) return false;
+    }
+    *previous = node;
+    return in_order(node->right, previous);
+}
+
+void test_atlas_cow_invariants(void) {
+    for (int balancing = 0; balancing < 2; balancing++) {
+        NLMAtlasNode* root = NULL;
+        NLMAtlasNode* retired[OBIVOX_ATLAS_MAX_RETIRED];
+        uint32_t retired_count, rotations, inserted = 0;
+        char key[32];
+
+        for (int i = 0; i < COW_KEYS; i++) {
+            NLMAtlasNode* next;
+            snprintf(key, sizeof(key), "k%d", (i * 7919) % 15013);
+            int ret = obivox_atlas_tree_update_cow(root, balancing, key, "x", NULL, NULL, &next,
+                                                   retired, &retired_count, &rotations);
+            UNIT_CHECK(ret >= 0);
+            if (ret < 0) break;
+            if (ret == 1) inserted++;
+            root = next;
+            // No readers here, so superseded nodes go straight back
+            for (uint32_t j = 0; j < retired_count; j++) free(retired[j]);
+        }
+
+        const NLMAtlasNode* previous = NULL;
+        UNIT_CHECK(in_order(root, &previous));
+        if (balancing == 0) {
+            avl_height(root);
+        } else {
+            black_height(root);
+        }
+        UNIT_CHECK(obivox_atlas_tree_count(root) == inserted);
+        obivox_atlas_free(root);
+    }
+}
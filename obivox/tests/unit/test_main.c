@@ -0,0 +1,28 @@
+/**
+ * test_main.c
+ * Runs every unit suite; exits non-zero if any check failed
+ */
+
+#include "unit.h"
+
+int unit_failures = 0;
+
+static const struct {
+    const char* name;
+    void (*run)(void);
+} SUITES[] = {
+    { "atlas_epoch_readers", test_atlas_epoch_readers },
+    { "atlas_cow_invariants", test_atlas_cow_invariants },
+    { "validation_concurrent_review", test_validation_concurrent_review },
+    { "validation_destroy_wakes", test_validation_destroy_wakes_submitters },
+    { "vad_convert_skips_silence", test_vad_convert_skips_silence },
+};
+
+int main(void) {
+    for (size_t i = 0; i < sizeof(SUITES) / sizeof(SUITES[0]); i++) {
+        int before = unit_failures;
+        SUITES[i].run();
+        printf("%-28s %s\n", SUITES[i].name, unit_failures == before ? "ok" : "FAILED");
+    }
+    return unit_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,83 @@
+/**
+ * test_vad_convert.c
+ * STT runs voice activity segmentation first: silence around an utterance
+ * must never reach variation detection or the codec, and an all-silent
+ * buffer must come back as an empty transcript without running them
+ */
+
+#include "unit.h"
+#include "obivox/nlm_framwork.h"
+#include "obivox/nlm_arena.h"
+#include "obivox/nlm_metrics.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define VAD_RATE        16000
+#define VAD_SAMPLES     (3 * VAD_RATE)      // Silence, 1 s tone, silence
+#define VAD_PADDING     (VAD_RATE / 20)     // Default 50 ms per side
+#define VAD_FRAME       (VAD_RATE / 100)    // Default 10 ms frames
+
+// Background hiss well under the VAD's -60 dB silence floor
+static void fill_silence(float* audio, uint32_t count, uint32_t seed) {
+    for (uint32_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        audio[i] = ((float)(seed >> 8) / (float)(1u << 24) - 0.5f) * 1e-4f;
+    }
+}
+
+void test_vad_convert_skips_silence(void) {
+    float* audio = malloc(VAD_SAMPLES * sizeof(float));
+    float* original = malloc(VAD_SAMPLES * sizeof(float));
+    OBIVoxNLMSystem* system = NULL;
+    OBIVoxMetrics* metrics = NULL;
+    UNIT_CHECK(audio && original);
+    UNIT_CHECK(obivox_nlm_init(&system) == 0);
+    UNIT_CHECK(obivox_metrics_create(NULL, &metrics) == 0);
+    if (!audio || !original || !system || !metrics) goto done;
+    obivox_nlm_attach_metrics(system, metrics);
+
+    fill_silence(audio, VAD_SAMPLES, 7);
+    for (uint32_t i = VAD_RATE; i < 2 * VAD_RATE; i++) {
+        audio[i] = 0.3f * sinf(2.0f * (float)M_PI * 220.0f * i / VAD_RATE);
+    }
+    memcpy(original, audio, VAD_SAMPLES * sizeof(float));
+
+    void* output = NULL;
+    float confidence = 0.0f;
+    UNIT_CHECK(obivox_bidirectional_convert_sized(system, audio, VAD_SAMPLES * sizeof(float),
+                                                 INPUT_AUDIO, &output, &confidence) == 0);
+    obivox_release_output(system, output);
+
+    // Only the tone and its padding went on to the later stages
+    OBIVoxMetricsSnapshot snapshot;
+    obivox_metrics_snapshot(metrics, &snapshot);
+    uint64_t voiced = snapshot.counters[OBIVOX_COUNTER_SAMPLES_VOICED];
+    UNIT_CHECK(snapshot.counters[OBIVOX_COUNTER_SAMPLES_IN] == VAD_SAMPLES);
+    UNIT_CHECK(voiced >= VAD_RATE - 2 * VAD_FRAME);
+    UNIT_CHECK(voiced <= VAD_RATE + 2 * (VAD_PADDING + VAD_FRAME));
+    UNIT_CHECK(snapshot.stages[OBIVOX_STAGE_VAD].count == 1);
+    UNIT_CHECK(snapshot.stages[OBIVOX_STAGE_VARIATION].count == 1);
+    UNIT_CHECK(memcmp(original, audio, VAD_SAMPLES * sizeof(float)) == 0);
+
+    // All silence: segmented, then nothing else runs
+    fill_silence(audio, VAD_SAMPLES, 11);
+    output = NULL;
+    UNIT_CHECK(obivox_bidirectional_convert_sized(system, audio, VAD_SAMPLES * sizeof(float),
+                                                 INPUT_AUDIO, &output, &confidence) == 0);
+    UNIT_CHECK(output && ((const char*)output)[0] == '\0');
+    obivox_release_output(system, output);
+
+    obivox_metrics_snapshot(metrics, &snapshot);
+    UNIT_CHECK(snapshot.counters[OBIVOX_COUNTER_SAMPLES_VOICED] == voiced);
+    UNIT_CHECK(snapshot.stages[OBIVOX_STAGE_VAD].count == 2);
+    UNIT_CHECK(snapshot.stages[OBIVOX_STAGE_VARIATION].count == 1);
+    UNIT_CHECK(snapshot.stages[OBIVOX_STAGE_DENOISE].count == 1);
+    UNIT_CHECK(snapshot.stages[OBIVOX_STAGE_CODEC].count == 1);
+
+done:
+    obivox_nlm_destroy(system);
+    obivox_metrics_destroy(metrics);
+    free(original);
+    free(audio);
+}
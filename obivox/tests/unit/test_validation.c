@@ -0,0 +1,159 @@
+/**
+ * test_validation.c
+ * Validation queue under load: producers race reviewers through a small
+ * queue (backpressure), every resolution must reach on_applied exactly
+ * once; destroy must release a submitter blocked on a full queue
+ */
+
+#include "unit.h"
+#include "obivox/nlm_validation.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define VALIDATION_PRODUCERS    4
+#define VALIDATION_REVIEWERS    3
+#define VALIDATION_PER_PRODUCER 2000
+#define VALIDATION_TOTAL        (VALIDATION_PRODUCERS * VALIDATION_PER_PRODUCER)
+
+static OBIVoxValidationQueue* shared_queue;
+static atomic_int applied_counts[VALIDATION_TOTAL];
+static atomic_int corrections_seen;
+static atomic_int submit_errors;
+static atomic_int resolutions_made;
+
+// Texts are "t<index>"; reviewers correct every third one
+static void on_applied(OBIVoxTicket ticket, const char* original,
+                       const char* correction, void* user_data) {
+    (void)ticket;
+    (void)user_data;
+    int index = atoi(original + 1);
+    if (index >= 0 && index < VALIDATION_TOTAL) atomic_fetch_add(&applied_counts[index], 1);
+    if (correction) atomic_fetch_add(&corrections_seen, 1);
+}
+
+static void* producer_main(void* arg) {
+    int base = (int)(intptr_t)arg * VALIDATION_PER_PRODUCER;
+    char text[32];
+    for (int i = 0; i < VALIDATION_PER_PRODUCER; i++) {
+        snprintf(text, sizeof(text), "t%d", base + i);
+        OBIVoxTicket ticket = 0;
+        if (obivox_validation_submit(shared_queue, text, 0.1f, true, &ticket) != 0 || ticket == 0) {
+            atomic_fetch_add(&submit_errors, 1);
+        }
+    }
+    return NULL;
+}
+
+static void* reviewer_main(void* arg) {
+    (void)arg;
+    OBIVoxValidationRequest request;
+    while (atomic_load(&resolutions_made) < VALIDATION_TOTAL) {
+        if (obivox_validation_next(shared_queue, &request) != 0) {
+            sched_yield();
+            continue;
+        }
+        int index = atoi(request.text + 1);
+        const char* correction = index % 3 == 0 ? "fixed" : NULL;
+        UNIT_CHECK(obivox_validation_resolve(shared_queue, request.ticket, correction) == 0);
+        UNIT_CHECK(obivox_validation_resolve(shared_queue, request.ticket, NULL) == -1);
+        atomic_fetch_add(&resolutions_made, 1);
+    }
+    return NULL;
+}
+
+void test_validation_concurrent_review(void) {
+    OBIVoxValidationConfig config;
+    obivox_validation_config_default(&config);
+    config.capacity = 16;               // Far below the load: producers block
+    config.block_timeout_ms = 30000;
+    config.batch_size = 8;
+    config.flush_interval_ms = 5;
+    config.expire_ms = 0;
+    config.on_applied = on_applied;
+
+    for (int i = 0; i < VALIDATION_TOTAL; i++) atomic_store(&applied_counts[i], 0);
+    atomic_store(&corrections_seen, 0);
+    atomic_store(&submit_errors, 0);
+    atomic_store(&resolutions_made, 0);
+
+    UNIT_CHECK(obivox_validation_queue_create(NULL, &config, &shared_queue) == 0);
+    if (!shared_queue) return;
+
+    pthread_t producers[VALIDATION_PRODUCERS], reviewers[VALIDATION_REVIEWERS];
+    for (intptr_t i = 0; i < VALIDATION_PRODUCERS; i++) {
+        UNIT_CHECK(pthread_create(&producers[i], NULL, producer_main, (void*)i) == 0);
+    }
+    for (intptr_t i = 0; i < VALIDATION_REVIEWERS; i++) {
+        UNIT_CHECK(pthread_create(&reviewers[i], NULL, reviewer_main, NULL) == 0);
+    }
+    for (int i = 0; i < VALIDATION_PRODUCERS; i++) pthread_join(producers[i], NULL);
+    for (int i = 0; i < VALIDATION_REVIEWERS; i++) pthread_join(reviewers[i], NULL);
+
+    UNIT_CHECK(obivox_validation_flush(shared_queue) == 0);
+    OBIVoxValidationStats stats;
+    obivox_validation_stats(shared_queue, &stats);
+    obivox_validation_queue_destroy(shared_queue);
+    shared_queue = NULL;
+
+    UNIT_CHECK(atomic_load(&submit_errors) == 0);
+    UNIT_CHECK(stats.submitted == VALIDATION_TOTAL);
+    UNIT_CHECK(stats.resolved == VALIDATION_TOTAL);
+    UNIT_CHECK(stats.applied == VALIDATION_TOTAL);
+    UNIT_CHECK(stats.outstanding == 0);
+    UNIT_CHECK(stats.blocked > 0);
+
+    int wrong = 0;
+    for (int i = 0; i < VALIDATION_TOTAL; i++) {
+        if (atomic_load(&applied_counts[i]) != 1) wrong++;
+    }
+    UNIT_CHECK(wrong == 0);
+    UNIT_CHECK(atomic_load(&corrections_seen) == (VALIDATION_TOTAL + 2) / 3);
+}
+
+static void* blocked_submitter_main(void* arg) {
+    OBIVoxTicket ticket = 0;
+    intptr_t ret = obivox_validation_submit(arg, "late", 0.1f, true, &ticket);
+    return (void*)ret;
+}
+
+void test_validation_destroy_wakes_submitters(void) {
+    OBIVoxValidationConfig config;
+    obivox_validation_config_default(&config);
+    config.capacity = 1;
+    config.block_timeout_ms = 60000;   // Only destroy can end the wait in time
+    config.expire_ms = 0;
+
+    OBIVoxValidationQueue* queue = NULL;
+    UNIT_CHECK(obivox_validation_queue_create(NULL, &config, &queue) == 0);
+    if (!queue) return;
+
+    OBIVoxTicket ticket = 0;
+    UNIT_CHECK(obivox_validation_submit(queue, "first", 0.1f, true, &ticket) == 0);
+    UNIT_CHECK(ticket != 0);
+
+    pthread_t thread;
+    UNIT_CHECK(pthread_create(&thread, NULL, blocked_submitter_main, queue) == 0);
+
+    // blocked is counted under the lock as the submitter starts waiting
+    OBIVoxValidationStats stats = {0};
+    struct timespec pause = { .tv_sec = 0, .tv_nsec = 1000000 };
+    for (int i = 0; i < 10000 && stats.blocked == 0; i++) {
+        nanosleep(&pause, NULL);
+        obivox_validation_stats(queue, &stats);
+    }
+    UNIT_CHECK(stats.blocked == 1);
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    obivox_validation_queue_destroy(queue);
+    void* ret = NULL;
+    pthread_join(thread, &ret);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    UNIT_CHECK((intptr_t)ret == -1);
+    UNIT_CHECK(end.tv_sec - start.tv_sec < 10);
+}
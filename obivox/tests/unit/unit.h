@@ -0,0 +1,29 @@
+/**
+ * unit.h
+ * Minimal harness for tests/unit: every *.c here links into one binary
+ * (make test-unit) whose main runs the suites listed in test_main.c
+ */
+
+#ifndef OBIVOX_TESTS_UNIT_H
+#define OBIVOX_TESTS_UNIT_H
+
+#include <stdio.h>
+
+extern int unit_failures;
+
+// Record a failure and keep going, so one run reports every broken check
+#define UNIT_CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+        unit_failures++; \
+    } \
+} while (0)
+
+// Suites
+void test_atlas_epoch_readers(void);
+void test_atlas_cow_invariants(void);
+void test_validation_concurrent_review(void);
+void test_validation_destroy_wakes_submitters(void);
+void test_vad_convert_skips_silence(void);
+
+#endif // OBIVOX_TESTS_UNIT_H